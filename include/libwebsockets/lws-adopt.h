@@ -120,6 +120,26 @@ struct lws_udp {
 	lws_sockaddr46		sa46_pending;
 	uint8_t			connected:1;
 };
+
+/**
+ * lws_udp_dgram_t - one datagram in a batch
+ *
+ * For LWS_CALLBACK_RAW_RX_BATCH, \p in is an array of these and \p len the
+ * count of them.  \p buf points into lws-owned storage that is only valid
+ * during the callback.
+ *
+ * For lws_udp_write_batch(), you fill in an array of them.  If \p sa46 is
+ * left zeroed, the datagram goes to the wsi's current peer, as lws_write()
+ * would send it.
+ */
+typedef struct lws_udp_dgram {
+	const uint8_t		*buf;	/**< datagram payload */
+	size_t			len;	/**< payload length */
+	lws_sockaddr46		sa46;	/**< peer it came from / goes to */
+	uint8_t			truncated:1; /**< rx: didn't fit the slot (always
+						* 0 on platforms without
+						* recvmmsg() or recvmsg()) */
+} lws_udp_dgram_t;
 #endif
 
 /**
@@ -244,6 +264,12 @@ lws_adopt_socket_vhost_readbuf(struct lws_vhost *vhost,
 #define LWS_CAUDP_BIND (1 << 0)
 #define LWS_CAUDP_BROADCAST (1 << 1)
 #define LWS_CAUDP_PF_PACKET (1 << 2)
+#define LWS_CAUDP_BATCH_RX (1 << 3)
+/**< rx is delivered as up to LWS_UDP_BATCH datagrams at a time in
+ * LWS_CALLBACK_RAW_RX_BATCH, using one recvmmsg() where the platform has it,
+ * instead of one LWS_CALLBACK_RAW_RX per datagram */
+
+#define LWS_UDP_BATCH 16
 
 #if defined(LWS_WITH_UDP)
 /**
@@ -252,7 +278,7 @@ lws_adopt_socket_vhost_readbuf(struct lws_vhost *vhost,
  * \param vhost:	 lws vhost
  * \param ads:		 NULL or address to do dns lookup on
  * \param port:		 UDP port to bind to, -1 means unbound
- * \param flags:	 0 or LWS_CAUDP_NO_BIND
+ * \param flags:	 0 or LWS_CAUDP_ flags
  * \param protocol_name: Name of protocol on vhost to bind wsi to
  * \param ifname:	 NULL, for network interface name to bind socket to
  * \param parent_wsi:	 NULL or parent wsi new wsi will be a child of
@@ -272,6 +298,27 @@ lws_create_adopt_udp(struct lws_vhost *vhost, const char *ads, int port,
 		     int flags, const char *protocol_name, const char *ifname,
 		     struct lws *parent_wsi, void *opaque,
 		     const lws_retry_bo_t *retry_policy, const char *fi_wsi_name);
+
+/**
+ * lws_udp_write_batch() - send several datagrams on a UDP wsi at once
+ *
+ * \param wsi:	 the UDP wsi
+ * \param d:	 array of datagrams to send
+ * \param count: number of datagrams in \p d
+ *
+ * Sends the datagrams in order, using sendmmsg() to pass up to LWS_UDP_BATCH
+ * of them to the kernel per syscall where the platform has it.
+ *
+ * Returns how many datagrams were sent, which may be less than \p count if
+ * the socket stopped accepting them, or -1 on fatal error.  Unlike
+ * lws_write(), the unsent remainder is not buffered: lws asks for a
+ * writeable callback and it's up to you to send the rest from there.
+ *
+ * Call it from the wsi's LWS_CALLBACK_RAW_WRITEABLE like lws_write().
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_udp_write_batch(struct lws *wsi, const lws_udp_dgram_t *d,
+		    unsigned int count);
 #endif
 
 
@@ -892,6 +892,12 @@ enum lws_callback_reasons {
 	 * mount.
 	 */
 
+	LWS_CALLBACK_RAW_RX_BATCH				= 214,
+	/**< RAW mode UDP wsi created with LWS_CAUDP_BATCH_RX has received
+	 * datagrams.  \p in is an array of lws_udp_dgram_t and \p len is the
+	 * number of them, 1 to LWS_UDP_BATCH.  Return -1 to close the wsi.
+	 */
+
 	/****** add new things just above ---^ ******/
 
 	LWS_CALLBACK_USER = 1000,
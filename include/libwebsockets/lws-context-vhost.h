@@ -262,6 +262,48 @@
 #define LWS_SERVER_OPTION_VH_INSTANTIATE_ALL_PROTOCOLS		(1ll << 42)
 	/**< (VH) force instantiation of all protocols for this vhost */
 
+#define LWS_SERVER_OPTION_EPOLL					 (1ll << 43)
+	/**< (CTX) Use the built-in Linux epoll() event loop */
+
+#define LWS_SERVER_OPTION_EPOLL_EDGE_TRIGGERED			 (1ll << 44)
+	/**< (CTX) With LWS_SERVER_OPTION_EPOLL, register connection fds
+	 * EPOLLET.  Dropping POLLOUT / rx flow control interest then costs no
+	 * syscall, at the cost of a re-arm after each rx service */
+
+#define LWS_SERVER_OPTION_EPOLL_EXCLUSIVE_LISTEN		 (1ll << 45)
+	/**< (CTX) With LWS_SERVER_OPTION_EPOLL, register listen sockets with
+	 * EPOLLEXCLUSIVE, so when one listen fd is shared by several processes
+	 * or loops, only one of them is woken per incoming connection */
+
+#define LWS_SERVER_OPTION_IO_URING				 (1ll << 46)
+	/**< (CTX) Use the built-in Linux io_uring event loop.  If the
+	 * running kernel can't provide it, lws warns and falls back to the
+	 * loop it would otherwise have used */
+
+#define LWS_SERVER_OPTION_KTLS					 (1ll << 47)
+	/**< (VH) OpenSSL 3+ on Linux: ask OpenSSL to hand the record crypto
+	 * for this vhost's server and client connections to the kernel (kTLS)
+	 * after the handshake.  Connections where the kernel or the negotiated
+	 * cipher can't do it silently stay in userland.  Where tx moved to
+	 * the kernel, zero-copy file:// mounts can use sendfile() on tls
+	 * connections too */
+
+#define LWS_SERVER_OPTION_WSI_SLAB				 (1ll << 48)
+	/**< (CTX) Each service thread keeps freed wsi and per-session data
+	 * allocations for reuse, up to info.wsi_slab_depth of each size, so
+	 * accept and close stop going to the heap once it is warm.  Hits and
+	 * misses are reported in the n.slab.wsi and n.slab.pss metrics */
+
+#define LWS_SERVER_OPTION_REUSEPORT_CPU_AFFINITY		 (1ll << 49)
+	/**< (VH) Linux only, with count_threads > 1, where each service thread
+	 * already has its own SO_REUSEPORT listen socket.  Connections are kept
+	 * on the service thread whose listener accepted them instead of being
+	 * moved to the least busy one, and a classic BPF program steers each
+	 * new connection to the listener of thread (rx cpu % count_threads),
+	 * or SO_INCOMING_CPU is set on the listeners if that's not possible.
+	 * Pin service thread n to cpu n to keep a connection's processing on
+	 * the cpu its packets arrive on */
+
 	/****** add new things just above ---^ ******/
 
 
@@ -998,6 +1040,36 @@ struct lws_context_creation_info {
 	/**< CONTEXT: optionally pass the app commandline to the context, so we can use it
 	 * as part of lws_cmdline_option_cx() */
 
+	unsigned int		wsi_slab_depth;
+	/**< CONTEXT: with LWS_SERVER_OPTION_WSI_SLAB, how many freed wsi, and
+	 * pss of each size, each service thread may keep for reuse.  0 means
+	 * 1024 */
+
+	unsigned int		accept_budget;
+	/**< CONTEXT: how many connections a service thread may accept from a
+	 * listen socket each time it's woken for it, before going on to
+	 * service other things.  0 means 64 */
+
+	int			h2_hpack_enc_table_size;
+	/**< VHOST: size in bytes of the HPACK dynamic table lws keeps for
+	 * header blocks it sends on each h2 connection, limited to what the
+	 * peer allows.  0 means 4096.  LWS_H2_HPACK_ENC_NO_DYNAMIC only uses
+	 * the static table and Huffman coding, LWS_H2_HPACK_ENC_DISABLE sends
+	 * headers as plain literals like older lws */
+#define LWS_H2_HPACK_ENC_NO_DYNAMIC	-1
+#define LWS_H2_HPACK_ENC_DISABLE	-2
+
+	size_t			http_file_cache_size;
+	/**< VHOST: 0, or how many bytes of recently served files the vhost
+	 * may keep in memory, so repeat requests for them are served without
+	 * touching the filesystem.  Compressed forms kept for them count too */
+	size_t			http_file_cache_max_file;
+	/**< VHOST: files bigger than this are not cached.  0 means 64KiB */
+	unsigned int		http_file_cache_revalidate_ms;
+	/**< VHOST: a cached file is stat()ed to check it didn't change when
+	 * it's served, if it was last checked longer ago than this.
+	 * 0 means 1000ms */
+
 	/* Add new things just above here ---^
 	 * This is part of the ABI, don't needlessly break compatibility
 	 *
@@ -1406,6 +1478,19 @@ struct lws_http_mount {
 	unsigned int cache_revalidate:1; /**< set if client cache should revalidate on use */
 	unsigned int cache_intermediaries:1; /**< set if intermediaries are allowed to cache */
 	unsigned int cache_no:1; /**< set if client should check cache always*/
+	unsigned int zero_copy:1;
+	/**< set to send files on this mount with sendfile() where possible,
+	 * ie, non-tls h1 connections on platforms that have it, without
+	 * chunking, interpretation or stream compression */
+	unsigned int precompressed:1;
+	/**< set to send file.br or file.gz instead of file to clients that
+	 * accept br or gzip, if it exists and is not older than file */
+	unsigned int precompress_generate:1;
+	/**< with precompressed, when a client could take it but there is no
+	 * usable file.br or file.gz for a compressible file, make them in the
+	 * background (needs LWS_WITH_THREADPOOL and
+	 * LWS_WITH_HTTP_STREAM_COMPRESSION).  They get file's mtime, and
+	 * siblings lws could make are then only used with exactly that mtime */
 
 	unsigned char origin_protocol; /**< one of enum lws_mount_protocols */
 	unsigned char mountpoint_len; /**< length of mountpoint string */
@@ -77,6 +77,12 @@ struct lws_event_loop_ops {
 	uint16_t	evlib_size_pt;
 	uint16_t	evlib_size_vh;
 	uint16_t	evlib_size_wsi;
+
+	/* optional: replaces poll() in the default service loop, dispatching
+	 * ready fds itself.  Returns count of pt->fds left with revents for
+	 * the default loop to service, or < 0 for error */
+	int (*service_wait)(struct lws_context *context, int timeout_ms,
+			    int tsi);
 };
 
 LWS_VISIBLE LWS_EXTERN void *
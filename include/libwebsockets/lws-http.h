@@ -91,6 +91,32 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 
 LWS_VISIBLE LWS_EXTERN int
 lws_serve_http_file_fragment(struct lws *wsi);
+
+typedef struct lws_http_file_cache_stats {
+	uint64_t	hits;	   /**< files served from the cache */
+	uint64_t	misses;	   /**< files read into the cache */
+	uint64_t	enc_hits;  /**< hits served as a cached gzip or br form */
+	uint32_t	invalidations; /**< entries dropped as the file changed */
+	uint32_t	evictions; /**< entries dropped to make room */
+	uint32_t	entries;   /**< files held in the cache now */
+	size_t		footprint; /**< bytes held now, with compressed forms */
+} lws_http_file_cache_stats_t;
+
+/**
+ * lws_http_file_cache_stats() - get the vhost's file cache stats
+ *
+ * \param vh: the vhost
+ * \param stats: struct to fill with the stats
+ *
+ * Vhosts created with a nonzero http_file_cache_size in their creation info
+ * keep the content of small files served by lws_serve_http_file(), and by
+ * file:// mounts, in memory.  This reports how that is going.
+ *
+ * Returns 0 if \p stats was filled, or nonzero if the vhost has no cache.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_http_file_cache_stats(struct lws_vhost *vh,
+			  lws_http_file_cache_stats_t *stats);
 //@}
 
 
@@ -753,6 +779,79 @@ lws_add_http_common_headers(struct lws *wsi, unsigned int code,
 			    const char *content_type, lws_filepos_t content_len,
 			    unsigned char **p, unsigned char *end);
 
+/*
+ * Precompiled response headers
+ *
+ * A server that sends the same set of response headers over and over can
+ * build them once into an lws_http_hdr_block_t, which holds the finished h1
+ * and h2 forms of the status and headers.  Adding them to a response is then
+ * a memcpy, with only the parts that change each time added after it.
+ */
+
+typedef struct lws_http_hdr_block lws_http_hdr_block_t;
+
+#define LWSHBF_DATE	(1 << 0) /* add a date: header for the time it's sent */
+
+typedef struct lws_http_hdr_block_info {
+	struct lws_vhost		*vhost;
+	/**< the vhost the responses will go out on.  Its headers, server name
+	 * and sts header are built into the block, as
+	 * lws_add_http_header_status() would add them */
+	const struct lws_protocol_vhost_options *mount_headers;
+	/**< NULL, or the headers of the mount the responses are for, these
+	 * override vhost headers of the same name */
+	const struct lws_protocol_vhost_options *headers;
+	/**< NULL, or a linked-list of further headers, name like "name:" */
+	const char			*content_type;
+	/**< NULL, or the content-type */
+	unsigned int			code;
+	/**< the response code, may have LWSAHH_FLAG_NO_SERVER_NAME OR'd */
+	unsigned int			flags;
+	/**< LWSHBF_ flags */
+} lws_http_hdr_block_info_t;
+
+/**
+ * lws_http_hdr_block_create() - precompile a set of response headers
+ *
+ * \param info: what goes in the block
+ *
+ * Returns the block, or NULL on OOM or if the headers are too big.  The block
+ * does not refer to anything in info after it returns, but it should not be
+ * used after the vhost is destroyed.
+ */
+LWS_VISIBLE LWS_EXTERN lws_http_hdr_block_t *
+lws_http_hdr_block_create(const lws_http_hdr_block_info_t *info);
+
+/**
+ * lws_http_hdr_block_destroy() - free a block of precompiled headers
+ *
+ * \param pb: pointer to the block pointer, set to NULL after
+ */
+LWS_VISIBLE LWS_EXTERN void
+lws_http_hdr_block_destroy(lws_http_hdr_block_t **pb);
+
+/**
+ * lws_add_http_header_block() - add the status and precompiled headers
+ *
+ * \param wsi: the connection to check
+ * \param b: the precompiled headers
+ * \param content_len: the content length, or LWS_ILLEGAL_HTTP_CONTENT_LEN
+ * \param etag: NULL, or the etag value for this response
+ * \param p: pointer to current position in buffer pointer
+ * \param end: pointer to end of buffer
+ *
+ * Adds the same thing lws_add_http_header_status() and then adding the other
+ * headers in the block one by one would, in the form the connection needs,
+ * followed by the content-length, etag and date if any.
+ *
+ * Like lws_add_http_common_headers(), it does not finalize the headers, so
+ * more can be added after it.
+ */
+LWS_VISIBLE LWS_EXTERN int LWS_WARN_UNUSED_RESULT
+lws_add_http_header_block(struct lws *wsi, const lws_http_hdr_block_t *b,
+			  lws_filepos_t content_len, const char *etag,
+			  unsigned char **p, unsigned char *end);
+
 enum {
 	LWSHUMETH_GET,
 	LWSHUMETH_POST,
@@ -1072,5 +1171,31 @@ lws_h2_update_peer_txcredit(struct lws *wsi, unsigned int sid, int bump);
 LWS_VISIBLE LWS_EXTERN int
 lws_h2_get_peer_txcredit_estimate(struct lws *wsi);
 
+typedef struct lws_h2_hpack_enc_stats {
+	uint64_t	in;	 /**< header bytes as built by lws_add_http_* */
+	uint64_t	out;	 /**< header bytes after HPACK encoding */
+	uint32_t	blocks;	 /**< header blocks sent */
+	uint32_t	inserts; /**< entries added to the dynamic table */
+	uint32_t	evictions; /**< entries evicted from the dynamic table */
+	uint32_t	table_size; /**< RFC7541 size of the dynamic table now */
+	uint32_t	table_max; /**< dynamic table size in force now */
+} lws_h2_hpack_enc_stats_t;
+
+/**
+ * lws_h2_hpack_enc_stats() - get HPACK encoder stats for an h2 connection
+ *
+ * \param wsi: the h2 network connection, or any stream on it
+ * \param stats: struct to fill with the stats
+ *
+ * lws_add_http_header_*() build h2 header blocks as plain literals, lws
+ * encodes them against the static and dynamic tables with Huffman coding as
+ * they are sent.  This reports totals for every header block sent on the
+ * connection so far, and the state of the dynamic table.
+ *
+ * Returns 0 if \p stats was filled, or nonzero if \p wsi is not h2.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_h2_hpack_enc_stats(struct lws *wsi, lws_h2_hpack_enc_stats_t *stats);
+
 ///@}
 
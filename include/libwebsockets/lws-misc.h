@@ -158,6 +158,49 @@ LWS_VISIBLE LWS_EXTERN int
 lws_buflist_fragment_use(struct lws_buflist **head, uint8_t *buf,
 			 size_t len, char *frag_first, char *frag_fin);
 
+typedef struct lws_buflist_frag {
+	const uint8_t		*buf;
+	size_t			len;
+} lws_buflist_frag_t;
+
+/**
+ * lws_buflist_peek_segments(): describe the first few segments without using
+ *
+ * \param head: list head
+ * \param frags: array of lws_buflist_frag_t to fill
+ * \param max_frags: number of entries available in \p frags
+ *
+ * Fills \p frags with pointers to, and the unused length of, up to
+ * \p max_frags segments starting from the head of the buflist, eg, so they
+ * can be given to writev() in one go.  Nothing is consumed, after sending
+ * you should call lws_buflist_use() with the number of bytes that were
+ * actually sent.
+ *
+ * The pointers are only valid until the buflist is next modified.
+ *
+ * Returns the number of entries filled in \p frags, 0 means the buflist is
+ * empty.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_buflist_peek_segments(struct lws_buflist **head, lws_buflist_frag_t *frags,
+			  int max_frags);
+
+/**
+ * lws_buflist_use(): consume len bytes from the buflist head
+ *
+ * \param head: list head
+ * \param len: number of bytes to consume
+ *
+ * Like lws_buflist_use_segment(), but \p len may span several segments, eg,
+ * after a vectored send described by lws_buflist_peek_segments().  \p len
+ * must not be more than lws_buflist_total_len() minus what was already used.
+ *
+ * Returns the number of bytes left in the new head segment, or 0 if the
+ * buflist is now empty.
+ */
+LWS_VISIBLE LWS_EXTERN size_t
+lws_buflist_use(struct lws_buflist **head, size_t len);
+
 /**
  * lws_buflist_destroy_all_segments(): free all segments on the list
  *
@@ -512,6 +555,23 @@ lws_hex_random(struct lws_context *context, char *dest, size_t len);
 LWS_VISIBLE LWS_EXTERN int
 lws_timingsafe_bcmp(const void *a, const void *b, uint32_t len);
 
+#define LWS_FNV1A32_INIT 0x811c9dc5u
+
+/*
+ * lws_fnv1a32(): 32-bit FNV-1a hash
+ *
+ * \param h: LWS_FNV1A32_INIT, or the result of hashing what went before
+ * \param buf: the bytes to hash
+ * \param len: count of bytes to hash
+ *
+ * Returns the hash updated with len bytes from buf.  Fast and good enough for
+ * hash table buckets, it's not suitable for anything needing resistance to
+ * deliberate collisions.
+ */
+
+LWS_VISIBLE LWS_EXTERN uint32_t
+lws_fnv1a32(uint32_t h, const void *buf, size_t len);
+
 /**
  * lws_get_random(): fill a buffer with platform random data
  *
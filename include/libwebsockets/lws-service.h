@@ -90,6 +90,84 @@ lws_cancel_service_pt(struct lws *wsi);
 LWS_VISIBLE LWS_EXTERN void
 lws_cancel_service(struct lws_context *context);
 
+typedef struct lws_pt_wake_stats {
+	uint32_t	requested; /**< wakes asked for, eg, lws_cancel_service() */
+	uint32_t	signalled; /**< ... that needed a syscall to signal */
+	uint32_t	delivered; /**< times the service thread was woken */
+} lws_pt_wake_stats_t;
+
+/**
+ * lws_pt_wake_stats() - get counts of cross-thread wakes for a service thread
+ *
+ * \param context:	Websocket context
+ * \param tsi:		Thread service index
+ * \param stats:	filled with the counts since the context was created
+ *
+ * Service threads are woken from other threads via an eventfd or pipe.  Any
+ * wakes requested after the first one but before the service thread gets
+ * around to handling it are folded into it without another syscall, so
+ * requested can be much larger than signalled and delivered.
+ *
+ * requested and signalled are only counted on unix-type platforms.  The
+ * counts are free-running and wrap.
+ *
+ * Returns 0 if OK or nonzero if tsi is out of range.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_pt_wake_stats(struct lws_context *context, int tsi,
+		  lws_pt_wake_stats_t *stats);
+
+struct lws_pt_msg;
+
+typedef void (*lws_pt_msg_cb_t)(struct lws_context *cx, int tsi,
+				struct lws_pt_msg *msg);
+
+/**
+ * struct lws_pt_msg - message posted to a service thread's inbox
+ *
+ * Embed this in your own struct along with whatever the message needs to
+ * carry, eg, a buffer and the pss it is for, and recover your struct in the
+ * callback with lws_container_of().  lws doesn't copy or free it, it belongs
+ * to the poster until the callback is called, and to the callback after.
+ */
+typedef struct lws_pt_msg {
+	struct lws_pt_msg	*next;	/**< private to lws */
+	lws_pt_msg_cb_t		cb;	/**< called on the service thread */
+	void			*opaque; /**< user pointer, not used by lws */
+} lws_pt_msg_t;
+
+/**
+ * lws_pt_msg_post() - pass a message to a service thread from any thread
+ *
+ * \param context:	Websocket context
+ * \param tsi:		Thread service index to deliver the message to
+ * \param msg:		Message with its .cb set
+ *
+ * Each service thread has a lock-free inbox any thread may post to, including
+ * threads lws doesn't know about and other service threads.  Posting costs
+ * one atomic op, and the target service thread is woken by lws_cancel_service()
+ * style signalling only if its inbox was empty.
+ *
+ * The service thread calls msg->cb(context, tsi, msg) for each message, in the
+ * order they were posted, before it issues LWS_CALLBACK_EVENT_WAIT_CANCELLED.
+ * From the callback you may do anything you could do from a protocol callback
+ * on that thread, eg, lws_callback_on_writable() or lws_sul_schedule() for
+ * a wsi or sul belonging to that thread.  It's up to you to make sure any wsi
+ * you refer to in the message is still alive when it arrives.
+ *
+ * If the context is destroyed with messages still queued, the callbacks are
+ * still made during the destroy so the messages can be freed,
+ * lws_context_is_being_destroyed() is true then.  Posts may race the destroy
+ * from other threads until lws_context_destroy() returns, each is either
+ * delivered like that or refused.
+ *
+ * Returns 0 if posted, or nonzero if the service thread's inbox was already
+ * closed by the context destroy or tsi is invalid, and the message still
+ * belongs to the caller.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_pt_msg_post(struct lws_context *context, int tsi, lws_pt_msg_t *msg);
+
 /**
  * lws_service_fd() - Service polled socket with something waiting
  * \param context:	Websocket context
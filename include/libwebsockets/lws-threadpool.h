@@ -72,15 +72,20 @@ struct lws_threadpool_create_args {
 
 struct lws_threadpool_task_args {
 #if defined(LWS_WITH_SECURE_STREAMS)
-	struct lws_ss_handle *ss; /**< either wsi or ss must be set */
+	struct lws_ss_handle *ss; /**< either wsi or ss must be set, unless
+				       async_task */
 #endif
-	struct lws *wsi;	/**< either wsi or ss must be set */
+	struct lws *wsi;	/**< either wsi or ss must be set, unless
+				     async_task */
 
 	void *user;		/**< user may set (user-private pointer) */
 	const char *name;	/**< user may set to describe task */
 	char async_task;	/**< set to allow the task to shrug off the loss
 				     of the associated wsi and continue to
-				     completion */
+				     completion.  An async task may also be
+				     queued with no wsi or ss, it's reaped by
+				     the pool when it ends, calling cleanup
+				     with a NULL wsi */
 	enum lws_threadpool_task_return (*task)(void *user,
 					enum lws_threadpool_task_status s);
 	/**< user must set to actual task function */
@@ -213,6 +213,40 @@ lws_write(struct lws *wsi, unsigned char *buf, size_t len,
 #define lws_write_http(wsi, buf, len) \
 	lws_write(wsi, (unsigned char *)(buf), len, LWS_WRITE_HTTP)
 
+/** struct lws_iov - one fragment of the payload given to lws_write_iov() */
+typedef struct lws_iov {
+	const void	*buf;	/**< start of the fragment */
+	size_t		len;	/**< length of the fragment */
+} lws_iov_t;
+
+/**
+ * lws_write_iov() - Like lws_write() but the payload is in fragments
+ *
+ * \param wsi:	Websocket instance (available from user callback)
+ * \param iov:	array of fragments making up the payload, in order
+ * \param count: number of fragments in iov
+ * \param protocol: as for lws_write()
+ *
+ * The payload is the concatenation of the fragments, and it's written as if
+ * you had copied it into one buffer and given that to lws_write() with the
+ * same protocol, eg, a single ws frame for LWS_WRITE_TEXT.  The fragments
+ * don't need LWS_PRE in front of them and are not modified, so they may be
+ * const.
+ *
+ * On plain tcp connections, for raw sockets and for server ws frames that no
+ * extension wants to see, the frame header and the fragments are passed to
+ * the kernel together in one sendmsg() without copying them.  In the other
+ * cases, eg, tls, client ws masking, ws extensions or h2, lws copies the
+ * fragments into one buffer and uses lws_write(), so with tls everything
+ * still goes out in one record.
+ *
+ * The return is as for lws_write(), the total payload length if it was all
+ * sent or buffered by lws, or -1 if the connection failed.
+ */
+LWS_VISIBLE LWS_EXTERN int
+lws_write_iov(struct lws *wsi, const lws_iov_t *iov, int count,
+	      enum lws_write_protocol protocol);
+
 /**
  * lws_write_ws_flags() - Helper for multi-frame ws message flags
  *
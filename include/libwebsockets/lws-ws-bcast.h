@@ -0,0 +1,124 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/** \defgroup wsbcast Websocket broadcast messages
+ * ##Websocket encode-once broadcast messages
+ *
+ * When the same message goes to many ws connections, the usual pattern of
+ * putting it in an lws_ring and having each connection lws_write() it from
+ * its WRITEABLE callback rebuilds the frame header, and with
+ * permessage-deflate recompresses the payload, once per connection.
+ *
+ * An lws_ws_bcast holds the message already framed for server -> client
+ * use, and optionally also already compressed in a form any
+ * permessage-deflate peer whose tx compression context is fresh can accept.
+ * lws_ws_bcast_write() then sends the shared bytes directly to each
+ * connection; only a partial send causes the unsent remainder to be copied,
+ * exactly as it would be with lws_write().
+ *
+ * Connections that can't use the shared bytes (client role, which must
+ * mask, or ws carried inside h2) transparently get an ordinary lws_write()
+ * of a private copy instead.
+ *
+ * The object is refcounted: typically it's created once when the message
+ * arrives, the lws_ring element holds the creation reference, and the ring
+ * element destroy callback calls lws_ws_bcast_unref().
+ *
+ * The refcount is not atomic, the object must be protected by the same lock
+ * as the ring it lives in, if any.
+ */
+///@{
+
+struct lws_ws_bcast;
+
+/* lws_ws_bcast_create() flags */
+#define LWSWSBC_F_DEFLATE		(1 << 0)
+/**< also prepare a permessage-deflate version, used for peers who can
+ * take it if it is smaller than the plain version */
+
+/**
+ * lws_ws_bcast_create() - create a refcounted, pre-framed broadcast message
+ *
+ * \param payload: the message payload, copied into the object
+ * \param len: the payload length
+ * \param wp: LWS_WRITE_TEXT or LWS_WRITE_BINARY
+ * \param flags: 0 or LWSWSBC_F_ flags
+ *
+ * Returns the new object with a refcount of 1, or NULL on OOM or if wp
+ * isn't TEXT or BINARY.  The whole message is sent as one frame with FIN.
+ */
+LWS_VISIBLE LWS_EXTERN struct lws_ws_bcast *
+lws_ws_bcast_create(const void *payload, size_t len,
+		    enum lws_write_protocol wp, int flags);
+
+/**
+ * lws_ws_bcast_ref() - take an additional reference on a broadcast message
+ *
+ * \param b: the broadcast message
+ *
+ * Returns b, for convenience.
+ */
+LWS_VISIBLE LWS_EXTERN struct lws_ws_bcast *
+lws_ws_bcast_ref(struct lws_ws_bcast *b);
+
+/**
+ * lws_ws_bcast_unref() - drop a reference on a broadcast message
+ *
+ * \param b: the broadcast message, or NULL
+ *
+ * The object is freed when the last reference goes.  It's safe to unref
+ * as soon as lws_ws_bcast_write() returns, lws has either sent the bytes
+ * or buffered the unsent part by then.
+ */
+LWS_VISIBLE LWS_EXTERN void
+lws_ws_bcast_unref(struct lws_ws_bcast *b);
+
+/**
+ * lws_ws_bcast_payload() - get the original payload of a broadcast message
+ *
+ * \param b: the broadcast message
+ * \param len: set to the payload length
+ *
+ * Returns a pointer to the unframed payload, which must not be modified.
+ */
+LWS_VISIBLE LWS_EXTERN const uint8_t *
+lws_ws_bcast_payload(const struct lws_ws_bcast *b, size_t *len);
+
+/**
+ * lws_ws_bcast_write() - send a broadcast message on one ws connection
+ *
+ * \param wsi: the ws connection, from its WRITEABLE callback
+ * \param b: the broadcast message
+ *
+ * Use it in place of lws_write() for one whole message, with the same
+ * rules: only call it from the connection's WRITEABLE callback, and check
+ * lws_send_pipe_choked() before sending anything else in the same callback.
+ *
+ * Returns 0 if the message was sent or buffered, or -1 if the connection
+ * should be closed.
+ */
+LWS_VISIBLE LWS_EXTERN int LWS_WARN_UNUSED_RESULT
+lws_ws_bcast_write(struct lws *wsi, struct lws_ws_bcast *b);
+
+///@}
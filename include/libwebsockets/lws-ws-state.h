@@ -106,4 +106,22 @@ lws_partial_buffered(struct lws *wsi);
  */
 LWS_VISIBLE LWS_EXTERN int LWS_WARN_UNUSED_RESULT
 lws_frame_is_binary(struct lws *wsi);
+
+/**
+ * lws_ws_mask_xor(): apply a ws masking key to a buffer in place
+ *
+ * \param buf: the payload to mask or unmask
+ * \param len: the number of bytes in buf
+ * \param mask: the 4-byte masking key
+ * \param mask_idx: NULL, or in: key index that applies to buf[0], out:
+ *		    key index for the byte following buf[len - 1]
+ *
+ * Masking and unmasking are the same operation.  lws uses this itself
+ * on rx payload from clients and tx payload to servers, it's exported so
+ * code that handles ws framing itself can use the same fast path.  Uses
+ * AVX2, SSE2 or NEON if the build targets them, else 64-bit words.
+ */
+LWS_VISIBLE LWS_EXTERN void
+lws_ws_mask_xor(uint8_t *buf, size_t len, const uint8_t *mask,
+		uint8_t *mask_idx);
 ///@}
@@ -119,7 +119,7 @@ lws_create_new_server_wsi(struct lws_vhost *vhost, int fixed_tsi, int group,
 static struct lws *
 __lws_adopt_descriptor_vhost1(struct lws_vhost *vh, lws_adoption_type type,
 			    const char *vh_prot_name, struct lws *parent,
-			    void *opaque, const char *fi_wsi_name)
+			    void *opaque, const char *fi_wsi_name, int fixed_tsi)
 {
 	struct lws_context *context;
 	struct lws_context_per_thread *pt;
@@ -139,7 +139,7 @@ __lws_adopt_descriptor_vhost1(struct lws_vhost *vh, lws_adoption_type type,
 
 	lws_context_assert_lock_held(vh->context);
 
-	n = -1;
+	n = fixed_tsi;
 	if (parent)
 		n = parent->tsi;
 	new_wsi = lws_create_new_server_wsi(vh, n, LWSLCG_WSI_SERVER, fi_wsi_name);
@@ -226,14 +226,14 @@ bail:
 	if (parent)
 		parent->child_list = new_wsi->sibling_list;
 	if (new_wsi->user_space)
-		lws_free(new_wsi->user_space);
+		lws_pt_pss_free(new_wsi);
 
 	lws_fi_destroy(&new_wsi->fic);
 
 	lws_pt_unlock(pt);
 	__lws_vhost_unbind_wsi(new_wsi); /* req cx, acq vh lock */
 
-	lws_free(new_wsi);
+	lws_pt_wsi_free(pt, new_wsi);
 
 	return NULL;
 }
@@ -516,8 +516,11 @@ lws_adopt_descriptor_vhost(struct lws_vhost *vh, lws_adoption_type type,
 	return lws_adopt_descriptor_vhost_via_info(&info);
 }
 
-struct lws *
-lws_adopt_descriptor_vhost_via_info(const lws_adopt_desc_t *info)
+static struct lws *
+__lws_adopt_descriptor_vhost_via_info(const lws_adopt_desc_t *info,
+				      int fixed_tsi,
+				      const struct sockaddr_storage *peer_sa,
+				      socklen_t peer_len)
 {
 	socklen_t slen = sizeof(lws_sockaddr46);
 	struct lws *new_wsi;
@@ -547,17 +550,23 @@ lws_adopt_descriptor_vhost_via_info(const lws_adopt_desc_t *info)
 
 	new_wsi = __lws_adopt_descriptor_vhost1(info->vh, info->type,
 					      info->vh_prot_name, info->parent,
-					      info->opaque, info->fi_wsi_name);
+					      info->opaque, info->fi_wsi_name,
+					      fixed_tsi);
 	if (!new_wsi) {
 		if (info->type & LWS_ADOPT_SOCKET)
 			compatible_close(info->fd.sockfd);
 		goto bail;
 	}
 
-	if (info->type & LWS_ADOPT_SOCKET &&
-	    getpeername(info->fd.sockfd, (struct sockaddr *)&new_wsi->sa46_peer,
-								    &slen) < 0)
-		lwsl_info("%s: getpeername failed\n", __func__);
+	if (peer_sa)
+		memcpy(&new_wsi->sa46_peer, peer_sa,
+		       peer_len < slen ? peer_len : slen);
+	else
+		if (info->type & LWS_ADOPT_SOCKET &&
+		    getpeername(info->fd.sockfd,
+				(struct sockaddr *)&new_wsi->sa46_peer,
+				&slen) < 0)
+			lwsl_info("%s: getpeername failed\n", __func__);
 
 #if defined(LWS_WITH_PEER_LIMITS)
 	if (peer)
@@ -572,6 +581,39 @@ bail:
 	return new_wsi;
 }
 
+struct lws *
+lws_adopt_descriptor_vhost_via_info(const lws_adopt_desc_t *info)
+{
+	return __lws_adopt_descriptor_vhost_via_info(info, -1, NULL, 0);
+}
+
+/*
+ * As lws_adopt_descriptor_vhost(), but the new wsi is created on pt tsi, or
+ * the least busy one if tsi is -1.  The caller must know tsi has room for it.
+ * If the caller got the peer address from accept() already, it can pass it
+ * in peer_sa and we don't have to ask for it again.
+ */
+
+struct lws *
+lws_adopt_descriptor_vhost_tsi(struct lws_vhost *vh, lws_adoption_type type,
+			       lws_sock_file_fd_type fd,
+			       const char *vh_prot_name, int tsi,
+			       const struct sockaddr_storage *peer_sa,
+			       socklen_t peer_len)
+{
+	lws_adopt_desc_t info;
+
+	memset(&info, 0, sizeof(info));
+
+	info.vh = vh;
+	info.type = type;
+	info.fd = fd;
+	info.vh_prot_name = vh_prot_name;
+
+	return __lws_adopt_descriptor_vhost_via_info(&info, tsi, peer_sa,
+						     peer_len);
+}
+
 struct lws *
 lws_adopt_socket_vhost(struct lws_vhost *vh, lws_sockfd_type accept_fd)
 {
@@ -839,7 +881,7 @@ lws_create_adopt_udp(struct lws_vhost *vhost, const char *ads, int port,
 	wsi = __lws_adopt_descriptor_vhost1(vhost, LWS_ADOPT_SOCKET |
 						 LWS_ADOPT_RAW_SOCKET_UDP,
 					  protocol_name, parent_wsi, opaque,
-					  fi_wsi_name);
+					  fi_wsi_name, -1);
 
 	lws_context_unlock(vhost->context);
 	if (!wsi) {
@@ -852,6 +894,7 @@ lws_create_adopt_udp(struct lws_vhost *vhost, const char *ads, int port,
 	wsi->do_bind = !!(flags & LWS_CAUDP_BIND);
 	wsi->do_broadcast = !!(flags & LWS_CAUDP_BROADCAST);
 	wsi->pf_packet = !!(flags & LWS_CAUDP_PF_PACKET);
+	wsi->udp_batch_rx = !!(flags & LWS_CAUDP_BATCH_RX);
 	wsi->c_port = (uint16_t)(unsigned int)port;
 	if (retry_policy)
 		wsi->retry_policy = retry_policy;
@@ -100,7 +100,7 @@ __lws_reset_wsi(struct lws *wsi)
 		/* confirm no sul left scheduled in user data itself */
 		lws_sul_debug_zombies(wsi->a.context, wsi->user_space,
 				wsi->a.protocol->per_session_data_size, __func__);
-		lws_free_set_NULL(wsi->user_space);
+		lws_pt_pss_free(wsi);
 	}
 
 	/*
@@ -118,6 +118,7 @@ __lws_reset_wsi(struct lws *wsi)
 				      sizeof(*wsi->udp), "close udp wsi");
 		lws_free_set_NULL(wsi->udp);
 	}
+	lws_free_set_NULL(wsi->udp_rx_batch);
 #endif
 	wsi->retry = 0;
 	wsi->mount_hit = 0;
@@ -278,7 +279,7 @@ __lws_free_wsi(struct lws *wsi)
 	wsi->socket_is_permanently_unusable = 1; // !!!
 
 	__lws_lc_untag(wsi->a.context, &wsi->lc);
-	lws_free(wsi);
+	lws_pt_wsi_free(&wsi->a.context->pt[(int)wsi->tsi], wsi);
 }
 
 
@@ -383,6 +384,11 @@ __lws_close_free_wsi(struct lws *wsi, enum lws_close_status reason,
 	pt = &context->pt[(int)wsi->tsi];
 
 	if (pt->pipe_wsi == wsi) {
+		/*
+		 * Nothing may post to us and signal the pipe any more, hand
+		 * back what's in the inbox
+		 */
+		lws_pt_msg_drain(pt, 1);
 		lws_plat_pipe_close(pt->pipe_wsi);
 		pt->pipe_wsi = NULL;
 	}
@@ -615,6 +621,7 @@ just_kill_connection:
 
 		lws_free_set_NULL(wsi->udp);
 	}
+	lws_free_set_NULL(wsi->udp_rx_batch);
 #endif
 
 	if (lws_rops_fidx(wsi->role_ops, LWS_ROPS_close_kill_connection))
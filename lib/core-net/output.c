@@ -24,6 +24,204 @@
 
 #include "private-lib-core.h"
 
+/* how much we offer the socket at one time */
+
+static size_t
+lws_issue_raw_limit(struct lws *wsi)
+{
+	size_t n;
+
+	if (wsi->a.protocol->tx_packet_size)
+		n = wsi->a.protocol->tx_packet_size;
+	else {
+		n = wsi->a.protocol->rx_buffer_size;
+		if (!n)
+			n = wsi->a.context->pt_serv_buf_size;
+	}
+
+	return n + LWS_PRE + 4;
+}
+
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+#include <sys/uio.h>
+
+/*
+ * On a plain tcp socket, where lws_ssl_capable_write() would just do a send(),
+ * we can give the kernel several buffers in one go with sendmsg()... that's
+ * used to drain multiple buflist_out segments, and by lws_write_iov().
+ */
+
+static int
+lws_issue_raw_plain_skt(struct lws *wsi)
+{
+	return
+#if defined(LWS_WITH_TLS)
+	       !wsi->tls.ssl &&
+#endif
+#if defined(LWS_WITH_UDP)
+	       !lws_wsi_is_udp(wsi) &&
+#endif
+	       !wsi->mux_substream && !wsi->role_ops->file_handle;
+}
+
+static int
+lws_issue_raw_can_vector(struct lws *wsi)
+{
+	return wsi->buflist_out && wsi->buflist_out->next &&
+	       lws_issue_raw_plain_skt(wsi);
+}
+
+static int
+lws_issue_raw_sendmsg(struct lws *wsi, struct iovec *iov, unsigned int n)
+{
+	struct msghdr mh;
+	ssize_t m;
+
+	memset(&mh, 0, sizeof(mh));
+	mh.msg_iov = iov;
+	mh.msg_iovlen = n;
+
+	m = sendmsg(wsi->desc.sockfd, &mh, MSG_NOSIGNAL);
+	if (m >= 0)
+		return (int)m;
+
+	if (LWS_ERRNO == LWS_EAGAIN ||
+	    LWS_ERRNO == LWS_EWOULDBLOCK ||
+	    LWS_ERRNO == LWS_EINTR) {
+		if (LWS_ERRNO == LWS_EWOULDBLOCK) {
+			lws_set_blocking_send(wsi);
+		}
+
+		return LWS_SSL_CAPABLE_MORE_SERVICE;
+	}
+
+	lwsl_wsi_debug(wsi, "ERROR writing %u segs to skt fd %d errno %d",
+			    n, wsi->desc.sockfd, LWS_ERRNO);
+
+	return LWS_SSL_CAPABLE_ERROR;
+}
+
+static int
+lws_issue_raw_vectored(struct lws *wsi, size_t limit, size_t *offered)
+{
+	lws_buflist_frag_t frags[LWS_ISSUE_RAW_MAX_IOV];
+	struct iovec iov[LWS_ISSUE_RAW_MAX_IOV];
+	unsigned int n, c;
+
+	c = (unsigned int)lws_buflist_peek_segments(&wsi->buflist_out, frags,
+						     LWS_ISSUE_RAW_MAX_IOV);
+	*offered = 0;
+	for (n = 0; n < c && *offered < limit; n++) {
+		iov[n].iov_base = (void *)frags[n].buf;
+		iov[n].iov_len = frags[n].len;
+		if (iov[n].iov_len > limit - *offered)
+			iov[n].iov_len = limit - *offered;
+		*offered += iov[n].iov_len;
+	}
+
+	return lws_issue_raw_sendmsg(wsi, iov, n);
+}
+
+/*
+ * The fragments are already framed, send what the socket will take of them
+ * and buffer the rest on buflist_out.  Returns the total length, or -1.
+ */
+
+int
+lws_issue_raw_iov(struct lws *wsi, const lws_iov_t *iov, int count)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	struct iovec v[LWS_ISSUE_RAW_MAX_IOV];
+	size_t total = 0, limit, offered = 0, sent;
+	unsigned int c = 0;
+	int n, m;
+
+	if (count > LWS_ISSUE_RAW_MAX_IOV)
+		return -1;
+
+	for (n = 0; n < count; n++)
+		total += iov[n].len;
+
+	/* just ignore sends after we cleared the truncation buffer */
+	if (lwsi_state(wsi) == LRS_FLUSHING_BEFORE_CLOSE &&
+	    !lws_has_buffered_out(wsi))
+		return (int)total;
+
+	if (lws_has_buffered_out(wsi)) {
+		/* it has to go behind what's already waiting */
+		for (n = 0; n < count; n++)
+			if (iov[n].len &&
+			    __lws_buflist_append(&wsi->buflist_out, iov[n].buf,
+						 iov[n].len, &pt->buflist_pool,
+						 LWSBLAF_COALESCE) < 0)
+				return -1;
+
+		if (lws_issue_raw(wsi, NULL, 0) < 0)
+			return -1;
+
+		return (int)total;
+	}
+
+	limit = lws_issue_raw_limit(wsi);
+	for (n = 0; n < count && offered < limit; n++) {
+		if (!iov[n].len)
+			continue;
+		v[c].iov_base = (void *)iov[n].buf;
+		v[c].iov_len = iov[n].len;
+		if (v[c].iov_len > limit - offered)
+			v[c].iov_len = limit - offered;
+		offered += v[c++].iov_len;
+	}
+
+	if (!c)
+		return 0;
+
+	if (lws_fi(&wsi->fic, "sendfail"))
+		m = LWS_SSL_CAPABLE_ERROR;
+	else
+		m = lws_issue_raw_sendmsg(wsi, v, c);
+
+	lwsl_wsi_info(wsi, "sendmsg of %u frags (%d) says %d", c,
+			   (int)offered, m);
+
+	/* something got written, it can have been truncated now */
+	wsi->could_have_pending = 1;
+
+	switch (m) {
+	case LWS_SSL_CAPABLE_ERROR:
+		/* we're going to close, let close know sends aren't possible */
+		wsi->socket_is_permanently_unusable = 1;
+		return -1;
+	case LWS_SSL_CAPABLE_MORE_SERVICE:
+		m = 0;
+		break;
+	}
+
+	if ((size_t)m == total)
+		return (int)total;
+
+	/* buffer the unsent remainder, it gets priority next writeable */
+
+	sent = (size_t)m;
+	for (n = 0; n < count; n++) {
+		if (sent >= iov[n].len) {
+			sent -= iov[n].len;
+			continue;
+		}
+		if (__lws_buflist_append(&wsi->buflist_out,
+					 (const uint8_t *)iov[n].buf + sent,
+					 iov[n].len - sent, &pt->buflist_pool,
+					 LWSBLAF_COALESCE) < 0)
+			return -1;
+		sent = 0;
+	}
+
+	lws_callback_on_writable(wsi);
+
+	return (int)total;
+}
+#endif
+
 /*
  * notice this returns number of bytes consumed, or -1
  */
@@ -31,8 +229,16 @@ int
 lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len)
 {
 	struct lws_context *context = lws_get_context(wsi);
+	struct lws_context_per_thread *pt = &context->pt[(int)wsi->tsi];
 	size_t real_len = len;
 	unsigned int n, m;
+	int bf = LWSBLAF_COALESCE;
+
+#if defined(LWS_WITH_UDP)
+	/* each buflist_out segment is a datagram */
+	if (lws_wsi_is_udp(wsi))
+		bf = 0;
+#endif
 
 	/*
 	 * If you're looking to dump data being sent down the tls tunnel, see
@@ -63,7 +269,8 @@ lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len)
 		 * the buflist...
 		 */
 
-		if (lws_buflist_append_segment(&wsi->buflist_out, buf, len))
+		if (__lws_buflist_append(&wsi->buflist_out, buf, len,
+					 &pt->buflist_pool, bf) < 0)
 			return -1;
 
 		buf = NULL;
@@ -86,23 +293,23 @@ lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len)
 		lwsl_wsi_err(wsi, "invalid sock");
 
 	/* limit sending */
-	if (wsi->a.protocol->tx_packet_size)
-		n = (unsigned int)wsi->a.protocol->tx_packet_size;
-	else {
-		n = (unsigned int)wsi->a.protocol->rx_buffer_size;
-		if (!n)
-			n = context->pt_serv_buf_size;
-	}
-	n += LWS_PRE + 4;
-	if (n > len)
-		n = (unsigned int)len;
+	n = (unsigned int)lws_issue_raw_limit(wsi);
 
 	/* nope, send it on the socket directly */
 
 	if (lws_fi(&wsi->fic, "sendfail"))
 		m = (unsigned int)LWS_SSL_CAPABLE_ERROR;
 	else
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+	if (lws_issue_raw_can_vector(wsi))
+		m = (unsigned int)lws_issue_raw_vectored(wsi, n, &real_len);
+	else
+#endif
+	{
+		if (n > len)
+			n = (unsigned int)len;
 		m = (unsigned int)lws_ssl_capable_write(wsi, buf, n);
+	}
 
 	lwsl_wsi_info(wsi, "ssl_capable_write (%d) says %d", n, m);
 
@@ -136,7 +343,7 @@ lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len)
 		if (m) {
 			lwsl_wsi_info(wsi, "partial adv %d (vs %ld)",
 					   m, (long)real_len);
-			lws_buflist_use_segment(&wsi->buflist_out, m);
+			lws_buflist_use(&wsi->buflist_out, m);
 		}
 
 		if (!lws_has_buffered_out(wsi)) {
@@ -194,8 +401,8 @@ lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len)
 	lwsl_wsi_debug(wsi, "new partial sent %d from %lu total",
 			    m, (unsigned long)real_len);
 
-	if (lws_buflist_append_segment(&wsi->buflist_out, buf + m,
-				       real_len - m) < 0)
+	if (__lws_buflist_append(&wsi->buflist_out, buf + m, real_len - m,
+				 &pt->buflist_pool, bf) < 0)
 		return -1;
 
 #if defined(LWS_WITH_UDP)
@@ -243,6 +450,101 @@ lws_write(struct lws *wsi, unsigned char *buf, size_t len,
 	return m;
 }
 
+/*
+ * Copy the fragments into one buffer with LWS_PRE in front and lws_write() it.
+ * permessage-deflate may keep pointing into its input until it drained it on
+ * later writeable callbacks, so in that case the buffer is kept on the wsi
+ * until the drain finishes, instead of being freed on return.
+ */
+
+static int
+lws_write_iov_linear(struct lws *wsi, const lws_iov_t *iov, int count,
+		     size_t len, enum lws_write_protocol wp)
+{
+	uint8_t *p, *tmp = NULL;
+	size_t o = 0;
+	int n;
+
+#if defined(LWS_ROLE_WS) && !defined(LWS_WITHOUT_EXTENSIONS)
+	if (lwsi_role_ws(wsi) && wsi->ws && wsi->ws->count_act_ext) {
+		if (wsi->ws->tx_lin) {
+			/* lws doesn't let us write while the last one drains */
+			lwsl_wsi_err(wsi, "previous message still draining");
+			return -1;
+		}
+		p = wsi->ws->tx_lin = lws_malloc(LWS_PRE + len + 1, __func__);
+	} else
+#endif
+		tmp = p = lws_malloc(LWS_PRE + len + 1, __func__);
+	if (!p)
+		return -1;
+
+	for (n = 0; n < count; n++) {
+		if (iov[n].len)
+			memcpy(p + LWS_PRE + o, iov[n].buf, iov[n].len);
+		o += iov[n].len;
+	}
+
+	n = lws_write(wsi, p + LWS_PRE, len, wp);
+	if (tmp)
+		lws_free(tmp);
+#if defined(LWS_ROLE_WS) && !defined(LWS_WITHOUT_EXTENSIONS)
+	else
+		lws_ws_tx_lin_release(wsi);
+#endif
+
+	return n;
+}
+
+int
+lws_write_iov(struct lws *wsi, const lws_iov_t *iov, int count,
+	      enum lws_write_protocol wp)
+{
+	size_t len = 0;
+	int n;
+
+	if (count < 0)
+		return -1;
+
+	for (n = 0; n < count; n++)
+		len += iov[n].len;
+
+	if ((int)len < 0) {
+		lwsl_wsi_err(wsi, "suspicious len int %d, ulong %lu",
+				  (int)len, (unsigned long)len);
+		return -1;
+	}
+
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+	if (count < LWS_ISSUE_RAW_MAX_IOV && lws_issue_raw_plain_skt(wsi)) {
+		int m;
+
+		if (!lws_rops_fidx(wsi->role_ops, LWS_ROPS_write_role_protocol))
+			m = lws_issue_raw_iov(wsi, iov, count);
+		else
+#if defined(LWS_ROLE_WS)
+		if (lwsi_role_ws(wsi) && lws_ws_can_write_iov(wsi, wp))
+			m = lws_ws_write_iov(wsi, iov, count, len, wp);
+		else
+#endif
+			return lws_write_iov_linear(wsi, iov, count, len, wp);
+
+#ifdef LWS_WITH_ACCESS_LOG
+		wsi->http.access_log.sent += len;
+#endif
+#if defined(LWS_WITH_SYS_METRICS)
+		if (wsi->a.vhost)
+			lws_metric_event(wsi->a.vhost->mt_traffic_tx, (char)
+					 (m < 0 ? METRES_NOGO : METRES_GO), len);
+#endif
+
+		return m;
+	}
+#endif
+
+	return lws_write_iov_linear(wsi, iov, count, len, wp);
+}
+
 int
 lws_ssl_capable_read_no_ssl(struct lws *wsi, unsigned char *buf, size_t len)
 {
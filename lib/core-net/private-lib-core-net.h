@@ -52,9 +52,37 @@ struct lws_muxable {
 extern "C" {
 #endif
 
-#define __lws_sul_insert_us(owner, sul, _us) \
+#define __lws_sul_insert_us(_pt, _n, sul, _us) \
 		(sul)->us = lws_now_usecs() + (lws_usec_t)(_us); \
-		__lws_sul_insert(owner, sul)
+		__lws_sul_insert_pt(_pt, _n, sul)
+
+#if defined(LWS_WITH_SUL_WHEEL)
+/*
+ * Sul due inside the current "near" window of the wheel are kept sorted on
+ * pt->pt_sul_owner[] as usual.  Later ones wait unsorted in a hierarchical
+ * timer wheel slot until their slot's time comes, then they are cascaded to a
+ * lower level or into the near list.  Time in the wheel is in ticks of
+ * 1 << LWS_SUL_WHEEL_TICK_BITS us.
+ *
+ * With 6 bits per level, the near window is 64 ticks (65ms), a level 0 slot
+ * is 65ms (the level covers 4.2s), level 1 slots are 4.2s (covering 268s) and
+ * level 2 slots are 268s (covering 4.7h).  Anything later is on overflow.
+ */
+
+#define LWS_SUL_WHEEL_TICK_BITS		10
+#define LWS_SUL_WHEEL_BITS		6
+#define LWS_SUL_WHEEL_SLOTS		(1 << LWS_SUL_WHEEL_BITS)
+#define LWS_SUL_WHEEL_LEVELS		3
+
+typedef struct lws_sul_wheel {
+	lws_dll2_owner_t	slot[LWS_SUL_WHEEL_LEVELS][LWS_SUL_WHEEL_SLOTS];
+	lws_dll2_owner_t	overflow;
+	/* bit set if slot may be occupied... sul can be removed behind our
+	 * back with lws_dll2_remove(), so only a clear bit is authoritative */
+	uint64_t		used[LWS_SUL_WHEEL_LEVELS];
+	uint64_t		cur;	/* wheel time, in ticks */
+} lws_sul_wheel_t;
+#endif
 
 
 /*
@@ -236,12 +264,25 @@ struct client_info_stash {
 
 #if defined(LWS_WITH_UDP)
 #define lws_wsi_is_udp(___wsi) (!!___wsi->udp)
+
+/*
+ * rx storage of a LWS_CAUDP_BATCH_RX wsi, allocated on first rx.  The
+ * LWS_UDP_BATCH datagram slots of slot bytes each follow the struct.
+ */
+struct lws_udp_rx_batch {
+	lws_udp_dgram_t			d[LWS_UDP_BATCH];
+	size_t				slot;
+};
 #endif
 
 #define LWS_H2_FRAME_HEADER_LENGTH 9
 
 lws_usec_t
 __lws_sul_service_ripe(lws_dll2_owner_t *own, int num_own, lws_usec_t usnow);
+struct lws_context_per_thread;
+int
+__lws_sul_insert_pt(struct lws_context_per_thread *pt, int n,
+		    lws_sorted_usec_list_t *sul);
 
 /*
  * lws_async_dns
@@ -287,6 +328,19 @@ lws_async_dns_cancel(struct lws *wsi);
 void
 lws_async_dns_drop_server(lws_async_dns_server_t *dsrv);
 
+/*
+ * Per-pt cache of freed objects of one size, for LWS_SERVER_OPTION_WSI_SLAB.
+ * Objects are linked through their first pointer.
+ */
+
+#define LWS_SLAB_PSS_CLASSES 4
+
+typedef struct lws_slab {
+	void			*free;
+	size_t			size;	/* pss classes: 0 = unclaimed */
+	unsigned int		count;
+} lws_slab_t;
+
 /*
  * so we can have n connections being serviced simultaneously,
  * these things need to be isolated per-thread.
@@ -300,6 +354,11 @@ struct lws_context_per_thread {
 #endif
 	struct lws_dll2_owner dll_buflist_owner;  /* guys with pending rxflow */
 	lws_dll2_owner_t      attach_owner;	/* pending lws_attach */
+	lws_buflist_pool_t    buflist_pool;	/* recycled buflist segments */
+	lws_slab_t	      slab_wsi;		/* recycled wsi */
+	lws_slab_t	      slab_pss[LWS_SLAB_PSS_CLASSES]; /* recycled pss */
+	lws_pt_msg_t	      *inbox;	/* lws_pt_msg_post(), newest first */
+	long		      inbox_posters; /* lws_pt_msg_post() in flight */
 
 #if defined(LWS_WITH_SECURE_STREAMS)
 	lws_dll2_owner_t ss_owner;
@@ -311,6 +370,9 @@ struct lws_context_per_thread {
 #endif
 
 	struct lws_dll2_owner pt_sul_owner[LWS_COUNT_PT_SUL_OWNERS];
+#if defined(LWS_WITH_SUL_WHEEL)
+	lws_sul_wheel_t pt_sul_wheel[LWS_COUNT_PT_SUL_OWNERS];
+#endif
 
 	lws_dll2_owner_t pre_natal_wsi_owner; /* allocated wsi not yet bound to vh
 						 are kept on here until bound, so
@@ -358,6 +420,18 @@ struct lws_context_per_thread {
 	lws_sockfd_type dummy_pipe_fds[2];
 	struct lws *pipe_wsi;
 
+	/*
+	 * Wakes via the event pipe.  wake_pending is set by the first signal
+	 * after the service thread last consumed the pipe, so later signals
+	 * before it runs again can skip the syscall.  The counters are for
+	 * lws_pt_wake_stats(), requested and signalled are updated from any
+	 * thread, delivered only by the service thread.
+	 */
+	uint32_t	wake_requested;
+	uint32_t	wake_signalled;
+	uint32_t	wake_delivered;
+	char		wake_pending;
+
 	/* --- role based members --- */
 
 #if defined(LWS_ROLE_WS) && !defined(LWS_WITHOUT_EXTENSIONS)
@@ -402,6 +476,7 @@ struct lws_context_per_thread {
 	unsigned char event_loop_pt_unused:1;
 	unsigned char destroy_self:1;
 	unsigned char is_destroyed:1;
+	unsigned char slab_destroyed:1;
 };
 
 /*
@@ -471,6 +546,7 @@ struct lws_vhost {
 
 	struct lws_context *context;
 	struct lws_vhost *vhost_next;
+	lws_dll2_t vh_name_hash_list; /* context->vh_name_hash[] bucket */
 
 	const lws_retry_bo_t *retry_policy;
 
@@ -539,6 +615,7 @@ struct lws_vhost {
 	uint32_t		tls_session_cache_max;
 #endif
 	uint32_t		protocol_init; /* bitmap indicating if protocol initialized */
+	uint32_t		seq; /* creation order */
 #if defined(LWS_WITH_SECURE_STREAMS_STATIC_POLICY_ONLY) || defined(LWS_WITH_SECURE_STREAMS_CPP)
 	int8_t			ss_refcount;
 	/**< refcount of number of ss connections with streamtypes using this
@@ -549,6 +626,10 @@ struct lws_vhost {
 	uint8_t created_vhost_protocols:1;
 	uint8_t being_destroyed:1;
 	uint8_t from_ss_policy:1;
+#if defined(__linux__)
+	uint8_t listen_cbpf_failed:1;
+	/* reuseport group cbpf steering failed, use SO_INCOMING_CPU */
+#endif
 #if defined(LWS_WITH_TLS_JIT_TRUST)
 	uint8_t 		grace_after_unref:1;
 	/* grace time / autodelete aoplies to us */
@@ -561,6 +642,14 @@ struct lws_vhost {
 void
 __lws_vhost_destroy2(struct lws_vhost *vh);
 
+int
+lws_vhost_name_hash_add(struct lws_vhost *vh);
+void
+lws_vhost_name_hash_remove(struct lws_vhost *vh);
+struct lws_vhost *
+lws_vhost_name_hash_lookup(struct lws_context *cx, const char *name,
+			   size_t len, int port);
+
 #define mux_to_wsi(_m) lws_container_of(_m, struct lws, mux)
 
 void
@@ -738,6 +827,7 @@ struct lws {
 
 #if defined(LWS_WITH_UDP)
 	struct lws_udp			*udp;
+	struct lws_udp_rx_batch		*udp_rx_batch; /* LWS_CAUDP_BATCH_RX */
 #endif
 #if defined(LWS_WITH_CLIENT)
 	struct client_info_stash	*stash;
@@ -787,6 +877,7 @@ struct lws {
 	unsigned int			listener:1;
 	unsigned int			pf_packet:1;
 	unsigned int			do_broadcast:1;
+	unsigned int			udp_batch_rx:1;
 	unsigned int			user_space_externally_allocated:1;
 	unsigned int			socket_is_permanently_unusable:1;
 	unsigned int			rxflow_change_to:2;
@@ -879,6 +970,7 @@ struct lws {
 	char rx_frame_type; /* enum lws_write_protocol */
 	char pending_timeout; /* enum pending_timeout */
 	char tsi; /* thread service index we belong to */
+	uint8_t user_space_slab; /* 0, or 1 + pt pss slab class */
 	char protocol_interpret_idx;
 	char redirects;
 	uint8_t rxflow_bitmap;
@@ -1063,6 +1155,19 @@ __lws_close_free_wsi(struct lws *wsi, enum lws_close_status, const char *caller)
 void
 __lws_free_wsi(struct lws *wsi);
 
+struct lws *
+lws_pt_wsi_alloc(struct lws_context_per_thread *pt, size_t size);
+void
+lws_pt_wsi_free(struct lws_context_per_thread *pt, struct lws *wsi);
+void *
+lws_pt_pss_alloc(struct lws *wsi, size_t size);
+void
+lws_pt_pss_free(struct lws *wsi);
+void
+lws_pt_slab_destroy(struct lws_context_per_thread *pt);
+void
+lws_pt_msg_drain(struct lws_context_per_thread *pt, int closing);
+
 void
 lws_conmon_addrinfo_destroy(struct addrinfo *ai);
 
@@ -1139,6 +1244,12 @@ user_callback_handle_rxflow(lws_callback_function, struct lws *wsi,
 int
 lws_plat_set_nonblocking(lws_sockfd_type fd);
 
+/*
+ * unix_skt is normally 0 or 1.  The unix plat also understands this, meaning
+ * the socket came from accept4() already nonblocking and close-on-exec
+ */
+#define LWS_SKT_OPT_ACCEPTED_NB_CLOEXEC 2
+
 int
 lws_plat_set_socket_options(struct lws_vhost *vhost, lws_sockfd_type fd,
 			    int unix_skt);
@@ -1146,6 +1257,17 @@ lws_plat_set_socket_options(struct lws_vhost *vhost, lws_sockfd_type fd,
 int
 lws_plat_set_socket_options_ip(lws_sockfd_type fd, uint8_t pri, int lws_flags);
 
+#if defined(LWS_WITH_UDP)
+int
+lws_udp_read_batch(struct lws *wsi);
+#endif
+
+#if defined(__linux__)
+int
+lws_plat_listen_steer_cpu(struct lws_vhost *vh, lws_sockfd_type fd,
+			  int index, int count);
+#endif
+
 int
 lws_plat_check_connection_error(struct lws *wsi);
 
@@ -1296,6 +1418,14 @@ __insert_wsi_socket_into_fds(struct lws_context *context, struct lws *wsi);
 int LWS_WARN_UNUSED_RESULT
 lws_issue_raw(struct lws *wsi, unsigned char *buf, size_t len);
 
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+/* most fragments we try to send with one sendmsg() */
+#define LWS_ISSUE_RAW_MAX_IOV 16
+
+int LWS_WARN_UNUSED_RESULT
+lws_issue_raw_iov(struct lws *wsi, const lws_iov_t *iov, int count);
+#endif
+
 lws_usec_t
 __lws_seq_timeout_check(struct lws_context_per_thread *pt, lws_usec_t usnow);
 
@@ -1313,6 +1443,16 @@ struct lws * LWS_WARN_UNUSED_RESULT
 lws_create_new_server_wsi(struct lws_vhost *vhost, int fixed_tsi,
 				int group, const char *desc);
 
+struct lws *
+lws_adopt_descriptor_vhost_tsi(struct lws_vhost *vh, lws_adoption_type type,
+			       lws_sock_file_fd_type fd,
+			       const char *vh_prot_name, int tsi,
+			       const struct sockaddr_storage *peer_sa,
+			       socklen_t peer_len);
+
+lws_handling_result_t
+lws_listen_accepted(struct lws *wsi, lws_sockfd_type accept_fd);
+
 char * LWS_WARN_UNUSED_RESULT
 lws_generate_client_handshake(struct lws *wsi, char *pkt, size_t pkt_len);
 
@@ -1434,6 +1574,8 @@ int
 lws_plat_service(struct lws_context *context, int timeout_ms);
 LWS_VISIBLE int
 _lws_plat_service_tsi(struct lws_context *context, int timeout_ms, int tsi);
+void
+lws_plat_service_foreign_pfd_list(struct lws_context_per_thread *pt);
 
 int
 lws_pthread_self_to_tsi(struct lws_context *context);
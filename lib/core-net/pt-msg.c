@@ -0,0 +1,163 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Per-pt inbox for messages from other threads
+ *
+ * The inbox is a singly-linked stack of caller-owned lws_pt_msg_t.  Posters
+ * push onto it with a compare-and-swap, the service thread takes the whole
+ * stack with one exchange and reverses it to get posting order back.  So
+ * there are no locks on either side, and because the service thread always
+ * takes everything, only a post that finds the inbox empty has to wake it.
+ *
+ * When the pt is destroyed, the final take leaves a "closed" marker in the
+ * inbox instead of NULL, so a post racing the destroy either gets in before
+ * it and is delivered, or sees the marker and keeps its message.  A post that
+ * got in may still be about to signal the pt's event pipe, so the destroy
+ * waits for posts in flight before the pipe goes away.
+ */
+
+#include "private-lib-core.h"
+
+#define LWS_INBOX_CLOSED ((lws_pt_msg_t *)(lws_intptr_t)1)
+
+#if defined(_MSC_VER)
+#define lws_inbox_cas(_p, _o, _n) \
+	(InterlockedCompareExchangePointer((PVOID volatile *)(_p), \
+					   (_n), (_o)) == (_o))
+#define lws_inbox_take(_p, _n) \
+	((lws_pt_msg_t *)InterlockedExchangePointer((PVOID volatile *)(_p), \
+						    (_n)))
+#define lws_inbox_posters_add(_p, _n) \
+	InterlockedExchangeAdd((LONG volatile *)(_p), (_n))
+#define lws_inbox_posters(_p) \
+	InterlockedCompareExchange((LONG volatile *)(_p), 0, 0)
+#else
+#define lws_inbox_cas(_p, _o, _n) \
+	__atomic_compare_exchange_n(_p, &(_o), _n, 1, __ATOMIC_RELEASE, \
+				    __ATOMIC_RELAXED)
+#define lws_inbox_take(_p, _n) \
+	__atomic_exchange_n(_p, _n, __ATOMIC_ACQUIRE)
+#define lws_inbox_posters_add(_p, _n) \
+	__atomic_fetch_add(_p, _n, __ATOMIC_SEQ_CST)
+#define lws_inbox_posters(_p) \
+	__atomic_load_n(_p, __ATOMIC_SEQ_CST)
+#endif
+
+int
+lws_pt_msg_post(struct lws_context *cx, int tsi, lws_pt_msg_t *msg)
+{
+	struct lws_context_per_thread *pt;
+	lws_pt_msg_t *head;
+
+	/*
+	 * Whether the context is going down is decided by the inbox being
+	 * closed or not, at the moment we try to add to it
+	 */
+	if (tsi < 0 || tsi >= cx->count_threads || !msg->cb)
+		return 1;
+
+	pt = &cx->pt[tsi];
+
+	/* the destroy won't take away the pipe until we are done */
+	lws_inbox_posters_add(&pt->inbox_posters, 1);
+
+	if (!pt->pipe_wsi)
+		goto closed;
+
+#if defined(_MSC_VER)
+	do {
+		head = pt->inbox;
+		if (head == LWS_INBOX_CLOSED)
+			goto closed;
+		msg->next = head;
+	} while (!lws_inbox_cas(&pt->inbox, head, msg));
+#else
+	head = __atomic_load_n(&pt->inbox, __ATOMIC_RELAXED);
+	do {
+		if (head == LWS_INBOX_CLOSED)
+			goto closed;
+		msg->next = head;
+	} while (!lws_inbox_cas(&pt->inbox, head, msg));
+#endif
+
+	/*
+	 * If the inbox had something in it already, a wake is on the way that
+	 * will find our message too
+	 */
+
+	if (!head)
+		lws_plat_pipe_signal(cx, tsi);
+
+	lws_inbox_posters_add(&pt->inbox_posters, -1);
+
+	return 0;
+
+closed:
+	/* the pt is going down, the message is still the caller's */
+	lws_inbox_posters_add(&pt->inbox_posters, -1);
+
+	return 1;
+}
+
+/*
+ * Called on the service thread of pt after it was woken via its event pipe,
+ * and with closing set when the pt is destroyed.  Then the inbox is left
+ * closed, and we wait for any post in flight to finish with the pipe.
+ */
+
+void
+lws_pt_msg_drain(struct lws_context_per_thread *pt, int closing)
+{
+	lws_pt_msg_t *m, *fifo = NULL, *next;
+
+	if (closing) {
+		m = lws_inbox_take(&pt->inbox, LWS_INBOX_CLOSED);
+		while (lws_inbox_posters(&pt->inbox_posters))
+			;
+	} else {
+		/* only the destroy closes it, after service has stopped */
+		if (pt->inbox == LWS_INBOX_CLOSED)
+			return;
+		m = lws_inbox_take(&pt->inbox, NULL);
+	}
+
+	if (!m || m == LWS_INBOX_CLOSED)
+		return;
+
+	/* the stack is newest first, reverse it into posting order */
+
+	while (m) {
+		next = m->next;
+		m->next = fifo;
+		fifo = m;
+		m = next;
+	}
+
+	while (fifo) {
+		next = fifo->next;
+		fifo->next = NULL;
+		/* the cb owns it now and may free it */
+		fifo->cb(pt->context, pt->tid, fifo);
+		fifo = next;
+	}
+}
@@ -277,7 +277,8 @@ lws_rxflow_cache(struct lws *wsi, unsigned char *buf, size_t n, size_t len)
 	/* a new rxflow, buffer it and warn caller */
 
 	lwsl_wsi_debug(wsi, "rxflow append %d", (int)(len - n));
-	m = lws_buflist_append_segment(&wsi->buflist, buf + n, len - n);
+	m = __lws_buflist_append(&wsi->buflist, buf + n, len - n,
+				 &pt->buflist_pool, 0);
 
 	if (m < 0)
 		return LWSRXFC_ERROR;
@@ -498,9 +499,9 @@ lws_buflist_aware_finished_consuming(struct lws *wsi, struct lws_tokens *ebuf,
 	/* any remainder goes on the buflist */
 
 	if (used < ebuf->len && ebuf->len >= 0 && used >= 0) {
-		m = lws_buflist_append_segment(&wsi->buflist,
-					       ebuf->token + used,
-					       (unsigned int)(ebuf->len - used));
+		m = __lws_buflist_append(&wsi->buflist, ebuf->token + used,
+					 (unsigned int)(ebuf->len - used),
+					 &pt->buflist_pool, 0);
 		if (m < 0)
 			return 1; /* OOM */
 		if (m) {
@@ -0,0 +1,217 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Per-pt caches of freed wsi and pss, for LWS_SERVER_OPTION_WSI_SLAB
+ *
+ * Under connection storms every accept and close otherwise goes to the heap
+ * for the wsi and again for its pss, from all the service threads at once.
+ * With the option, each pt keeps up to context->wsi_slab_depth freed objects
+ * of each size and hands them out again, so once the cache is warm accept and
+ * close don't allocate.
+ *
+ * Every cached object is its own heap allocation, so code that doesn't know
+ * about the cache can still lws_free() one, it just isn't recycled then.
+ *
+ * The wsi allocation size is fixed per context.  pss sizes depend on the
+ * protocol, which is bound after the wsi exists, so they are cached by size
+ * in a few classes that each pt claims as it meets new sizes.
+ */
+
+#include "private-lib-core.h"
+
+/* pss sizes are rounded up to this so close sizes share a class */
+#define LWS_SLAB_PSS_ROUND 64
+
+static void *
+lws_slab_get(struct lws_context_per_thread *pt, lws_slab_t *sl)
+{
+	void *p;
+
+	lws_pt_lock(pt, __func__); /* -------------- pt { */
+	p = sl->free;
+	if (p) {
+		sl->free = *(void **)p;
+		sl->count--;
+	}
+	lws_pt_unlock(pt); /* } pt --------------- */
+
+	return p;
+}
+
+/* returns 0 if the cache took it, else the caller must free it */
+
+static int
+lws_slab_put(struct lws_context_per_thread *pt, lws_slab_t *sl, void *p)
+{
+	int ret = 1;
+
+	lws_pt_lock(pt, __func__); /* -------------- pt { */
+	if (!pt->slab_destroyed &&
+	    sl->count < pt->context->wsi_slab_depth) {
+		*(void **)p = sl->free;
+		sl->free = p;
+		sl->count++;
+		ret = 0;
+	}
+	lws_pt_unlock(pt); /* } pt --------------- */
+
+	return ret;
+}
+
+static void
+lws_slab_drain(lws_slab_t *sl)
+{
+	void *p;
+
+	while (sl->free) {
+		p = sl->free;
+		sl->free = *(void **)p;
+		lws_free(p);
+	}
+	sl->count = 0;
+}
+
+struct lws *
+lws_pt_wsi_alloc(struct lws_context_per_thread *pt, size_t size)
+{
+	struct lws *wsi = NULL;
+
+	if (pt->context->wsi_slab_depth)
+		wsi = lws_slab_get(pt, &pt->slab_wsi);
+
+#if defined(LWS_WITH_SYS_METRICS)
+	if (pt->context->wsi_slab_depth)
+		lws_metric_event(pt->context->mt_slab_wsi,
+				 (char)(wsi ? METRES_GO : METRES_NOGO), 0);
+#endif
+
+	if (!wsi)
+		return lws_zalloc(size, "wsi");
+
+	memset(wsi, 0, size);
+
+	return wsi;
+}
+
+void
+lws_pt_wsi_free(struct lws_context_per_thread *pt, struct lws *wsi)
+{
+	if (!pt->context->wsi_slab_depth ||
+	    lws_slab_put(pt, &pt->slab_wsi, wsi))
+		lws_free(wsi);
+}
+
+static int
+lws_slab_pss_class(struct lws_context_per_thread *pt, size_t size, int claim)
+{
+	int n;
+
+	size = (size + LWS_SLAB_PSS_ROUND - 1) & ~((size_t)LWS_SLAB_PSS_ROUND - 1);
+
+	for (n = 0; n < LWS_SLAB_PSS_CLASSES; n++) {
+		if (pt->slab_pss[n].size == size)
+			return n;
+		if (!pt->slab_pss[n].size) {
+			if (!claim)
+				return -1;
+			pt->slab_pss[n].size = size;
+			return n;
+		}
+	}
+
+	return -1;
+}
+
+void *
+lws_pt_pss_alloc(struct lws *wsi, size_t size)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	void *p = NULL;
+	int c;
+
+	wsi->user_space_slab = 0;
+
+	if (!pt->context->wsi_slab_depth)
+		return lws_zalloc(size, "user space");
+
+	lws_pt_lock(pt, __func__); /* -------------- pt { */
+	c = lws_slab_pss_class(pt, size, 1);
+	lws_pt_unlock(pt); /* } pt --------------- */
+
+	if (c < 0)
+		/* too many different sizes, this one isn't cached */
+		return lws_zalloc(size, "user space");
+
+	p = lws_slab_get(pt, &pt->slab_pss[c]);
+
+#if defined(LWS_WITH_SYS_METRICS)
+	lws_metric_event(pt->context->mt_slab_pss,
+			 (char)(p ? METRES_GO : METRES_NOGO), 0);
+#endif
+
+	if (!p) {
+		p = lws_malloc(pt->slab_pss[c].size, "user space");
+		if (!p)
+			return NULL;
+	}
+
+	memset(p, 0, size);
+
+	/*
+	 * Record the class, since the protocol pss size can change while it
+	 * is allocated (lws_adjust_protocol_psds())
+	 */
+	wsi->user_space_slab = (uint8_t)(c + 1);
+
+	return p;
+}
+
+void
+lws_pt_pss_free(struct lws *wsi)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	void *p = wsi->user_space;
+
+	wsi->user_space = NULL;
+	if (!p)
+		return;
+
+	if (!wsi->user_space_slab ||
+	    lws_slab_put(pt, &pt->slab_pss[wsi->user_space_slab - 1], p))
+		lws_free(p);
+
+	wsi->user_space_slab = 0;
+}
+
+void
+lws_pt_slab_destroy(struct lws_context_per_thread *pt)
+{
+	int n;
+
+	/* anything freed after this goes back to the heap */
+	pt->slab_destroyed = 1;
+
+	lws_slab_drain(&pt->slab_wsi);
+	for (n = 0; n < LWS_SLAB_PSS_CLASSES; n++)
+		lws_slab_drain(&pt->slab_pss[n]);
+}
@@ -64,6 +64,337 @@ __lws_sul_insert(lws_dll2_owner_t *own, lws_sorted_usec_list_t *sul)
 	return 0;
 }
 
+#if defined(LWS_WITH_SUL_WHEEL)
+
+static uint64_t
+sul_tick(const lws_sorted_usec_list_t *sul)
+{
+	return sul->us < 0 ? 0 : (uint64_t)sul->us >> LWS_SUL_WHEEL_TICK_BITS;
+}
+
+/* index of the lowest set bit, b must not be 0 */
+
+static int
+sul_ctz64(uint64_t b)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(b);
+#else
+	int n = 0;
+
+	while (!(b & 1)) {
+		b >>= 1;
+		n++;
+	}
+
+	return n;
+#endif
+}
+
+/*
+ * Bottom-up merge sort of a whole sul list by time.  Cascading a wheel slot
+ * can drop thousands of sul on the near list at once, sorting them afterwards
+ * is O(n log n) where sorted insertion of each would be O(n^2).
+ */
+
+static void
+sul_list_sort(lws_dll2_owner_t *own)
+{
+	struct lws_dll2 *list = own->head, *p, *q, *e, *tail;
+	int insize = 1, nmerges, psize, qsize, i;
+
+	if (!list)
+		return;
+
+	do {
+		p = list;
+		list = tail = NULL;
+		nmerges = 0;
+
+		while (p) {
+			nmerges++;
+			q = p;
+			psize = 0;
+			for (i = 0; i < insize && q; i++) {
+				psize++;
+				q = q->next;
+			}
+			qsize = insize;
+
+			while (psize || (qsize && q)) {
+				if (!psize) {
+					e = q;
+					q = q->next;
+					qsize--;
+				} else if (!qsize || !q ||
+					   sul_compare(p, q) <= 0) {
+					e = p;
+					p = p->next;
+					psize--;
+				} else {
+					e = q;
+					q = q->next;
+					qsize--;
+				}
+
+				if (tail)
+					tail->next = e;
+				else
+					list = e;
+				e->prev = tail;
+				tail = e;
+			}
+
+			p = q;
+		}
+
+		tail->next = NULL;
+		insize *= 2;
+	} while (nmerges > 1);
+
+	own->head = list;
+	own->tail = tail;
+}
+
+/*
+ * Put sul in the right place for the wheel's current time.  If it's due in
+ * the near window, or already late, it goes on the near list, sorted if
+ * asked, otherwise on the tail and the caller sorts the near list afterwards.
+ *
+ * Otherwise the level is decided by the most significant tick digit that
+ * differs from the wheel time, and the slot is the sul's digit at that level.
+ */
+
+static void
+sul_wheel_place(lws_sul_wheel_t *w, lws_dll2_owner_t *near,
+		lws_sorted_usec_list_t *sul, int sorted)
+{
+	uint64_t t = sul_tick(sul), x = t ^ w->cur;
+	int l, i;
+
+	if (t < w->cur || !(x >> LWS_SUL_WHEEL_BITS)) {
+		if (sorted)
+			lws_dll2_add_sorted(&sul->list, near, sul_compare);
+		else
+			lws_dll2_add_tail(&sul->list, near);
+
+		return;
+	}
+
+	for (l = 0; l < LWS_SUL_WHEEL_LEVELS; l++)
+		if (!(x >> (LWS_SUL_WHEEL_BITS * (l + 2)))) {
+			i = (int)(t >> (LWS_SUL_WHEEL_BITS * (l + 1))) &
+							(LWS_SUL_WHEEL_SLOTS - 1);
+			lws_dll2_add_tail(&sul->list, &w->slot[l][i]);
+			w->used[l] |= 1ull << i;
+
+			return;
+		}
+
+	lws_dll2_add_tail(&sul->list, &w->overflow);
+}
+
+/*
+ * For when the near list is empty, find the wheel slot holding the next sul.
+ * Returns nonzero if the wheel is empty, else sets *level (with
+ * LWS_SUL_WHEEL_LEVELS meaning the overflow list), *slot, and *start, the tick
+ * the slot begins at, which is no later than any sul in it.
+ *
+ * Lower levels hold earlier sul than higher levels, and at a given level only
+ * slots after the wheel time's digit can be in use.
+ */
+
+static int
+sul_wheel_next(lws_sul_wheel_t *w, int *level, int *slot, uint64_t *start)
+{
+	uint64_t b, m = 0;
+	int l, i, sh;
+
+	for (l = 0; l < LWS_SUL_WHEEL_LEVELS; l++) {
+		sh = LWS_SUL_WHEEL_BITS * (l + 1);
+		i = (int)(w->cur >> sh) & (LWS_SUL_WHEEL_SLOTS - 1);
+		b = w->used[l] & ~((2ull << i) - 1);
+
+		while (b) {
+			i = sul_ctz64(b);
+			if (w->slot[l][i].count) {
+				*level = l;
+				*slot = i;
+				*start = ((w->cur >> (sh + LWS_SUL_WHEEL_BITS)) <<
+						(sh + LWS_SUL_WHEEL_BITS)) |
+					 ((uint64_t)i << sh);
+
+				return 0;
+			}
+
+			/* everything left the slot behind our back */
+			w->used[l] &= ~(1ull << i);
+			b &= b - 1;
+		}
+	}
+
+	if (!w->overflow.count)
+		return 1;
+
+	/* the overflow list is unsorted, but it's normally tiny */
+
+	lws_start_foreach_dll(struct lws_dll2 *, p,
+			      lws_dll2_get_head(&w->overflow)) {
+		uint64_t t = sul_tick((lws_sorted_usec_list_t *)p);
+
+		if (p == lws_dll2_get_head(&w->overflow) || t < m)
+			m = t;
+	} lws_end_foreach_dll(p);
+
+	sh = LWS_SUL_WHEEL_BITS * (LWS_SUL_WHEEL_LEVELS + 1);
+	*level = LWS_SUL_WHEEL_LEVELS;
+	*slot = 0;
+	*start = (m >> sh) << sh;
+
+	return 0;
+}
+
+/*
+ * Move the wheel time on to the start of the slot, and redistribute the slot's
+ * sul onto lower levels or the near list
+ */
+
+static void
+sul_wheel_cascade(lws_sul_wheel_t *w, lws_dll2_owner_t *near, int level,
+		  int slot, uint64_t start)
+{
+	lws_dll2_owner_t *o = &w->overflow, tmp;
+	struct lws_dll2 *d;
+
+	if (level < LWS_SUL_WHEEL_LEVELS) {
+		o = &w->slot[level][slot];
+		w->used[level] &= ~(1ull << slot);
+	}
+
+	w->cur = start;
+
+	/* some overflow sul may go back on overflow, so take them all off */
+
+	memset(&tmp, 0, sizeof(tmp));
+	while ((d = lws_dll2_get_head(o))) {
+		lws_dll2_remove(d);
+		lws_dll2_add_tail(d, &tmp);
+	}
+
+	while ((d = lws_dll2_get_head(&tmp))) {
+		lws_dll2_remove(d);
+		sul_wheel_place(w, near, (lws_sorted_usec_list_t *)d, 0);
+	}
+
+	sul_list_sort(near);
+}
+
+/* everything in the wheel onto the tail of the near list, unsorted */
+
+static void
+sul_wheel_unload(lws_sul_wheel_t *w, lws_dll2_owner_t *near)
+{
+	struct lws_dll2 *d;
+	int l, i;
+
+	for (l = 0; l < LWS_SUL_WHEEL_LEVELS; l++) {
+		for (i = 0; i < LWS_SUL_WHEEL_SLOTS; i++)
+			while ((d = lws_dll2_get_head(&w->slot[l][i]))) {
+				lws_dll2_remove(d);
+				lws_dll2_add_tail(d, near);
+			}
+		w->used[l] = 0;
+	}
+
+	while ((d = lws_dll2_get_head(&w->overflow))) {
+		lws_dll2_remove(d);
+		lws_dll2_add_tail(d, near);
+	}
+}
+
+/* redistribute everything on the near list for the current wheel time */
+
+static void
+sul_wheel_reload(lws_sul_wheel_t *w, lws_dll2_owner_t *near)
+{
+	lws_dll2_owner_t tmp;
+	struct lws_dll2 *d;
+
+	memset(&tmp, 0, sizeof(tmp));
+	while ((d = lws_dll2_get_head(near))) {
+		lws_dll2_remove(d);
+		lws_dll2_add_tail(d, &tmp);
+	}
+
+	while ((d = lws_dll2_get_head(&tmp))) {
+		lws_dll2_remove(d);
+		sul_wheel_place(w, near, (lws_sorted_usec_list_t *)d, 0);
+	}
+
+	sul_list_sort(near);
+}
+#endif
+
+/*
+ * Schedule on one of the pt's sul owners.  sul->us was already computed.
+ */
+
+int
+__lws_sul_insert_pt(struct lws_context_per_thread *pt, int n,
+		    lws_sorted_usec_list_t *sul)
+{
+#if defined(LWS_WITH_SUL_WHEEL)
+	lws_dll2_remove(&sul->list);
+
+	assert(sul->cb);
+
+	sul_wheel_place(&pt->pt_sul_wheel[n], &pt->pt_sul_owner[n], sul, 1);
+
+	return 0;
+#else
+	return __lws_sul_insert(&pt->pt_sul_owner[n], sul);
+#endif
+}
+
+/*
+ * The earliest sul on one of the pt's owners, returns nonzero if none
+ */
+
+static int
+sul_pt_earliest(struct lws_context_per_thread *pt, int n, lws_usec_t *us)
+{
+#if defined(LWS_WITH_SUL_WHEEL)
+	lws_sul_wheel_t *w = &pt->pt_sul_wheel[n];
+	lws_dll2_owner_t *o;
+	uint64_t start;
+	int level, slot;
+#endif
+
+	if (pt->pt_sul_owner[n].count) {
+		*us = ((lws_sorted_usec_list_t *)
+				lws_dll2_get_head(&pt->pt_sul_owner[n]))->us;
+
+		return 0;
+	}
+
+#if defined(LWS_WITH_SUL_WHEEL)
+	if (sul_wheel_next(w, &level, &slot, &start))
+		return 1;
+
+	o = level == LWS_SUL_WHEEL_LEVELS ? &w->overflow : &w->slot[level][slot];
+	*us = ((lws_sorted_usec_list_t *)lws_dll2_get_head(o))->us;
+
+	lws_start_foreach_dll(struct lws_dll2 *, p, lws_dll2_get_head(o)) {
+		if (((lws_sorted_usec_list_t *)p)->us < *us)
+			*us = ((lws_sorted_usec_list_t *)p)->us;
+	} lws_end_foreach_dll(p);
+
+	return 0;
+#else
+	return 1;
+#endif
+}
+
 void
 lws_sul_cancel(lws_sorted_usec_list_t *sul)
 {
@@ -83,8 +414,7 @@ lws_sul2_schedule(struct lws_context *context, int tsi, int flags,
 
 	assert(sul->cb);
 
-	__lws_sul_insert(
-		&pt->pt_sul_owner[!!(flags & LWSSULLI_WAKE_IF_SUSPENDED)], sul);
+	__lws_sul_insert_pt(pt, !!(flags & LWSSULLI_WAKE_IF_SUSPENDED), sul);
 }
 
 /*
@@ -123,27 +453,74 @@ __lws_sul_service_ripe(lws_dll2_owner_t *own, int own_len, lws_usec_t usnow)
 	do {
 		lws_sorted_usec_list_t *hit = NULL;
 		lws_usec_t lowest = 0;
-		int n = 0;
+		int n = 0, found = -1;
+#if defined(LWS_WITH_SUL_WHEEL)
+		uint64_t now = (uint64_t)usnow >> LWS_SUL_WHEEL_TICK_BITS,
+			 start = 0, hstart = 0;
+		int level = 0, slot = 0, hlevel = 0, hslot = 0;
+#endif
 
 		for (n = 0; n < own_len; n++) {
-			lws_sorted_usec_list_t *sul;
-			if (!own[n].count)
-				continue;
-			 sul = (lws_sorted_usec_list_t *)
+			lws_sorted_usec_list_t *sul = NULL;
+			lws_usec_t us;
+
+			if (own[n].count) {
+				sul = (lws_sorted_usec_list_t *)
 						     lws_dll2_get_head(&own[n]);
+				us = sul->us;
+			} else {
+#if defined(LWS_WITH_SUL_WHEEL)
+				/*
+				 * Nothing in the near window, the next thing
+				 * is the start of the next used wheel slot.
+				 * While that's in the future we can bring the
+				 * wheel time up to now, so new sul get placed
+				 * as low in the wheel as possible.
+				 */
+				lws_sul_wheel_t *w = &pt->pt_sul_wheel[n];
+
+				if (sul_wheel_next(w, &level, &slot, &start)) {
+					if (now > w->cur)
+						w->cur = now;
+					continue;
+				}
+				if (now > w->cur && now < start)
+					w->cur = now;
+
+				us = (lws_usec_t)(start <<
+						LWS_SUL_WHEEL_TICK_BITS);
+#else
+				continue;
+#endif
+			}
 
-			if (!hit || sul->us <= lowest) {
+			if (found < 0 || us <= lowest) {
+				found = n;
 				hit = sul;
-				lowest = sul->us;
+				lowest = us;
+#if defined(LWS_WITH_SUL_WHEEL)
+				hlevel = level;
+				hslot = slot;
+				hstart = start;
+#endif
 			}
 		}
 
-		if (!hit)
+		if (found < 0)
 			return 0;
 
 		if (lowest > usnow)
 			return lowest - usnow;
 
+#if defined(LWS_WITH_SUL_WHEEL)
+		if (!hit) {
+			/* a wheel slot's time has come, cascade it and retry */
+			sul_wheel_cascade(&pt->pt_sul_wheel[found], &own[found],
+					  hlevel, hslot, hstart);
+			continue;
+		}
+#endif
+
 		/* his moment has come... remove him from his owning list */
 
 		if (!hit->cb) {
@@ -203,6 +580,21 @@ lws_sul_nonmonotonic_adjust(struct lws_context *ctx, int64_t step_us)
 		lws_pt_lock(pt, __func__);
 
 		for (n = 0; n < LWS_COUNT_PT_SUL_OWNERS; n++) {
+#if defined(LWS_WITH_SUL_WHEEL)
+			lws_sul_wheel_t *w = &pt->pt_sul_wheel[n];
+			int64_t c;
+
+			/*
+			 * The wheel slots depend on the sul times, take
+			 * everything off the wheel and put it back after
+			 */
+			sul_wheel_unload(w, &pt->pt_sul_owner[n]);
+
+			c = (int64_t)(w->cur << LWS_SUL_WHEEL_TICK_BITS) +
+								step_us;
+			w->cur = c < 0 ? 0 : (uint64_t)c >>
+						LWS_SUL_WHEEL_TICK_BITS;
+#endif
 
 			if (!pt->pt_sul_owner[n].count)
 				continue;
@@ -224,6 +616,10 @@ lws_sul_nonmonotonic_adjust(struct lws_context *ctx, int64_t step_us)
 				sul->us += step_us;
 
 			} lws_end_foreach_dll(p);
+
+#if defined(LWS_WITH_SUL_WHEEL)
+			sul_wheel_reload(w, &pt->pt_sul_owner[n]);
+#endif
 		}
 
 		lws_pt_unlock(pt);
@@ -243,22 +639,17 @@ lws_sul_earliest_wakeable_event(struct lws_context *ctx, lws_usec_t *pearliest)
 {
 	struct lws_context_per_thread *pt;
 	int n = 0, hit = -1;
-	lws_usec_t lowest = 0;
+	lws_usec_t lowest = 0, us;
 
 	for (n = 0; n < ctx->count_threads; n++) {
 		pt = &ctx->pt[n];
 
 		lws_pt_lock(pt, __func__);
 
-		if (pt->pt_sul_owner[LWSSULLI_WAKE_IF_SUSPENDED].count) {
-			lws_sorted_usec_list_t *sul = (lws_sorted_usec_list_t *)
-					lws_dll2_get_head(&pt->pt_sul_owner[
-					           LWSSULLI_WAKE_IF_SUSPENDED]);
-
-			if (hit == -1 || sul->us < lowest) {
-				hit = n;
-				lowest = sul->us;
-			}
+		if (!sul_pt_earliest(pt, LWSSULLI_WAKE_IF_SUSPENDED, &us) &&
+		    (hit == -1 || us < lowest)) {
+			hit = n;
+			lowest = us;
 		}
 
 		lws_pt_unlock(pt);
@@ -326,12 +717,62 @@ lws_sul_schedule_wakesuspend(struct lws_context *ctx, int tsi,
  * being destroyed, there is no live sul scheduled from inside the object.
  */
 
+static void
+sul_debug_zombies_list(struct lws_context *ctx, lws_dll2_owner_t *own, int m,
+		       void *po, size_t len, const char *destroy_description)
+{
+	lws_start_foreach_dll(struct lws_dll2 *, p, lws_dll2_get_head(own)) {
+		lws_sorted_usec_list_t *sul =
+			lws_container_of(p, lws_sorted_usec_list_t, list);
+
+		if (!po) {
+			lwsl_cx_err(ctx, "%s", destroy_description);
+			/* just sanity check the list */
+			assert(sul->cb);
+		}
+
+		/*
+		 * Is the sul resident inside the object that is
+		 * indicated as being deleted?
+		 */
+
+		if (po &&
+		    (void *)sul >= po &&
+		    lws_ptr_diff_size_t(sul, po) < len) {
+			lwsl_cx_err(ctx, "ERROR: Zombie Sul "
+				 "(on list %d) %s, cb %p\n", m,
+				 destroy_description, sul->cb);
+			/*
+			 * This assert fires if you have left
+			 * a sul scheduled to fire later, but
+			 * are about to destroy the object the
+			 * sul lives in.  You must take care to
+			 * do lws_sul_cancel(&sul) on any suls
+			 * that may be scheduled before
+			 * destroying the object the sul lives
+			 * inside.
+			 *
+			 * You can look up the cb pointer in
+			 * your mapfile to find out which
+			 * callback function the sul was using
+			 * which usually tells you which sul
+			 * it is.
+			 */
+			assert(0);
+		}
+
+	} lws_end_foreach_dll(p);
+}
+
 void
 lws_sul_debug_zombies(struct lws_context *ctx, void *po, size_t len,
 		      const char *destroy_description)
 {
 	struct lws_context_per_thread *pt;
 	int n, m;
+#if defined(LWS_WITH_SUL_WHEEL)
+	int l, i;
+#endif
 
 	for (n = 0; n < ctx->count_threads; n++) {
 		pt = &ctx->pt[n];
@@ -339,51 +780,17 @@ lws_sul_debug_zombies(struct lws_context *ctx, void *po, size_t len,
 		lws_pt_lock(pt, __func__);
 
 		for (m = 0; m < LWS_COUNT_PT_SUL_OWNERS; m++) {
-
-			lws_start_foreach_dll(struct lws_dll2 *, p,
-				      lws_dll2_get_head(&pt->pt_sul_owner[m])) {
-				lws_sorted_usec_list_t *sul =
-					lws_container_of(p,
-						lws_sorted_usec_list_t, list);
-
-				if (!po) {
-					lwsl_cx_err(ctx, "%s",
-							 destroy_description);
-					/* just sanity check the list */
-					assert(sul->cb);
-				}
-
-				/*
-				 * Is the sul resident inside the object that is
-				 * indicated as being deleted?
-				 */
-
-				if (po &&
-				    (void *)sul >= po &&
-				    (size_t)lws_ptr_diff(sul, po) < len) {
-					lwsl_cx_err(ctx, "ERROR: Zombie Sul "
-						 "(on list %d) %s, cb %p\n", m,
-						 destroy_description, sul->cb);
-					/*
-					 * This assert fires if you have left
-					 * a sul scheduled to fire later, but
-					 * are about to destroy the object the
-					 * sul lives in.  You must take care to
-					 * do lws_sul_cancel(&sul) on any suls
-					 * that may be scheduled before
-					 * destroying the object the sul lives
-					 * inside.
-					 *
-					 * You can look up the cb pointer in
-					 * your mapfile to find out which
-					 * callback function the sul was using
-					 * which usually tells you which sul
-					 * it is.
-					 */
-					assert(0);
-				}
-
-			} lws_end_foreach_dll(p);
+			sul_debug_zombies_list(ctx, &pt->pt_sul_owner[m], m,
+					       po, len, destroy_description);
+#if defined(LWS_WITH_SUL_WHEEL)
+			for (l = 0; l < LWS_SUL_WHEEL_LEVELS; l++)
+				for (i = 0; i < LWS_SUL_WHEEL_SLOTS; i++)
+					sul_debug_zombies_list(ctx,
+						&pt->pt_sul_wheel[m].slot[l][i],
+						m, po, len, destroy_description);
+			sul_debug_zombies_list(ctx, &pt->pt_sul_wheel[m].overflow,
+					       m, po, len, destroy_description);
+#endif
 		}
 
 		lws_pt_unlock(pt);
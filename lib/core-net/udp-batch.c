@@ -0,0 +1,242 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Batched UDP rx and tx
+ *
+ * A UDP wsi normally costs one wake, one recvfrom() and one callback per
+ * datagram.  These move up to LWS_UDP_BATCH datagrams per syscall with
+ * recvmmsg() / sendmmsg() where the platform has them, and otherwise loop
+ * recvmsg() (or recvfrom()) / sendto() so the api behaves the same
+ * everywhere... except with only recvfrom(), eg, on windows, truncation of
+ * a datagram bigger than the slot can't be detected or reported.
+ */
+
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for recvmmsg() / sendmmsg() */
+#endif
+#include "private-lib-core.h"
+
+static int
+lws_udp_batch_would_block(void)
+{
+	return LWS_ERRNO == LWS_EAGAIN || LWS_ERRNO == LWS_EWOULDBLOCK ||
+	       LWS_ERRNO == LWS_EINTR;
+}
+
+static const lws_sockaddr46 *
+lws_udp_batch_peer(struct lws *wsi, const lws_udp_dgram_t *d)
+{
+	return d->sa46.sa4.sin_family ? &d->sa46 : &wsi->udp->sa46;
+}
+
+/*
+ * Returns how many datagrams were read into wsi->udp_rx_batch->d, 0 if none
+ * were waiting, or LWS_SSL_CAPABLE_ERROR
+ */
+
+int
+lws_udp_read_batch(struct lws *wsi)
+{
+	struct lws_udp_rx_batch *b = wsi->udp_rx_batch;
+	unsigned int n, m = 0;
+	uint8_t *slots;
+#if defined(LWS_HAVE_RECVMMSG)
+	struct mmsghdr mh[LWS_UDP_BATCH];
+	struct iovec iov[LWS_UDP_BATCH];
+	int r;
+#endif
+
+	if (!b) {
+		size_t slot = wsi->a.protocol->rx_buffer_size;
+
+		if (!slot)
+			slot = wsi->a.context->pt_serv_buf_size;
+
+		b = lws_malloc(sizeof(*b) + (LWS_UDP_BATCH * slot),
+			       "udp rx batch");
+		if (!b)
+			return LWS_SSL_CAPABLE_ERROR;
+
+		memset(b, 0, sizeof(*b));
+		b->slot = slot;
+		wsi->udp_rx_batch = b;
+	}
+
+	slots = (uint8_t *)&b[1];
+
+#if defined(LWS_HAVE_RECVMMSG)
+	memset(mh, 0, sizeof(mh));
+	for (n = 0; n < LWS_UDP_BATCH; n++) {
+		iov[n].iov_base = slots + (n * b->slot);
+		iov[n].iov_len = b->slot;
+		mh[n].msg_hdr.msg_iov = &iov[n];
+		mh[n].msg_hdr.msg_iovlen = 1;
+		mh[n].msg_hdr.msg_name = sa46_sockaddr(&b->d[n].sa46);
+		mh[n].msg_hdr.msg_namelen = sizeof(b->d[n].sa46);
+	}
+
+	r = recvmmsg(wsi->desc.sockfd, mh, LWS_UDP_BATCH, MSG_DONTWAIT, NULL);
+	if (r < 0)
+		return lws_udp_batch_would_block() ? 0 : LWS_SSL_CAPABLE_ERROR;
+
+	for (n = 0; n < (unsigned int)r; n++) {
+		b->d[n].buf = iov[n].iov_base;
+		b->d[n].len = mh[n].msg_len;
+		b->d[n].truncated = !!(mh[n].msg_hdr.msg_flags & MSG_TRUNC);
+	}
+	m = (unsigned int)r;
+#else
+	for (n = 0; n < LWS_UDP_BATCH; n++) {
+#if defined(LWS_HAVE_RECVMSG)
+		struct msghdr mh;
+		struct iovec iov;
+#else
+		socklen_t slt = sizeof(b->d[n].sa46);
+#endif
+		int r;
+
+#if defined(LWS_HAVE_RECVMSG)
+		memset(&mh, 0, sizeof(mh));
+		iov.iov_base = slots + (n * b->slot);
+		iov.iov_len = b->slot;
+		mh.msg_iov = &iov;
+		mh.msg_iovlen = 1;
+		mh.msg_name = sa46_sockaddr(&b->d[n].sa46);
+		mh.msg_namelen = sizeof(b->d[n].sa46);
+
+		r = (int)recvmsg(wsi->desc.sockfd, &mh, 0);
+#else
+		r = (int)recvfrom(wsi->desc.sockfd, (char *)slots + (n * b->slot),
+#if defined(WIN32)
+				(int)
+#endif
+				b->slot, 0, sa46_sockaddr(&b->d[n].sa46), &slt);
+#endif
+		if (r < 0) {
+			if (!n && !lws_udp_batch_would_block())
+				return LWS_SSL_CAPABLE_ERROR;
+			break;
+		}
+
+		b->d[n].buf = slots + (n * b->slot);
+		b->d[n].len = (size_t)r;
+#if defined(LWS_HAVE_RECVMSG)
+		b->d[n].truncated = !!(mh.msg_flags & MSG_TRUNC);
+#else
+		/* recvfrom() can't tell us, the datagram is just cut short */
+		b->d[n].truncated = 0;
+#endif
+		m++;
+	}
+#endif
+
+	if (m)
+		/* replies by lws_write() go to the last one, like unbatched */
+		wsi->udp->sa46 = b->d[m - 1].sa46;
+
+	return (int)m;
+}
+
+int
+lws_udp_write_batch(struct lws *wsi, const lws_udp_dgram_t *d,
+		    unsigned int count)
+{
+	unsigned int done = 0;
+#if defined(LWS_HAVE_SENDMMSG)
+	struct mmsghdr mh[LWS_UDP_BATCH];
+	struct iovec iov[LWS_UDP_BATCH];
+	const lws_sockaddr46 *sa;
+	unsigned int n, c;
+	int r;
+#endif
+
+	if (!wsi->udp)
+		return -1;
+
+	if (lws_has_buffered_out(wsi)) {
+		/* lws_write() datagrams still queued must go first */
+		lws_callback_on_writable(wsi);
+
+		return 0;
+	}
+
+	if (lws_fi(&wsi->fic, "udp_tx_loss"))
+		/* pretend they were all sent */
+		return (int)count;
+
+#if defined(LWS_HAVE_SENDMMSG)
+	while (done < count) {
+		c = count - done;
+		if (c > LWS_UDP_BATCH)
+			c = LWS_UDP_BATCH;
+
+		memset(mh, 0, sizeof(mh[0]) * c);
+		for (n = 0; n < c; n++) {
+			sa = lws_udp_batch_peer(wsi, &d[done + n]);
+			iov[n].iov_base = (void *)d[done + n].buf;
+			iov[n].iov_len = d[done + n].len;
+			mh[n].msg_hdr.msg_iov = &iov[n];
+			mh[n].msg_hdr.msg_iovlen = 1;
+			mh[n].msg_hdr.msg_name = (void *)sa46_sockaddr(sa);
+			mh[n].msg_hdr.msg_namelen = sa46_socklen(sa);
+		}
+
+		r = sendmmsg(wsi->desc.sockfd, mh, c, MSG_DONTWAIT);
+		if (r < 0) {
+			if (lws_udp_batch_would_block())
+				break;
+			goto bail;
+		}
+
+		done += (unsigned int)r;
+		if ((unsigned int)r < c)
+			break;
+	}
+#else
+	for (; done < count; done++) {
+		const lws_sockaddr46 *sa = lws_udp_batch_peer(wsi, &d[done]);
+
+		if (sendto(wsi->desc.sockfd, (const char *)d[done].buf,
+#if defined(WIN32)
+				(int)
+#endif
+				d[done].len, 0, sa46_sockaddr(sa),
+				sa46_socklen(sa)) < 0) {
+			if (lws_udp_batch_would_block())
+				break;
+			goto bail;
+		}
+	}
+#endif
+
+	if (done < count)
+		/* the rest is on the caller, when we can take more */
+		lws_callback_on_writable(wsi);
+
+	return (int)done;
+
+bail:
+	lwsl_wsi_debug(wsi, "ERROR sending batch, errno %d", LWS_ERRNO);
+
+	return done ? (int)done : -1;
+}
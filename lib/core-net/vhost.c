@@ -891,6 +891,11 @@ lws_create_vhost(struct lws_context *context,
 				   (unsigned int)vh->count_protocols, "same vh list");
 #if defined(LWS_ROLE_H1) || defined(LWS_ROLE_H2)
 	vh->http.mount_list = info->mounts;
+	lws_http_mount_index_create(vh);
+	if (lws_http_file_cache_create(vh, info)) {
+		lwsl_vhost_err(vh, "OOM creating file cache");
+		goto bail;
+	}
 #endif
 
 #if defined(LWS_WITH_SYS_METRICS) && defined(LWS_WITH_SERVER)
@@ -1047,6 +1052,11 @@ lws_create_vhost(struct lws_context *context,
 		vh1 = &(*vh1)->vhost_next;
 	};
 
+	if (lws_vhost_name_hash_add(vh)) {
+		lwsl_vhost_err(vh, "OOM hashing vhost name");
+		goto bail1;
+	}
+
 #if defined(LWS_WITH_SYS_ASYNC_DNS)
 	if (!n)
 		lws_async_dns_init(context);
@@ -1069,6 +1079,10 @@ bail1:
 	return NULL;
 
 bail:
+#if defined(LWS_ROLE_H1) || defined(LWS_ROLE_H2)
+	lws_http_mount_index_destroy(vh);
+	lws_http_file_cache_destroy(vh);
+#endif
 	__lws_lc_untag(vh->context, &vh->lc);
 	lws_fi_destroy(&vh->fic);
 	lws_free(vh);
@@ -1084,6 +1098,9 @@ lws_vhost_set_mounts(struct lws_vhost *vh, const struct lws_http_mount *mounts)
 {
 #if defined(LWS_ROLE_H1) || defined(LWS_ROLE_H2)
         vh->http.mount_list = mounts;
+        lws_http_mount_index_create(vh);
+	/* the blocks may be for mount headers that are going away */
+	lws_http_serve_hdrs_destroy(vh);
 #endif
 }
 
@@ -1123,6 +1140,23 @@ lws_cancel_service(struct lws_context *context)
 	}
 }
 
+int
+lws_pt_wake_stats(struct lws_context *context, int tsi,
+		  lws_pt_wake_stats_t *stats)
+{
+	struct lws_context_per_thread *pt;
+
+	if (tsi < 0 || tsi >= context->count_threads)
+		return 1;
+
+	pt = &context->pt[tsi];
+	stats->requested = pt->wake_requested;
+	stats->signalled = pt->wake_signalled;
+	stats->delivered = pt->wake_delivered;
+
+	return 0;
+}
+
 int
 __lws_create_event_pipes(struct lws_context *context)
 {
@@ -1511,6 +1545,7 @@ __lws_vhost_destroy2(struct lws_vhost *vh)
 			break;
 		}
 	} lws_end_foreach_llp(pv, vhost_next);
+	lws_vhost_name_hash_remove(vh);
 
 	/* add ourselves to the pending destruction list */
 
@@ -1578,6 +1613,18 @@ __lws_vhost_destroy2(struct lws_vhost *vh)
 	vh->tls.key_path = NULL;
 #endif
 
+#if defined(LWS_ROLE_H1) || defined(LWS_ROLE_H2)
+	lws_http_mount_index_destroy(vh);
+	/*
+	 * The workers' jobs refer to the file cache and precomp, and these
+	 * take the vhost lock, so before it goes
+	 */
+	lws_http_cw_destroy(vh);
+	lws_http_file_cache_destroy(vh);
+	lws_http_precomp_destroy(vh);
+	lws_http_serve_hdrs_destroy(vh);
+#endif
+
 #if LWS_MAX_SMP > 1
 	lws_mutex_refcount_destroy(&vh->mr);
 #endif
@@ -1746,15 +1793,120 @@ lws_context_deprecate(struct lws_context *cx, lws_reload_func cb)
 
 #if defined(LWS_WITH_NETWORK)
 
+/*
+ * Vhosts are also kept in a hash table by name, so finding one by name, SNI or
+ * Host: header doesn't have to walk what may be thousands of vhosts.  Vhosts
+ * may share a name if they listen on different ports, each bucket keeps them
+ * in the same order as context->vhost_list.
+ */
+
+#define LWS_VH_NAME_HASH_MIN 16
+
+static lws_dll2_owner_t *
+lws_vhost_name_bucket(struct lws_context *cx, const char *name, size_t len)
+{
+	uint32_t h = lws_fnv1a32(LWS_FNV1A32_INIT, name, len);
+
+	return &cx->vh_name_hash[h & (cx->vh_name_hash_size - 1)];
+}
+
+int
+lws_vhost_name_hash_add(struct lws_vhost *vh)
+{
+	struct lws_context *cx = vh->context;
+	lws_dll2_owner_t *ht;
+	uint32_t size;
+
+	vh->seq = cx->vh_seq++;
+
+	if (cx->vh_name_hash_count < cx->vh_name_hash_size) {
+		lws_dll2_add_tail(&vh->vh_name_hash_list,
+				  lws_vhost_name_bucket(cx, vh->name,
+							strlen(vh->name)));
+		cx->vh_name_hash_count++;
+
+		return 0;
+	}
+
+	/* (re)create the table at twice the size */
+
+	size = cx->vh_name_hash_size ? cx->vh_name_hash_size * 2 :
+				       LWS_VH_NAME_HASH_MIN;
+	ht = lws_zalloc(sizeof(*ht) * size, "vh name hash");
+	if (!ht)
+		return 1;
+
+	lws_free(cx->vh_name_hash);
+	cx->vh_name_hash = ht;
+	cx->vh_name_hash_size = size;
+	cx->vh_name_hash_count = 0;
+
+	/* we're already on the vhost list, so this rehashes us too */
+
+	lws_start_foreach_ll(struct lws_vhost *, v, cx->vhost_list) {
+		lws_dll2_clear(&v->vh_name_hash_list);
+		lws_dll2_add_tail(&v->vh_name_hash_list,
+				  lws_vhost_name_bucket(cx, v->name,
+							strlen(v->name)));
+		cx->vh_name_hash_count++;
+	} lws_end_foreach_ll(v, vhost_next);
+
+	return 0;
+}
+
+void
+lws_vhost_name_hash_remove(struct lws_vhost *vh)
+{
+	if (lws_dll2_is_detached(&vh->vh_name_hash_list))
+		return;
+
+	lws_dll2_remove(&vh->vh_name_hash_list);
+	vh->context->vh_name_hash_count--;
+}
+
+/*
+ * The first created vhost called name[0 .. len) listening on port, or any port
+ * if port is -1
+ */
+
+struct lws_vhost *
+lws_vhost_name_hash_lookup(struct lws_context *cx, const char *name,
+			   size_t len, int port)
+{
+	if (!cx->vh_name_hash_size)
+		return NULL;
+
+	lws_start_foreach_dll(struct lws_dll2 *, d, lws_dll2_get_head(
+				lws_vhost_name_bucket(cx, name, len))) {
+		struct lws_vhost *v = lws_container_of(d, struct lws_vhost,
+						       vh_name_hash_list);
+
+		if ((port == -1 || port == v->listen_port) &&
+		    !strncmp(v->name, name, len) && !v->name[len])
+			return v;
+
+	} lws_end_foreach_dll(d);
+
+	return NULL;
+}
+
 struct lws_vhost *
 lws_get_vhost_by_name(struct lws_context *context, const char *name)
 {
-	lws_start_foreach_ll(struct lws_vhost *, v,
-			     context->vhost_list) {
+	size_t len = strlen(name);
+
+	if (!context->vh_name_hash_size)
+		return NULL;
+
+	lws_start_foreach_dll(struct lws_dll2 *, d, lws_dll2_get_head(
+				lws_vhost_name_bucket(context, name, len))) {
+		struct lws_vhost *v = lws_container_of(d, struct lws_vhost,
+						       vh_name_hash_list);
+
 		if (!v->being_destroyed && !strcmp(v->name, name))
 			return v;
 
-	} lws_end_foreach_ll(v, vhost_next);
+	} lws_end_foreach_dll(d);
 
 	return NULL;
 }
@@ -277,7 +277,7 @@ struct lws *__lws_wsi_create_with_role(struct lws_context *context, int tsi,
 	s += context->event_loop_ops->evlib_size_wsi;
 #endif
 
-	wsi = lws_zalloc(s, __func__);
+	wsi = lws_pt_wsi_alloc(pt, s);
 
 	if (!wsi) {
 		lwsl_cx_err(context, "OOM");
@@ -310,7 +310,7 @@ struct lws *__lws_wsi_create_with_role(struct lws_context *context, int tsi,
 	if (lws_fi(&wsi->fic, "createfail")) {
 		lws_dll2_remove(&wsi->pre_natal);
 		lws_fi_destroy(&wsi->fic);
-		lws_free(wsi);
+		lws_pt_wsi_free(pt, wsi);
 		return NULL;
 	}
 
@@ -534,8 +534,8 @@ int lws_ensure_user_space(struct lws *wsi) {
 	/* allocate the per-connection user memory (if any) */
 
 	if (wsi->a.protocol->per_session_data_size && !wsi->user_space) {
-		wsi->user_space =
-			lws_zalloc(wsi->a.protocol->per_session_data_size, "user space");
+		wsi->user_space = lws_pt_pss_alloc(wsi,
+				wsi->a.protocol->per_session_data_size);
 		if (wsi->user_space == NULL) {
 			lwsl_wsi_err(wsi, "OOM");
 			return 1;
@@ -807,7 +807,7 @@ int lws_wsi_tsi(struct lws *wsi) { return wsi->tsi; }
 
 void lws_set_wsi_user(struct lws *wsi, void *data) {
 	if (!wsi->user_space_externally_allocated && wsi->user_space)
-		lws_free(wsi->user_space);
+		lws_pt_pss_free(wsi);
 
 	wsi->user_space_externally_allocated = 1;
 	wsi->user_space = data;
@@ -1073,7 +1073,7 @@ int lws_bind_protocol(struct lws *wsi, const struct lws_protocols *p,
 		wsi->protocol_bind_balance = 0;
 	}
 	if (!wsi->user_space_externally_allocated)
-		lws_free_set_NULL(wsi->user_space);
+		lws_pt_pss_free(wsi);
 
 	lws_same_vh_protocol_remove(wsi);
 
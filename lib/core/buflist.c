@@ -30,57 +30,159 @@
 
 /* lws_buflist */
 
+/* payload sizes of the pooled segment classes */
+static const size_t buflist_pool_sizes[LWS_BUFLIST_POOL_CLASSES] = {
+	512, 2048, 8192
+};
+
+static struct lws_buflist *
+lws_buflist_alloc(lws_buflist_pool_t *pool, size_t len, int flags)
+{
+	int c = LWS_BUFLIST_POOL_CLASSES;
+	struct lws_buflist *b = NULL;
+	size_t size = len;
+
+	if (pool && !pool->destroyed)
+		/*
+		 * if we will coalesce into it, leave room for a useful number
+		 * of further small appends
+		 */
+		for (c = (flags & LWSBLAF_COALESCE) ? 1 : 0;
+		     c < LWS_BUFLIST_POOL_CLASSES; c++)
+			if (len <= buflist_pool_sizes[c])
+				break;
+
+	if (c < LWS_BUFLIST_POOL_CLASSES) {
+		size = buflist_pool_sizes[c];
+		b = pool->free[c];
+		if (b) {
+			pool->free[c] = b->next;
+			pool->count[c]--;
+		}
+	}
+
+	if (!b) {
+		/* whoever consumes this might need LWS_PRE from the start... */
+		b = (struct lws_buflist *)lws_malloc(sizeof(*b) + size +
+						     LWS_PRE + 1, __func__);
+		if (!b)
+			return NULL;
+	}
+
+	memset(b, 0, sizeof(*b));
+	b->size = size;
+	if (c < LWS_BUFLIST_POOL_CLASSES) {
+		b->pool = pool;
+		b->sclass = (unsigned char)c;
+	}
+
+	return b;
+}
+
+static void
+lws_buflist_free(struct lws_buflist *b)
+{
+	lws_buflist_pool_t *pool = b->pool;
+
+	if (pool && !pool->destroyed &&
+	    pool->count[b->sclass] < LWS_BUFLIST_POOL_DEPTH) {
+		b->next = pool->free[b->sclass];
+		pool->free[b->sclass] = b;
+		pool->count[b->sclass]++;
+
+		return;
+	}
+
+	lws_free(b);
+}
+
+void
+lws_buflist_pool_destroy(lws_buflist_pool_t *pool)
+{
+	struct lws_buflist *b;
+	int c;
+
+	/* anything still pooled and freed after this goes back to the heap */
+	pool->destroyed = 1;
+
+	for (c = 0; c < LWS_BUFLIST_POOL_CLASSES; c++) {
+		while (pool->free[c]) {
+			b = pool->free[c];
+			pool->free[c] = b->next;
+			lws_free(b);
+		}
+		pool->count[c] = 0;
+	}
+}
+
+/*
+ * The head segment's tail member points to the last segment, so we don't have
+ * to walk the list to append.
+ *
+ * If pool is given, small segments are allocated at one of the pool's class
+ * sizes and recycled through it when used.  With LWSBLAF_COALESCE, a new
+ * append that fits in the slack of the tail segment is copied in there rather
+ * than creating a new segment, this is only for users that don't care about
+ * segment boundaries, such as a tcp connection's buflist_out.
+ */
+
 int
-lws_buflist_append_segment(struct lws_buflist **head, const uint8_t *buf,
-			   size_t len)
+__lws_buflist_append(struct lws_buflist **head, const uint8_t *buf, size_t len,
+		     lws_buflist_pool_t *pool, int flags)
 {
-	struct lws_buflist *nbuf;
+	struct lws_buflist *nbuf, *t = NULL;
 	int first = !*head;
-	void *p = *head;
-	int sanity = 1024;
 
 	if (!buf)
 		return -1;
 
 	assert(len);
 
-	/* append at the tail */
-	while (*head) {
-		if (!--sanity) {
-			lwsl_err("%s: buflist reached sanity limit\n", __func__);
+	if (!first) {
+		t = (*head)->tail;
+		if (!t || t->next) {
+			lwsl_err("%s: corrupt buflist tail\n", __func__);
 			return -1;
 		}
-		if (*head == (*head)->next) {
-			lwsl_err("%s: corrupt list points to self\n", __func__);
-			return -1;
+
+		if ((flags & LWSBLAF_COALESCE) && t->coalesce &&
+		    !t->awaiting_eom && t->size - t->len >= len) {
+			memcpy((uint8_t *)&t[1] + LWS_PRE + t->len, buf, len);
+			t->len += len;
+
+			return 0;
 		}
-		head = &((*head)->next);
 	}
 
-	(void)p;
 	lwsl_info("%s: len %u first %d %p\n", __func__, (unsigned int)len,
-					      first, p);
+					      first, *head);
 
-	nbuf = (struct lws_buflist *)lws_malloc(sizeof(struct lws_buflist) +
-						len + LWS_PRE + 1, __func__);
+	nbuf = lws_buflist_alloc(pool, len, flags);
 	if (!nbuf) {
 		lwsl_err("%s: OOM\n", __func__);
 		return -1;
 	}
 
 	nbuf->len = len;
-	nbuf->pos = 0;
-	nbuf->next = NULL;
-
-	/* whoever consumes this might need LWS_PRE from the start... */
-	p = (uint8_t *)nbuf + sizeof(*nbuf) + LWS_PRE;
-	memcpy(p, buf, len);
+	nbuf->coalesce = !!(flags & LWSBLAF_COALESCE);
+	memcpy((uint8_t *)&nbuf[1] + LWS_PRE, buf, len);
 
-	*head = nbuf;
+	if (first)
+		*head = nbuf;
+	else
+		t->next = nbuf;
+	(*head)->tail = nbuf;
 
 	return first; /* returns 1 if first segment just created */
 }
 
+int
+lws_buflist_append_segment(struct lws_buflist **head, const uint8_t *buf,
+			   size_t len)
+{
+	return __lws_buflist_append(head, buf, len, NULL, 0);
+}
+
 static int
 lws_buflist_destroy_segment(struct lws_buflist **head)
 {
@@ -88,9 +190,12 @@ lws_buflist_destroy_segment(struct lws_buflist **head)
 
 	assert(*head);
 	*head = old->next;
+	if (*head)
+		/* the new head inherits knowing where the tail is */
+		(*head)->tail = old->tail;
 	old->next = NULL;
 	old->pos = old->len = 0;
-	lws_free(old);
+	lws_buflist_free(old);
 
 	return !*head; /* returns 1 if last segment just destroyed */
 }
@@ -103,7 +208,7 @@ lws_buflist_destroy_all_segments(struct lws_buflist **head)
 	while (p) {
 		p1 = p->next;
 		p->next = NULL;
-		lws_free(p);
+		lws_buflist_free(p);
 		p = p1;
 	}
 
@@ -160,6 +265,43 @@ lws_buflist_use_segment(struct lws_buflist **head, size_t len)
 	return lws_buflist_next_segment_len(head, NULL);
 }
 
+int
+lws_buflist_peek_segments(struct lws_buflist **head, lws_buflist_frag_t *frags,
+			  int max_frags)
+{
+	struct lws_buflist *b = *head;
+	int n = 0;
+
+	while (b && n < max_frags) {
+		if (b->len > b->pos) {
+			frags[n].buf = (uint8_t *)&b[1] + LWS_PRE + b->pos;
+			frags[n].len = b->len - b->pos;
+			n++;
+		}
+		b = b->next;
+	}
+
+	return n;
+}
+
+size_t
+lws_buflist_use(struct lws_buflist **head, size_t len)
+{
+	size_t s, left = 0;
+
+	while (*head && len) {
+		s = (*head)->len - (*head)->pos;
+		if (s > len)
+			s = len;
+		len -= s;
+		left = lws_buflist_use_segment(head, s);
+	}
+
+	assert(!len);
+
+	return left;
+}
+
 size_t
 lws_buflist_total_len(struct lws_buflist **head)
 {
@@ -355,8 +497,7 @@ lws_wsmsg_transfer(lws_wsmsg_info_t *info)
 	if (!bl)
 		return;
 
-	while (bl && bl->next)
-		bl = bl->next;
+	bl = bl->tail;
 
 	if (bl->awaiting_eom)
 		return;
@@ -376,8 +517,7 @@ lws_wsmsg_transfer(lws_wsmsg_info_t *info)
 
 	/* find the end of the existing upstream */
 
-	while (ubl && ubl->next)
-		ubl = ubl->next;
+	ubl = ubl->tail;
 
 	if (ubl->awaiting_eom)
 		return;
@@ -388,6 +528,7 @@ lws_wsmsg_transfer(lws_wsmsg_info_t *info)
 	 */
 
 	ubl->next					= info->private_heads[info->private_source_idx];
+	(*info->head_upstream)->tail			= info->private_heads[info->private_source_idx]->tail;
 	info->private_heads[info->private_source_idx]	= NULL; /* now it transferred upstream, private owns nothing */
 }
 
@@ -427,12 +568,11 @@ lws_wsmsg_append(lws_wsmsg_info_t *info)
 		bl = info->private_heads[info->private_source_idx];
 	}
 
-	while (bl && bl->next)
-		bl = bl->next;
-
 	if (!bl)
 		return 0;
 
+	bl = bl->tail;
+
 	bl->awaiting_eom	= !(info->ss_flags & LWSSS_FLAG_EOM);
 	bl->src_channel		= (unsigned char)info->private_source_idx;
 
@@ -498,6 +498,45 @@ lws_create_context(const struct lws_context_creation_info *info)
 	}
 #endif
 
+#if defined(LWS_WITH_EPOLL)
+	if (!info->event_lib_custom &&
+	    lws_check_opt(info->options, LWS_SERVER_OPTION_EPOLL)) {
+		extern const lws_plugin_evlib_t evlib_epoll;
+		plev = &evlib_epoll;
+		/* epoll_wait() is also ms resolution */
+		us_wait_resolution = 1000;
+	}
+#else
+	if (lws_check_opt(info->options, LWS_SERVER_OPTION_EPOLL)) {
+		lwsl_cx_err(context, "Application wants epoll, but lws not built with it");
+		goto bail;
+	}
+#endif
+
+#if defined(LWS_WITH_IO_URING)
+	if (!info->event_lib_custom &&
+	    lws_check_opt(info->options, LWS_SERVER_OPTION_IO_URING)) {
+		extern const lws_plugin_evlib_t evlib_uring;
+		int e = lws_uring_probe();
+
+		if (e)
+			/* keep whatever we picked above */
+			lwsl_cx_warn(context, "io_uring unavailable (%d), "
+					      "falling back to %s", e,
+				     plev ? plev->ops->name : "none");
+		else {
+			plev = &evlib_uring;
+			/* we pass the wait to the kernel in ms */
+			us_wait_resolution = 1000;
+		}
+	}
+#else
+	if (lws_check_opt(info->options, LWS_SERVER_OPTION_IO_URING)) {
+		lwsl_cx_err(context, "Application wants io_uring, but lws not built with it");
+		goto bail;
+	}
+#endif
+
 #if defined(LWS_WITH_EVLIB_PLUGINS) && defined(LWS_WITH_EVENT_LIBS)
 
 	/*
@@ -785,6 +824,18 @@ lws_create_context(const struct lws_context_creation_info *info)
 					LWSMTFL_REPORT_DUTY_WALLCLOCK_US |
 					LWSMTFL_REPORT_ONLY_GO, "cpu.svc");
 
+	if (lws_check_opt(info->options, LWS_SERVER_OPTION_WSI_SLAB)) {
+		context->mt_slab_wsi = lws_metric_create(context, 0,
+							 "n.slab.wsi");
+		context->mt_slab_pss = lws_metric_create(context, 0,
+							 "n.slab.pss");
+	}
+
+#if defined(LWS_WITH_SERVER)
+	context->mth_accept_batch = lws_metric_create(context,
+					LWSMTFL_REPORT_HIST, "n.srv.accept");
+#endif
+
 #if defined(LWS_WITH_CLIENT)
 
 	context->mt_conn_dns = lws_metric_create(context,
@@ -1182,6 +1233,14 @@ lws_create_context(const struct lws_context_creation_info *info)
 			context->fd_limit_per_thread = context->max_fds /
 							context->count_threads;
 
+#if defined(LWS_WITH_NETWORK)
+	if (lws_check_opt(info->options, LWS_SERVER_OPTION_WSI_SLAB))
+		context->wsi_slab_depth = info->wsi_slab_depth ?
+						info->wsi_slab_depth : 1024;
+	context->accept_budget = info->accept_budget ?
+					info->accept_budget : 64;
+#endif
+
 #if defined(LWS_WITH_SYS_SMD)
 	lws_mutex_init(context->smd.lock_messages);
 	lws_mutex_init(context->smd.lock_peers);
@@ -1882,6 +1941,12 @@ lws_pt_destroy(struct lws_context_per_thread *pt)
 	}
 	vpt->foreign_pfd_list = NULL;
 
+	/*
+	 * give any undelivered lws_pt_msg_post() messages back to be freed,
+	 * and refuse any more from now, if closing the pipe didn't already
+	 */
+	lws_pt_msg_drain(pt, 1);
+
 	lws_pt_lock(pt, __func__);
 
 	lws_start_foreach_dll_safe(struct lws_dll2 *, d, d1,
@@ -1926,6 +1991,9 @@ lws_pt_destroy(struct lws_context_per_thread *pt)
 
 #endif
 
+	lws_buflist_pool_destroy(&pt->buflist_pool);
+	lws_pt_slab_destroy(pt);
+
 	lws_pt_unlock(pt);
 	pt->pipe_wsi = NULL;
 
@@ -2224,6 +2292,8 @@ next:
 		while (context->vhost_pending_destruction_list)
 			/* removes itself from list */
 			__lws_vhost_destroy2(context->vhost_pending_destruction_list);
+
+		lws_free_set_NULL(context->vh_name_hash);
 #endif
 
 #if defined(LWS_WITH_NETWORK)
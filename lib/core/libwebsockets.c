@@ -115,6 +115,17 @@ lws_vbi_decode(const void *buf, uint64_t *value, size_t len)
 	return 0;
 }
 
+uint32_t
+lws_fnv1a32(uint32_t h, const void *buf, size_t len)
+{
+	const uint8_t *p = (const uint8_t *)buf;
+
+	while (len--)
+		h = (h ^ *p++) * 0x01000193u;
+
+	return h;
+}
+
 signed char char_to_hex(const char c)
 {
 	if (c >= '0' && c <= '9')
@@ -323,6 +323,43 @@ struct lws_ring {
 	uint32_t oldest_tail;
 };
 
+typedef struct lws_buflist {
+	struct lws_buflist			*next;
+	struct lws_buflist			*tail; /* only valid in head seg */
+	struct lws_buflist_pool			*pool; /* NULL if not pooled */
+	size_t					len;
+	size_t					pos;
+	size_t					size; /* payload allocation */
+	unsigned char				awaiting_eom;
+	unsigned char				src_channel;
+	unsigned char				coalesce; /* may grow into slack */
+	unsigned char				sclass;
+} lws_buflist_t;
+
+/*
+ * Per-pt cache of freed buflist segments in a few common payload sizes, so
+ * busy connections buffering output aren't continuously going to the heap.
+ * Only touched from the pt service thread.
+ */
+
+#define LWS_BUFLIST_POOL_CLASSES		3
+#define LWS_BUFLIST_POOL_DEPTH			8
+
+typedef struct lws_buflist_pool {
+	struct lws_buflist			*free[LWS_BUFLIST_POOL_CLASSES];
+	uint8_t					count[LWS_BUFLIST_POOL_CLASSES];
+	uint8_t					destroyed;
+} lws_buflist_pool_t;
+
+/* flags for __lws_buflist_append() */
+#define LWSBLAF_COALESCE			(1 << 0)
+
+int
+__lws_buflist_append(struct lws_buflist **head, const uint8_t *buf, size_t len,
+		     lws_buflist_pool_t *pool, int flags);
+void
+lws_buflist_pool_destroy(lws_buflist_pool_t *pool);
+
 struct lws_protocols;
 struct lws;
 
@@ -439,14 +476,6 @@ typedef struct lws_ss_sinks {
 } lws_ss_sinks_t;
 #endif
 
-typedef struct lws_buflist {
-	struct lws_buflist			*next;
-	size_t					len;
-	size_t					pos;
-	unsigned char				awaiting_eom;
-	unsigned char				src_channel;
-} lws_buflist_t;
-
 
 /*
  * the rest is managed per-context, that includes
@@ -536,6 +565,11 @@ struct lws_context {
 	lws_dll2_owner_t		owner_vh_being_destroyed;
 
 	lws_metric_t			*mt_service; /* doing service */
+#if defined(LWS_WITH_SYS_METRICS)
+	lws_metric_t			*mt_slab_wsi; /* wsi from pt cache */
+	lws_metric_t			*mt_slab_pss; /* pss from pt cache */
+	lws_metric_t			*mth_accept_batch; /* accepts per listen wake */
+#endif
 	const lws_metric_policy_t	*metrics_policies;
 	const char			*metrics_prefix;
 
@@ -626,6 +660,7 @@ struct lws_context {
 	struct lws_vhost		*no_listener_vhost_list;
 	struct lws_vhost		*vhost_pending_destruction_list;
 	struct lws_vhost		*vhost_system;
+	lws_dll2_owner_t		*vh_name_hash; /* by vh name */
 
 #if defined(LWS_WITH_SERVER)
 	const char			*server_string;
@@ -779,6 +814,8 @@ struct lws_context {
 #endif
 
 	unsigned int fd_limit_per_thread;
+	unsigned int wsi_slab_depth; /* 0 = no wsi / pss caching */
+	unsigned int accept_budget; /* max accepts per listen socket wake */
 	unsigned int timeout_secs;
 	unsigned int pt_serv_buf_size;
 	unsigned int max_http_header_data;
@@ -787,6 +824,11 @@ struct lws_context {
 	int simultaneous_ssl;
 	int simultaneous_ssl_handshake_restriction;
 	int simultaneous_ssl_handshake;
+#if defined(LWS_WITH_NETWORK)
+	uint32_t vh_name_hash_size;	/* buckets, power of 2 */
+	uint32_t vh_name_hash_count;	/* vhosts in the hash */
+	uint32_t vh_seq;		/* next vhost creation seq */
+#endif
 #if defined(LWS_WITH_TLS_JIT_TRUST)
 	int		vh_idle_grace_ms;
 #endif
@@ -1165,6 +1207,12 @@ lws_plat_user_colon_group_to_ids(const char *u_colon_g, uid_t *puid, gid_t *pgid
 int
 lws_plat_ntpclient_config(struct lws_context *context);
 
+#if defined(LWS_HAVE_SENDFILE)
+int
+lws_plat_file_sendfile(lws_fop_fd_t fop_fd, lws_sockfd_type sock,
+		       lws_filepos_t *amount, lws_filepos_t len);
+#endif
+
 int
 lws_plat_ifname_to_hwaddr(int fd, const char *ifname, uint8_t *hwaddr, int len);
 
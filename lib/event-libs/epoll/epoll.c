@@ -0,0 +1,402 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Built-in Linux epoll() event loop.
+ *
+ * Unlike the other event libs, this doesn't own the loop: it plugs into the
+ * default unix service loop via .service_wait, replacing the poll() wait.  So
+ * sul, forced service, foreign thread pollfd changes and lws_service()
+ * semantics are all exactly as with poll(), but the wait costs O(ready fds)
+ * instead of O(all fds).
+ *
+ * pt->fds[] is still maintained by the core as usual, pfd->events there is
+ * the authoritative idea of what lws wants for the fd.  We keep one byte per
+ * fd recording what we told the kernel, so we only call epoll_ctl() when that
+ * actually changes.
+ */
+
+#include <private-lib-core.h>
+#include "private-lib-event-libs-epoll.h"
+
+#define pt_to_priv_epoll(_pt) ((struct lws_pt_eventlibs_epoll *)(_pt)->evlib_pt)
+
+static uint32_t
+lws_epoll_events(struct lws_pt_eventlibs_epoll *ep, uint8_t st)
+{
+	uint32_t e = 0;
+
+	if (st & LWSEPS_IN)
+		e |= EPOLLIN;
+	if (st & LWSEPS_OUT)
+		e |= EPOLLOUT;
+#if defined(EPOLLEXCLUSIVE)
+	if (st & LWSEPS_EXCLUSIVE)
+		return e | EPOLLEXCLUSIVE;
+#endif
+	if (ep->edge)
+		e |= EPOLLET;
+
+	return e;
+}
+
+/*
+ * Make the kernel registration for fd match st.  EPOLLEXCLUSIVE can only be
+ * applied at EPOLL_CTL_ADD time, so any change to those means DEL + ADD.
+ */
+
+static int
+lws_epoll_apply(struct lws_pt_eventlibs_epoll *ep, int fd, uint8_t *pst,
+		uint8_t st)
+{
+	struct epoll_event ev;
+	int op = EPOLL_CTL_MOD;
+
+	memset(&ev, 0, sizeof(ev));
+	ev.data.fd = fd;
+	ev.events = lws_epoll_events(ep, st);
+
+	if (!(*pst & LWSEPS_REGISTERED))
+		op = EPOLL_CTL_ADD;
+	else
+		if (st & LWSEPS_EXCLUSIVE) {
+			epoll_ctl(ep->epfd, EPOLL_CTL_DEL, fd, &ev);
+			op = EPOLL_CTL_ADD;
+		}
+
+	if (epoll_ctl(ep->epfd, op, fd, &ev) < 0) {
+		/*
+		 * Our idea of the registration can go stale if an fd was
+		 * closed and reused without passing through the core remove
+		 * path, recover by flipping the op
+		 */
+		if (errno == EEXIST)
+			op = EPOLL_CTL_MOD;
+		else
+			if (errno == ENOENT)
+				op = EPOLL_CTL_ADD;
+			else {
+				lwsl_warn("%s: epoll_ctl fd %d failed: errno %d\n",
+					  __func__, fd, errno);
+				*pst = 0;
+
+				return 1;
+			}
+
+		if (epoll_ctl(ep->epfd, op, fd, &ev) < 0) {
+			lwsl_warn("%s: epoll_ctl fd %d retry failed: errno %d\n",
+				  __func__, fd, errno);
+			*pst = 0;
+
+			return 1;
+		}
+	}
+
+	*pst = (uint8_t)(st | LWSEPS_REGISTERED);
+
+	return 0;
+}
+
+static uint8_t *
+lws_epoll_fdstate(struct lws_context *cx, struct lws_pt_eventlibs_epoll *ep,
+		  lws_sockfd_type fd)
+{
+	int idx = fd - lws_plat_socket_offset();
+
+	if (!ep->fdstate || idx < 0 || (unsigned int)idx >= cx->max_fds)
+		return NULL;
+
+	return &ep->fdstate[idx];
+}
+
+static void
+elops_io_epoll(struct lws *wsi, unsigned int flags)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	struct lws_pt_eventlibs_epoll *ep = pt_to_priv_epoll(pt);
+	uint8_t *pst, st, bits = 0;
+
+	if (ep->epfd < 0 || !lws_socket_is_valid(wsi->desc.sockfd))
+		return;
+
+	pst = lws_epoll_fdstate(wsi->a.context, ep, wsi->desc.sockfd);
+	if (!pst)
+		return;
+
+	if (flags & LWS_EV_READ)
+		bits |= LWSEPS_IN;
+	if (flags & LWS_EV_WRITE)
+		bits |= LWSEPS_OUT;
+
+	if ((flags & LWS_EV_STOP) &&
+	    bits == (LWSEPS_IN | LWSEPS_OUT)) {
+		/* the core is removing the fd from the pt */
+		if (*pst & LWSEPS_REGISTERED) {
+			struct epoll_event ev;
+
+			memset(&ev, 0, sizeof(ev));
+			epoll_ctl(ep->epfd, EPOLL_CTL_DEL, wsi->desc.sockfd,
+				  &ev);
+		}
+		*pst = 0;
+
+		return;
+	}
+
+	st = *pst & (LWSEPS_IN | LWSEPS_OUT);
+	if (flags & LWS_EV_START)
+		st |= bits;
+	else
+		st &= (uint8_t)~bits;
+
+#if defined(LWS_WITH_SERVER)
+	if (ep->exclusive && wsi->listener)
+		st |= LWSEPS_EXCLUSIVE;
+#endif
+
+	if (ep->edge && !(st & LWSEPS_EXCLUSIVE)) {
+		/*
+		 * Edge-triggered: leave the kernel registration alone when
+		 * only dropping interest, stray events are filtered against
+		 * pfd->events when they arrive.  Any START re-arms it with
+		 * exactly what lws wants now, so readiness that arrived while
+		 * we weren't interested is reported again.
+		 */
+		if (!(flags & LWS_EV_START) && (*pst & LWSEPS_REGISTERED))
+			return;
+
+		if (wsi->position_in_fds_table != LWS_NO_FDS_POS) {
+			short e = pt->fds[wsi->position_in_fds_table].events;
+
+			st = (uint8_t)(((e & LWS_POLLIN) ? LWSEPS_IN : 0) |
+				       ((e & LWS_POLLOUT) ? LWSEPS_OUT : 0));
+		}
+	} else
+		if ((*pst & LWSEPS_REGISTERED) &&
+		    st == (*pst & (uint8_t)~LWSEPS_REGISTERED))
+			return; /* the kernel already has it like that */
+
+	lws_epoll_apply(ep, wsi->desc.sockfd, pst, st);
+}
+
+static int
+elops_service_wait_epoll(struct lws_context *context, int timeout_ms, int tsi)
+{
+	struct lws_context_per_thread *pt = &context->pt[tsi];
+	struct lws_pt_eventlibs_epoll *ep = pt_to_priv_epoll(pt);
+	volatile struct lws_context_per_thread *vpt =
+				(volatile struct lws_context_per_thread *)pt;
+	struct lws_pollfd pfd;
+	struct lws *wsi;
+	int n, m, fd;
+
+	n = epoll_wait(ep->epfd, ep->events, LWS_EPOLL_MAX_EVENTS, timeout_ms);
+
+	vpt->inside_poll = 0;
+	lws_memory_barrier();
+
+	if (n < 0) {
+		if (errno != EINTR)
+			lwsl_cx_err(context, "epoll_wait errno %d", errno);
+
+		return 0;
+	}
+
+	/*
+	 * Apply any changes foreign threads queued while we were waiting
+	 * first, before dispatch may close wsi and reorder pt->fds[] under
+	 * the queued fd_index
+	 */
+	lws_plat_service_foreign_pfd_list(pt);
+
+	for (m = 0; m < n; m++) {
+		uint32_t e = ep->events[m].events;
+
+		fd = ep->events[m].data.fd;
+		wsi = wsi_from_fd(context, fd);
+		if (!wsi || wsi->position_in_fds_table == LWS_NO_FDS_POS)
+			/* closed by an earlier dispatch in this batch */
+			continue;
+
+		pfd.fd = fd;
+		pfd.events = pt->fds[wsi->position_in_fds_table].events;
+		pfd.revents = 0;
+		if (e & EPOLLIN)
+			pfd.revents |= LWS_POLLIN;
+		if (e & EPOLLOUT)
+			pfd.revents |= LWS_POLLOUT;
+		if (e & EPOLLHUP)
+			pfd.revents |= LWS_POLLHUP;
+		if (e & EPOLLERR)
+			pfd.revents |= LWS_POLLHUP;
+
+		/* stray edge-triggered events we no longer want */
+		pfd.revents = (short)(pfd.revents &
+				      (pfd.events | LWS_POLLHUP));
+		if (!pfd.revents)
+			continue;
+
+		if (lws_service_fd_tsi(context, &pfd, tsi) < 0)
+			return -1;
+
+		if (ep->edge && (e & EPOLLIN)) {
+			uint8_t *pst;
+
+			/*
+			 * lws reads at most one buffer per POLLIN, there may
+			 * still be data waiting that won't generate a new
+			 * edge.  If lws still wants rx, re-arm so the kernel
+			 * reports it again if so.
+			 */
+			wsi = wsi_from_fd(context, fd);
+			pst = lws_epoll_fdstate(context, ep, fd);
+			if (wsi && pst && (*pst & LWSEPS_REGISTERED) &&
+			    !(*pst & LWSEPS_EXCLUSIVE) &&
+			    wsi->position_in_fds_table != LWS_NO_FDS_POS &&
+			    (pt->fds[wsi->position_in_fds_table].events &
+							      LWS_POLLIN))
+				lws_epoll_apply(ep, fd, pst,
+					(uint8_t)(*pst & (LWSEPS_IN | LWSEPS_OUT)));
+		}
+	}
+
+	/* everything that was ready has been serviced */
+
+	return 0;
+}
+
+static int
+elops_init_pt_epoll(struct lws_context *context, void *_loop, int tsi)
+{
+	struct lws_context_per_thread *pt = &context->pt[tsi];
+	struct lws_pt_eventlibs_epoll *ep = pt_to_priv_epoll(pt);
+	unsigned int n;
+
+	ep->pt = pt;
+	ep->epfd = -1;
+	ep->edge = !!lws_check_opt(context->options,
+				   LWS_SERVER_OPTION_EPOLL_EDGE_TRIGGERED);
+	ep->exclusive = !!lws_check_opt(context->options,
+				   LWS_SERVER_OPTION_EPOLL_EXCLUSIVE_LISTEN);
+#if !defined(EPOLLEXCLUSIVE)
+	if (ep->exclusive) {
+		lwsl_cx_warn(context, "EPOLLEXCLUSIVE unavailable, ignoring");
+		ep->exclusive = 0;
+	}
+#endif
+
+	ep->fdstate = lws_zalloc(context->max_fds, "epoll fdstate");
+	if (!ep->fdstate)
+		return 1;
+
+	ep->epfd = epoll_create1(EPOLL_CLOEXEC);
+	if (ep->epfd < 0) {
+		lwsl_cx_err(context, "epoll_create1 failed: errno %d", errno);
+		lws_free_set_NULL(ep->fdstate);
+
+		return 1;
+	}
+
+	/* pick up anything that was already inserted into the pt */
+
+	for (n = 0; n < pt->fds_count; n++) {
+		struct lws *wsi = wsi_from_fd(context, pt->fds[n].fd);
+
+		if (!wsi)
+			continue;
+
+		if (pt->fds[n].events & LWS_POLLIN)
+			elops_io_epoll(wsi, LWS_EV_START | LWS_EV_READ);
+		if (pt->fds[n].events & LWS_POLLOUT)
+			elops_io_epoll(wsi, LWS_EV_START | LWS_EV_WRITE);
+	}
+
+	lwsl_cx_info(context, "tsi %d: epoll fd %d%s%s", tsi, ep->epfd,
+		     ep->edge ? ", edge-triggered" : "",
+		     ep->exclusive ? ", exclusive listen" : "");
+
+	return 0;
+}
+
+static void
+elops_destroy_pt_epoll(struct lws_context *context, int tsi)
+{
+	struct lws_pt_eventlibs_epoll *ep = pt_to_priv_epoll(&context->pt[tsi]);
+
+	if (ep->fdstate && ep->epfd >= 0) {
+		close(ep->epfd);
+		ep->epfd = -1;
+	}
+
+	lws_free_set_NULL(ep->fdstate);
+}
+
+static int
+elops_foreign_thread_epoll(struct lws_context *cx, int tsi)
+{
+	volatile struct lws_context_per_thread *vpt =
+				(volatile struct lws_context_per_thread *)
+								&cx->pt[tsi];
+
+	/* as for poll(), the service thread can't be calling us from wait */
+
+	return vpt->inside_poll;
+}
+
+const struct lws_event_loop_ops event_loop_ops_epoll = {
+	/* name */			"epoll",
+	/* init_context */		NULL,
+	/* destroy_context1 */		NULL,
+	/* destroy_context2 */		NULL,
+	/* init_vhost_listen_wsi */	NULL,
+	/* init_pt */			elops_init_pt_epoll,
+	/* wsi_logical_close */		NULL,
+	/* check_client_connect_ok */	NULL,
+	/* close_handle_manually */	NULL,
+	/* accept */			NULL,
+	/* io */			elops_io_epoll,
+	/* run_pt */			NULL,
+	/* destroy_pt */		elops_destroy_pt_epoll,
+	/* destroy wsi */		NULL,
+	/* foreign_thread */		elops_foreign_thread_epoll,
+	/* fake_POLLIN */		NULL,
+
+	/* flags */			LELOF_ISPOLL,
+
+	/* evlib_size_ctx */	0,
+	/* evlib_size_pt */	sizeof(struct lws_pt_eventlibs_epoll),
+	/* evlib_size_vh */	0,
+	/* evlib_size_wsi */	0,
+
+	/* service_wait */		elops_service_wait_epoll,
+};
+
+const lws_plugin_evlib_t evlib_epoll = {
+	.hdr = {
+		"epoll",
+		"lws_evlib_plugin",
+		"n/a",
+		LWS_PLUGIN_API_MAGIC
+	},
+
+	.ops	= &event_loop_ops_epoll
+};
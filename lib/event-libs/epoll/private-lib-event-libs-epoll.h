@@ -0,0 +1,48 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <sys/epoll.h>
+
+/* max ready fds we collect from one epoll_wait() */
+#define LWS_EPOLL_MAX_EVENTS 64
+
+/* per-fd state kept in lws_pt_eventlibs_epoll.fdstate[] */
+enum {
+	LWSEPS_REGISTERED			= (1 << 0),
+	LWSEPS_IN				= (1 << 1),
+	LWSEPS_OUT				= (1 << 2),
+	LWSEPS_EXCLUSIVE			= (1 << 3),
+};
+
+struct lws_pt_eventlibs_epoll {
+	struct epoll_event			events[LWS_EPOLL_MAX_EVENTS];
+	struct lws_context_per_thread		*pt;
+	uint8_t					*fdstate; /* by fd */
+	int					epfd;
+
+	uint8_t					edge:1;
+	uint8_t					exclusive:1;
+};
+
+extern const struct lws_event_loop_ops event_loop_ops_epoll;
@@ -25,3 +25,7 @@
  */
 
 
+#if defined(LWS_WITH_IO_URING)
+int
+lws_uring_probe(void);
+#endif
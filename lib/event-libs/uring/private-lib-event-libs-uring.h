@@ -0,0 +1,78 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <linux/io_uring.h>
+
+/* SQ depth, the CQ gets twice this */
+#define LWS_URING_ENTRIES 256
+
+/* per-fd interest bits, in lws_uring_fd.want / .armed */
+enum {
+	LWSURS_IN				= (1 << 0),
+	LWSURS_OUT				= (1 << 1),
+};
+
+/* per-fd flags, in lws_uring_fd.flags */
+enum {
+	LWSURF_DIRTY				= (1 << 0),
+	LWSURF_ACCEPT				= (1 << 1), /* listen fd, the
+							     * kernel accepts */
+};
+
+struct lws_uring_fd {
+	uint32_t				gen; /* of the last POLL_ADD
+						      * or ACCEPT */
+	int32_t					next_dirty;
+	uint8_t					want; /* what lws wants */
+	uint8_t					armed; /* what the kernel has */
+	uint8_t					flags;
+};
+
+struct lws_pt_eventlibs_uring {
+	struct lws_context_per_thread		*pt;
+	struct lws_uring_fd			*fds; /* by fd */
+
+	void					*sq_ring;
+	void					*cq_ring;
+	struct io_uring_sqe			*sqes;
+	size_t					sq_ring_size;
+	size_t					cq_ring_size;
+
+	unsigned int				*sq_head;
+	unsigned int				*sq_tail;
+	unsigned int				*sq_mask;
+	unsigned int				*cq_head;
+	unsigned int				*cq_tail;
+	unsigned int				*cq_mask;
+	struct io_uring_cqe			*cqes;
+
+	unsigned int				sq_entries;
+	int					dirty_head;
+	int					ring_fd;
+
+	uint8_t					no_ms_accept; /* kernel
+							       * said no */
+};
+
+extern const struct lws_event_loop_ops event_loop_ops_uring;
@@ -0,0 +1,711 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ *
+ * Built-in Linux io_uring event loop.
+ *
+ * Like the epoll backend, this plugs into the default unix service loop via
+ * .service_wait, so sul, forced service and lws_service() semantics are the
+ * same as poll().
+ *
+ * Each fd lws is interested in has a oneshot IORING_OP_POLL_ADD outstanding.
+ * Interest changes from the core don't cost a syscall: io() just records
+ * what lws now wants and marks the fd dirty.  Once per service iteration we
+ * turn the dirty fds into POLL_REMOVE / POLL_ADD sqes, plus re-arms for the
+ * fds we serviced last time, and a single io_uring_enter() both submits the
+ * whole batch and waits for completions.
+ *
+ * Oneshot (rather than multishot) polls are used deliberately, lws reads at
+ * most one buffer per POLLIN, so we need the level-triggered behaviour a
+ * fresh poll gives us.
+ *
+ * Listen sockets are different, where the kernel can do it, they have a
+ * multishot IORING_OP_ACCEPT outstanding instead of a poll.  Each connection
+ * it accepts arrives as a completion carrying the new fd, which we hand to
+ * the listen role to filter and adopt, so there's no accept() or re-arm per
+ * connection.  If the kernel is too old for multishot accept, the first
+ * completion is -EINVAL and we go back to polling the listen sockets.
+ *
+ * sqe user_data carries the fd and a per-fd generation, bumped at every
+ * POLL_ADD or ACCEPT, so completions from polls we since removed or replaced,
+ * perhaps for a different file that reused the fd, are recognized and
+ * ignored.
+ */
+
+#include <private-lib-core.h>
+#include "private-lib-event-libs-uring.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#if !defined(__NR_io_uring_setup)
+#define __NR_io_uring_setup	425
+#endif
+#if !defined(__NR_io_uring_enter)
+#define __NR_io_uring_enter	426
+#endif
+
+#define pt_to_priv_uring(_pt) ((struct lws_pt_eventlibs_uring *)(_pt)->evlib_pt)
+
+#define LWS_URING_UD(_fd, _gen) (((uint64_t)(_gen) << 32) | (uint32_t)(_fd))
+#define LWS_URING_UD_REMOVE	(1u << 31)
+#define LWS_URING_UD_ACCEPT	(1u << 30)
+#define LWS_URING_UD_FD_MASK	(LWS_URING_UD_ACCEPT - 1)
+
+#if defined(LWS_WITH_SERVER) && defined(IORING_ACCEPT_MULTISHOT)
+#define LWS_URING_MS_ACCEPT
+#endif
+
+static int
+lws_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int
+lws_uring_enter(int fd, unsigned int to_submit, unsigned int min_complete,
+		unsigned int flags, void *arg, size_t argsz)
+{
+	return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+			    flags, arg, argsz);
+}
+
+/*
+ * Returns 0 if the kernel lets us create a ring with the features we need,
+ * or an errno.  io_uring may be missing, too old, or disabled by sysctl or
+ * a seccomp policy, the caller falls back to poll() then.
+ */
+
+int
+lws_uring_probe(void)
+{
+	struct io_uring_params p;
+	int fd;
+
+	memset(&p, 0, sizeof(p));
+	fd = lws_uring_setup(2, &p);
+	if (fd < 0)
+		return errno ? errno : 1;
+
+	close(fd);
+
+	return (p.features & IORING_FEAT_EXT_ARG) ? 0 : EOPNOTSUPP;
+}
+
+static struct lws_uring_fd *
+lws_uring_fdstate(struct lws_context *cx, struct lws_pt_eventlibs_uring *ur,
+		  lws_sockfd_type fd)
+{
+	int idx = fd - lws_plat_socket_offset();
+
+	if (!ur->fds || idx < 0 || (unsigned int)idx >= cx->max_fds)
+		return NULL;
+
+	return &ur->fds[idx];
+}
+
+/* call with pt lock held */
+
+static void
+lws_uring_mark_dirty(struct lws_pt_eventlibs_uring *ur, struct lws_uring_fd *f)
+{
+	if (f->flags & LWSURF_DIRTY)
+		return;
+
+	f->flags |= LWSURF_DIRTY;
+	f->next_dirty = ur->dirty_head;
+	ur->dirty_head = (int)(f - ur->fds);
+}
+
+/* call with pt lock held */
+
+static struct io_uring_sqe *
+lws_uring_get_sqe(struct lws_pt_eventlibs_uring *ur)
+{
+	unsigned int tail = *ur->sq_tail,
+		     head = __atomic_load_n(ur->sq_head, __ATOMIC_ACQUIRE);
+	struct io_uring_sqe *sqe;
+
+	if (tail - head >= ur->sq_entries) {
+		/* the SQ is full, hand what we have to the kernel early */
+		if (lws_uring_enter(ur->ring_fd, tail - head, 0, 0, NULL, 0) < 0)
+			lwsl_warn("%s: flush failed: errno %d\n", __func__,
+				  errno);
+
+		head = __atomic_load_n(ur->sq_head, __ATOMIC_ACQUIRE);
+		if (tail - head >= ur->sq_entries)
+			return NULL;
+	}
+
+	sqe = &ur->sqes[tail & *ur->sq_mask];
+	memset(sqe, 0, sizeof(*sqe));
+
+	return sqe;
+}
+
+static void
+lws_uring_commit_sqe(struct lws_pt_eventlibs_uring *ur)
+{
+	__atomic_store_n(ur->sq_tail, *ur->sq_tail + 1, __ATOMIC_RELEASE);
+}
+
+static int
+lws_uring_queue_remove(struct lws_pt_eventlibs_uring *ur, int fd,
+		       struct lws_uring_fd *f)
+{
+	struct io_uring_sqe *sqe = lws_uring_get_sqe(ur);
+	uint64_t ud = LWS_URING_UD(fd, f->gen);
+
+	if (!sqe) {
+		lwsl_warn("%s: no sqe for fd %d\n", __func__, fd);
+
+		return 1;
+	}
+
+	/* a multishot accept is cancelled, a poll is removed */
+
+	if (f->flags & LWSURF_ACCEPT) {
+		sqe->opcode	= IORING_OP_ASYNC_CANCEL;
+		ud		|= LWS_URING_UD_ACCEPT;
+	} else
+		sqe->opcode	= IORING_OP_POLL_REMOVE;
+	sqe->fd		= -1;
+	sqe->addr	= ud;
+	sqe->user_data	= ud | LWS_URING_UD_REMOVE;
+	lws_uring_commit_sqe(ur);
+
+	f->armed = 0;
+
+	return 0;
+}
+
+static int
+lws_uring_queue_add(struct lws_pt_eventlibs_uring *ur, int fd,
+		    struct lws_uring_fd *f)
+{
+	struct io_uring_sqe *sqe = lws_uring_get_sqe(ur);
+	uint32_t e = 0;
+
+	if (!sqe) {
+		lwsl_warn("%s: no sqe for fd %d\n", __func__, fd);
+
+		return 1;
+	}
+
+	if (f->want & LWSURS_IN)
+		e |= POLLIN;
+	if (f->want & LWSURS_OUT)
+		e |= POLLOUT;
+#if __BYTE_ORDER == __BIG_ENDIAN
+	/* the kernel reads poll32_events halfword-swapped on BE */
+	e = (e << 16) | (e >> 16);
+#endif
+
+	f->gen++;
+
+	sqe->opcode		= IORING_OP_POLL_ADD;
+	sqe->fd			= fd;
+	sqe->poll32_events	= e;
+	sqe->user_data		= LWS_URING_UD(fd, f->gen);
+	lws_uring_commit_sqe(ur);
+
+	f->armed = f->want;
+
+	return 0;
+}
+
+#if defined(LWS_URING_MS_ACCEPT)
+static int
+lws_uring_queue_accept(struct lws_pt_eventlibs_uring *ur, int fd,
+		       struct lws_uring_fd *f)
+{
+	struct io_uring_sqe *sqe = lws_uring_get_sqe(ur);
+
+	if (!sqe) {
+		lwsl_warn("%s: no sqe for fd %d\n", __func__, fd);
+
+		return 1;
+	}
+
+	f->gen++;
+
+	/*
+	 * The peer address would be overwritten by each accept before we
+	 * might look at it, so we don't ask for it
+	 */
+
+	sqe->opcode		= IORING_OP_ACCEPT;
+	sqe->fd			= fd;
+	sqe->ioprio		= IORING_ACCEPT_MULTISHOT;
+	sqe->accept_flags	= SOCK_NONBLOCK | SOCK_CLOEXEC;
+	sqe->user_data		= LWS_URING_UD(fd, f->gen) | LWS_URING_UD_ACCEPT;
+	lws_uring_commit_sqe(ur);
+
+	f->armed = LWSURS_IN;
+
+	return 0;
+}
+#endif
+
+/*
+ * Turn everything marked dirty since the last time into sqes.  Call with
+ * pt lock held.
+ */
+
+static void
+lws_uring_apply_dirty(struct lws_pt_eventlibs_uring *ur)
+{
+	while (ur->dirty_head >= 0) {
+		struct lws_uring_fd *f = &ur->fds[ur->dirty_head];
+		int fd = ur->dirty_head + lws_plat_socket_offset();
+
+		ur->dirty_head = f->next_dirty;
+		f->flags &= (uint8_t)~LWSURF_DIRTY;
+
+		if (f->armed == f->want)
+			continue;
+
+		if (f->armed && lws_uring_queue_remove(ur, fd, f))
+			continue;
+
+		if (!f->want)
+			continue;
+
+#if defined(LWS_URING_MS_ACCEPT)
+		if (f->flags & LWSURF_ACCEPT) {
+			lws_uring_queue_accept(ur, fd, f);
+			continue;
+		}
+#endif
+		lws_uring_queue_add(ur, fd, f);
+	}
+}
+
+static void
+elops_io_uring(struct lws *wsi, unsigned int flags)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	struct lws_pt_eventlibs_uring *ur = pt_to_priv_uring(pt);
+	struct lws_uring_fd *f;
+	uint8_t bits = 0;
+
+	if (ur->ring_fd < 0 || !lws_socket_is_valid(wsi->desc.sockfd))
+		return;
+
+	f = lws_uring_fdstate(wsi->a.context, ur, wsi->desc.sockfd);
+	if (!f)
+		return;
+
+	if (flags & LWS_EV_READ)
+		bits |= LWSURS_IN;
+	if (flags & LWS_EV_WRITE)
+		bits |= LWSURS_OUT;
+
+	lws_pt_lock(pt, __func__);
+
+#if defined(LWS_URING_MS_ACCEPT)
+	if (!f->want && !f->armed) {
+		/* fresh use of the fd, does the kernel accept for it? */
+		f->flags = (uint8_t)(f->flags & ~LWSURF_ACCEPT);
+		if (wsi->role_ops == &role_ops_listen && !ur->no_ms_accept)
+			f->flags |= LWSURF_ACCEPT;
+	}
+
+	if (f->flags & LWSURF_ACCEPT)
+		/* the accept stands for POLLIN, listen has no use for POLLOUT */
+		bits &= LWSURS_IN;
+#endif
+
+	if ((flags & LWS_EV_STOP) && (flags & LWS_EV_READ) &&
+	    (flags & LWS_EV_WRITE)) {
+		/*
+		 * The core is removing the fd from the pt, it's likely about
+		 * to be closed and the fd number reused.  An outstanding poll
+		 * pins the old file, so it must be removed by its user_data
+		 * now rather than waiting to see what the fd is used for next
+		 */
+		if (f->armed)
+			lws_uring_queue_remove(ur, wsi->desc.sockfd, f);
+		f->want = 0;
+	} else {
+		if (flags & LWS_EV_START)
+			f->want |= bits;
+		else
+			f->want &= (uint8_t)~bits;
+
+		lws_uring_mark_dirty(ur, f);
+	}
+
+	lws_pt_unlock(pt);
+}
+
+#if defined(LWS_URING_MS_ACCEPT)
+/*
+ * A completion from the multishot accept on listen socket fd.  res is the
+ * new connection's fd, or -errno.
+ */
+
+static void
+lws_uring_accepted(struct lws_context *cx, struct lws_pt_eventlibs_uring *ur,
+		   struct lws_uring_fd *f, int fd, uint32_t gen, int32_t res,
+		   uint32_t cflags)
+{
+	struct lws_context_per_thread *pt = ur->pt;
+	struct lws *wsi;
+
+	lws_pt_lock(pt, __func__);
+	if (f && (f->flags & LWSURF_ACCEPT) && f->armed && f->gen == gen) {
+		if (res == -EINVAL) {
+			/* the kernel can't do multishot accept, poll instead */
+			lwsl_cx_info(cx, "no multishot accept, polling");
+			ur->no_ms_accept = 1;
+			f->flags = (uint8_t)(f->flags & ~LWSURF_ACCEPT);
+		}
+
+		if (!(cflags & IORING_CQE_F_MORE)) {
+			/* it stopped, eg, on an error, re-arm if still wanted */
+			f->armed = 0;
+			lws_uring_mark_dirty(ur, f);
+		}
+	}
+	lws_pt_unlock(pt);
+
+	if (res < 0) {
+		if (res != -ECANCELED && res != -EINVAL)
+			lwsl_cx_info(cx, "accept on fd %d: %d", fd, (int)res);
+
+		return;
+	}
+
+	/*
+	 * It may have been accepted after we asked to cancel it, it's still a
+	 * real connection, so adopt it if the listen wsi is still there
+	 */
+
+	wsi = wsi_from_fd(cx, fd);
+	if (!wsi || wsi->role_ops != &role_ops_listen) {
+		compatible_close(res);
+
+		return;
+	}
+
+	if (lws_listen_accepted(wsi, res) == LWS_HPI_RET_PLEASE_CLOSE_ME)
+		lws_close_free_wsi(wsi, LWS_CLOSE_STATUS_NOSTATUS,
+				   "close_and_handled");
+}
+#endif
+
+static int
+elops_service_wait_uring(struct lws_context *context, int timeout_ms, int tsi)
+{
+	struct lws_context_per_thread *pt = &context->pt[tsi];
+	struct lws_pt_eventlibs_uring *ur = pt_to_priv_uring(pt);
+	volatile struct lws_context_per_thread *vpt =
+				(volatile struct lws_context_per_thread *)pt;
+	struct io_uring_getevents_arg arg;
+	struct __kernel_timespec ts;
+	unsigned int to_submit, head;
+	struct lws_pollfd pfd;
+	struct lws_uring_fd *f;
+	struct lws *wsi;
+	int n;
+
+	lws_pt_lock(pt, __func__);
+	lws_uring_apply_dirty(ur);
+	to_submit = *ur->sq_tail - __atomic_load_n(ur->sq_head,
+						     __ATOMIC_ACQUIRE);
+	lws_pt_unlock(pt);
+
+	memset(&arg, 0, sizeof(arg));
+	arg.sigmask_sz = _NSIG / 8;
+	if (timeout_ms) {
+		ts.tv_sec = timeout_ms / 1000;
+		ts.tv_nsec = (timeout_ms % 1000) * 1000000ll;
+		arg.ts = (uint64_t)(uintptr_t)&ts;
+	}
+
+	/* submit the whole batch and wait, in one syscall */
+
+	n = lws_uring_enter(ur->ring_fd, to_submit, timeout_ms ? 1 : 0,
+			    IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+			    &arg, sizeof(arg));
+
+	vpt->inside_poll = 0;
+	lws_memory_barrier();
+
+	if (n < 0 && errno != EINTR && errno != ETIME && errno != EBUSY &&
+	    errno != EAGAIN)
+		lwsl_cx_err(context, "io_uring_enter errno %d", errno);
+
+	/* as for epoll, apply foreign thread changes before any dispatch */
+	lws_plat_service_foreign_pfd_list(pt);
+
+	head = *ur->cq_head;
+	while (head != __atomic_load_n(ur->cq_tail, __ATOMIC_ACQUIRE)) {
+		struct io_uring_cqe *cqe = &ur->cqes[head & *ur->cq_mask];
+		uint64_t ud = cqe->user_data;
+		int32_t res = cqe->res;
+		int fd;
+
+		/* let the kernel reuse the slot while we dispatch */
+		__atomic_store_n(ur->cq_head, ++head, __ATOMIC_RELEASE);
+
+		if (ud & LWS_URING_UD_REMOVE)
+			continue;
+
+		fd = (int)(ud & LWS_URING_UD_FD_MASK);
+		f = lws_uring_fdstate(context, ur, fd);
+
+#if defined(LWS_URING_MS_ACCEPT)
+		if (ud & LWS_URING_UD_ACCEPT) {
+			lws_uring_accepted(context, ur, f, fd,
+					   (uint32_t)(ud >> 32), res,
+					   cqe->flags);
+			continue;
+		}
+#endif
+
+		lws_pt_lock(pt, __func__);
+		if (!f || !f->armed || f->gen != (uint32_t)(ud >> 32)) {
+			/* removed, replaced or cancelled since */
+			lws_pt_unlock(pt);
+			continue;
+		}
+
+		/* the oneshot poll is spent, re-arm next time if still wanted */
+		f->armed = 0;
+		lws_uring_mark_dirty(ur, f);
+		lws_pt_unlock(pt);
+
+		wsi = wsi_from_fd(context, fd);
+		if (!wsi || wsi->position_in_fds_table == LWS_NO_FDS_POS)
+			continue;
+
+		pfd.fd = fd;
+		pfd.events = pt->fds[wsi->position_in_fds_table].events;
+		pfd.revents = 0;
+		if (res < 0)
+			pfd.revents = LWS_POLLHUP;
+		else {
+			if (res & POLLIN)
+				pfd.revents |= LWS_POLLIN;
+			if (res & POLLOUT)
+				pfd.revents |= LWS_POLLOUT;
+			if (res & (POLLHUP | POLLERR))
+				pfd.revents |= LWS_POLLHUP;
+		}
+
+		pfd.revents = (short)(pfd.revents & (pfd.events | LWS_POLLHUP));
+		if (!pfd.revents)
+			continue;
+
+		if (lws_service_fd_tsi(context, &pfd, tsi) < 0)
+			return -1;
+	}
+
+	/* everything that was ready has been serviced */
+
+	return 0;
+}
+
+static void
+lws_uring_unmap(struct lws_pt_eventlibs_uring *ur)
+{
+	if (ur->sqes)
+		munmap(ur->sqes, ur->sq_entries * sizeof(struct io_uring_sqe));
+	if (ur->cq_ring && ur->cq_ring != ur->sq_ring)
+		munmap(ur->cq_ring, ur->cq_ring_size);
+	if (ur->sq_ring)
+		munmap(ur->sq_ring, ur->sq_ring_size);
+
+	ur->sqes = NULL;
+	ur->cq_ring = ur->sq_ring = NULL;
+}
+
+static int
+elops_init_pt_uring(struct lws_context *context, void *_loop, int tsi)
+{
+	struct lws_context_per_thread *pt = &context->pt[tsi];
+	struct lws_pt_eventlibs_uring *ur = pt_to_priv_uring(pt);
+	struct io_uring_params p;
+	unsigned int n;
+	void *m;
+
+	ur->pt = pt;
+	ur->ring_fd = -1;
+	ur->dirty_head = -1;
+
+	ur->fds = lws_zalloc(context->max_fds * sizeof(*ur->fds),
+			     "uring fdstate");
+	if (!ur->fds)
+		return 1;
+
+	memset(&p, 0, sizeof(p));
+	ur->ring_fd = lws_uring_setup(LWS_URING_ENTRIES, &p);
+	if (ur->ring_fd < 0) {
+		lwsl_cx_err(context, "io_uring_setup failed: errno %d", errno);
+		goto bail;
+	}
+
+	ur->sq_entries = p.sq_entries;
+	ur->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+	ur->cq_ring_size = p.cq_off.cqes +
+				p.cq_entries * sizeof(struct io_uring_cqe);
+	if (p.features & IORING_FEAT_SINGLE_MMAP) {
+		if (ur->cq_ring_size > ur->sq_ring_size)
+			ur->sq_ring_size = ur->cq_ring_size;
+		ur->cq_ring_size = ur->sq_ring_size;
+	}
+
+	m = mmap(NULL, ur->sq_ring_size, PROT_READ | PROT_WRITE,
+		 MAP_SHARED | MAP_POPULATE, ur->ring_fd, IORING_OFF_SQ_RING);
+	if (m == MAP_FAILED)
+		goto bail_mmap;
+	ur->sq_ring = m;
+
+	if (p.features & IORING_FEAT_SINGLE_MMAP)
+		ur->cq_ring = ur->sq_ring;
+	else {
+		m = mmap(NULL, ur->cq_ring_size, PROT_READ | PROT_WRITE,
+			 MAP_SHARED | MAP_POPULATE, ur->ring_fd,
+			 IORING_OFF_CQ_RING);
+		if (m == MAP_FAILED)
+			goto bail_mmap;
+		ur->cq_ring = m;
+	}
+
+	m = mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+		 PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+		 ur->ring_fd, IORING_OFF_SQES);
+	if (m == MAP_FAILED)
+		goto bail_mmap;
+	ur->sqes = m;
+
+	ur->sq_head = (unsigned int *)((uint8_t *)ur->sq_ring + p.sq_off.head);
+	ur->sq_tail = (unsigned int *)((uint8_t *)ur->sq_ring + p.sq_off.tail);
+	ur->sq_mask = (unsigned int *)((uint8_t *)ur->sq_ring +
+							p.sq_off.ring_mask);
+	ur->cq_head = (unsigned int *)((uint8_t *)ur->cq_ring + p.cq_off.head);
+	ur->cq_tail = (unsigned int *)((uint8_t *)ur->cq_ring + p.cq_off.tail);
+	ur->cq_mask = (unsigned int *)((uint8_t *)ur->cq_ring +
+							p.cq_off.ring_mask);
+	ur->cqes = (struct io_uring_cqe *)((uint8_t *)ur->cq_ring +
+							p.cq_off.cqes);
+
+	/* sqe slot i is always at SQ array index i */
+	for (n = 0; n < p.sq_entries; n++)
+		((unsigned int *)((uint8_t *)ur->sq_ring + p.sq_off.array))[n] = n;
+
+	/* pick up anything that was already inserted into the pt */
+
+	for (n = 0; n < pt->fds_count; n++) {
+		struct lws *wsi = wsi_from_fd(context, pt->fds[n].fd);
+
+		if (!wsi)
+			continue;
+
+		if (pt->fds[n].events & LWS_POLLIN)
+			elops_io_uring(wsi, LWS_EV_START | LWS_EV_READ);
+		if (pt->fds[n].events & LWS_POLLOUT)
+			elops_io_uring(wsi, LWS_EV_START | LWS_EV_WRITE);
+	}
+
+	lwsl_cx_info(context, "tsi %d: io_uring fd %d, %u sq entries", tsi,
+		     ur->ring_fd, ur->sq_entries);
+
+	return 0;
+
+bail_mmap:
+	lwsl_cx_err(context, "io_uring mmap failed: errno %d", errno);
+	lws_uring_unmap(ur);
+	close(ur->ring_fd);
+	ur->ring_fd = -1;
+bail:
+	lws_free_set_NULL(ur->fds);
+
+	return 1;
+}
+
+static void
+elops_destroy_pt_uring(struct lws_context *context, int tsi)
+{
+	struct lws_pt_eventlibs_uring *ur =
+				pt_to_priv_uring(&context->pt[tsi]);
+
+	if (ur->fds && ur->ring_fd >= 0) {
+		lws_uring_unmap(ur);
+		close(ur->ring_fd);
+		ur->ring_fd = -1;
+	}
+
+	lws_free_set_NULL(ur->fds);
+}
+
+static int
+elops_foreign_thread_uring(struct lws_context *cx, int tsi)
+{
+	volatile struct lws_context_per_thread *vpt =
+				(volatile struct lws_context_per_thread *)
+								&cx->pt[tsi];
+
+	return vpt->inside_poll;
+}
+
+const struct lws_event_loop_ops event_loop_ops_uring = {
+	/* name */			"io_uring",
+	/* init_context */		NULL,
+	/* destroy_context1 */		NULL,
+	/* destroy_context2 */		NULL,
+	/* init_vhost_listen_wsi */	NULL,
+	/* init_pt */			elops_init_pt_uring,
+	/* wsi_logical_close */		NULL,
+	/* check_client_connect_ok */	NULL,
+	/* close_handle_manually */	NULL,
+	/* accept */			NULL,
+	/* io */			elops_io_uring,
+	/* run_pt */			NULL,
+	/* destroy_pt */		elops_destroy_pt_uring,
+	/* destroy wsi */		NULL,
+	/* foreign_thread */		elops_foreign_thread_uring,
+	/* fake_POLLIN */		NULL,
+
+	/* flags */			LELOF_ISPOLL,
+
+	/* evlib_size_ctx */	0,
+	/* evlib_size_pt */	sizeof(struct lws_pt_eventlibs_uring),
+	/* evlib_size_vh */	0,
+	/* evlib_size_wsi */	0,
+
+	/* service_wait */		elops_service_wait_uring,
+};
+
+const lws_plugin_evlib_t evlib_uring = {
+	.hdr = {
+		"io_uring",
+		"lws_evlib_plugin",
+		"n/a",
+		LWS_PLUGIN_API_MAGIC
+	},
+
+	.ops	= &event_loop_ops_uring
+};
@@ -609,7 +609,8 @@ lws_threadpool_worker(void *d)
 
 			pthread_mutex_lock(&tp->lock); /* =================== tp lock */
 
-			if (tp->destroying || !task_to_wsi(task)) { /* cov */
+			if (tp->destroying || (!task_to_wsi(task) &&
+					       !task->args.async_task)) { /* cov */
 				lwsl_info("%s: stopping on wsi gone\n", __func__);
 				state_transition(task, LWS_TP_STATUS_STOPPING);
 			}
@@ -1008,7 +1009,9 @@ lws_threadpool_enqueue(struct lws_threadpool *tp,
 	pthread_mutex_lock(&tp->lock); /* ======================== tpool lock */
 
 #if defined(LWS_WITH_SECURE_STREAMS)
-	assert(args->ss || args->wsi);
+	assert(args->ss || args->wsi || args->async_task);
+#else
+	assert(args->wsi || args->async_task);
 #endif
 
 	if (tp->destroying)
@@ -1055,7 +1058,8 @@ lws_threadpool_enqueue(struct lws_threadpool *tp,
 
 	/*
 	 * mark the wsi itself as depending on this tp (so wsi close for
-	 * whatever reason can clean up)
+	 * whatever reason can clean up)... an async task may have none, it
+	 * reaps itself when it's done
 	 */
 
 #if defined(LWS_WITH_SECURE_STREAMS)
@@ -1063,6 +1067,7 @@ lws_threadpool_enqueue(struct lws_threadpool *tp,
 		lws_dll2_add_tail(&task->list, &args->ss->wsi->tp_task_owner);
 	else
 #endif
+	if (args->wsi)
 		lws_dll2_add_tail(&task->list, &args->wsi->tp_task_owner);
 
 	lwsl_thread("%s: tp %s: enqueued task %p (%s) for %s, depth %d\n",
@@ -34,6 +34,9 @@
 #include <dlfcn.h>
 #endif
 #include <dirent.h>
+#if defined(LWS_HAVE_SENDFILE)
+#include <sys/sendfile.h>
+#endif
 
 int lws_plat_apply_FD_CLOEXEC(int n)
 {
@@ -165,6 +168,40 @@ _lws_plat_file_read(lws_fop_fd_t fop_fd, lws_filepos_t *amount,
 	return 0;
 }
 
+#if defined(LWS_HAVE_SENDFILE)
+/*
+ * Send up to len bytes of the file from its current position directly to the
+ * socket, without them passing through userland.  *amount is 0 if the socket
+ * couldn't take anything right now.
+ */
+
+int
+lws_plat_file_sendfile(lws_fop_fd_t fop_fd, lws_sockfd_type sock,
+		       lws_filepos_t *amount, lws_filepos_t len)
+{
+	ssize_t n;
+
+	*amount = 0;
+
+	/* NULL offset: use and advance the fd position like read() does */
+	n = sendfile(sock, (int)fop_fd->fd, NULL, (size_t)len);
+	if (n < 0) {
+		if (LWS_ERRNO == LWS_EAGAIN || LWS_ERRNO == LWS_EINTR)
+			return 0;
+
+		return -1;
+	}
+	if (!n && len)
+		/* the file got shorter than we thought */
+		return -1;
+
+	fop_fd->pos = (lws_filepos_t)(fop_fd->pos + (lws_filepos_t)n);
+	*amount = (lws_filepos_t)n;
+
+	return 0;
+}
+#endif
+
 int
 _lws_plat_file_write(lws_fop_fd_t fop_fd, lws_filepos_t *amount,
 		     uint8_t *buf, lws_filepos_t len)
@@ -33,6 +33,8 @@ lws_plat_pipe_create(struct lws *wsi)
 	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
 	int n;
 
+	pt->wake_pending = 0;
+
 #if defined(LWS_HAVE_EVENTFD)
 	pt->dummy_pipe_fds[0] = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
 	pt->dummy_pipe_fds[1] = -1;
@@ -67,16 +69,32 @@ lws_plat_pipe_signal(struct lws_context *ctx, int tsi)
 	struct lws_context_per_thread *pt = &ctx->pt[tsi];
 #if defined(LWS_HAVE_EVENTFD)
 	eventfd_t value = 1;
-
-	return eventfd_write(pt->dummy_pipe_fds[0], value);
 #else
 	char buf = 0;
+#endif
 	int n;
 
-	n = (int)write(pt->dummy_pipe_fds[1], &buf, 1);
+	__atomic_fetch_add(&pt->wake_requested, 1, __ATOMIC_RELAXED);
+
+	/*
+	 * If somebody already signalled since the service thread last
+	 * consumed the pipe, it hasn't run yet and will see our work too
+	 */
+	if (__atomic_exchange_n(&pt->wake_pending, 1, __ATOMIC_ACQ_REL))
+		return 0;
+
+	__atomic_fetch_add(&pt->wake_signalled, 1, __ATOMIC_RELAXED);
 
-	return n != 1;
+#if defined(LWS_HAVE_EVENTFD)
+	n = eventfd_write(pt->dummy_pipe_fds[0], value);
+#else
+	n = (int)write(pt->dummy_pipe_fds[1], &buf, 1) != 1;
 #endif
+	if (n)
+		/* no wake is coming, let the next signal try again */
+		__atomic_store_n(&pt->wake_pending, 0, __ATOMIC_RELEASE);
+
+	return n;
 }
 
 void
@@ -66,12 +66,60 @@ _lws_plat_service_forced_tsi(struct lws_context *context, int tsi)
 	return r;
 }
 
+void
+lws_plat_service_foreign_pfd_list(struct lws_context_per_thread *pt)
+{
+	volatile struct lws_context_per_thread *vpt =
+				(volatile struct lws_context_per_thread *)pt;
+	volatile struct lws_foreign_thread_pollfd *ftp, *next;
+
+	/* Collision will be rare and brief.  Spin until it completes */
+	while (vpt->foreign_spinlock)
+		;
+
+	/*
+	 * At this point we are not inside a foreign thread pollfd
+	 * change, and we have marked ourselves as outside the poll()
+	 * wait.  So we are the only guys that can modify the
+	 * lws_foreign_thread_pollfd list on the pt.  Drain the list
+	 * and apply the changes to the affected pollfds in the correct
+	 * order.
+	 */
+
+	lws_pt_lock(pt, __func__);
+
+	ftp = vpt->foreign_pfd_list;
+	//lwsl_notice("cleared list %p\n", ftp);
+	while (ftp) {
+		struct lws *wsi;
+		struct lws_pollfd *pfd;
+
+		next = ftp->next;
+		pfd = &vpt->fds[ftp->fd_index];
+		if (lws_socket_is_valid(pfd->fd)) {
+			wsi = wsi_from_fd(pt->context, pfd->fd);
+			if (wsi)
+				__lws_change_pollfd(wsi, ftp->_and,
+						    ftp->_or);
+		}
+#if defined(LWS_WITH_WAKE_LOGGING)
+		else
+			lwsl_cx_notice(pt->context, "*** WOKE on Invalid fd in foreign pfd list");
+#endif
+		lws_free((void *)ftp);
+		ftp = next;
+	}
+	vpt->foreign_pfd_list = NULL;
+	lws_memory_barrier();
+
+	lws_pt_unlock(pt);
+}
+
 #define LWS_POLL_WAIT_LIMIT 2000000000
 
 int
 _lws_plat_service_tsi(struct lws_context *context, int timeout_ms, int tsi)
 {
-	volatile struct lws_foreign_thread_pollfd *ftp, *next;
 	volatile struct lws_context_per_thread *vpt;
 	struct lws_context_per_thread *pt;
 	lws_usec_t timeout_us, us;
@@ -160,10 +208,21 @@ _lws_plat_service_tsi(struct lws_context *context, int timeout_ms, int tsi)
 #endif
 	vpt->inside_poll = 1;
 	lws_memory_barrier();
-	n = poll(pt->fds, pt->fds_count, (int)timeout_us /* ms now */ );
+	if (context->event_loop_ops->service_wait)
+		n = context->event_loop_ops->service_wait(context,
+						(int)timeout_us /* ms now */, tsi);
+	else
+		n = poll(pt->fds, pt->fds_count, (int)timeout_us /* ms now */ );
 	vpt->inside_poll = 0;
 	lws_memory_barrier();
 
+	if (n < 0 && context->event_loop_ops->service_wait) {
+		/* it already dispatched, and lws_service_fd_tsi() failed */
+		lwsl_cx_err(context, "service_wait failed");
+
+		return -1;
+	}
+
 #if defined(LWS_WITH_SYS_METRICS) || defined(LWS_WITH_WAKE_LOGGING)
 	b = lws_now_usecs();
 #endif
@@ -197,46 +256,7 @@ _lws_plat_service_tsi(struct lws_context *context, int timeout_ms, int tsi)
 	}
 #endif
 
-	/* Collision will be rare and brief.  Spin until it completes */
-	while (vpt->foreign_spinlock)
-		;
-
-	/*
-	 * At this point we are not inside a foreign thread pollfd
-	 * change, and we have marked ourselves as outside the poll()
-	 * wait.  So we are the only guys that can modify the
-	 * lws_foreign_thread_pollfd list on the pt.  Drain the list
-	 * and apply the changes to the affected pollfds in the correct
-	 * order.
-	 */
-
-	lws_pt_lock(pt, __func__);
-
-	ftp = vpt->foreign_pfd_list;
-	//lwsl_notice("cleared list %p\n", ftp);
-	while (ftp) {
-		struct lws *wsi;
-		struct lws_pollfd *pfd;
-
-		next = ftp->next;
-		pfd = &vpt->fds[ftp->fd_index];
-		if (lws_socket_is_valid(pfd->fd)) {
-			wsi = wsi_from_fd(context, pfd->fd);
-			if (wsi)
-				__lws_change_pollfd(wsi, ftp->_and,
-						    ftp->_or);
-		}
-#if defined(LWS_WITH_WAKE_LOGGING)
-		else
-			lwsl_cx_notice(context, "*** WOKE on Invalid fd in foreign pfd list");
-#endif
-		lws_free((void *)ftp);
-		ftp = next;
-	}
-	vpt->foreign_pfd_list = NULL;
-	lws_memory_barrier();
-
-	lws_pt_unlock(pt);
+	lws_plat_service_foreign_pfd_list(pt);
 
 #if (defined(LWS_ROLE_WS) && !defined(LWS_WITHOUT_EXTENSIONS)) || defined(LWS_WITH_TLS)
 	m = 0;
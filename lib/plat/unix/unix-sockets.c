@@ -52,6 +52,10 @@
 
 #include <netinet/ip.h>
 
+#if defined(__linux__)
+#include <linux/filter.h>
+#endif
+
 int
 lws_send_pipe_choked(struct lws *wsi)
 {
@@ -105,6 +109,7 @@ lws_plat_set_nonblocking(lws_sockfd_type fd)
 int
 lws_plat_set_socket_options(struct lws_vhost *vhost, int fd, int unix_skt)
 {
+	int nb_cloexec = unix_skt == LWS_SKT_OPT_ACCEPTED_NB_CLOEXEC;
 	int optval = 1;
 	socklen_t optlen = sizeof(optval);
 
@@ -116,7 +121,10 @@ lws_plat_set_socket_options(struct lws_vhost *vhost, int fd, int unix_skt)
 	struct protoent *tcp_proto;
 #endif
 
-	(void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+	if (nb_cloexec)
+		unix_skt = 0;
+	else
+		(void)fcntl(fd, F_SETFD, FD_CLOEXEC);
 
 	if (!unix_skt && vhost->ka_time) {
 		/* enable keepalive on this socket */
@@ -191,6 +199,9 @@ lws_plat_set_socket_options(struct lws_vhost *vhost, int fd, int unix_skt)
 		return 1;
 #endif
 
+	if (nb_cloexec)
+		return 0;
+
 	return lws_plat_set_nonblocking(fd);
 }
 
@@ -323,6 +334,62 @@ lws_plat_set_socket_options_ip(lws_sockfd_type fd, uint8_t pri, int lws_flags)
 	return ret;
 }
 
+#if defined(__linux__)
+/*
+ * Listener index of count in a SO_REUSEPORT group, one per pt, bound in pt
+ * order so the kernel's index for each socket in the group is its pt.
+ *
+ * The classic BPF program returns the index of the socket that should get the
+ * connection, we make it (cpu the SYN was processed on) % count.  It applies
+ * to the whole group, so attaching it once to the first listener is enough.
+ * If that fails, eg, on kernels before 4.5, fall back to SO_INCOMING_CPU on
+ * each of the vhost's listeners, which newer kernels use to prefer a
+ * listener for connections arriving on that cpu.
+ */
+
+int
+lws_plat_listen_steer_cpu(struct lws_vhost *vh, lws_sockfd_type fd,
+			  int index, int count)
+{
+#if defined(SO_ATTACH_REUSEPORT_CBPF)
+	struct sock_filter code[] = {
+		/* A = cpu the packet is being processed on */
+		{ BPF_LD | BPF_W | BPF_ABS, 0, 0,
+		  (uint32_t)(SKF_AD_OFF + SKF_AD_CPU) },
+		/* A = A % count */
+		{ BPF_ALU | BPF_MOD | BPF_K, 0, 0, (uint32_t)count },
+		/* return A as the group socket index */
+		{ BPF_RET | BPF_A, 0, 0, 0 },
+	};
+	struct sock_fprog prog;
+
+	if (!vh->listen_cbpf_failed) {
+		if (index)
+			return 0;
+
+		prog.len = LWS_ARRAY_SIZE(code);
+		prog.filter = code;
+
+		if (!setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF,
+				&prog, sizeof(prog)))
+			return 0;
+
+		lwsl_notice("%s: SO_ATTACH_REUSEPORT_CBPF failed: errno %d, "
+			    "using SO_INCOMING_CPU\n", __func__, errno);
+		vh->listen_cbpf_failed = 1;
+	}
+#endif
+#if defined(SO_INCOMING_CPU)
+	if (!setsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, &index, sizeof(index)))
+		return 0;
+#endif
+
+	lwsl_notice("%s: unable to steer listener %d\n", __func__, index);
+
+	return 1;
+}
+#endif
+
 /* cast a struct sockaddr_in6 * into addr for ipv6 */
 
 enum {
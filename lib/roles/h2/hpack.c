@@ -193,16 +193,6 @@ static const char * const http2_canned[] = {
 
 #include "huftable.h"
 
-static int huftable_decode(int pos, char c)
-{
-	int q = pos + !!c;
-
-	if (lextable_terms[q >> 3] & (1 << (q & 7))) /* terminal */
-		return lextable[q] | 0x8000;
-
-	return pos + (lextable[q] << 1);
-}
-
 static int lws_frag_start(struct lws *wsi, int hdr_token_idx)
 {
 	struct allocated_headers *ah = wsi->http.ah;
@@ -826,7 +816,7 @@ int lws_hpack_interpret(struct lws *wsi, unsigned char c)
 	struct lws *nwsi = lws_get_network_wsi(wsi);
 	struct lws_h2_netconn *h2n = nwsi->h2.h2n;
 	struct allocated_headers *ah = wsi->http.ah;
-	unsigned int prev;
+	uint32_t f;
 	unsigned char c1;
 	int n, m, plen;
 
@@ -846,8 +836,6 @@ int lws_hpack_interpret(struct lws *wsi, unsigned char c)
 
 	case HPKS_TYPE:
 		h2n->is_first_header_char = 1;
-		h2n->huff_pad = 0;
-		h2n->zero_huff_padding = 0;
 		h2n->last_action_dyntable_resize = 0;
 		h2n->ext_count = 0;
 		h2n->hpack_hdr_len = 0;
@@ -1028,6 +1016,7 @@ int lws_hpack_interpret(struct lws *wsi, unsigned char c)
 	case HPKS_HLEN: /* [ H | 7+ ] */
 		h2n->huff = !!(c & 0x80);
 		h2n->hpack_pos = 0;
+		h2n->huff_pad_bad = 0;
 		h2n->hpack_len = c & 0x7f;
 
 		if (h2n->hpack_len == 0x7f) {
@@ -1108,37 +1097,29 @@ pre_data:
 		//lwsl_header(" 0x%02X huff %d\n", c, h2n->huff);
 			c1 = c;
 
-		for (n = 0; n < 8; n++) {
-			if (h2n->huff) {
-				char b = (c >> 7) & 1;
-				prev = h2n->hpack_pos;
-				h2n->hpack_pos = (uint16_t)huftable_decode(
-						(int)h2n->hpack_pos, b);
-				c = (unsigned char)(c << 1);
-				if (h2n->hpack_pos == 0xffff) {
-					lwsl_notice("Huffman err\n");
-					return 1;
-				}
-				if (!(h2n->hpack_pos & 0x8000)) {
-					if (!b)
-						h2n->zero_huff_padding = 1;
-					h2n->huff_pad++;
-					continue;
-				}
-				c1 = (uint8_t)(h2n->hpack_pos & 0x7fff);
-				h2n->hpack_pos = 0;
-				h2n->huff_pad = 0;
-				h2n->zero_huff_padding = 0;
+		/*
+		 * Huffman is decoded a nibble at a time, no code is shorter
+		 * than 5 bits so each nibble produces at most one char
+		 */
 
+		for (n = 0; n < 2; n++) {
+			if (h2n->huff) {
+				f = huftable[h2n->hpack_pos]
+					    [n ? c & 0xf : c >> 4];
 				/* EOS |11111111|11111111|11111111|111111 */
-				if (!c1 && prev == HUFTABLE_0x100_PREV) {
+				if (f & LWS_HUF_FAIL) {
 					lws_h2_goaway(nwsi,
 						H2_ERR_COMPRESSION_ERROR,
 						"Huffman EOT seen");
 					return 1;
 				}
+				h2n->hpack_pos = (uint16_t)LWS_HUF_STATE(f);
+				h2n->huff_pad_bad = !(f & LWS_HUF_ACCEPT);
+				if (!(f & LWS_HUF_SYM))
+					continue;
+				c1 = LWS_HUF_CHAR(f);
 			} else
-				n = 8;
+				n = 2;
 
 			if (h2n->value) { /* value */
 
@@ -1213,10 +1194,9 @@ swallow:
 		 * is complete.
 		 */
 
-		if (h2n->huff && (h2n->huff_pad > 7 ||
-		    (h2n->zero_huff_padding && h2n->huff_pad))) {
-			lwsl_info("zero_huff_padding: %d huff_pad: %d\n",
-				    h2n->zero_huff_padding, h2n->huff_pad);
+		if (h2n->huff && h2n->huff_pad_bad) {
+			lwsl_info("%s: bad huff padding, state %d\n", __func__,
+				  h2n->hpack_pos);
 			lws_h2_goaway(nwsi, H2_ERR_COMPRESSION_ERROR,
 				      "Huffman padding excessive or wrong");
 			return 1;
@@ -1253,8 +1233,6 @@ fin:
 		if (!h2n->value) {
 			h2n->value = 1;
 			h2n->hpack = HPKS_HLEN;
-			h2n->huff_pad = 0;
-			h2n->zero_huff_padding = 0;
 			h2n->ext_count = 0;
 			break;
 		}
@@ -1389,6 +1367,46 @@ lws_h2_num(int starting_bits, unsigned long num,
 	return 0;
 }
 
+/*
+ * Adds a header as a literal without indexing, the form header blocks are
+ * built in until lws_hpack_enc_block() encodes them as they are sent
+ */
+
+int
+lws_h2_header_literal(const unsigned char *name, const unsigned char *value,
+		      int length, unsigned char **p, unsigned char *end)
+{
+	int len = (int)strlen((char *)name);
+
+	if (len && name[len - 1] == ':')
+		len--;
+
+	if (end - *p < len + length + 8)
+		return 1;
+
+	*((*p)++) = 0; /* literal hdr, literal name,  */
+
+	*((*p)++) = (uint8_t)(0 | (uint8_t)lws_h2_num_start(7, (unsigned long)len)); /* non-HUF */
+	if (lws_h2_num(7, (unsigned long)len, p, end))
+		return 1;
+
+	/* upper-case header names are verboten in h2, but OK on h1, so
+	 * they're not illegal per se.  Silently convert them for h2... */
+
+	while(len--)
+		*((*p)++) = (uint8_t)tolower((int)*name++);
+
+	*((*p)++) = (uint8_t)(0 | (uint8_t)lws_h2_num_start(7, (unsigned long)length)); /* non-HUF */
+	if (lws_h2_num(7, (unsigned long)length, p, end))
+		return 1;
+
+	if (value)
+		memcpy(*p, value, (unsigned int)length);
+	*p += length;
+
+	return 0;
+}
+
 int lws_add_http2_header_by_name(struct lws *wsi, const unsigned char *name,
 				 const unsigned char *value, int length,
 				 unsigned char **p, unsigned char *end)
@@ -1421,30 +1439,7 @@ int lws_add_http2_header_by_name(struct lws *wsi, const unsigned char *name,
 		return 0;
 	}
 
-	if (end - *p < len + length + 8)
-		return 1;
-
-	*((*p)++) = 0; /* literal hdr, literal name,  */
-
-	*((*p)++) = (uint8_t)(0 | (uint8_t)lws_h2_num_start(7, (unsigned long)len)); /* non-HUF */
-	if (lws_h2_num(7, (unsigned long)len, p, end))
-		return 1;
-
-	/* upper-case header names are verboten in h2, but OK on h1, so
-	 * they're not illegal per se.  Silently convert them for h2... */
-
-	while(len--)
-		*((*p)++) = (uint8_t)tolower((int)*name++);
-
-	*((*p)++) = (uint8_t)(0 | (uint8_t)lws_h2_num_start(7, (unsigned long)length)); /* non-HUF */
-	if (lws_h2_num(7, (unsigned long)length, p, end))
-		return 1;
-
-	if (value)
-		memcpy(*p, value, (unsigned int)length);
-	*p += length;
-
-	return 0;
+	return lws_h2_header_literal(name, value, length, p, end);
 }
 
 int lws_add_http2_header_by_token(struct lws *wsi, enum lws_token_indexes token,
@@ -1476,3 +1471,493 @@ int lws_add_http2_header_status(struct lws *wsi, unsigned int code,
 
 	return 0;
 }
+
+/*
+ * HPACK encoder
+ *
+ * lws_add_http2_header_by_name() builds header blocks out of literals without
+ * indexing.  That is all a block can safely be while it is being built, since
+ * blocks may be built a long time before they are sent (eg, by cgi) or not
+ * sent at all, and the peer's decoder only sees what actually goes on the
+ * wire.  So the real encoding is done here, each HEADERS / CONTINUATION
+ * payload being recoded against the static and our dynamic table with
+ * Huffman coding just before it is written.
+ *
+ * Anything in the block that is already compact and doesn't touch the table
+ * is copied as it is.  Anything that does touch the table was not made by us,
+ * so we stop using the dynamic table for the rest of the connection.  A
+ * block split part way through a header (cgi) is copied as it is from the
+ * split to the end of the block.
+ */
+
+#include "hufenc.h"
+
+#define LWS_HPACK_ENC_MAX_TABLE 65536
+
+enum {
+	LWS_HPE_RECODE,
+	LWS_HPE_COPY,
+	LWS_HPE_PARTIAL,
+	LWS_HPE_STATEFUL,
+};
+
+/* never put in the table, nor let an intermediary do it: RFC7541 7.1.3 */
+static const uint8_t hpack_enc_never[] = { 23, 32, 49, 55 };
+/* values that are rarely the same twice */
+static const uint8_t hpack_enc_noidx[] = { 4, 21, 28, 30, 33, 34, 40, 41, 44 };
+
+static uint8_t *
+lws_hpack_enc_int(uint8_t *p, uint8_t flags, int bits, uint32_t num)
+{
+	*p++ = (uint8_t)(flags | lws_h2_num_start(bits, num));
+	lws_h2_num(bits, num, &p, p + 8);
+
+	return p;
+}
+
+static uint8_t *
+lws_hpack_enc_str(uint8_t *p, const uint8_t *s, uint32_t len)
+{
+	uint64_t acc = 0;
+	uint32_t n, hl = 0;
+	int bits = 0;
+
+	for (n = 0; n < len; n++)
+		hl += hufenc_len[s[n]];
+	hl = (hl + 7) >> 3;
+
+	if (hl >= len) {
+		p = lws_hpack_enc_int(p, 0, 7, len);
+		memcpy(p, s, len);
+
+		return p + len;
+	}
+
+	p = lws_hpack_enc_int(p, 0x80, 7, hl);
+	while (len--) {
+		acc = (acc << hufenc_len[*s]) | hufenc_code[*s];
+		bits += hufenc_len[*s++];
+		while (bits >= 8) {
+			bits -= 8;
+			*p++ = (uint8_t)(acc >> bits);
+		}
+	}
+	if (bits)
+		/* pad with the msbs of EOS */
+		*p++ = (uint8_t)((acc << (8 - bits)) | (0xff >> bits));
+
+	return p;
+}
+
+static int
+lws_hpack_enc_get_int(const uint8_t **p, const uint8_t *end, int bits,
+		      uint32_t *num)
+{
+	uint32_t mask = (1u << bits) - 1;
+	int sh = 0;
+	uint8_t c;
+
+	if (*p >= end)
+		return 1;
+
+	*num = *(*p)++ & mask;
+	if (*num < mask)
+		return 0;
+
+	do {
+		if (*p >= end || sh > 21)
+			return 1;
+		c = *(*p)++;
+		*num += (uint32_t)(c & 0x7f) << sh;
+		sh += 7;
+	} while (c & 0x80);
+
+	return 0;
+}
+
+static int
+lws_hpack_enc_get_str(const uint8_t **p, const uint8_t *end,
+		      const uint8_t **s, uint32_t *len, int *huff)
+{
+	if (*p >= end)
+		return 1;
+
+	*huff = !!(**p & 0x80);
+	if (lws_hpack_enc_get_int(p, end, 7, len) ||
+	    (size_t)(end - *p) < *len)
+		return 1;
+
+	*s = *p;
+	*p += *len;
+
+	return 0;
+}
+
+/* works out what the next representation in the block is, and skips it */
+
+static int
+lws_hpack_enc_parse(const uint8_t **p, const uint8_t *end,
+		    const uint8_t **n, uint32_t *nl,
+		    const uint8_t **v, uint32_t *vl)
+{
+	uint8_t c = **p;
+	int hn = 0, hv;
+	uint32_t idx;
+
+	if (c & 0x80) {
+		/* indexed */
+		if (lws_hpack_enc_get_int(p, end, 7, &idx))
+			return LWS_HPE_PARTIAL;
+
+		return idx && idx <= 61 ? LWS_HPE_COPY : LWS_HPE_STATEFUL;
+	}
+
+	if (c & 0x60)
+		/* incremental indexing, or table size update */
+		return LWS_HPE_STATEFUL;
+
+	/* literal without indexing, or never indexed */
+
+	if (lws_hpack_enc_get_int(p, end, 4, &idx))
+		return LWS_HPE_PARTIAL;
+	if (idx > 61)
+		return LWS_HPE_STATEFUL;
+	if (!idx && lws_hpack_enc_get_str(p, end, n, nl, &hn))
+		return LWS_HPE_PARTIAL;
+	if (lws_hpack_enc_get_str(p, end, v, vl, &hv))
+		return LWS_HPE_PARTIAL;
+
+	return !c && !hn && !hv ? LWS_HPE_RECODE : LWS_HPE_COPY;
+}
+
+static struct lws_hpack_enc_entry *
+lws_hpack_enc_entry(struct lws_hpack_enc *e, int idx)
+{
+	/* dynamic idx 1 is the newest */
+	return &e->ring[(e->head + e->slots - (idx - 1)) % e->slots];
+}
+
+static void
+lws_hpack_enc_evict(struct lws_hpack_enc *e, uint32_t target)
+{
+	struct lws_hpack_enc_entry *de;
+
+	while (e->count && e->size > target) {
+		de = lws_hpack_enc_entry(e, e->count);
+		e->size -= (uint32_t)de->name_len + de->value_len + 32;
+		lws_free_set_NULL(de->nv);
+		e->count--;
+		e->evictions++;
+	}
+}
+
+static int
+lws_hpack_enc_insert(struct lws_hpack_enc *e, const uint8_t *n, uint32_t nl,
+		     const uint8_t *v, uint32_t vl)
+{
+	struct lws_hpack_enc_entry *de;
+	char *nv;
+
+	if (!e->ring) {
+		e->ring = lws_zalloc(sizeof(*e->ring) * e->slots,
+				     "hpack enc ring");
+		if (!e->ring)
+			goto bail;
+	}
+
+	nv = lws_malloc(nl + vl + 1, "hpack enc");
+	if (!nv)
+		goto bail;
+
+	memcpy(nv, n, nl);
+	memcpy(nv + nl, v, vl);
+
+	/* the decoder evicts exactly this way as it adds it */
+	lws_hpack_enc_evict(e, e->max - (nl + vl + 32));
+
+	e->head = (uint16_t)((e->head + 1) % e->slots);
+	de = &e->ring[e->head];
+	de->nv = nv;
+	de->name_len = (uint16_t)nl;
+	de->value_len = (uint16_t)vl;
+	e->count++;
+	e->size += nl + vl + 32;
+	e->inserts++;
+
+	return 0;
+
+bail:
+	e->desync = 1;
+
+	return 1;
+}
+
+static uint8_t *
+lws_hpack_enc_hdr(struct lws_hpack_enc *e, uint8_t *o,
+		  const uint8_t *n, uint32_t nl, const uint8_t *v, uint32_t vl)
+{
+	uint32_t sidx = 0, didx = 0, i;
+	struct lws_hpack_enc_entry *de;
+	uint8_t flags = 0x40;
+	const char *s;
+	int bits = 6;
+
+	for (i = 1; i < LWS_ARRAY_SIZE(static_hdr_len); i++) {
+		if (static_hdr_len[i] != nl)
+			continue;
+		s = (const char *)lws_token_to_string(static_token[i]);
+		if (!s || memcmp(s, n, nl))
+			continue;
+		if (!sidx)
+			sidx = i;
+		if (i < LWS_ARRAY_SIZE(http2_canned) && http2_canned[i][0] &&
+		    strlen(http2_canned[i]) == vl &&
+		    !memcmp(http2_canned[i], v, vl))
+			return lws_hpack_enc_int(o, 0x80, 7, i);
+	}
+
+	if (!e->desync)
+		for (i = 1; i <= e->count; i++) {
+			de = lws_hpack_enc_entry(e, (int)i);
+			if (de->name_len != nl || memcmp(de->nv, n, nl))
+				continue;
+			if (de->value_len == vl && !memcmp(de->nv + nl, v, vl))
+				return lws_hpack_enc_int(o, 0x80, 7, 61 + i);
+			if (!didx)
+				didx = 61 + i;
+		}
+
+	if (sidx && memchr(hpack_enc_never, (int)sidx, sizeof(hpack_enc_never))) {
+		flags = 0x10;
+		bits = 4;
+	} else
+		if (e->desync || nl + vl + 32 > e->max / 2 ||
+		    (sidx && memchr(hpack_enc_noidx, (int)sidx,
+				    sizeof(hpack_enc_noidx))) ||
+		    lws_hpack_enc_insert(e, n, nl, v, vl)) {
+			flags = 0;
+			bits = 4;
+		}
+
+	/* the decoder resolves the name before it inserts the new entry */
+
+	i = sidx ? sidx : didx;
+	o = lws_hpack_enc_int(o, flags, bits, i);
+	if (!i)
+		o = lws_hpack_enc_str(o, n, nl);
+
+	return lws_hpack_enc_str(o, v, vl);
+}
+
+/* a change to the table size must start the next block, RFC7541 4.2 */
+
+static uint8_t *
+lws_hpack_enc_table_size(struct lws *nwsi, struct lws_hpack_enc *e, int limit,
+			 uint8_t *o)
+{
+	uint32_t want = nwsi->h2.h2n->peer_set.s[H2SET_HEADER_TABLE_SIZE];
+
+	if (limit < 0)
+		limit = 0;
+	if (limit > LWS_HPACK_ENC_MAX_TABLE)
+		limit = LWS_HPACK_ENC_MAX_TABLE;
+	if (want > (uint32_t)limit)
+		want = (uint32_t)limit;
+
+	if (!e->slots) {
+		e->slots = (uint16_t)(limit / 32 + 1);
+		e->max = 4096; /* what the peer decoder starts with */
+	}
+
+	if (e->update_pending && e->update_min < want) {
+		/* the peer went lower than want in the meanwhile */
+		lws_hpack_enc_evict(e, e->update_min);
+		e->max = e->update_min;
+		o = lws_hpack_enc_int(o, 0x20, 5, e->max);
+	}
+	e->update_pending = 0;
+
+	if (want != e->max) {
+		lws_hpack_enc_evict(e, want);
+		e->max = want;
+		o = lws_hpack_enc_int(o, 0x20, 5, e->max);
+	}
+
+	return o;
+}
+
+/*
+ * Recodes one HEADERS or CONTINUATION payload, first if it is the HEADERS,
+ * last if it has END_HEADERS.  On success *buf / *len may be changed to point
+ * to the recoded payload, which has LWS_PRE available before it.
+ */
+
+int
+lws_hpack_enc_block(struct lws *wsi, int first, int last, unsigned char **buf,
+		    size_t *len)
+{
+	struct lws *nwsi = lws_get_network_wsi(wsi);
+	const uint8_t *p = *buf, *end = p + *len, *rep, *n = NULL, *v;
+	struct lws_hpack_enc *e;
+	uint32_t nl = 0, vl;
+	uint8_t *o, *op;
+	size_t need;
+	int limit;
+
+	if (!nwsi->h2.h2n)
+		return 0;
+
+	e = &nwsi->h2.h2n->hpack_enc;
+	limit = nwsi->a.vhost->h2.hpack_enc_table_size;
+
+	e->in += *len;
+	if (last)
+		e->blocks++;
+
+	if (limit == LWS_H2_HPACK_ENC_DISABLE) {
+		e->out += *len;
+
+		return 0;
+	}
+
+	/* recoding never grows a header, allow for two table size updates */
+
+	need = LWS_PRE + *len + 16;
+	if (e->scratch_len < need) {
+		op = lws_realloc(e->scratch, need, "hpack enc");
+		if (!op)
+			return 1;
+		e->scratch = op;
+		e->scratch_len = need;
+	}
+
+	op = o = e->scratch + LWS_PRE;
+
+	if (first) {
+		e->verbatim = 0;
+		o = lws_hpack_enc_table_size(nwsi, e, limit, o);
+	}
+
+	while (p < end) {
+		if (e->verbatim) {
+			memcpy(o, p, lws_ptr_diff_size_t(end, p));
+			o += end - p;
+			break;
+		}
+
+		rep = p;
+		switch (lws_hpack_enc_parse(&p, end, &n, &nl, &v, &vl)) {
+		case LWS_HPE_RECODE:
+			o = lws_hpack_enc_hdr(e, o, n, nl, v, vl);
+			break;
+		case LWS_HPE_COPY:
+			memcpy(o, rep, lws_ptr_diff_size_t(p, rep));
+			o += p - rep;
+			break;
+		case LWS_HPE_STATEFUL:
+			lwsl_wsi_notice(wsi, "foreign hpack, dynamic table off");
+			e->desync = 1;
+			/* fallthru */
+		default: /* LWS_HPE_PARTIAL */
+			e->verbatim = 1;
+			p = rep;
+			break;
+		}
+	}
+
+	if (last)
+		e->verbatim = 0;
+
+	*buf = op;
+	*len = lws_ptr_diff_size_t(o, op);
+	e->out += *len;
+
+	return 0;
+}
+
+/*
+ * Encodes a block of lws_h2_header_literal() headers using only the
+ * static table and Huffman coding, so the result can be sent on any
+ * connection as it is.  out must have room for len + 16.
+ */
+
+int
+lws_hpack_enc_stateless(const uint8_t *in, size_t len, uint8_t *out,
+			size_t *olen)
+{
+	const uint8_t *p = in, *end = in + len, *rep, *n = NULL, *v;
+	struct lws_hpack_enc e;
+	uint8_t *o = out;
+	uint32_t nl = 0, vl;
+
+	memset(&e, 0, sizeof(e));
+	e.desync = 1; /* no dynamic table */
+
+	while (p < end) {
+		rep = p;
+		switch (lws_hpack_enc_parse(&p, end, &n, &nl, &v, &vl)) {
+		case LWS_HPE_RECODE:
+			o = lws_hpack_enc_hdr(&e, o, n, nl, v, vl);
+			break;
+		case LWS_HPE_COPY:
+			memcpy(o, rep, lws_ptr_diff_size_t(p, rep));
+			o += p - rep;
+			break;
+		default:
+			return 1;
+		}
+	}
+
+	*olen = lws_ptr_diff_size_t(o, out);
+
+	return 0;
+}
+
+void
+lws_hpack_enc_peer_table_size(struct lws *nwsi, uint32_t size)
+{
+	struct lws_hpack_enc *e = &nwsi->h2.h2n->hpack_enc;
+
+	if (!e->update_pending || size < e->update_min)
+		e->update_min = size;
+	e->update_pending = 1;
+}
+
+void
+lws_hpack_enc_destroy(struct lws *wsi)
+{
+	struct lws_hpack_enc *e;
+
+	if (!wsi->h2.h2n)
+		return;
+
+	e = &wsi->h2.h2n->hpack_enc;
+	if (e->ring) {
+		lws_hpack_enc_evict(e, 0);
+		lws_free_set_NULL(e->ring);
+	}
+	lws_free_set_NULL(e->scratch);
+	e->scratch_len = 0;
+}
+
+int
+lws_h2_hpack_enc_stats(struct lws *wsi, lws_h2_hpack_enc_stats_t *stats)
+{
+	struct lws *nwsi = lws_get_network_wsi(wsi);
+	struct lws_hpack_enc *e;
+
+	if (!nwsi || !nwsi->h2.h2n)
+		return 1;
+
+	e = &nwsi->h2.h2n->hpack_enc;
+
+	stats->in		= e->in;
+	stats->out		= e->out;
+	stats->blocks		= e->blocks;
+	stats->inserts		= e->inserts;
+	stats->evictions	= e->evictions;
+	stats->table_size	= e->size;
+	stats->table_max	= e->max;
+
+	return 0;
+}
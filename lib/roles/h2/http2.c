@@ -179,6 +179,16 @@ lws_h2_update_peer_txcredit(struct lws *wsi, unsigned int sid, int bump)
 
 	lws_pps_schedule(wsi, pps);
 
+	/*
+	 * Every new stream bumps the nwsi as well, on a long-lived connection
+	 * that adds up; the peer's connection window must not go past 2^31 - 1
+	 */
+
+	if ((int64_t)nwsi->txc.peer_tx_cr_est + bump > 0x7fffffff)
+		bump = (int)(0x7fffffff - nwsi->txc.peer_tx_cr_est);
+	if (bump <= 0)
+		return 0;
+
 	pps = lws_h2_new_pps(LWS_H2_PPS_UPDATE_WINDOW);
 	if (!pps)
 		return 1;
@@ -412,6 +422,7 @@ lws_h2_issue_preface(struct lws *wsi)
 
 	h2n->count = 0;
 	wsi->txc.tx_cr = 65535;
+	wsi->txc.peer_tx_cr_est = 65535;
 
 	/*
 	 * we must send a settings frame
@@ -521,6 +532,9 @@ lws_h2_settings(struct lws *wsi, struct http2_settings *settings,
 
 		switch (a) {
 		case H2SET_HEADER_TABLE_SIZE:
+			if (nwsi->h2.h2n && settings == &nwsi->h2.h2n->peer_set)
+				/* our encoder must follow it next block */
+				lws_hpack_enc_peer_table_size(nwsi, b);
 			break;
 		case H2SET_ENABLE_PUSH:
 			if (b > 1) {
@@ -1522,6 +1536,8 @@ lws_h2_parse_end_of_frame(struct lws *wsi)
 			h2n->swsi->client_h2_alpn = 1;
 #if defined(LWS_WITH_CLIENT)
 			h2n->swsi->flags = wsi->flags;
+			h2n->swsi->client_no_follow_redirect =
+						wsi->client_no_follow_redirect;
 #if defined(LWS_WITH_CONMON)
 			/* sid1 needs to represent the connection experience
 			 * ... we take over responsibility for the DNS list
@@ -1553,6 +1569,7 @@ lws_h2_parse_end_of_frame(struct lws *wsi)
 			    !h2n->swsi->user_space_externally_allocated)
 				lws_free(h2n->swsi->user_space);
 			h2n->swsi->user_space = wsi->user_space;
+			h2n->swsi->user_space_slab = wsi->user_space_slab;
 			h2n->swsi->user_space_externally_allocated =
 					wsi->user_space_externally_allocated;
 			h2n->swsi->a.opaque_user_data = wsi->a.opaque_user_data;
@@ -1755,12 +1772,16 @@ lws_h2_parse_end_of_frame(struct lws *wsi)
 		 * going to be doing anything further on this stream.
 		 *
 		 * In that case handle the transaction completion and
-		 * finalize the stream for the peer
+		 * finalize the stream for the peer.  Like DATA, a remote
+		 * END_STREAM on HEADERS, eg, a 304, means the client is done
+		 * even if its side is still open.
 		 */
 
-		if (h2n->swsi->h2.h2_state == LWS_H2_STATE_CLOSED &&
-			h2n->swsi->client_mux_substream) {
+		if (h2n->swsi->client_mux_substream &&
+		    (h2n->swsi->h2.h2_state == LWS_H2_STATE_CLOSED ||
+		     h2n->swsi->h2.END_STREAM)) {
 
+			lws_h2_state(h2n->swsi, LWS_H2_STATE_CLOSED);
 			lws_h2_rst_stream(h2n->swsi, H2_ERR_NO_ERROR,
 				"client done");
 
@@ -2047,6 +2068,7 @@ lws_h2_parser(struct lws *wsi, unsigned char *in, lws_filepos_t _inlen,
 			lws_validity_confirmed(wsi);
 			h2n->count = 0;
 			wsi->txc.tx_cr = 65535;
+			wsi->txc.peer_tx_cr_est = 65535;
 
 			/*
 			 * we must send a settings frame -- empty one is OK...
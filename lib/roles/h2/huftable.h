@@ -1,530 +1,1550 @@
-static unsigned char lextable[] = {
-/* pos 0000:   0 */    /* 0 */ 0x42  /* (to 0x0084 state  98) */,
-                       /* 1 */ 0x01  /* (to 0x0002 state   1) */,
-/* pos 0002:   1 */    /* 0 */ 0x5C  /* (to 0x00BA state 151) */,
-                       /* 1 */ 0x01  /* (to 0x0004 state   2) */,
-/* pos 0004:   2 */    /* 0 */ 0x66  /* (to 0x00D0 state 173) */,
-                       /* 1 */ 0x01  /* (to 0x0006 state   3) */,
-/* pos 0006:   3 */    /* 0 */ 0x74  /* (to 0x00EE state 204) */,
-                       /* 1 */ 0x01  /* (to 0x0008 state   4) */,
-/* pos 0008:   4 */    /* 0 */ 0x8C  /* (to 0x0120 state 263) */,
-                       /* 1 */ 0x01  /* (to 0x000A state   5) */,
-/* pos 000a:   5 */    /* 0 */ 0x46  /* (to 0x0096 state 113) */,
-                       /* 1 */ 0x01  /* (to 0x000C state   6) */,
-/* pos 000c:   6 */    /* 0 */ 0x75  /* (to 0x00F6 state 211) */,
-                       /* 1 */ 0x01  /* (to 0x000E state   7) */,
-/* pos 000e:   7 */    /* 0 */ 0x40  /* (to 0x008E state 104) */,
-                       /* 1 */ 0x01  /* (to 0x0010 state   8) */,
-/* pos 0010:   8 */    /* 0 */ 0x45  /* (to 0x009A state 116) */,
-                       /* 1 */ 0x01  /* (to 0x0012 state   9) */,
-/* pos 0012:   9 */    /* 0 */ 0x40  /* (to 0x0092 state 108) */,
-                       /* 1 */ 0x01  /* (to 0x0014 state  10) */,
-/* pos 0014:  10 */    /* 0 */ 0x01  /* (to 0x0016 state  11) */,
-                       /* 1 */ 0x03  /* (to 0x001A state  14) */,
-/* pos 0016:  11 */    /* 0 */ 0x01  /* (to 0x0018 state  12) */,
-                       /* 1 */ 0x5B  /* (to 0x00CC state 166) */,
-/* pos 0018:  12 */     /* terminal 0 */ 0x00,
-                        /* terminal 36 */ 0x24,
-/* pos 001a:  14 */    /* 0 */ 0x72  /* (to 0x00FE state 220) */,
-                       /* 1 */ 0x01  /* (to 0x001C state  15) */,
-/* pos 001c:  15 */    /* 0 */ 0x72  /* (to 0x0100 state 222) */,
-                       /* 1 */ 0x01  /* (to 0x001E state  16) */,
-/* pos 001e:  16 */    /* 0 */ 0x53  /* (to 0x00C4 state 158) */,
-                       /* 1 */ 0x01  /* (to 0x0020 state  17) */,
-/* pos 0020:  17 */     /* terminal 123 */ 0x7B,
-                       /* 1 */ 0x01  /* (to 0x0022 state  18) */,
-/* pos 0022:  18 */    /* 0 */ 0x6B  /* (to 0x00F8 state 216) */,
-                       /* 1 */ 0x01  /* (to 0x0024 state  19) */,
-/* pos 0024:  19 */    /* 0 */ 0x84  /* (to 0x012C state 279) */,
-                       /* 1 */ 0x01  /* (to 0x0026 state  20) */,
-/* pos 0026:  20 */    /* 0 */ 0x01  /* (to 0x0028 state  21) */,
-                       /* 1 */ 0x06  /* (to 0x0032 state  27) */,
-/* pos 0028:  21 */    /* 0 */ 0xB3  /* (to 0x018E state 377) */,
-                       /* 1 */ 0x01  /* (to 0x002A state  22) */,
-/* pos 002a:  22 */    /* 0 */ 0xC3  /* (to 0x01B0 state 414) */,
-                       /* 1 */ 0x01  /* (to 0x002C state  23) */,
-/* pos 002c:  23 */    /* 0 */ 0x01  /* (to 0x002E state  24) */,
-                       /* 1 */ 0x8C  /* (to 0x0144 state 301) */,
-/* pos 002e:  24 */    /* 0 */ 0x01  /* (to 0x0030 state  25) */,
-                       /* 1 */ 0x8A  /* (to 0x0142 state 298) */,
-/* pos 0030:  25 */     /* terminal 1 */ 0x01,
-                        /* terminal 135 */ 0x87,
-/* pos 0032:  27 */    /* 0 */ 0x8E  /* (to 0x014E state 314) */,
-                       /* 1 */ 0x01  /* (to 0x0034 state  28) */,
-/* pos 0034:  28 */    /* 0 */ 0x0F  /* (to 0x0052 state  50) */,
-                       /* 1 */ 0x01  /* (to 0x0036 state  29) */,
-/* pos 0036:  29 */    /* 0 */ 0xA4  /* (to 0x017E state 362) */,
-                       /* 1 */ 0x01  /* (to 0x0038 state  30) */,
-/* pos 0038:  30 */    /* 0 */ 0xB7  /* (to 0x01A6 state 403) */,
-                       /* 1 */ 0x01  /* (to 0x003A state  31) */,
-/* pos 003a:  31 */    /* 0 */ 0xC8  /* (to 0x01CA state 440) */,
-                       /* 1 */ 0x01  /* (to 0x003C state  32) */,
-/* pos 003c:  32 */    /* 0 */ 0x01  /* (to 0x003E state  33) */,
-                       /* 1 */ 0x0F  /* (to 0x005A state  55) */,
-/* pos 003e:  33 */    /* 0 */ 0x01  /* (to 0x0040 state  34) */,
-                       /* 1 */ 0x07  /* (to 0x004C state  46) */,
-/* pos 0040:  34 */    /* 0 */ 0x01  /* (to 0x0042 state  35) */,
-                       /* 1 */ 0x03  /* (to 0x0046 state  39) */,
-/* pos 0042:  35 */     /* terminal 254 */ 0xFE,
-                       /* 1 */ 0x01  /* (to 0x0044 state  36) */,
-/* pos 0044:  36 */     /* terminal 2 */ 0x02,
-                        /* terminal 3 */ 0x03,
-/* pos 0046:  39 */    /* 0 */ 0x01  /* (to 0x0048 state  40) */,
-                       /* 1 */ 0x02  /* (to 0x004A state  43) */,
-/* pos 0048:  40 */     /* terminal 4 */ 0x04,
-                        /* terminal 5 */ 0x05,
-/* pos 004a:  43 */     /* terminal 6 */ 0x06,
-                        /* terminal 7 */ 0x07,
-/* pos 004c:  46 */    /* 0 */ 0x01  /* (to 0x004E state  47) */,
-                       /* 1 */ 0x0E  /* (to 0x0068 state  67) */,
-/* pos 004e:  47 */    /* 0 */ 0x01  /* (to 0x0050 state  48) */,
-                       /* 1 */ 0x0C  /* (to 0x0066 state  63) */,
-/* pos 0050:  48 */     /* terminal 8 */ 0x08,
-                        /* terminal 11 */ 0x0B,
-/* pos 0052:  50 */    /* 0 */ 0xA7  /* (to 0x01A0 state 396) */,
-                       /* 1 */ 0x01  /* (to 0x0054 state  51) */,
-/* pos 0054:  51 */    /* 0 */ 0x01  /* (to 0x0056 state  52) */,
-                       /* 1 */ 0x7B  /* (to 0x014A state 309) */,
-/* pos 0056:  52 */     /* terminal 239 */ 0xEF,
-                       /* 1 */ 0x01  /* (to 0x0058 state  53) */,
-/* pos 0058:  53 */     /* terminal 9 */ 0x09,
-                        /* terminal 142 */ 0x8E,
-/* pos 005a:  55 */    /* 0 */ 0x0A  /* (to 0x006E state  74) */,
-                       /* 1 */ 0x01  /* (to 0x005C state  56) */,
-/* pos 005c:  56 */    /* 0 */ 0x11  /* (to 0x007E state  91) */,
-                       /* 1 */ 0x01  /* (to 0x005E state  57) */,
-/* pos 005e:  57 */    /* 0 */ 0x64  /* (to 0x0126 state 274) */,
-                       /* 1 */ 0x01  /* (to 0x0060 state  58) */,
-/* pos 0060:  58 */     /* terminal 249 */ 0xF9,
-                       /* 1 */ 0x01  /* (to 0x0062 state  59) */,
-/* pos 0062:  59 */    /* 0 */ 0x01  /* (to 0x0064 state  60) */,
-                       /* 1 */ 0x0A  /* (to 0x0076 state  81) */,
-/* pos 0064:  60 */     /* terminal 10 */ 0x0A,
-                        /* terminal 13 */ 0x0D,
-/* pos 0066:  63 */     /* terminal 12 */ 0x0C,
-                        /* terminal 14 */ 0x0E,
-/* pos 0068:  67 */    /* 0 */ 0x01  /* (to 0x006A state  68) */,
-                       /* 1 */ 0x02  /* (to 0x006C state  71) */,
-/* pos 006a:  68 */     /* terminal 15 */ 0x0F,
-                        /* terminal 16 */ 0x10,
-/* pos 006c:  71 */     /* terminal 17 */ 0x11,
-                        /* terminal 18 */ 0x12,
-/* pos 006e:  74 */    /* 0 */ 0x01  /* (to 0x0070 state  75) */,
-                       /* 1 */ 0x05  /* (to 0x0078 state  84) */,
-/* pos 0070:  75 */    /* 0 */ 0x01  /* (to 0x0072 state  76) */,
-                       /* 1 */ 0x02  /* (to 0x0074 state  79) */,
-/* pos 0072:  76 */     /* terminal 19 */ 0x13,
-                        /* terminal 20 */ 0x14,
-/* pos 0074:  79 */     /* terminal 21 */ 0x15,
-                        /* terminal 23 */ 0x17,
-/* pos 0076:  81 */     /* terminal 22 */ 0x16,
-                        /* terminal 256 */ 0x00,
-/* pos 0078:  84 */    /* 0 */ 0x01  /* (to 0x007A state  85) */,
-                       /* 1 */ 0x02  /* (to 0x007C state  88) */,
-/* pos 007a:  85 */     /* terminal 24 */ 0x18,
-                        /* terminal 25 */ 0x19,
-/* pos 007c:  88 */     /* terminal 26 */ 0x1A,
-                        /* terminal 27 */ 0x1B,
-/* pos 007e:  91 */    /* 0 */ 0x01  /* (to 0x0080 state  92) */,
-                       /* 1 */ 0x02  /* (to 0x0082 state  95) */,
-/* pos 0080:  92 */     /* terminal 28 */ 0x1C,
-                        /* terminal 29 */ 0x1D,
-/* pos 0082:  95 */     /* terminal 30 */ 0x1E,
-                        /* terminal 31 */ 0x1F,
-/* pos 0084:  98 */    /* 0 */ 0x13  /* (to 0x00AA state 133) */,
-                       /* 1 */ 0x01  /* (to 0x0086 state  99) */,
-/* pos 0086:  99 */    /* 0 */ 0x01  /* (to 0x0088 state 100) */,
-                       /* 1 */ 0x0F  /* (to 0x00A4 state 129) */,
-/* pos 0088: 100 */    /* 0 */ 0x4B  /* (to 0x011E state 258) */,
-                       /* 1 */ 0x01  /* (to 0x008A state 101) */,
-/* pos 008a: 101 */    /* 0 */ 0x01  /* (to 0x008C state 102) */,
-                       /* 1 */ 0x0C  /* (to 0x00A2 state 126) */,
-/* pos 008c: 102 */     /* terminal 32 */ 0x20,
-                        /* terminal 37 */ 0x25,
-/* pos 008e: 104 */    /* 0 */ 0x01  /* (to 0x0090 state 105) */,
-                       /* 1 */ 0x08  /* (to 0x009E state 119) */,
-/* pos 0090: 105 */     /* terminal 33 */ 0x21,
-                        /* terminal 34 */ 0x22,
-/* pos 0092: 108 */     /* terminal 124 */ 0x7C,
-                       /* 1 */ 0x01  /* (to 0x0094 state 109) */,
-/* pos 0094: 109 */     /* terminal 35 */ 0x23,
-                        /* terminal 62 */ 0x3E,
-/* pos 0096: 113 */    /* 0 */ 0x01  /* (to 0x0098 state 114) */,
-                       /* 1 */ 0x05  /* (to 0x00A0 state 124) */,
-/* pos 0098: 114 */     /* terminal 38 */ 0x26,
-                        /* terminal 42 */ 0x2A,
-/* pos 009a: 116 */     /* terminal 63 */ 0x3F,
-                       /* 1 */ 0x01  /* (to 0x009C state 117) */,
-/* pos 009c: 117 */     /* terminal 39 */ 0x27,
-                        /* terminal 43 */ 0x2B,
-/* pos 009e: 119 */     /* terminal 40 */ 0x28,
-                        /* terminal 41 */ 0x29,
-/* pos 00a0: 124 */     /* terminal 44 */ 0x2C,
-                        /* terminal 59 */ 0x3B,
-/* pos 00a2: 126 */     /* terminal 45 */ 0x2D,
-                        /* terminal 46 */ 0x2E,
-/* pos 00a4: 129 */    /* 0 */ 0x01  /* (to 0x00A6 state 130) */,
-                       /* 1 */ 0x08  /* (to 0x00B4 state 144) */,
-/* pos 00a6: 130 */    /* 0 */ 0x01  /* (to 0x00A8 state 131) */,
-                       /* 1 */ 0x06  /* (to 0x00B2 state 141) */,
-/* pos 00a8: 131 */     /* terminal 47 */ 0x2F,
-                        /* terminal 51 */ 0x33,
-/* pos 00aa: 133 */    /* 0 */ 0x01  /* (to 0x00AC state 134) */,
-                       /* 1 */ 0x2D  /* (to 0x0104 state 229) */,
-/* pos 00ac: 134 */    /* 0 */ 0x01  /* (to 0x00AE state 135) */,
-                       /* 1 */ 0x02  /* (to 0x00B0 state 138) */,
-/* pos 00ae: 135 */     /* terminal 48 */ 0x30,
-                        /* terminal 49 */ 0x31,
-/* pos 00b0: 138 */     /* terminal 50 */ 0x32,
-                        /* terminal 97 */ 0x61,
-/* pos 00b2: 141 */     /* terminal 52 */ 0x34,
-                        /* terminal 53 */ 0x35,
-/* pos 00b4: 144 */    /* 0 */ 0x01  /* (to 0x00B6 state 145) */,
-                       /* 1 */ 0x02  /* (to 0x00B8 state 148) */,
-/* pos 00b6: 145 */     /* terminal 54 */ 0x36,
-                        /* terminal 55 */ 0x37,
-/* pos 00b8: 148 */     /* terminal 56 */ 0x38,
-                        /* terminal 57 */ 0x39,
-/* pos 00ba: 151 */    /* 0 */ 0x06  /* (to 0x00C6 state 160) */,
-                       /* 1 */ 0x01  /* (to 0x00BC state 152) */,
-/* pos 00bc: 152 */    /* 0 */ 0x2C  /* (to 0x0114 state 246) */,
-                       /* 1 */ 0x01  /* (to 0x00BE state 153) */,
-/* pos 00be: 153 */    /* 0 */ 0x2F  /* (to 0x011C state 256) */,
-                       /* 1 */ 0x01  /* (to 0x00C0 state 154) */,
-/* pos 00c0: 154 */    /* 0 */ 0x01  /* (to 0x00C2 state 155) */,
-                       /* 1 */ 0x07  /* (to 0x00CE state 170) */,
-/* pos 00c2: 155 */     /* terminal 58 */ 0x3A,
-                        /* terminal 66 */ 0x42,
-/* pos 00c4: 158 */     /* terminal 60 */ 0x3C,
-                        /* terminal 96 */ 0x60,
-/* pos 00c6: 160 */    /* 0 */ 0x01  /* (to 0x00C8 state 161) */,
-                       /* 1 */ 0x21  /* (to 0x0108 state 232) */,
-/* pos 00c8: 161 */    /* 0 */ 0x01  /* (to 0x00CA state 162) */,
-                       /* 1 */ 0x1D  /* (to 0x0102 state 224) */,
-/* pos 00ca: 162 */     /* terminal 61 */ 0x3D,
-                        /* terminal 65 */ 0x41,
-/* pos 00cc: 166 */     /* terminal 64 */ 0x40,
-                        /* terminal 91 */ 0x5B,
-/* pos 00ce: 170 */     /* terminal 67 */ 0x43,
-                        /* terminal 68 */ 0x44,
-/* pos 00d0: 173 */    /* 0 */ 0x01  /* (to 0x00D2 state 174) */,
-                       /* 1 */ 0x08  /* (to 0x00E0 state 189) */,
-/* pos 00d2: 174 */    /* 0 */ 0x01  /* (to 0x00D4 state 175) */,
-                       /* 1 */ 0x04  /* (to 0x00DA state 182) */,
-/* pos 00d4: 175 */    /* 0 */ 0x01  /* (to 0x00D6 state 176) */,
-                       /* 1 */ 0x02  /* (to 0x00D8 state 179) */,
-/* pos 00d6: 176 */     /* terminal 69 */ 0x45,
-                        /* terminal 70 */ 0x46,
-/* pos 00d8: 179 */     /* terminal 71 */ 0x47,
-                        /* terminal 72 */ 0x48,
-/* pos 00da: 182 */    /* 0 */ 0x01  /* (to 0x00DC state 183) */,
-                       /* 1 */ 0x02  /* (to 0x00DE state 186) */,
-/* pos 00dc: 183 */     /* terminal 73 */ 0x49,
-                        /* terminal 74 */ 0x4A,
-/* pos 00de: 186 */     /* terminal 75 */ 0x4B,
-                        /* terminal 76 */ 0x4C,
-/* pos 00e0: 189 */    /* 0 */ 0x01  /* (to 0x00E2 state 190) */,
-                       /* 1 */ 0x04  /* (to 0x00E8 state 197) */,
-/* pos 00e2: 190 */    /* 0 */ 0x01  /* (to 0x00E4 state 191) */,
-                       /* 1 */ 0x02  /* (to 0x00E6 state 194) */,
-/* pos 00e4: 191 */     /* terminal 77 */ 0x4D,
-                        /* terminal 78 */ 0x4E,
-/* pos 00e6: 194 */     /* terminal 79 */ 0x4F,
-                        /* terminal 80 */ 0x50,
-/* pos 00e8: 197 */    /* 0 */ 0x01  /* (to 0x00EA state 198) */,
-                       /* 1 */ 0x02  /* (to 0x00EC state 201) */,
-/* pos 00ea: 198 */     /* terminal 81 */ 0x51,
-                        /* terminal 82 */ 0x52,
-/* pos 00ec: 201 */     /* terminal 83 */ 0x53,
-                        /* terminal 84 */ 0x54,
-/* pos 00ee: 204 */    /* 0 */ 0x01  /* (to 0x00F0 state 205) */,
-                       /* 1 */ 0x11  /* (to 0x0110 state 242) */,
-/* pos 00f0: 205 */    /* 0 */ 0x01  /* (to 0x00F2 state 206) */,
-                       /* 1 */ 0x02  /* (to 0x00F4 state 209) */,
-/* pos 00f2: 206 */     /* terminal 85 */ 0x55,
-                        /* terminal 86 */ 0x56,
-/* pos 00f4: 209 */     /* terminal 87 */ 0x57,
-                        /* terminal 89 */ 0x59,
-/* pos 00f6: 211 */     /* terminal 88 */ 0x58,
-                        /* terminal 90 */ 0x5A,
-/* pos 00f8: 216 */    /* 0 */ 0x01  /* (to 0x00FA state 217) */,
-                       /* 1 */ 0x1F  /* (to 0x0136 state 286) */,
-/* pos 00fa: 217 */    /* 0 */ 0x01  /* (to 0x00FC state 218) */,
-                       /* 1 */ 0x17  /* (to 0x0128 state 276) */,
-/* pos 00fc: 218 */     /* terminal 92 */ 0x5C,
-                        /* terminal 195 */ 0xC3,
-/* pos 00fe: 220 */     /* terminal 93 */ 0x5D,
-                        /* terminal 126 */ 0x7E,
-/* pos 0100: 222 */     /* terminal 94 */ 0x5E,
-                        /* terminal 125 */ 0x7D,
-/* pos 0102: 224 */     /* terminal 95 */ 0x5F,
-                        /* terminal 98 */ 0x62,
-/* pos 0104: 229 */    /* 0 */ 0x01  /* (to 0x0106 state 230) */,
-                       /* 1 */ 0x05  /* (to 0x010E state 240) */,
-/* pos 0106: 230 */     /* terminal 99 */ 0x63,
-                        /* terminal 101 */ 0x65,
-/* pos 0108: 232 */    /* 0 */ 0x01  /* (to 0x010A state 233) */,
-                       /* 1 */ 0x02  /* (to 0x010C state 237) */,
-/* pos 010a: 233 */     /* terminal 100 */ 0x64,
-                        /* terminal 102 */ 0x66,
-/* pos 010c: 237 */     /* terminal 103 */ 0x67,
-                        /* terminal 104 */ 0x68,
-/* pos 010e: 240 */     /* terminal 105 */ 0x69,
-                        /* terminal 111 */ 0x6F,
-/* pos 0110: 242 */    /* 0 */ 0x01  /* (to 0x0112 state 243) */,
-                       /* 1 */ 0x05  /* (to 0x011A state 254) */,
-/* pos 0112: 243 */     /* terminal 106 */ 0x6A,
-                        /* terminal 107 */ 0x6B,
-/* pos 0114: 246 */    /* 0 */ 0x01  /* (to 0x0116 state 247) */,
-                       /* 1 */ 0x02  /* (to 0x0118 state 250) */,
-/* pos 0116: 247 */     /* terminal 108 */ 0x6C,
-                        /* terminal 109 */ 0x6D,
-/* pos 0118: 250 */     /* terminal 110 */ 0x6E,
-                        /* terminal 112 */ 0x70,
-/* pos 011a: 254 */     /* terminal 113 */ 0x71,
-                        /* terminal 118 */ 0x76,
-/* pos 011c: 256 */     /* terminal 114 */ 0x72,
-                        /* terminal 117 */ 0x75,
-/* pos 011e: 258 */     /* terminal 115 */ 0x73,
-                        /* terminal 116 */ 0x74,
-/* pos 0120: 263 */    /* 0 */ 0x01  /* (to 0x0122 state 264) */,
-                       /* 1 */ 0x02  /* (to 0x0124 state 267) */,
-/* pos 0122: 264 */     /* terminal 119 */ 0x77,
-                        /* terminal 120 */ 0x78,
-/* pos 0124: 267 */     /* terminal 121 */ 0x79,
-                        /* terminal 122 */ 0x7A,
-/* pos 0126: 274 */     /* terminal 127 */ 0x7F,
-                        /* terminal 220 */ 0xDC,
-/* pos 0128: 276 */     /* terminal 208 */ 0xD0,
-                       /* 1 */ 0x01  /* (to 0x012A state 277) */,
-/* pos 012a: 277 */     /* terminal 128 */ 0x80,
-                        /* terminal 130 */ 0x82,
-/* pos 012c: 279 */    /* 0 */ 0x2E  /* (to 0x0188 state 372) */,
-                       /* 1 */ 0x01  /* (to 0x012E state 280) */,
-/* pos 012e: 280 */    /* 0 */ 0x01  /* (to 0x0130 state 281) */,
-                       /* 1 */ 0x1B  /* (to 0x0164 state 332) */,
-/* pos 0130: 281 */    /* 0 */ 0x01  /* (to 0x0132 state 282) */,
-                       /* 1 */ 0x06  /* (to 0x013C state 291) */,
-/* pos 0132: 282 */     /* terminal 230 */ 0xE6,
-                       /* 1 */ 0x01  /* (to 0x0134 state 283) */,
-/* pos 0134: 283 */     /* terminal 129 */ 0x81,
-                        /* terminal 132 */ 0x84,
-/* pos 0136: 286 */    /* 0 */ 0x01  /* (to 0x0138 state 287) */,
-                       /* 1 */ 0x14  /* (to 0x015E state 328) */,
-/* pos 0138: 287 */    /* 0 */ 0x01  /* (to 0x013A state 288) */,
-                       /* 1 */ 0x30  /* (to 0x0198 state 388) */,
-/* pos 013a: 288 */     /* terminal 131 */ 0x83,
-                        /* terminal 162 */ 0xA2,
-/* pos 013c: 291 */    /* 0 */ 0x01  /* (to 0x013E state 292) */,
-                       /* 1 */ 0x02  /* (to 0x0140 state 296) */,
-/* pos 013e: 292 */     /* terminal 133 */ 0x85,
-                        /* terminal 134 */ 0x86,
-/* pos 0140: 296 */     /* terminal 136 */ 0x88,
-                        /* terminal 146 */ 0x92,
-/* pos 0142: 298 */     /* terminal 137 */ 0x89,
-                        /* terminal 138 */ 0x8A,
-/* pos 0144: 301 */    /* 0 */ 0x01  /* (to 0x0146 state 302) */,
-                       /* 1 */ 0x02  /* (to 0x0148 state 305) */,
-/* pos 0146: 302 */     /* terminal 139 */ 0x8B,
-                        /* terminal 140 */ 0x8C,
-/* pos 0148: 305 */     /* terminal 141 */ 0x8D,
-                        /* terminal 143 */ 0x8F,
-/* pos 014a: 309 */    /* 0 */ 0x01  /* (to 0x014C state 310) */,
-                       /* 1 */ 0x06  /* (to 0x0156 state 319) */,
-/* pos 014c: 310 */     /* terminal 144 */ 0x90,
-                        /* terminal 145 */ 0x91,
-/* pos 014e: 314 */    /* 0 */ 0x01  /* (to 0x0150 state 315) */,
-                       /* 1 */ 0x12  /* (to 0x0172 state 350) */,
-/* pos 0150: 315 */    /* 0 */ 0x01  /* (to 0x0152 state 316) */,
-                       /* 1 */ 0x05  /* (to 0x015A state 325) */,
-/* pos 0152: 316 */    /* 0 */ 0x01  /* (to 0x0154 state 317) */,
-                       /* 1 */ 0x03  /* (to 0x0158 state 322) */,
-/* pos 0154: 317 */     /* terminal 147 */ 0x93,
-                        /* terminal 149 */ 0x95,
-/* pos 0156: 319 */     /* terminal 148 */ 0x94,
-                        /* terminal 159 */ 0x9F,
-/* pos 0158: 322 */     /* terminal 150 */ 0x96,
-                        /* terminal 151 */ 0x97,
-/* pos 015a: 325 */    /* 0 */ 0x01  /* (to 0x015C state 326) */,
-                       /* 1 */ 0x08  /* (to 0x016A state 338) */,
-/* pos 015c: 326 */     /* terminal 152 */ 0x98,
-                        /* terminal 155 */ 0x9B,
-/* pos 015e: 328 */    /* 0 */ 0x42  /* (to 0x01E2 state 465) */,
-                       /* 1 */ 0x01  /* (to 0x0160 state 329) */,
-/* pos 0160: 329 */    /* 0 */ 0x01  /* (to 0x0162 state 330) */,
-                       /* 1 */ 0x0C  /* (to 0x0178 state 355) */,
-/* pos 0162: 330 */     /* terminal 153 */ 0x99,
-                        /* terminal 161 */ 0xA1,
-/* pos 0164: 332 */    /* 0 */ 0x01  /* (to 0x0166 state 333) */,
-                       /* 1 */ 0x05  /* (to 0x016E state 347) */,
-/* pos 0166: 333 */    /* 0 */ 0x01  /* (to 0x0168 state 334) */,
-                       /* 1 */ 0x03  /* (to 0x016C state 342) */,
-/* pos 0168: 334 */     /* terminal 154 */ 0x9A,
-                        /* terminal 156 */ 0x9C,
-/* pos 016a: 338 */     /* terminal 157 */ 0x9D,
-                        /* terminal 158 */ 0x9E,
-/* pos 016c: 342 */     /* terminal 160 */ 0xA0,
-                        /* terminal 163 */ 0xA3,
-/* pos 016e: 347 */    /* 0 */ 0x01  /* (to 0x0170 state 348) */,
-                       /* 1 */ 0x07  /* (to 0x017C state 360) */,
-/* pos 0170: 348 */     /* terminal 164 */ 0xA4,
-                        /* terminal 169 */ 0xA9,
-/* pos 0172: 350 */    /* 0 */ 0x01  /* (to 0x0174 state 351) */,
-                       /* 1 */ 0x09  /* (to 0x0184 state 369) */,
-/* pos 0174: 351 */    /* 0 */ 0x01  /* (to 0x0176 state 352) */,
-                       /* 1 */ 0x03  /* (to 0x017A state 357) */,
-/* pos 0176: 352 */     /* terminal 165 */ 0xA5,
-                        /* terminal 166 */ 0xA6,
-/* pos 0178: 355 */     /* terminal 167 */ 0xA7,
-                        /* terminal 172 */ 0xAC,
-/* pos 017a: 357 */     /* terminal 168 */ 0xA8,
-                        /* terminal 174 */ 0xAE,
-/* pos 017c: 360 */     /* terminal 170 */ 0xAA,
-                        /* terminal 173 */ 0xAD,
-/* pos 017e: 362 */    /* 0 */ 0x01  /* (to 0x0180 state 363) */,
-                       /* 1 */ 0x1B  /* (to 0x01B4 state 417) */,
-/* pos 0180: 363 */    /* 0 */ 0x01  /* (to 0x0182 state 364) */,
-                       /* 1 */ 0x2A  /* (to 0x01D4 state 449) */,
-/* pos 0182: 364 */     /* terminal 171 */ 0xAB,
-                        /* terminal 206 */ 0xCE,
-/* pos 0184: 369 */    /* 0 */ 0x01  /* (to 0x0186 state 370) */,
-                       /* 1 */ 0x09  /* (to 0x0196 state 385) */,
-/* pos 0186: 370 */     /* terminal 175 */ 0xAF,
-                        /* terminal 180 */ 0xB4,
-/* pos 0188: 372 */    /* 0 */ 0x01  /* (to 0x018A state 373) */,
-                       /* 1 */ 0x27  /* (to 0x01D6 state 451) */,
-/* pos 018a: 373 */    /* 0 */ 0x01  /* (to 0x018C state 374) */,
-                       /* 1 */ 0x05  /* (to 0x0194 state 381) */,
-/* pos 018c: 374 */     /* terminal 176 */ 0xB0,
-                        /* terminal 177 */ 0xB1,
-/* pos 018e: 377 */    /* 0 */ 0x01  /* (to 0x0190 state 378) */,
-                       /* 1 */ 0x07  /* (to 0x019C state 393) */,
-/* pos 0190: 378 */    /* 0 */ 0x01  /* (to 0x0192 state 379) */,
-                       /* 1 */ 0x05  /* (to 0x019A state 390) */,
-/* pos 0192: 379 */     /* terminal 178 */ 0xB2,
-                        /* terminal 181 */ 0xB5,
-/* pos 0194: 381 */     /* terminal 179 */ 0xB3,
-                        /* terminal 209 */ 0xD1,
-/* pos 0196: 385 */     /* terminal 182 */ 0xB6,
-                        /* terminal 183 */ 0xB7,
-/* pos 0198: 388 */     /* terminal 184 */ 0xB8,
-                        /* terminal 194 */ 0xC2,
-/* pos 019a: 390 */     /* terminal 185 */ 0xB9,
-                        /* terminal 186 */ 0xBA,
-/* pos 019c: 393 */    /* 0 */ 0x01  /* (to 0x019E state 394) */,
-                       /* 1 */ 0x04  /* (to 0x01A4 state 400) */,
-/* pos 019e: 394 */     /* terminal 187 */ 0xBB,
-                        /* terminal 189 */ 0xBD,
-/* pos 01a0: 396 */    /* 0 */ 0x01  /* (to 0x01A2 state 397) */,
-                       /* 1 */ 0x07  /* (to 0x01AE state 412) */,
-/* pos 01a2: 397 */     /* terminal 188 */ 0xBC,
-                        /* terminal 191 */ 0xBF,
-/* pos 01a4: 400 */     /* terminal 190 */ 0xBE,
-                        /* terminal 196 */ 0xC4,
-/* pos 01a6: 403 */    /* 0 */ 0x01  /* (to 0x01A8 state 404) */,
-                       /* 1 */ 0x0D  /* (to 0x01C0 state 427) */,
-/* pos 01a8: 404 */    /* 0 */ 0x01  /* (to 0x01AA state 405) */,
-                       /* 1 */ 0x0A  /* (to 0x01BC state 424) */,
-/* pos 01aa: 405 */    /* 0 */ 0x01  /* (to 0x01AC state 406) */,
-                       /* 1 */ 0x08  /* (to 0x01BA state 421) */,
-/* pos 01ac: 406 */     /* terminal 192 */ 0xC0,
-                        /* terminal 193 */ 0xC1,
-/* pos 01ae: 412 */     /* terminal 197 */ 0xC5,
-                        /* terminal 231 */ 0xE7,
-/* pos 01b0: 414 */    /* 0 */ 0x01  /* (to 0x01B2 state 415) */,
-                       /* 1 */ 0x1B  /* (to 0x01E6 state 475) */,
-/* pos 01b2: 415 */     /* terminal 198 */ 0xC6,
-                        /* terminal 228 */ 0xE4,
-/* pos 01b4: 417 */    /* 0 */ 0x1B  /* (to 0x01EA state 481) */,
-                       /* 1 */ 0x01  /* (to 0x01B6 state 418) */,
-/* pos 01b6: 418 */    /* 0 */ 0x01  /* (to 0x01B8 state 419) */,
-                       /* 1 */ 0x19  /* (to 0x01E8 state 478) */,
-/* pos 01b8: 419 */     /* terminal 199 */ 0xC7,
-                        /* terminal 207 */ 0xCF,
-/* pos 01ba: 421 */     /* terminal 200 */ 0xC8,
-                        /* terminal 201 */ 0xC9,
-/* pos 01bc: 424 */    /* 0 */ 0x01  /* (to 0x01BE state 425) */,
-                       /* 1 */ 0x06  /* (to 0x01C8 state 438) */,
-/* pos 01be: 425 */     /* terminal 202 */ 0xCA,
-                        /* terminal 205 */ 0xCD,
-/* pos 01c0: 427 */    /* 0 */ 0x0D  /* (to 0x01DA state 455) */,
-                       /* 1 */ 0x01  /* (to 0x01C2 state 428) */,
-/* pos 01c2: 428 */    /* 0 */ 0x17  /* (to 0x01F0 state 490) */,
-                       /* 1 */ 0x01  /* (to 0x01C4 state 429) */,
-/* pos 01c4: 429 */     /* terminal 255 */ 0xFF,
-                       /* 1 */ 0x01  /* (to 0x01C6 state 430) */,
-/* pos 01c6: 430 */     /* terminal 203 */ 0xCB,
-                        /* terminal 204 */ 0xCC,
-/* pos 01c8: 438 */     /* terminal 210 */ 0xD2,
-                        /* terminal 213 */ 0xD5,
-/* pos 01ca: 440 */    /* 0 */ 0x01  /* (to 0x01CC state 441) */,
-                       /* 1 */ 0x14  /* (to 0x01F2 state 494) */,
-/* pos 01cc: 441 */    /* 0 */ 0x01  /* (to 0x01CE state 442) */,
-                       /* 1 */ 0x09  /* (to 0x01DE state 461) */,
-/* pos 01ce: 442 */    /* 0 */ 0x01  /* (to 0x01D0 state 443) */,
-                       /* 1 */ 0x02  /* (to 0x01D2 state 447) */,
-/* pos 01d0: 443 */     /* terminal 211 */ 0xD3,
-                        /* terminal 212 */ 0xD4,
-/* pos 01d2: 447 */     /* terminal 214 */ 0xD6,
-                        /* terminal 221 */ 0xDD,
-/* pos 01d4: 449 */     /* terminal 215 */ 0xD7,
-                        /* terminal 225 */ 0xE1,
-/* pos 01d6: 451 */    /* 0 */ 0x01  /* (to 0x01D8 state 452) */,
-                       /* 1 */ 0x07  /* (to 0x01E4 state 469) */,
-/* pos 01d8: 452 */     /* terminal 216 */ 0xD8,
-                        /* terminal 217 */ 0xD9,
-/* pos 01da: 455 */    /* 0 */ 0x01  /* (to 0x01DC state 456) */,
-                       /* 1 */ 0x09  /* (to 0x01EC state 484) */,
-/* pos 01dc: 456 */     /* terminal 218 */ 0xDA,
-                        /* terminal 219 */ 0xDB,
-/* pos 01de: 461 */    /* 0 */ 0x01  /* (to 0x01E0 state 462) */,
-                       /* 1 */ 0x08  /* (to 0x01EE state 488) */,
-/* pos 01e0: 462 */     /* terminal 222 */ 0xDE,
-                        /* terminal 223 */ 0xDF,
-/* pos 01e2: 465 */     /* terminal 224 */ 0xE0,
-                        /* terminal 226 */ 0xE2,
-/* pos 01e4: 469 */     /* terminal 227 */ 0xE3,
-                        /* terminal 229 */ 0xE5,
-/* pos 01e6: 475 */     /* terminal 232 */ 0xE8,
-                        /* terminal 233 */ 0xE9,
-/* pos 01e8: 478 */     /* terminal 234 */ 0xEA,
-                        /* terminal 235 */ 0xEB,
-/* pos 01ea: 481 */     /* terminal 236 */ 0xEC,
-                        /* terminal 237 */ 0xED,
-/* pos 01ec: 484 */     /* terminal 238 */ 0xEE,
-                        /* terminal 240 */ 0xF0,
-/* pos 01ee: 488 */     /* terminal 241 */ 0xF1,
-                        /* terminal 244 */ 0xF4,
-/* pos 01f0: 490 */     /* terminal 242 */ 0xF2,
-                        /* terminal 243 */ 0xF3,
-/* pos 01f2: 494 */    /* 0 */ 0x01  /* (to 0x01F4 state 495) */,
-                       /* 1 */ 0x04  /* (to 0x01FA state 503) */,
-/* pos 01f4: 495 */    /* 0 */ 0x01  /* (to 0x01F6 state 496) */,
-                       /* 1 */ 0x02  /* (to 0x01F8 state 499) */,
-/* pos 01f6: 496 */     /* terminal 245 */ 0xF5,
-                        /* terminal 246 */ 0xF6,
-/* pos 01f8: 499 */     /* terminal 247 */ 0xF7,
-                        /* terminal 248 */ 0xF8,
-/* pos 01fa: 503 */    /* 0 */ 0x01  /* (to 0x01FC state 504) */,
-                       /* 1 */ 0x02  /* (to 0x01FE state 507) */,
-/* pos 01fc: 504 */     /* terminal 250 */ 0xFA,
-                        /* terminal 251 */ 0xFB,
-/* pos 01fe: 507 */     /* terminal 252 */ 0xFC,
-                        /* terminal 253 */ 0xFD,
-/* total size 512 bytes, biggest jump 200/256, fails=0 */
-};
+/*
+ * Generated by minihuf.c, do not edit
+ *
+ * huftable[state][nibble]: b0-7 next state, b8-10 flags, b16-23 symbol
+ */
 
- static unsigned char lextable_terms[] = {
+#define LWS_HUF_SYM		(1 << 8)  /* symbol completed */
+#define LWS_HUF_ACCEPT		(1 << 9)  /* ok to end here */
+#define LWS_HUF_FAIL		(1 << 10) /* EOS seen */
+#define LWS_HUF_STATE(e)	((e) & 0xff)
+#define LWS_HUF_CHAR(e)		((uint8_t)((e) >> 16))
 
-	0x00, 0x00, 0x00, 0x03, 0x01, 0x00, 0x03, 0x00, 
-	0x34, 0x0f, 0x43, 0x03, 0xf1, 0x3c, 0xfc, 0x3c, 
-	0x0f, 0x30, 0x37, 0xf7, 0x0f, 0xc3, 0xcf, 0x03, 
-	0x3c, 0xfc, 0xc0, 0xf3, 0xf0, 0x3c, 0xfc, 0xf0, 
-	0xcf, 0xfc, 0xcc, 0xff, 0xfc, 0x0d, 0x34, 0xcc, 
-	0xcf, 0x33, 0xf0, 0x33, 0x0c, 0x3f, 0xc3, 0x3f, 
-	0xcc, 0x30, 0xfc, 0xcf, 0x3c, 0xf0, 0x0c, 0xcf, 
-	0xd0, 0x03, 0x3f, 0x33, 0xff, 0xff, 0xc3, 0xf3, 
+static const uint32_t huftable[256][16] = {
+{ /* state 0 */
+	0x00000057, 0x00000058, 0x00000083, 0x00000087,
+	0x0000008f, 0x00000045, 0x00000053, 0x0000005a,
+	0x00000064, 0x00000084, 0x0000008a, 0x0000005f,
+	0x00000069, 0x00000070, 0x00000077, 0x00000204,
+},
+{ /* state 1 */
+	0x00000065, 0x00000081, 0x00000085, 0x00000086,
+	0x0000008b, 0x0000008c, 0x0000008e, 0x00000060,
+	0x0000006a, 0x0000006d, 0x00000071, 0x00000074,
+	0x00000078, 0x00000088, 0x00000090, 0x00000205,
+},
+{ /* state 2 */
+	0x0000006b, 0x0000006c, 0x0000006e, 0x0000006f,
+	0x00000072, 0x00000073, 0x00000075, 0x00000076,
+	0x00000079, 0x0000007a, 0x00000089, 0x0000008d,
+	0x00000091, 0x00000092, 0x0000004b, 0x00000206,
+},
+{ /* state 3 */
+	0x00550300, 0x00560300, 0x00570300, 0x00590300,
+	0x006a0300, 0x006b0300, 0x00710300, 0x00760300,
+	0x00770300, 0x00780300, 0x00790300, 0x007a0300,
+	0x0000004c, 0x00000050, 0x0000007b, 0x00000207,
+},
+{ /* state 4 */
+	0x00770142, 0x00770301, 0x00780142, 0x00780301,
+	0x00790142, 0x00790301, 0x007a0142, 0x007a0301,
+	0x00260300, 0x002a0300, 0x002c0300, 0x003b0300,
+	0x00580300, 0x005a0300, 0x00000047, 0x00000008,
+},
+{ /* state 5 */
+	0x00260142, 0x00260301, 0x002a0142, 0x002a0301,
+	0x002c0142, 0x002c0301, 0x003b0142, 0x003b0301,
+	0x00580142, 0x00580301, 0x005a0142, 0x005a0301,
+	0x00000048, 0x0000004f, 0x0000004d, 0x00000009,
+},
+{ /* state 6 */
+	0x00580155, 0x00580143, 0x0058015d, 0x00580302,
+	0x005a0155, 0x005a0143, 0x005a015d, 0x005a0302,
+	0x00210300, 0x00220300, 0x00280300, 0x00290300,
+	0x003f0300, 0x0000004e, 0x00000049, 0x0000000a,
+},
+{ /* state 7 */
+	0x00210142, 0x00210301, 0x00220142, 0x00220301,
+	0x00280142, 0x00280301, 0x00290142, 0x00290301,
+	0x003f0142, 0x003f0301, 0x00270300, 0x002b0300,
+	0x007c0300, 0x0000004a, 0x0000000b, 0x0000000d,
+},
+{ /* state 8 */
+	0x003f0155, 0x003f0143, 0x003f015d, 0x003f0302,
+	0x00270142, 0x00270301, 0x002b0142, 0x002b0301,
+	0x007c0142, 0x007c0301, 0x00230300, 0x003e0300,
+	0x0000000c, 0x00000066, 0x0000007f, 0x0000000e,
+},
+{ /* state 9 */
+	0x007c0155, 0x007c0143, 0x007c015d, 0x007c0302,
+	0x00230142, 0x00230301, 0x003e0142, 0x003e0301,
+	0x00000300, 0x00240300, 0x00400300, 0x005b0300,
+	0x005d0300, 0x007e0300, 0x00000080, 0x0000000f,
+},
+{ /* state 10 */
+	0x00000142, 0x00000301, 0x00240142, 0x00240301,
+	0x00400142, 0x00400301, 0x005b0142, 0x005b0301,
+	0x005d0142, 0x005d0301, 0x007e0142, 0x007e0301,
+	0x005e0300, 0x007d0300, 0x00000062, 0x00000010,
+},
+{ /* state 11 */
+	0x00000155, 0x00000143, 0x0000015d, 0x00000302,
+	0x00240155, 0x00240143, 0x0024015d, 0x00240302,
+	0x00400155, 0x00400143, 0x0040015d, 0x00400302,
+	0x005b0155, 0x005b0143, 0x005b015d, 0x005b0302,
+},
+{ /* state 12 */
+	0x00000156, 0x00000182, 0x00000144, 0x00000152,
+	0x00000163, 0x0000015e, 0x00000168, 0x00000303,
+	0x00240156, 0x00240182, 0x00240144, 0x00240152,
+	0x00240163, 0x0024015e, 0x00240168, 0x00240303,
+},
+{ /* state 13 */
+	0x005d0155, 0x005d0143, 0x005d015d, 0x005d0302,
+	0x007e0155, 0x007e0143, 0x007e015d, 0x007e0302,
+	0x005e0142, 0x005e0301, 0x007d0142, 0x007d0301,
+	0x003c0300, 0x00600300, 0x007b0300, 0x00000011,
+},
+{ /* state 14 */
+	0x005e0155, 0x005e0143, 0x005e015d, 0x005e0302,
+	0x007d0155, 0x007d0143, 0x007d015d, 0x007d0302,
+	0x003c0142, 0x003c0301, 0x00600142, 0x00600301,
+	0x007b0142, 0x007b0301, 0x0000007c, 0x00000012,
+},
+{ /* state 15 */
+	0x003c0155, 0x003c0143, 0x003c015d, 0x003c0302,
+	0x00600155, 0x00600143, 0x0060015d, 0x00600302,
+	0x007b0155, 0x007b0143, 0x007b015d, 0x007b0302,
+	0x0000007d, 0x0000009b, 0x00000096, 0x00000013,
+},
+{ /* state 16 */
+	0x007b0156, 0x007b0182, 0x007b0144, 0x007b0152,
+	0x007b0163, 0x007b015e, 0x007b0168, 0x007b0303,
+	0x0000007e, 0x00000094, 0x0000009c, 0x000000af,
+	0x000000c4, 0x00000097, 0x00000014, 0x00000019,
+},
+{ /* state 17 */
+	0x005c0300, 0x00c30300, 0x00d00300, 0x00000095,
+	0x0000009d, 0x000000cc, 0x000000f1, 0x000000b0,
+	0x000000c5, 0x000000eb, 0x00000098, 0x000000b2,
+	0x000000c7, 0x00000015, 0x000000a7, 0x0000001a,
+},
+{ /* state 18 */
+	0x000000c6, 0x000000ca, 0x000000ec, 0x000000f2,
+	0x00000099, 0x0000009e, 0x000000b3, 0x000000b7,
+	0x000000c8, 0x000000ce, 0x000000d8, 0x00000016,
+	0x000000a8, 0x000000b9, 0x00000029, 0x0000001b,
+},
+{ /* state 19 */
+	0x000000c9, 0x000000cd, 0x000000cf, 0x000000d2,
+	0x000000d9, 0x000000f3, 0x00000017, 0x000000a2,
+	0x000000a9, 0x000000ad, 0x000000ba, 0x000000c2,
+	0x000000d0, 0x0000002a, 0x000000bf, 0x0000001c,
+},
+{ /* state 20 */
+	0x00b20300, 0x00b50300, 0x00b90300, 0x00ba0300,
+	0x00bb0300, 0x00bd0300, 0x00be0300, 0x00c40300,
+	0x00c60300, 0x00e40300, 0x00e80300, 0x00e90300,
+	0x00000018, 0x000000a1, 0x000000a3, 0x000000a4,
+},
+{ /* state 21 */
+	0x00c60142, 0x00c60301, 0x00e40142, 0x00e40301,
+	0x00e80142, 0x00e80301, 0x00e90142, 0x00e90301,
+	0x00010300, 0x00870300, 0x00890300, 0x008a0300,
+	0x008b0300, 0x008c0300, 0x008d0300, 0x008f0300,
+},
+{ /* state 22 */
+	0x00010142, 0x00010301, 0x00870142, 0x00870301,
+	0x00890142, 0x00890301, 0x008a0142, 0x008a0301,
+	0x008b0142, 0x008b0301, 0x008c0142, 0x008c0301,
+	0x008d0142, 0x008d0301, 0x008f0142, 0x008f0301,
+},
+{ /* state 23 */
+	0x00010155, 0x00010143, 0x0001015d, 0x00010302,
+	0x00870155, 0x00870143, 0x0087015d, 0x00870302,
+	0x00890155, 0x00890143, 0x0089015d, 0x00890302,
+	0x008a0155, 0x008a0143, 0x008a015d, 0x008a0302,
+},
+{ /* state 24 */
+	0x00010156, 0x00010182, 0x00010144, 0x00010152,
+	0x00010163, 0x0001015e, 0x00010168, 0x00010303,
+	0x00870156, 0x00870182, 0x00870144, 0x00870152,
+	0x00870163, 0x0087015e, 0x00870168, 0x00870303,
+},
+{ /* state 25 */
+	0x000000aa, 0x000000ac, 0x000000ae, 0x000000b5,
+	0x000000bb, 0x000000bd, 0x000000c3, 0x000000cb,
+	0x000000d1, 0x000000d7, 0x0000002b, 0x000000a5,
+	0x000000c0, 0x000000da, 0x000000d3, 0x0000001d,
+},
+{ /* state 26 */
+	0x00bc0300, 0x00bf0300, 0x00c50300, 0x00e70300,
+	0x00ef0300, 0x0000002c, 0x000000a6, 0x000000ab,
+	0x000000c1, 0x000000ea, 0x000000f5, 0x000000db,
+	0x000000d4, 0x000000e0, 0x000000e5, 0x0000001e,
+},
+{ /* state 27 */
+	0x00ab0300, 0x00ce0300, 0x00d70300, 0x00e10300,
+	0x00ec0300, 0x00ed0300, 0x000000dc, 0x000000f4,
+	0x000000d5, 0x000000de, 0x000000ed, 0x000000e1,
+	0x000000e6, 0x000000f9, 0x0000001f, 0x0000002d,
+},
+{ /* state 28 */
+	0x000000d6, 0x000000dd, 0x000000df, 0x000000e4,
+	0x000000ee, 0x000000f6, 0x000000f8, 0x000000e2,
+	0x000000e7, 0x000000ef, 0x000000fa, 0x000000fd,
+	0x00000020, 0x00000026, 0x00000037, 0x0000002e,
+},
+{ /* state 29 */
+	0x000000e8, 0x000000e9, 0x000000f0, 0x000000f7,
+	0x000000fb, 0x000000fc, 0x000000fe, 0x000000ff,
+	0x00000021, 0x00000023, 0x00000027, 0x00000034,
+	0x00000038, 0x0000003c, 0x0000003f, 0x0000002f,
+},
+{ /* state 30 */
+	0x00fe0300, 0x00000022, 0x00000024, 0x00000025,
+	0x00000028, 0x00000033, 0x00000035, 0x00000036,
+	0x00000039, 0x0000003a, 0x0000003d, 0x0000003e,
+	0x00000040, 0x00000041, 0x00000093, 0x00000030,
+},
+{ /* state 31 */
+	0x00fe0142, 0x00fe0301, 0x00020300, 0x00030300,
+	0x00040300, 0x00050300, 0x00060300, 0x00070300,
+	0x00080300, 0x000b0300, 0x000c0300, 0x000e0300,
+	0x000f0300, 0x00100300, 0x00110300, 0x00120300,
+},
+{ /* state 32 */
+	0x00fe0155, 0x00fe0143, 0x00fe015d, 0x00fe0302,
+	0x00020142, 0x00020301, 0x00030142, 0x00030301,
+	0x00040142, 0x00040301, 0x00050142, 0x00050301,
+	0x00060142, 0x00060301, 0x00070142, 0x00070301,
+},
+{ /* state 33 */
+	0x00fe0156, 0x00fe0182, 0x00fe0144, 0x00fe0152,
+	0x00fe0163, 0x00fe015e, 0x00fe0168, 0x00fe0303,
+	0x00020155, 0x00020143, 0x0002015d, 0x00020302,
+	0x00030155, 0x00030143, 0x0003015d, 0x00030302,
+},
+{ /* state 34 */
+	0x00020156, 0x00020182, 0x00020144, 0x00020152,
+	0x00020163, 0x0002015e, 0x00020168, 0x00020303,
+	0x00030156, 0x00030182, 0x00030144, 0x00030152,
+	0x00030163, 0x0003015e, 0x00030168, 0x00030303,
+},
+{ /* state 35 */
+	0x00040155, 0x00040143, 0x0004015d, 0x00040302,
+	0x00050155, 0x00050143, 0x0005015d, 0x00050302,
+	0x00060155, 0x00060143, 0x0006015d, 0x00060302,
+	0x00070155, 0x00070143, 0x0007015d, 0x00070302,
+},
+{ /* state 36 */
+	0x00040156, 0x00040182, 0x00040144, 0x00040152,
+	0x00040163, 0x0004015e, 0x00040168, 0x00040303,
+	0x00050156, 0x00050182, 0x00050144, 0x00050152,
+	0x00050163, 0x0005015e, 0x00050168, 0x00050303,
+},
+{ /* state 37 */
+	0x00060156, 0x00060182, 0x00060144, 0x00060152,
+	0x00060163, 0x0006015e, 0x00060168, 0x00060303,
+	0x00070156, 0x00070182, 0x00070144, 0x00070152,
+	0x00070163, 0x0007015e, 0x00070168, 0x00070303,
+},
+{ /* state 38 */
+	0x00080142, 0x00080301, 0x000b0142, 0x000b0301,
+	0x000c0142, 0x000c0301, 0x000e0142, 0x000e0301,
+	0x000f0142, 0x000f0301, 0x00100142, 0x00100301,
+	0x00110142, 0x00110301, 0x00120142, 0x00120301,
+},
+{ /* state 39 */
+	0x00080155, 0x00080143, 0x0008015d, 0x00080302,
+	0x000b0155, 0x000b0143, 0x000b015d, 0x000b0302,
+	0x000c0155, 0x000c0143, 0x000c015d, 0x000c0302,
+	0x000e0155, 0x000e0143, 0x000e015d, 0x000e0302,
+},
+{ /* state 40 */
+	0x00080156, 0x00080182, 0x00080144, 0x00080152,
+	0x00080163, 0x0008015e, 0x00080168, 0x00080303,
+	0x000b0156, 0x000b0182, 0x000b0144, 0x000b0152,
+	0x000b0163, 0x000b015e, 0x000b0168, 0x000b0303,
+},
+{ /* state 41 */
+	0x00bc0142, 0x00bc0301, 0x00bf0142, 0x00bf0301,
+	0x00c50142, 0x00c50301, 0x00e70142, 0x00e70301,
+	0x00ef0142, 0x00ef0301, 0x00090300, 0x008e0300,
+	0x00900300, 0x00910300, 0x00940300, 0x009f0300,
+},
+{ /* state 42 */
+	0x00ef0155, 0x00ef0143, 0x00ef015d, 0x00ef0302,
+	0x00090142, 0x00090301, 0x008e0142, 0x008e0301,
+	0x00900142, 0x00900301, 0x00910142, 0x00910301,
+	0x00940142, 0x00940301, 0x009f0142, 0x009f0301,
+},
+{ /* state 43 */
+	0x00ef0156, 0x00ef0182, 0x00ef0144, 0x00ef0152,
+	0x00ef0163, 0x00ef015e, 0x00ef0168, 0x00ef0303,
+	0x00090155, 0x00090143, 0x0009015d, 0x00090302,
+	0x008e0155, 0x008e0143, 0x008e015d, 0x008e0302,
+},
+{ /* state 44 */
+	0x00090156, 0x00090182, 0x00090144, 0x00090152,
+	0x00090163, 0x0009015e, 0x00090168, 0x00090303,
+	0x008e0156, 0x008e0182, 0x008e0144, 0x008e0152,
+	0x008e0163, 0x008e015e, 0x008e0168, 0x008e0303,
+},
+{ /* state 45 */
+	0x00130300, 0x00140300, 0x00150300, 0x00170300,
+	0x00180300, 0x00190300, 0x001a0300, 0x001b0300,
+	0x001c0300, 0x001d0300, 0x001e0300, 0x001f0300,
+	0x007f0300, 0x00dc0300, 0x00f90300, 0x00000031,
+},
+{ /* state 46 */
+	0x001c0142, 0x001c0301, 0x001d0142, 0x001d0301,
+	0x001e0142, 0x001e0301, 0x001f0142, 0x001f0301,
+	0x007f0142, 0x007f0301, 0x00dc0142, 0x00dc0301,
+	0x00f90142, 0x00f90301, 0x00000032, 0x0000003b,
+},
+{ /* state 47 */
+	0x007f0155, 0x007f0143, 0x007f015d, 0x007f0302,
+	0x00dc0155, 0x00dc0143, 0x00dc015d, 0x00dc0302,
+	0x00f90155, 0x00f90143, 0x00f9015d, 0x00f90302,
+	0x000a0300, 0x000d0300, 0x00160300, 0x00000400,
+},
+{ /* state 48 */
+	0x00f90156, 0x00f90182, 0x00f90144, 0x00f90152,
+	0x00f90163, 0x00f9015e, 0x00f90168, 0x00f90303,
+	0x000a0142, 0x000a0301, 0x000d0142, 0x000d0301,
+	0x00160142, 0x00160301, 0x00000400, 0x00000400,
+},
+{ /* state 49 */
+	0x000a0155, 0x000a0143, 0x000a015d, 0x000a0302,
+	0x000d0155, 0x000d0143, 0x000d015d, 0x000d0302,
+	0x00160155, 0x00160143, 0x0016015d, 0x00160302,
+	0x00000400, 0x00000400, 0x00000400, 0x00000400,
+},
+{ /* state 50 */
+	0x000a0156, 0x000a0182, 0x000a0144, 0x000a0152,
+	0x000a0163, 0x000a015e, 0x000a0168, 0x000a0303,
+	0x000d0156, 0x000d0182, 0x000d0144, 0x000d0152,
+	0x000d0163, 0x000d015e, 0x000d0168, 0x000d0303,
+},
+{ /* state 51 */
+	0x000c0156, 0x000c0182, 0x000c0144, 0x000c0152,
+	0x000c0163, 0x000c015e, 0x000c0168, 0x000c0303,
+	0x000e0156, 0x000e0182, 0x000e0144, 0x000e0152,
+	0x000e0163, 0x000e015e, 0x000e0168, 0x000e0303,
+},
+{ /* state 52 */
+	0x000f0155, 0x000f0143, 0x000f015d, 0x000f0302,
+	0x00100155, 0x00100143, 0x0010015d, 0x00100302,
+	0x00110155, 0x00110143, 0x0011015d, 0x00110302,
+	0x00120155, 0x00120143, 0x0012015d, 0x00120302,
+},
+{ /* state 53 */
+	0x000f0156, 0x000f0182, 0x000f0144, 0x000f0152,
+	0x000f0163, 0x000f015e, 0x000f0168, 0x000f0303,
+	0x00100156, 0x00100182, 0x00100144, 0x00100152,
+	0x00100163, 0x0010015e, 0x00100168, 0x00100303,
+},
+{ /* state 54 */
+	0x00110156, 0x00110182, 0x00110144, 0x00110152,
+	0x00110163, 0x0011015e, 0x00110168, 0x00110303,
+	0x00120156, 0x00120182, 0x00120144, 0x00120152,
+	0x00120163, 0x0012015e, 0x00120168, 0x00120303,
+},
+{ /* state 55 */
+	0x00130142, 0x00130301, 0x00140142, 0x00140301,
+	0x00150142, 0x00150301, 0x00170142, 0x00170301,
+	0x00180142, 0x00180301, 0x00190142, 0x00190301,
+	0x001a0142, 0x001a0301, 0x001b0142, 0x001b0301,
+},
+{ /* state 56 */
+	0x00130155, 0x00130143, 0x0013015d, 0x00130302,
+	0x00140155, 0x00140143, 0x0014015d, 0x00140302,
+	0x00150155, 0x00150143, 0x0015015d, 0x00150302,
+	0x00170155, 0x00170143, 0x0017015d, 0x00170302,
+},
+{ /* state 57 */
+	0x00130156, 0x00130182, 0x00130144, 0x00130152,
+	0x00130163, 0x0013015e, 0x00130168, 0x00130303,
+	0x00140156, 0x00140182, 0x00140144, 0x00140152,
+	0x00140163, 0x0014015e, 0x00140168, 0x00140303,
+},
+{ /* state 58 */
+	0x00150156, 0x00150182, 0x00150144, 0x00150152,
+	0x00150163, 0x0015015e, 0x00150168, 0x00150303,
+	0x00170156, 0x00170182, 0x00170144, 0x00170152,
+	0x00170163, 0x0017015e, 0x00170168, 0x00170303,
+},
+{ /* state 59 */
+	0x00160156, 0x00160182, 0x00160144, 0x00160152,
+	0x00160163, 0x0016015e, 0x00160168, 0x00160303,
+	0x00000400, 0x00000400, 0x00000400, 0x00000400,
+	0x00000400, 0x00000400, 0x00000400, 0x00000400,
+},
+{ /* state 60 */
+	0x00180155, 0x00180143, 0x0018015d, 0x00180302,
+	0x00190155, 0x00190143, 0x0019015d, 0x00190302,
+	0x001a0155, 0x001a0143, 0x001a015d, 0x001a0302,
+	0x001b0155, 0x001b0143, 0x001b015d, 0x001b0302,
+},
+{ /* state 61 */
+	0x00180156, 0x00180182, 0x00180144, 0x00180152,
+	0x00180163, 0x0018015e, 0x00180168, 0x00180303,
+	0x00190156, 0x00190182, 0x00190144, 0x00190152,
+	0x00190163, 0x0019015e, 0x00190168, 0x00190303,
+},
+{ /* state 62 */
+	0x001a0156, 0x001a0182, 0x001a0144, 0x001a0152,
+	0x001a0163, 0x001a015e, 0x001a0168, 0x001a0303,
+	0x001b0156, 0x001b0182, 0x001b0144, 0x001b0152,
+	0x001b0163, 0x001b015e, 0x001b0168, 0x001b0303,
+},
+{ /* state 63 */
+	0x001c0155, 0x001c0143, 0x001c015d, 0x001c0302,
+	0x001d0155, 0x001d0143, 0x001d015d, 0x001d0302,
+	0x001e0155, 0x001e0143, 0x001e015d, 0x001e0302,
+	0x001f0155, 0x001f0143, 0x001f015d, 0x001f0302,
+},
+{ /* state 64 */
+	0x001c0156, 0x001c0182, 0x001c0144, 0x001c0152,
+	0x001c0163, 0x001c015e, 0x001c0168, 0x001c0303,
+	0x001d0156, 0x001d0182, 0x001d0144, 0x001d0152,
+	0x001d0163, 0x001d015e, 0x001d0168, 0x001d0303,
+},
+{ /* state 65 */
+	0x001e0156, 0x001e0182, 0x001e0144, 0x001e0152,
+	0x001e0163, 0x001e015e, 0x001e0168, 0x001e0303,
+	0x001f0156, 0x001f0182, 0x001f0144, 0x001f0152,
+	0x001f0163, 0x001f015e, 0x001f0168, 0x001f0303,
+},
+{ /* state 66 */
+	0x00300300, 0x00310300, 0x00320300, 0x00610300,
+	0x00630300, 0x00650300, 0x00690300, 0x006f0300,
+	0x00730300, 0x00740300, 0x00000046, 0x00000051,
+	0x00000054, 0x00000059, 0x0000005b, 0x0000005c,
+},
+{ /* state 67 */
+	0x00730142, 0x00730301, 0x00740142, 0x00740301,
+	0x00200300, 0x00250300, 0x002d0300, 0x002e0300,
+	0x002f0300, 0x00330300, 0x00340300, 0x00350300,
+	0x00360300, 0x00370300, 0x00380300, 0x00390300,
+},
+{ /* state 68 */
+	0x00730155, 0x00730143, 0x0073015d, 0x00730302,
+	0x00740155, 0x00740143, 0x0074015d, 0x00740302,
+	0x00200142, 0x00200301, 0x00250142, 0x00250301,
+	0x002d0142, 0x002d0301, 0x002e0142, 0x002e0301,
+},
+{ /* state 69 */
+	0x00200155, 0x00200143, 0x0020015d, 0x00200302,
+	0x00250155, 0x00250143, 0x0025015d, 0x00250302,
+	0x002d0155, 0x002d0143, 0x002d015d, 0x002d0302,
+	0x002e0155, 0x002e0143, 0x002e015d, 0x002e0302,
+},
+{ /* state 70 */
+	0x00200156, 0x00200182, 0x00200144, 0x00200152,
+	0x00200163, 0x0020015e, 0x00200168, 0x00200303,
+	0x00250156, 0x00250182, 0x00250144, 0x00250152,
+	0x00250163, 0x0025015e, 0x00250168, 0x00250303,
+},
+{ /* state 71 */
+	0x00210155, 0x00210143, 0x0021015d, 0x00210302,
+	0x00220155, 0x00220143, 0x0022015d, 0x00220302,
+	0x00280155, 0x00280143, 0x0028015d, 0x00280302,
+	0x00290155, 0x00290143, 0x0029015d, 0x00290302,
+},
+{ /* state 72 */
+	0x00210156, 0x00210182, 0x00210144, 0x00210152,
+	0x00210163, 0x0021015e, 0x00210168, 0x00210303,
+	0x00220156, 0x00220182, 0x00220144, 0x00220152,
+	0x00220163, 0x0022015e, 0x00220168, 0x00220303,
+},
+{ /* state 73 */
+	0x007c0156, 0x007c0182, 0x007c0144, 0x007c0152,
+	0x007c0163, 0x007c015e, 0x007c0168, 0x007c0303,
+	0x00230155, 0x00230143, 0x0023015d, 0x00230302,
+	0x003e0155, 0x003e0143, 0x003e015d, 0x003e0302,
+},
+{ /* state 74 */
+	0x00230156, 0x00230182, 0x00230144, 0x00230152,
+	0x00230163, 0x0023015e, 0x00230168, 0x00230303,
+	0x003e0156, 0x003e0182, 0x003e0144, 0x003e0152,
+	0x003e0163, 0x003e015e, 0x003e0168, 0x003e0303,
+},
+{ /* state 75 */
+	0x00260155, 0x00260143, 0x0026015d, 0x00260302,
+	0x002a0155, 0x002a0143, 0x002a015d, 0x002a0302,
+	0x002c0155, 0x002c0143, 0x002c015d, 0x002c0302,
+	0x003b0155, 0x003b0143, 0x003b015d, 0x003b0302,
+},
+{ /* state 76 */
+	0x00260156, 0x00260182, 0x00260144, 0x00260152,
+	0x00260163, 0x0026015e, 0x00260168, 0x00260303,
+	0x002a0156, 0x002a0182, 0x002a0144, 0x002a0152,
+	0x002a0163, 0x002a015e, 0x002a0168, 0x002a0303,
+},
+{ /* state 77 */
+	0x003f0156, 0x003f0182, 0x003f0144, 0x003f0152,
+	0x003f0163, 0x003f015e, 0x003f0168, 0x003f0303,
+	0x00270155, 0x00270143, 0x0027015d, 0x00270302,
+	0x002b0155, 0x002b0143, 0x002b015d, 0x002b0302,
+},
+{ /* state 78 */
+	0x00270156, 0x00270182, 0x00270144, 0x00270152,
+	0x00270163, 0x0027015e, 0x00270168, 0x00270303,
+	0x002b0156, 0x002b0182, 0x002b0144, 0x002b0152,
+	0x002b0163, 0x002b015e, 0x002b0168, 0x002b0303,
+},
+{ /* state 79 */
+	0x00280156, 0x00280182, 0x00280144, 0x00280152,
+	0x00280163, 0x0028015e, 0x00280168, 0x00280303,
+	0x00290156, 0x00290182, 0x00290144, 0x00290152,
+	0x00290163, 0x0029015e, 0x00290168, 0x00290303,
+},
+{ /* state 80 */
+	0x002c0156, 0x002c0182, 0x002c0144, 0x002c0152,
+	0x002c0163, 0x002c015e, 0x002c0168, 0x002c0303,
+	0x003b0156, 0x003b0182, 0x003b0144, 0x003b0152,
+	0x003b0163, 0x003b015e, 0x003b0168, 0x003b0303,
+},
+{ /* state 81 */
+	0x002d0156, 0x002d0182, 0x002d0144, 0x002d0152,
+	0x002d0163, 0x002d015e, 0x002d0168, 0x002d0303,
+	0x002e0156, 0x002e0182, 0x002e0144, 0x002e0152,
+	0x002e0163, 0x002e015e, 0x002e0168, 0x002e0303,
+},
+{ /* state 82 */
+	0x002f0142, 0x002f0301, 0x00330142, 0x00330301,
+	0x00340142, 0x00340301, 0x00350142, 0x00350301,
+	0x00360142, 0x00360301, 0x00370142, 0x00370301,
+	0x00380142, 0x00380301, 0x00390142, 0x00390301,
+},
+{ /* state 83 */
+	0x002f0155, 0x002f0143, 0x002f015d, 0x002f0302,
+	0x00330155, 0x00330143, 0x0033015d, 0x00330302,
+	0x00340155, 0x00340143, 0x0034015d, 0x00340302,
+	0x00350155, 0x00350143, 0x0035015d, 0x00350302,
+},
+{ /* state 84 */
+	0x002f0156, 0x002f0182, 0x002f0144, 0x002f0152,
+	0x002f0163, 0x002f015e, 0x002f0168, 0x002f0303,
+	0x00330156, 0x00330182, 0x00330144, 0x00330152,
+	0x00330163, 0x0033015e, 0x00330168, 0x00330303,
+},
+{ /* state 85 */
+	0x00300142, 0x00300301, 0x00310142, 0x00310301,
+	0x00320142, 0x00320301, 0x00610142, 0x00610301,
+	0x00630142, 0x00630301, 0x00650142, 0x00650301,
+	0x00690142, 0x00690301, 0x006f0142, 0x006f0301,
+},
+{ /* state 86 */
+	0x00300155, 0x00300143, 0x0030015d, 0x00300302,
+	0x00310155, 0x00310143, 0x0031015d, 0x00310302,
+	0x00320155, 0x00320143, 0x0032015d, 0x00320302,
+	0x00610155, 0x00610143, 0x0061015d, 0x00610302,
+},
+{ /* state 87 */
+	0x00300156, 0x00300182, 0x00300144, 0x00300152,
+	0x00300163, 0x0030015e, 0x00300168, 0x00300303,
+	0x00310156, 0x00310182, 0x00310144, 0x00310152,
+	0x00310163, 0x0031015e, 0x00310168, 0x00310303,
+},
+{ /* state 88 */
+	0x00320156, 0x00320182, 0x00320144, 0x00320152,
+	0x00320163, 0x0032015e, 0x00320168, 0x00320303,
+	0x00610156, 0x00610182, 0x00610144, 0x00610152,
+	0x00610163, 0x0061015e, 0x00610168, 0x00610303,
+},
+{ /* state 89 */
+	0x00340156, 0x00340182, 0x00340144, 0x00340152,
+	0x00340163, 0x0034015e, 0x00340168, 0x00340303,
+	0x00350156, 0x00350182, 0x00350144, 0x00350152,
+	0x00350163, 0x0035015e, 0x00350168, 0x00350303,
+},
+{ /* state 90 */
+	0x00360155, 0x00360143, 0x0036015d, 0x00360302,
+	0x00370155, 0x00370143, 0x0037015d, 0x00370302,
+	0x00380155, 0x00380143, 0x0038015d, 0x00380302,
+	0x00390155, 0x00390143, 0x0039015d, 0x00390302,
+},
+{ /* state 91 */
+	0x00360156, 0x00360182, 0x00360144, 0x00360152,
+	0x00360163, 0x0036015e, 0x00360168, 0x00360303,
+	0x00370156, 0x00370182, 0x00370144, 0x00370152,
+	0x00370163, 0x0037015e, 0x00370168, 0x00370303,
+},
+{ /* state 92 */
+	0x00380156, 0x00380182, 0x00380144, 0x00380152,
+	0x00380163, 0x0038015e, 0x00380168, 0x00380303,
+	0x00390156, 0x00390182, 0x00390144, 0x00390152,
+	0x00390163, 0x0039015e, 0x00390168, 0x00390303,
+},
+{ /* state 93 */
+	0x003d0300, 0x00410300, 0x005f0300, 0x00620300,
+	0x00640300, 0x00660300, 0x00670300, 0x00680300,
+	0x006c0300, 0x006d0300, 0x006e0300, 0x00700300,
+	0x00720300, 0x00750300, 0x00000061, 0x00000067,
+},
+{ /* state 94 */
+	0x006c0142, 0x006c0301, 0x006d0142, 0x006d0301,
+	0x006e0142, 0x006e0301, 0x00700142, 0x00700301,
+	0x00720142, 0x00720301, 0x00750142, 0x00750301,
+	0x003a0300, 0x00420300, 0x00430300, 0x00440300,
+},
+{ /* state 95 */
+	0x00720155, 0x00720143, 0x0072015d, 0x00720302,
+	0x00750155, 0x00750143, 0x0075015d, 0x00750302,
+	0x003a0142, 0x003a0301, 0x00420142, 0x00420301,
+	0x00430142, 0x00430301, 0x00440142, 0x00440301,
+},
+{ /* state 96 */
+	0x003a0155, 0x003a0143, 0x003a015d, 0x003a0302,
+	0x00420155, 0x00420143, 0x0042015d, 0x00420302,
+	0x00430155, 0x00430143, 0x0043015d, 0x00430302,
+	0x00440155, 0x00440143, 0x0044015d, 0x00440302,
+},
+{ /* state 97 */
+	0x003a0156, 0x003a0182, 0x003a0144, 0x003a0152,
+	0x003a0163, 0x003a015e, 0x003a0168, 0x003a0303,
+	0x00420156, 0x00420182, 0x00420144, 0x00420152,
+	0x00420163, 0x0042015e, 0x00420168, 0x00420303,
+},
+{ /* state 98 */
+	0x003c0156, 0x003c0182, 0x003c0144, 0x003c0152,
+	0x003c0163, 0x003c015e, 0x003c0168, 0x003c0303,
+	0x00600156, 0x00600182, 0x00600144, 0x00600152,
+	0x00600163, 0x0060015e, 0x00600168, 0x00600303,
+},
+{ /* state 99 */
+	0x003d0142, 0x003d0301, 0x00410142, 0x00410301,
+	0x005f0142, 0x005f0301, 0x00620142, 0x00620301,
+	0x00640142, 0x00640301, 0x00660142, 0x00660301,
+	0x00670142, 0x00670301, 0x00680142, 0x00680301,
+},
+{ /* state 100 */
+	0x003d0155, 0x003d0143, 0x003d015d, 0x003d0302,
+	0x00410155, 0x00410143, 0x0041015d, 0x00410302,
+	0x005f0155, 0x005f0143, 0x005f015d, 0x005f0302,
+	0x00620155, 0x00620143, 0x0062015d, 0x00620302,
+},
+{ /* state 101 */
+	0x003d0156, 0x003d0182, 0x003d0144, 0x003d0152,
+	0x003d0163, 0x003d015e, 0x003d0168, 0x003d0303,
+	0x00410156, 0x00410182, 0x00410144, 0x00410152,
+	0x00410163, 0x0041015e, 0x00410168, 0x00410303,
+},
+{ /* state 102 */
+	0x00400156, 0x00400182, 0x00400144, 0x00400152,
+	0x00400163, 0x0040015e, 0x00400168, 0x00400303,
+	0x005b0156, 0x005b0182, 0x005b0144, 0x005b0152,
+	0x005b0163, 0x005b015e, 0x005b0168, 0x005b0303,
+},
+{ /* state 103 */
+	0x00430156, 0x00430182, 0x00430144, 0x00430152,
+	0x00430163, 0x0043015e, 0x00430168, 0x00430303,
+	0x00440156, 0x00440182, 0x00440144, 0x00440152,
+	0x00440163, 0x0044015e, 0x00440168, 0x00440303,
+},
+{ /* state 104 */
+	0x00450300, 0x00460300, 0x00470300, 0x00480300,
+	0x00490300, 0x004a0300, 0x004b0300, 0x004c0300,
+	0x004d0300, 0x004e0300, 0x004f0300, 0x00500300,
+	0x00510300, 0x00520300, 0x00530300, 0x00540300,
+},
+{ /* state 105 */
+	0x00450142, 0x00450301, 0x00460142, 0x00460301,
+	0x00470142, 0x00470301, 0x00480142, 0x00480301,
+	0x00490142, 0x00490301, 0x004a0142, 0x004a0301,
+	0x004b0142, 0x004b0301, 0x004c0142, 0x004c0301,
+},
+{ /* state 106 */
+	0x00450155, 0x00450143, 0x0045015d, 0x00450302,
+	0x00460155, 0x00460143, 0x0046015d, 0x00460302,
+	0x00470155, 0x00470143, 0x0047015d, 0x00470302,
+	0x00480155, 0x00480143, 0x0048015d, 0x00480302,
+},
+{ /* state 107 */
+	0x00450156, 0x00450182, 0x00450144, 0x00450152,
+	0x00450163, 0x0045015e, 0x00450168, 0x00450303,
+	0x00460156, 0x00460182, 0x00460144, 0x00460152,
+	0x00460163, 0x0046015e, 0x00460168, 0x00460303,
+},
+{ /* state 108 */
+	0x00470156, 0x00470182, 0x00470144, 0x00470152,
+	0x00470163, 0x0047015e, 0x00470168, 0x00470303,
+	0x00480156, 0x00480182, 0x00480144, 0x00480152,
+	0x00480163, 0x0048015e, 0x00480168, 0x00480303,
+},
+{ /* state 109 */
+	0x00490155, 0x00490143, 0x0049015d, 0x00490302,
+	0x004a0155, 0x004a0143, 0x004a015d, 0x004a0302,
+	0x004b0155, 0x004b0143, 0x004b015d, 0x004b0302,
+	0x004c0155, 0x004c0143, 0x004c015d, 0x004c0302,
+},
+{ /* state 110 */
+	0x00490156, 0x00490182, 0x00490144, 0x00490152,
+	0x00490163, 0x0049015e, 0x00490168, 0x00490303,
+	0x004a0156, 0x004a0182, 0x004a0144, 0x004a0152,
+	0x004a0163, 0x004a015e, 0x004a0168, 0x004a0303,
+},
+{ /* state 111 */
+	0x004b0156, 0x004b0182, 0x004b0144, 0x004b0152,
+	0x004b0163, 0x004b015e, 0x004b0168, 0x004b0303,
+	0x004c0156, 0x004c0182, 0x004c0144, 0x004c0152,
+	0x004c0163, 0x004c015e, 0x004c0168, 0x004c0303,
+},
+{ /* state 112 */
+	0x004d0142, 0x004d0301, 0x004e0142, 0x004e0301,
+	0x004f0142, 0x004f0301, 0x00500142, 0x00500301,
+	0x00510142, 0x00510301, 0x00520142, 0x00520301,
+	0x00530142, 0x00530301, 0x00540142, 0x00540301,
+},
+{ /* state 113 */
+	0x004d0155, 0x004d0143, 0x004d015d, 0x004d0302,
+	0x004e0155, 0x004e0143, 0x004e015d, 0x004e0302,
+	0x004f0155, 0x004f0143, 0x004f015d, 0x004f0302,
+	0x00500155, 0x00500143, 0x0050015d, 0x00500302,
+},
+{ /* state 114 */
+	0x004d0156, 0x004d0182, 0x004d0144, 0x004d0152,
+	0x004d0163, 0x004d015e, 0x004d0168, 0x004d0303,
+	0x004e0156, 0x004e0182, 0x004e0144, 0x004e0152,
+	0x004e0163, 0x004e015e, 0x004e0168, 0x004e0303,
+},
+{ /* state 115 */
+	0x004f0156, 0x004f0182, 0x004f0144, 0x004f0152,
+	0x004f0163, 0x004f015e, 0x004f0168, 0x004f0303,
+	0x00500156, 0x00500182, 0x00500144, 0x00500152,
+	0x00500163, 0x0050015e, 0x00500168, 0x00500303,
+},
+{ /* state 116 */
+	0x00510155, 0x00510143, 0x0051015d, 0x00510302,
+	0x00520155, 0x00520143, 0x0052015d, 0x00520302,
+	0x00530155, 0x00530143, 0x0053015d, 0x00530302,
+	0x00540155, 0x00540143, 0x0054015d, 0x00540302,
+},
+{ /* state 117 */
+	0x00510156, 0x00510182, 0x00510144, 0x00510152,
+	0x00510163, 0x0051015e, 0x00510168, 0x00510303,
+	0x00520156, 0x00520182, 0x00520144, 0x00520152,
+	0x00520163, 0x0052015e, 0x00520168, 0x00520303,
+},
+{ /* state 118 */
+	0x00530156, 0x00530182, 0x00530144, 0x00530152,
+	0x00530163, 0x0053015e, 0x00530168, 0x00530303,
+	0x00540156, 0x00540182, 0x00540144, 0x00540152,
+	0x00540163, 0x0054015e, 0x00540168, 0x00540303,
+},
+{ /* state 119 */
+	0x00550142, 0x00550301, 0x00560142, 0x00560301,
+	0x00570142, 0x00570301, 0x00590142, 0x00590301,
+	0x006a0142, 0x006a0301, 0x006b0142, 0x006b0301,
+	0x00710142, 0x00710301, 0x00760142, 0x00760301,
+},
+{ /* state 120 */
+	0x00550155, 0x00550143, 0x0055015d, 0x00550302,
+	0x00560155, 0x00560143, 0x0056015d, 0x00560302,
+	0x00570155, 0x00570143, 0x0057015d, 0x00570302,
+	0x00590155, 0x00590143, 0x0059015d, 0x00590302,
+},
+{ /* state 121 */
+	0x00550156, 0x00550182, 0x00550144, 0x00550152,
+	0x00550163, 0x0055015e, 0x00550168, 0x00550303,
+	0x00560156, 0x00560182, 0x00560144, 0x00560152,
+	0x00560163, 0x0056015e, 0x00560168, 0x00560303,
+},
+{ /* state 122 */
+	0x00570156, 0x00570182, 0x00570144, 0x00570152,
+	0x00570163, 0x0057015e, 0x00570168, 0x00570303,
+	0x00590156, 0x00590182, 0x00590144, 0x00590152,
+	0x00590163, 0x0059015e, 0x00590168, 0x00590303,
+},
+{ /* state 123 */
+	0x00580156, 0x00580182, 0x00580144, 0x00580152,
+	0x00580163, 0x0058015e, 0x00580168, 0x00580303,
+	0x005a0156, 0x005a0182, 0x005a0144, 0x005a0152,
+	0x005a0163, 0x005a015e, 0x005a0168, 0x005a0303,
+},
+{ /* state 124 */
+	0x005c0142, 0x005c0301, 0x00c30142, 0x00c30301,
+	0x00d00142, 0x00d00301, 0x00800300, 0x00820300,
+	0x00830300, 0x00a20300, 0x00b80300, 0x00c20300,
+	0x00e00300, 0x00e20300, 0x000000b1, 0x000000bc,
+},
+{ /* state 125 */
+	0x005c0155, 0x005c0143, 0x005c015d, 0x005c0302,
+	0x00c30155, 0x00c30143, 0x00c3015d, 0x00c30302,
+	0x00d00155, 0x00d00143, 0x00d0015d, 0x00d00302,
+	0x00800142, 0x00800301, 0x00820142, 0x00820301,
+},
+{ /* state 126 */
+	0x005c0156, 0x005c0182, 0x005c0144, 0x005c0152,
+	0x005c0163, 0x005c015e, 0x005c0168, 0x005c0303,
+	0x00c30156, 0x00c30182, 0x00c30144, 0x00c30152,
+	0x00c30163, 0x00c3015e, 0x00c30168, 0x00c30303,
+},
+{ /* state 127 */
+	0x005d0156, 0x005d0182, 0x005d0144, 0x005d0152,
+	0x005d0163, 0x005d015e, 0x005d0168, 0x005d0303,
+	0x007e0156, 0x007e0182, 0x007e0144, 0x007e0152,
+	0x007e0163, 0x007e015e, 0x007e0168, 0x007e0303,
+},
+{ /* state 128 */
+	0x005e0156, 0x005e0182, 0x005e0144, 0x005e0152,
+	0x005e0163, 0x005e015e, 0x005e0168, 0x005e0303,
+	0x007d0156, 0x007d0182, 0x007d0144, 0x007d0152,
+	0x007d0163, 0x007d015e, 0x007d0168, 0x007d0303,
+},
+{ /* state 129 */
+	0x005f0156, 0x005f0182, 0x005f0144, 0x005f0152,
+	0x005f0163, 0x005f015e, 0x005f0168, 0x005f0303,
+	0x00620156, 0x00620182, 0x00620144, 0x00620152,
+	0x00620163, 0x0062015e, 0x00620168, 0x00620303,
+},
+{ /* state 130 */
+	0x00630155, 0x00630143, 0x0063015d, 0x00630302,
+	0x00650155, 0x00650143, 0x0065015d, 0x00650302,
+	0x00690155, 0x00690143, 0x0069015d, 0x00690302,
+	0x006f0155, 0x006f0143, 0x006f015d, 0x006f0302,
+},
+{ /* state 131 */
+	0x00630156, 0x00630182, 0x00630144, 0x00630152,
+	0x00630163, 0x0063015e, 0x00630168, 0x00630303,
+	0x00650156, 0x00650182, 0x00650144, 0x00650152,
+	0x00650163, 0x0065015e, 0x00650168, 0x00650303,
+},
+{ /* state 132 */
+	0x00640155, 0x00640143, 0x0064015d, 0x00640302,
+	0x00660155, 0x00660143, 0x0066015d, 0x00660302,
+	0x00670155, 0x00670143, 0x0067015d, 0x00670302,
+	0x00680155, 0x00680143, 0x0068015d, 0x00680302,
+},
+{ /* state 133 */
+	0x00640156, 0x00640182, 0x00640144, 0x00640152,
+	0x00640163, 0x0064015e, 0x00640168, 0x00640303,
+	0x00660156, 0x00660182, 0x00660144, 0x00660152,
+	0x00660163, 0x0066015e, 0x00660168, 0x00660303,
+},
+{ /* state 134 */
+	0x00670156, 0x00670182, 0x00670144, 0x00670152,
+	0x00670163, 0x0067015e, 0x00670168, 0x00670303,
+	0x00680156, 0x00680182, 0x00680144, 0x00680152,
+	0x00680163, 0x0068015e, 0x00680168, 0x00680303,
+},
+{ /* state 135 */
+	0x00690156, 0x00690182, 0x00690144, 0x00690152,
+	0x00690163, 0x0069015e, 0x00690168, 0x00690303,
+	0x006f0156, 0x006f0182, 0x006f0144, 0x006f0152,
+	0x006f0163, 0x006f015e, 0x006f0168, 0x006f0303,
+},
+{ /* state 136 */
+	0x006a0155, 0x006a0143, 0x006a015d, 0x006a0302,
+	0x006b0155, 0x006b0143, 0x006b015d, 0x006b0302,
+	0x00710155, 0x00710143, 0x0071015d, 0x00710302,
+	0x00760155, 0x00760143, 0x0076015d, 0x00760302,
+},
+{ /* state 137 */
+	0x006a0156, 0x006a0182, 0x006a0144, 0x006a0152,
+	0x006a0163, 0x006a015e, 0x006a0168, 0x006a0303,
+	0x006b0156, 0x006b0182, 0x006b0144, 0x006b0152,
+	0x006b0163, 0x006b015e, 0x006b0168, 0x006b0303,
+},
+{ /* state 138 */
+	0x006c0155, 0x006c0143, 0x006c015d, 0x006c0302,
+	0x006d0155, 0x006d0143, 0x006d015d, 0x006d0302,
+	0x006e0155, 0x006e0143, 0x006e015d, 0x006e0302,
+	0x00700155, 0x00700143, 0x0070015d, 0x00700302,
+},
+{ /* state 139 */
+	0x006c0156, 0x006c0182, 0x006c0144, 0x006c0152,
+	0x006c0163, 0x006c015e, 0x006c0168, 0x006c0303,
+	0x006d0156, 0x006d0182, 0x006d0144, 0x006d0152,
+	0x006d0163, 0x006d015e, 0x006d0168, 0x006d0303,
+},
+{ /* state 140 */
+	0x006e0156, 0x006e0182, 0x006e0144, 0x006e0152,
+	0x006e0163, 0x006e015e, 0x006e0168, 0x006e0303,
+	0x00700156, 0x00700182, 0x00700144, 0x00700152,
+	0x00700163, 0x0070015e, 0x00700168, 0x00700303,
+},
+{ /* state 141 */
+	0x00710156, 0x00710182, 0x00710144, 0x00710152,
+	0x00710163, 0x0071015e, 0x00710168, 0x00710303,
+	0x00760156, 0x00760182, 0x00760144, 0x00760152,
+	0x00760163, 0x0076015e, 0x00760168, 0x00760303,
+},
+{ /* state 142 */
+	0x00720156, 0x00720182, 0x00720144, 0x00720152,
+	0x00720163, 0x0072015e, 0x00720168, 0x00720303,
+	0x00750156, 0x00750182, 0x00750144, 0x00750152,
+	0x00750163, 0x0075015e, 0x00750168, 0x00750303,
+},
+{ /* state 143 */
+	0x00730156, 0x00730182, 0x00730144, 0x00730152,
+	0x00730163, 0x0073015e, 0x00730168, 0x00730303,
+	0x00740156, 0x00740182, 0x00740144, 0x00740152,
+	0x00740163, 0x0074015e, 0x00740168, 0x00740303,
+},
+{ /* state 144 */
+	0x00770155, 0x00770143, 0x0077015d, 0x00770302,
+	0x00780155, 0x00780143, 0x0078015d, 0x00780302,
+	0x00790155, 0x00790143, 0x0079015d, 0x00790302,
+	0x007a0155, 0x007a0143, 0x007a015d, 0x007a0302,
+},
+{ /* state 145 */
+	0x00770156, 0x00770182, 0x00770144, 0x00770152,
+	0x00770163, 0x0077015e, 0x00770168, 0x00770303,
+	0x00780156, 0x00780182, 0x00780144, 0x00780152,
+	0x00780163, 0x0078015e, 0x00780168, 0x00780303,
+},
+{ /* state 146 */
+	0x00790156, 0x00790182, 0x00790144, 0x00790152,
+	0x00790163, 0x0079015e, 0x00790168, 0x00790303,
+	0x007a0156, 0x007a0182, 0x007a0144, 0x007a0152,
+	0x007a0163, 0x007a015e, 0x007a0168, 0x007a0303,
+},
+{ /* state 147 */
+	0x007f0156, 0x007f0182, 0x007f0144, 0x007f0152,
+	0x007f0163, 0x007f015e, 0x007f0168, 0x007f0303,
+	0x00dc0156, 0x00dc0182, 0x00dc0144, 0x00dc0152,
+	0x00dc0163, 0x00dc015e, 0x00dc0168, 0x00dc0303,
+},
+{ /* state 148 */
+	0x00d00156, 0x00d00182, 0x00d00144, 0x00d00152,
+	0x00d00163, 0x00d0015e, 0x00d00168, 0x00d00303,
+	0x00800155, 0x00800143, 0x0080015d, 0x00800302,
+	0x00820155, 0x00820143, 0x0082015d, 0x00820302,
+},
+{ /* state 149 */
+	0x00800156, 0x00800182, 0x00800144, 0x00800152,
+	0x00800163, 0x0080015e, 0x00800168, 0x00800303,
+	0x00820156, 0x00820182, 0x00820144, 0x00820152,
+	0x00820163, 0x0082015e, 0x00820168, 0x00820303,
+},
+{ /* state 150 */
+	0x00b00300, 0x00b10300, 0x00b30300, 0x00d10300,
+	0x00d80300, 0x00d90300, 0x00e30300, 0x00e50300,
+	0x00e60300, 0x0000009a, 0x0000009f, 0x000000a0,
+	0x000000b4, 0x000000b6, 0x000000b8, 0x000000be,
+},
+{ /* state 151 */
+	0x00e60142, 0x00e60301, 0x00810300, 0x00840300,
+	0x00850300, 0x00860300, 0x00880300, 0x00920300,
+	0x009a0300, 0x009c0300, 0x00a00300, 0x00a30300,
+	0x00a40300, 0x00a90300, 0x00aa0300, 0x00ad0300,
+},
+{ /* state 152 */
+	0x00e60155, 0x00e60143, 0x00e6015d, 0x00e60302,
+	0x00810142, 0x00810301, 0x00840142, 0x00840301,
+	0x00850142, 0x00850301, 0x00860142, 0x00860301,
+	0x00880142, 0x00880301, 0x00920142, 0x00920301,
+},
+{ /* state 153 */
+	0x00e60156, 0x00e60182, 0x00e60144, 0x00e60152,
+	0x00e60163, 0x00e6015e, 0x00e60168, 0x00e60303,
+	0x00810155, 0x00810143, 0x0081015d, 0x00810302,
+	0x00840155, 0x00840143, 0x0084015d, 0x00840302,
+},
+{ /* state 154 */
+	0x00810156, 0x00810182, 0x00810144, 0x00810152,
+	0x00810163, 0x0081015e, 0x00810168, 0x00810303,
+	0x00840156, 0x00840182, 0x00840144, 0x00840152,
+	0x00840163, 0x0084015e, 0x00840168, 0x00840303,
+},
+{ /* state 155 */
+	0x00830142, 0x00830301, 0x00a20142, 0x00a20301,
+	0x00b80142, 0x00b80301, 0x00c20142, 0x00c20301,
+	0x00e00142, 0x00e00301, 0x00e20142, 0x00e20301,
+	0x00990300, 0x00a10300, 0x00a70300, 0x00ac0300,
+},
+{ /* state 156 */
+	0x00830155, 0x00830143, 0x0083015d, 0x00830302,
+	0x00a20155, 0x00a20143, 0x00a2015d, 0x00a20302,
+	0x00b80155, 0x00b80143, 0x00b8015d, 0x00b80302,
+	0x00c20155, 0x00c20143, 0x00c2015d, 0x00c20302,
+},
+{ /* state 157 */
+	0x00830156, 0x00830182, 0x00830144, 0x00830152,
+	0x00830163, 0x0083015e, 0x00830168, 0x00830303,
+	0x00a20156, 0x00a20182, 0x00a20144, 0x00a20152,
+	0x00a20163, 0x00a2015e, 0x00a20168, 0x00a20303,
+},
+{ /* state 158 */
+	0x00850155, 0x00850143, 0x0085015d, 0x00850302,
+	0x00860155, 0x00860143, 0x0086015d, 0x00860302,
+	0x00880155, 0x00880143, 0x0088015d, 0x00880302,
+	0x00920155, 0x00920143, 0x0092015d, 0x00920302,
+},
+{ /* state 159 */
+	0x00850156, 0x00850182, 0x00850144, 0x00850152,
+	0x00850163, 0x0085015e, 0x00850168, 0x00850303,
+	0x00860156, 0x00860182, 0x00860144, 0x00860152,
+	0x00860163, 0x0086015e, 0x00860168, 0x00860303,
+},
+{ /* state 160 */
+	0x00880156, 0x00880182, 0x00880144, 0x00880152,
+	0x00880163, 0x0088015e, 0x00880168, 0x00880303,
+	0x00920156, 0x00920182, 0x00920144, 0x00920152,
+	0x00920163, 0x0092015e, 0x00920168, 0x00920303,
+},
+{ /* state 161 */
+	0x00890156, 0x00890182, 0x00890144, 0x00890152,
+	0x00890163, 0x0089015e, 0x00890168, 0x00890303,
+	0x008a0156, 0x008a0182, 0x008a0144, 0x008a0152,
+	0x008a0163, 0x008a015e, 0x008a0168, 0x008a0303,
+},
+{ /* state 162 */
+	0x008b0155, 0x008b0143, 0x008b015d, 0x008b0302,
+	0x008c0155, 0x008c0143, 0x008c015d, 0x008c0302,
+	0x008d0155, 0x008d0143, 0x008d015d, 0x008d0302,
+	0x008f0155, 0x008f0143, 0x008f015d, 0x008f0302,
+},
+{ /* state 163 */
+	0x008b0156, 0x008b0182, 0x008b0144, 0x008b0152,
+	0x008b0163, 0x008b015e, 0x008b0168, 0x008b0303,
+	0x008c0156, 0x008c0182, 0x008c0144, 0x008c0152,
+	0x008c0163, 0x008c015e, 0x008c0168, 0x008c0303,
+},
+{ /* state 164 */
+	0x008d0156, 0x008d0182, 0x008d0144, 0x008d0152,
+	0x008d0163, 0x008d015e, 0x008d0168, 0x008d0303,
+	0x008f0156, 0x008f0182, 0x008f0144, 0x008f0152,
+	0x008f0163, 0x008f015e, 0x008f0168, 0x008f0303,
+},
+{ /* state 165 */
+	0x00900155, 0x00900143, 0x0090015d, 0x00900302,
+	0x00910155, 0x00910143, 0x0091015d, 0x00910302,
+	0x00940155, 0x00940143, 0x0094015d, 0x00940302,
+	0x009f0155, 0x009f0143, 0x009f015d, 0x009f0302,
+},
+{ /* state 166 */
+	0x00900156, 0x00900182, 0x00900144, 0x00900152,
+	0x00900163, 0x0090015e, 0x00900168, 0x00900303,
+	0x00910156, 0x00910182, 0x00910144, 0x00910152,
+	0x00910163, 0x0091015e, 0x00910168, 0x00910303,
+},
+{ /* state 167 */
+	0x00930300, 0x00950300, 0x00960300, 0x00970300,
+	0x00980300, 0x009b0300, 0x009d0300, 0x009e0300,
+	0x00a50300, 0x00a60300, 0x00a80300, 0x00ae0300,
+	0x00af0300, 0x00b40300, 0x00b60300, 0x00b70300,
+},
+{ /* state 168 */
+	0x00930142, 0x00930301, 0x00950142, 0x00950301,
+	0x00960142, 0x00960301, 0x00970142, 0x00970301,
+	0x00980142, 0x00980301, 0x009b0142, 0x009b0301,
+	0x009d0142, 0x009d0301, 0x009e0142, 0x009e0301,
+},
+{ /* state 169 */
+	0x00930155, 0x00930143, 0x0093015d, 0x00930302,
+	0x00950155, 0x00950143, 0x0095015d, 0x00950302,
+	0x00960155, 0x00960143, 0x0096015d, 0x00960302,
+	0x00970155, 0x00970143, 0x0097015d, 0x00970302,
+},
+{ /* state 170 */
+	0x00930156, 0x00930182, 0x00930144, 0x00930152,
+	0x00930163, 0x0093015e, 0x00930168, 0x00930303,
+	0x00950156, 0x00950182, 0x00950144, 0x00950152,
+	0x00950163, 0x0095015e, 0x00950168, 0x00950303,
+},
+{ /* state 171 */
+	0x00940156, 0x00940182, 0x00940144, 0x00940152,
+	0x00940163, 0x0094015e, 0x00940168, 0x00940303,
+	0x009f0156, 0x009f0182, 0x009f0144, 0x009f0152,
+	0x009f0163, 0x009f015e, 0x009f0168, 0x009f0303,
+},
+{ /* state 172 */
+	0x00960156, 0x00960182, 0x00960144, 0x00960152,
+	0x00960163, 0x0096015e, 0x00960168, 0x00960303,
+	0x00970156, 0x00970182, 0x00970144, 0x00970152,
+	0x00970163, 0x0097015e, 0x00970168, 0x00970303,
+},
+{ /* state 173 */
+	0x00980155, 0x00980143, 0x0098015d, 0x00980302,
+	0x009b0155, 0x009b0143, 0x009b015d, 0x009b0302,
+	0x009d0155, 0x009d0143, 0x009d015d, 0x009d0302,
+	0x009e0155, 0x009e0143, 0x009e015d, 0x009e0302,
+},
+{ /* state 174 */
+	0x00980156, 0x00980182, 0x00980144, 0x00980152,
+	0x00980163, 0x0098015e, 0x00980168, 0x00980303,
+	0x009b0156, 0x009b0182, 0x009b0144, 0x009b0152,
+	0x009b0163, 0x009b015e, 0x009b0168, 0x009b0303,
+},
+{ /* state 175 */
+	0x00e00155, 0x00e00143, 0x00e0015d, 0x00e00302,
+	0x00e20155, 0x00e20143, 0x00e2015d, 0x00e20302,
+	0x00990142, 0x00990301, 0x00a10142, 0x00a10301,
+	0x00a70142, 0x00a70301, 0x00ac0142, 0x00ac0301,
+},
+{ /* state 176 */
+	0x00990155, 0x00990143, 0x0099015d, 0x00990302,
+	0x00a10155, 0x00a10143, 0x00a1015d, 0x00a10302,
+	0x00a70155, 0x00a70143, 0x00a7015d, 0x00a70302,
+	0x00ac0155, 0x00ac0143, 0x00ac015d, 0x00ac0302,
+},
+{ /* state 177 */
+	0x00990156, 0x00990182, 0x00990144, 0x00990152,
+	0x00990163, 0x0099015e, 0x00990168, 0x00990303,
+	0x00a10156, 0x00a10182, 0x00a10144, 0x00a10152,
+	0x00a10163, 0x00a1015e, 0x00a10168, 0x00a10303,
+},
+{ /* state 178 */
+	0x009a0142, 0x009a0301, 0x009c0142, 0x009c0301,
+	0x00a00142, 0x00a00301, 0x00a30142, 0x00a30301,
+	0x00a40142, 0x00a40301, 0x00a90142, 0x00a90301,
+	0x00aa0142, 0x00aa0301, 0x00ad0142, 0x00ad0301,
+},
+{ /* state 179 */
+	0x009a0155, 0x009a0143, 0x009a015d, 0x009a0302,
+	0x009c0155, 0x009c0143, 0x009c015d, 0x009c0302,
+	0x00a00155, 0x00a00143, 0x00a0015d, 0x00a00302,
+	0x00a30155, 0x00a30143, 0x00a3015d, 0x00a30302,
+},
+{ /* state 180 */
+	0x009a0156, 0x009a0182, 0x009a0144, 0x009a0152,
+	0x009a0163, 0x009a015e, 0x009a0168, 0x009a0303,
+	0x009c0156, 0x009c0182, 0x009c0144, 0x009c0152,
+	0x009c0163, 0x009c015e, 0x009c0168, 0x009c0303,
+},
+{ /* state 181 */
+	0x009d0156, 0x009d0182, 0x009d0144, 0x009d0152,
+	0x009d0163, 0x009d015e, 0x009d0168, 0x009d0303,
+	0x009e0156, 0x009e0182, 0x009e0144, 0x009e0152,
+	0x009e0163, 0x009e015e, 0x009e0168, 0x009e0303,
+},
+{ /* state 182 */
+	0x00a00156, 0x00a00182, 0x00a00144, 0x00a00152,
+	0x00a00163, 0x00a0015e, 0x00a00168, 0x00a00303,
+	0x00a30156, 0x00a30182, 0x00a30144, 0x00a30152,
+	0x00a30163, 0x00a3015e, 0x00a30168, 0x00a30303,
+},
+{ /* state 183 */
+	0x00a40155, 0x00a40143, 0x00a4015d, 0x00a40302,
+	0x00a90155, 0x00a90143, 0x00a9015d, 0x00a90302,
+	0x00aa0155, 0x00aa0143, 0x00aa015d, 0x00aa0302,
+	0x00ad0155, 0x00ad0143, 0x00ad015d, 0x00ad0302,
+},
+{ /* state 184 */
+	0x00a40156, 0x00a40182, 0x00a40144, 0x00a40152,
+	0x00a40163, 0x00a4015e, 0x00a40168, 0x00a40303,
+	0x00a90156, 0x00a90182, 0x00a90144, 0x00a90152,
+	0x00a90163, 0x00a9015e, 0x00a90168, 0x00a90303,
+},
+{ /* state 185 */
+	0x00a50142, 0x00a50301, 0x00a60142, 0x00a60301,
+	0x00a80142, 0x00a80301, 0x00ae0142, 0x00ae0301,
+	0x00af0142, 0x00af0301, 0x00b40142, 0x00b40301,
+	0x00b60142, 0x00b60301, 0x00b70142, 0x00b70301,
+},
+{ /* state 186 */
+	0x00a50155, 0x00a50143, 0x00a5015d, 0x00a50302,
+	0x00a60155, 0x00a60143, 0x00a6015d, 0x00a60302,
+	0x00a80155, 0x00a80143, 0x00a8015d, 0x00a80302,
+	0x00ae0155, 0x00ae0143, 0x00ae015d, 0x00ae0302,
+},
+{ /* state 187 */
+	0x00a50156, 0x00a50182, 0x00a50144, 0x00a50152,
+	0x00a50163, 0x00a5015e, 0x00a50168, 0x00a50303,
+	0x00a60156, 0x00a60182, 0x00a60144, 0x00a60152,
+	0x00a60163, 0x00a6015e, 0x00a60168, 0x00a60303,
+},
+{ /* state 188 */
+	0x00a70156, 0x00a70182, 0x00a70144, 0x00a70152,
+	0x00a70163, 0x00a7015e, 0x00a70168, 0x00a70303,
+	0x00ac0156, 0x00ac0182, 0x00ac0144, 0x00ac0152,
+	0x00ac0163, 0x00ac015e, 0x00ac0168, 0x00ac0303,
+},
+{ /* state 189 */
+	0x00a80156, 0x00a80182, 0x00a80144, 0x00a80152,
+	0x00a80163, 0x00a8015e, 0x00a80168, 0x00a80303,
+	0x00ae0156, 0x00ae0182, 0x00ae0144, 0x00ae0152,
+	0x00ae0163, 0x00ae015e, 0x00ae0168, 0x00ae0303,
+},
+{ /* state 190 */
+	0x00aa0156, 0x00aa0182, 0x00aa0144, 0x00aa0152,
+	0x00aa0163, 0x00aa015e, 0x00aa0168, 0x00aa0303,
+	0x00ad0156, 0x00ad0182, 0x00ad0144, 0x00ad0152,
+	0x00ad0163, 0x00ad015e, 0x00ad0168, 0x00ad0303,
+},
+{ /* state 191 */
+	0x00ab0142, 0x00ab0301, 0x00ce0142, 0x00ce0301,
+	0x00d70142, 0x00d70301, 0x00e10142, 0x00e10301,
+	0x00ec0142, 0x00ec0301, 0x00ed0142, 0x00ed0301,
+	0x00c70300, 0x00cf0300, 0x00ea0300, 0x00eb0300,
+},
+{ /* state 192 */
+	0x00ab0155, 0x00ab0143, 0x00ab015d, 0x00ab0302,
+	0x00ce0155, 0x00ce0143, 0x00ce015d, 0x00ce0302,
+	0x00d70155, 0x00d70143, 0x00d7015d, 0x00d70302,
+	0x00e10155, 0x00e10143, 0x00e1015d, 0x00e10302,
+},
+{ /* state 193 */
+	0x00ab0156, 0x00ab0182, 0x00ab0144, 0x00ab0152,
+	0x00ab0163, 0x00ab015e, 0x00ab0168, 0x00ab0303,
+	0x00ce0156, 0x00ce0182, 0x00ce0144, 0x00ce0152,
+	0x00ce0163, 0x00ce015e, 0x00ce0168, 0x00ce0303,
+},
+{ /* state 194 */
+	0x00af0155, 0x00af0143, 0x00af015d, 0x00af0302,
+	0x00b40155, 0x00b40143, 0x00b4015d, 0x00b40302,
+	0x00b60155, 0x00b60143, 0x00b6015d, 0x00b60302,
+	0x00b70155, 0x00b70143, 0x00b7015d, 0x00b70302,
+},
+{ /* state 195 */
+	0x00af0156, 0x00af0182, 0x00af0144, 0x00af0152,
+	0x00af0163, 0x00af015e, 0x00af0168, 0x00af0303,
+	0x00b40156, 0x00b40182, 0x00b40144, 0x00b40152,
+	0x00b40163, 0x00b4015e, 0x00b40168, 0x00b40303,
+},
+{ /* state 196 */
+	0x00b00142, 0x00b00301, 0x00b10142, 0x00b10301,
+	0x00b30142, 0x00b30301, 0x00d10142, 0x00d10301,
+	0x00d80142, 0x00d80301, 0x00d90142, 0x00d90301,
+	0x00e30142, 0x00e30301, 0x00e50142, 0x00e50301,
+},
+{ /* state 197 */
+	0x00b00155, 0x00b00143, 0x00b0015d, 0x00b00302,
+	0x00b10155, 0x00b10143, 0x00b1015d, 0x00b10302,
+	0x00b30155, 0x00b30143, 0x00b3015d, 0x00b30302,
+	0x00d10155, 0x00d10143, 0x00d1015d, 0x00d10302,
+},
+{ /* state 198 */
+	0x00b00156, 0x00b00182, 0x00b00144, 0x00b00152,
+	0x00b00163, 0x00b0015e, 0x00b00168, 0x00b00303,
+	0x00b10156, 0x00b10182, 0x00b10144, 0x00b10152,
+	0x00b10163, 0x00b1015e, 0x00b10168, 0x00b10303,
+},
+{ /* state 199 */
+	0x00b20142, 0x00b20301, 0x00b50142, 0x00b50301,
+	0x00b90142, 0x00b90301, 0x00ba0142, 0x00ba0301,
+	0x00bb0142, 0x00bb0301, 0x00bd0142, 0x00bd0301,
+	0x00be0142, 0x00be0301, 0x00c40142, 0x00c40301,
+},
+{ /* state 200 */
+	0x00b20155, 0x00b20143, 0x00b2015d, 0x00b20302,
+	0x00b50155, 0x00b50143, 0x00b5015d, 0x00b50302,
+	0x00b90155, 0x00b90143, 0x00b9015d, 0x00b90302,
+	0x00ba0155, 0x00ba0143, 0x00ba015d, 0x00ba0302,
+},
+{ /* state 201 */
+	0x00b20156, 0x00b20182, 0x00b20144, 0x00b20152,
+	0x00b20163, 0x00b2015e, 0x00b20168, 0x00b20303,
+	0x00b50156, 0x00b50182, 0x00b50144, 0x00b50152,
+	0x00b50163, 0x00b5015e, 0x00b50168, 0x00b50303,
+},
+{ /* state 202 */
+	0x00b30156, 0x00b30182, 0x00b30144, 0x00b30152,
+	0x00b30163, 0x00b3015e, 0x00b30168, 0x00b30303,
+	0x00d10156, 0x00d10182, 0x00d10144, 0x00d10152,
+	0x00d10163, 0x00d1015e, 0x00d10168, 0x00d10303,
+},
+{ /* state 203 */
+	0x00b60156, 0x00b60182, 0x00b60144, 0x00b60152,
+	0x00b60163, 0x00b6015e, 0x00b60168, 0x00b60303,
+	0x00b70156, 0x00b70182, 0x00b70144, 0x00b70152,
+	0x00b70163, 0x00b7015e, 0x00b70168, 0x00b70303,
+},
+{ /* state 204 */
+	0x00b80156, 0x00b80182, 0x00b80144, 0x00b80152,
+	0x00b80163, 0x00b8015e, 0x00b80168, 0x00b80303,
+	0x00c20156, 0x00c20182, 0x00c20144, 0x00c20152,
+	0x00c20163, 0x00c2015e, 0x00c20168, 0x00c20303,
+},
+{ /* state 205 */
+	0x00b90156, 0x00b90182, 0x00b90144, 0x00b90152,
+	0x00b90163, 0x00b9015e, 0x00b90168, 0x00b90303,
+	0x00ba0156, 0x00ba0182, 0x00ba0144, 0x00ba0152,
+	0x00ba0163, 0x00ba015e, 0x00ba0168, 0x00ba0303,
+},
+{ /* state 206 */
+	0x00bb0155, 0x00bb0143, 0x00bb015d, 0x00bb0302,
+	0x00bd0155, 0x00bd0143, 0x00bd015d, 0x00bd0302,
+	0x00be0155, 0x00be0143, 0x00be015d, 0x00be0302,
+	0x00c40155, 0x00c40143, 0x00c4015d, 0x00c40302,
+},
+{ /* state 207 */
+	0x00bb0156, 0x00bb0182, 0x00bb0144, 0x00bb0152,
+	0x00bb0163, 0x00bb015e, 0x00bb0168, 0x00bb0303,
+	0x00bd0156, 0x00bd0182, 0x00bd0144, 0x00bd0152,
+	0x00bd0163, 0x00bd015e, 0x00bd0168, 0x00bd0303,
+},
+{ /* state 208 */
+	0x00bc0155, 0x00bc0143, 0x00bc015d, 0x00bc0302,
+	0x00bf0155, 0x00bf0143, 0x00bf015d, 0x00bf0302,
+	0x00c50155, 0x00c50143, 0x00c5015d, 0x00c50302,
+	0x00e70155, 0x00e70143, 0x00e7015d, 0x00e70302,
+},
+{ /* state 209 */
+	0x00bc0156, 0x00bc0182, 0x00bc0144, 0x00bc0152,
+	0x00bc0163, 0x00bc015e, 0x00bc0168, 0x00bc0303,
+	0x00bf0156, 0x00bf0182, 0x00bf0144, 0x00bf0152,
+	0x00bf0163, 0x00bf015e, 0x00bf0168, 0x00bf0303,
+},
+{ /* state 210 */
+	0x00be0156, 0x00be0182, 0x00be0144, 0x00be0152,
+	0x00be0163, 0x00be015e, 0x00be0168, 0x00be0303,
+	0x00c40156, 0x00c40182, 0x00c40144, 0x00c40152,
+	0x00c40163, 0x00c4015e, 0x00c40168, 0x00c40303,
+},
+{ /* state 211 */
+	0x00c00300, 0x00c10300, 0x00c80300, 0x00c90300,
+	0x00ca0300, 0x00cd0300, 0x00d20300, 0x00d50300,
+	0x00da0300, 0x00db0300, 0x00ee0300, 0x00f00300,
+	0x00f20300, 0x00f30300, 0x00ff0300, 0x000000e3,
+},
+{ /* state 212 */
+	0x00c00142, 0x00c00301, 0x00c10142, 0x00c10301,
+	0x00c80142, 0x00c80301, 0x00c90142, 0x00c90301,
+	0x00ca0142, 0x00ca0301, 0x00cd0142, 0x00cd0301,
+	0x00d20142, 0x00d20301, 0x00d50142, 0x00d50301,
+},
+{ /* state 213 */
+	0x00c00155, 0x00c00143, 0x00c0015d, 0x00c00302,
+	0x00c10155, 0x00c10143, 0x00c1015d, 0x00c10302,
+	0x00c80155, 0x00c80143, 0x00c8015d, 0x00c80302,
+	0x00c90155, 0x00c90143, 0x00c9015d, 0x00c90302,
+},
+{ /* state 214 */
+	0x00c00156, 0x00c00182, 0x00c00144, 0x00c00152,
+	0x00c00163, 0x00c0015e, 0x00c00168, 0x00c00303,
+	0x00c10156, 0x00c10182, 0x00c10144, 0x00c10152,
+	0x00c10163, 0x00c1015e, 0x00c10168, 0x00c10303,
+},
+{ /* state 215 */
+	0x00c50156, 0x00c50182, 0x00c50144, 0x00c50152,
+	0x00c50163, 0x00c5015e, 0x00c50168, 0x00c50303,
+	0x00e70156, 0x00e70182, 0x00e70144, 0x00e70152,
+	0x00e70163, 0x00e7015e, 0x00e70168, 0x00e70303,
+},
+{ /* state 216 */
+	0x00c60155, 0x00c60143, 0x00c6015d, 0x00c60302,
+	0x00e40155, 0x00e40143, 0x00e4015d, 0x00e40302,
+	0x00e80155, 0x00e80143, 0x00e8015d, 0x00e80302,
+	0x00e90155, 0x00e90143, 0x00e9015d, 0x00e90302,
+},
+{ /* state 217 */
+	0x00c60156, 0x00c60182, 0x00c60144, 0x00c60152,
+	0x00c60163, 0x00c6015e, 0x00c60168, 0x00c60303,
+	0x00e40156, 0x00e40182, 0x00e40144, 0x00e40152,
+	0x00e40163, 0x00e4015e, 0x00e40168, 0x00e40303,
+},
+{ /* state 218 */
+	0x00ec0155, 0x00ec0143, 0x00ec015d, 0x00ec0302,
+	0x00ed0155, 0x00ed0143, 0x00ed015d, 0x00ed0302,
+	0x00c70142, 0x00c70301, 0x00cf0142, 0x00cf0301,
+	0x00ea0142, 0x00ea0301, 0x00eb0142, 0x00eb0301,
+},
+{ /* state 219 */
+	0x00c70155, 0x00c70143, 0x00c7015d, 0x00c70302,
+	0x00cf0155, 0x00cf0143, 0x00cf015d, 0x00cf0302,
+	0x00ea0155, 0x00ea0143, 0x00ea015d, 0x00ea0302,
+	0x00eb0155, 0x00eb0143, 0x00eb015d, 0x00eb0302,
+},
+{ /* state 220 */
+	0x00c70156, 0x00c70182, 0x00c70144, 0x00c70152,
+	0x00c70163, 0x00c7015e, 0x00c70168, 0x00c70303,
+	0x00cf0156, 0x00cf0182, 0x00cf0144, 0x00cf0152,
+	0x00cf0163, 0x00cf015e, 0x00cf0168, 0x00cf0303,
+},
+{ /* state 221 */
+	0x00c80156, 0x00c80182, 0x00c80144, 0x00c80152,
+	0x00c80163, 0x00c8015e, 0x00c80168, 0x00c80303,
+	0x00c90156, 0x00c90182, 0x00c90144, 0x00c90152,
+	0x00c90163, 0x00c9015e, 0x00c90168, 0x00c90303,
+},
+{ /* state 222 */
+	0x00ca0155, 0x00ca0143, 0x00ca015d, 0x00ca0302,
+	0x00cd0155, 0x00cd0143, 0x00cd015d, 0x00cd0302,
+	0x00d20155, 0x00d20143, 0x00d2015d, 0x00d20302,
+	0x00d50155, 0x00d50143, 0x00d5015d, 0x00d50302,
+},
+{ /* state 223 */
+	0x00ca0156, 0x00ca0182, 0x00ca0144, 0x00ca0152,
+	0x00ca0163, 0x00ca015e, 0x00ca0168, 0x00ca0303,
+	0x00cd0156, 0x00cd0182, 0x00cd0144, 0x00cd0152,
+	0x00cd0163, 0x00cd015e, 0x00cd0168, 0x00cd0303,
+},
+{ /* state 224 */
+	0x00da0142, 0x00da0301, 0x00db0142, 0x00db0301,
+	0x00ee0142, 0x00ee0301, 0x00f00142, 0x00f00301,
+	0x00f20142, 0x00f20301, 0x00f30142, 0x00f30301,
+	0x00ff0142, 0x00ff0301, 0x00cb0300, 0x00cc0300,
+},
+{ /* state 225 */
+	0x00f20155, 0x00f20143, 0x00f2015d, 0x00f20302,
+	0x00f30155, 0x00f30143, 0x00f3015d, 0x00f30302,
+	0x00ff0155, 0x00ff0143, 0x00ff015d, 0x00ff0302,
+	0x00cb0142, 0x00cb0301, 0x00cc0142, 0x00cc0301,
+},
+{ /* state 226 */
+	0x00ff0156, 0x00ff0182, 0x00ff0144, 0x00ff0152,
+	0x00ff0163, 0x00ff015e, 0x00ff0168, 0x00ff0303,
+	0x00cb0155, 0x00cb0143, 0x00cb015d, 0x00cb0302,
+	0x00cc0155, 0x00cc0143, 0x00cc015d, 0x00cc0302,
+},
+{ /* state 227 */
+	0x00cb0156, 0x00cb0182, 0x00cb0144, 0x00cb0152,
+	0x00cb0163, 0x00cb015e, 0x00cb0168, 0x00cb0303,
+	0x00cc0156, 0x00cc0182, 0x00cc0144, 0x00cc0152,
+	0x00cc0163, 0x00cc015e, 0x00cc0168, 0x00cc0303,
+},
+{ /* state 228 */
+	0x00d20156, 0x00d20182, 0x00d20144, 0x00d20152,
+	0x00d20163, 0x00d2015e, 0x00d20168, 0x00d20303,
+	0x00d50156, 0x00d50182, 0x00d50144, 0x00d50152,
+	0x00d50163, 0x00d5015e, 0x00d50168, 0x00d50303,
+},
+{ /* state 229 */
+	0x00d30300, 0x00d40300, 0x00d60300, 0x00dd0300,
+	0x00de0300, 0x00df0300, 0x00f10300, 0x00f40300,
+	0x00f50300, 0x00f60300, 0x00f70300, 0x00f80300,
+	0x00fa0300, 0x00fb0300, 0x00fc0300, 0x00fd0300,
+},
+{ /* state 230 */
+	0x00d30142, 0x00d30301, 0x00d40142, 0x00d40301,
+	0x00d60142, 0x00d60301, 0x00dd0142, 0x00dd0301,
+	0x00de0142, 0x00de0301, 0x00df0142, 0x00df0301,
+	0x00f10142, 0x00f10301, 0x00f40142, 0x00f40301,
+},
+{ /* state 231 */
+	0x00d30155, 0x00d30143, 0x00d3015d, 0x00d30302,
+	0x00d40155, 0x00d40143, 0x00d4015d, 0x00d40302,
+	0x00d60155, 0x00d60143, 0x00d6015d, 0x00d60302,
+	0x00dd0155, 0x00dd0143, 0x00dd015d, 0x00dd0302,
+},
+{ /* state 232 */
+	0x00d30156, 0x00d30182, 0x00d30144, 0x00d30152,
+	0x00d30163, 0x00d3015e, 0x00d30168, 0x00d30303,
+	0x00d40156, 0x00d40182, 0x00d40144, 0x00d40152,
+	0x00d40163, 0x00d4015e, 0x00d40168, 0x00d40303,
+},
+{ /* state 233 */
+	0x00d60156, 0x00d60182, 0x00d60144, 0x00d60152,
+	0x00d60163, 0x00d6015e, 0x00d60168, 0x00d60303,
+	0x00dd0156, 0x00dd0182, 0x00dd0144, 0x00dd0152,
+	0x00dd0163, 0x00dd015e, 0x00dd0168, 0x00dd0303,
+},
+{ /* state 234 */
+	0x00d70156, 0x00d70182, 0x00d70144, 0x00d70152,
+	0x00d70163, 0x00d7015e, 0x00d70168, 0x00d70303,
+	0x00e10156, 0x00e10182, 0x00e10144, 0x00e10152,
+	0x00e10163, 0x00e1015e, 0x00e10168, 0x00e10303,
+},
+{ /* state 235 */
+	0x00d80155, 0x00d80143, 0x00d8015d, 0x00d80302,
+	0x00d90155, 0x00d90143, 0x00d9015d, 0x00d90302,
+	0x00e30155, 0x00e30143, 0x00e3015d, 0x00e30302,
+	0x00e50155, 0x00e50143, 0x00e5015d, 0x00e50302,
+},
+{ /* state 236 */
+	0x00d80156, 0x00d80182, 0x00d80144, 0x00d80152,
+	0x00d80163, 0x00d8015e, 0x00d80168, 0x00d80303,
+	0x00d90156, 0x00d90182, 0x00d90144, 0x00d90152,
+	0x00d90163, 0x00d9015e, 0x00d90168, 0x00d90303,
+},
+{ /* state 237 */
+	0x00da0155, 0x00da0143, 0x00da015d, 0x00da0302,
+	0x00db0155, 0x00db0143, 0x00db015d, 0x00db0302,
+	0x00ee0155, 0x00ee0143, 0x00ee015d, 0x00ee0302,
+	0x00f00155, 0x00f00143, 0x00f0015d, 0x00f00302,
+},
+{ /* state 238 */
+	0x00da0156, 0x00da0182, 0x00da0144, 0x00da0152,
+	0x00da0163, 0x00da015e, 0x00da0168, 0x00da0303,
+	0x00db0156, 0x00db0182, 0x00db0144, 0x00db0152,
+	0x00db0163, 0x00db015e, 0x00db0168, 0x00db0303,
+},
+{ /* state 239 */
+	0x00de0155, 0x00de0143, 0x00de015d, 0x00de0302,
+	0x00df0155, 0x00df0143, 0x00df015d, 0x00df0302,
+	0x00f10155, 0x00f10143, 0x00f1015d, 0x00f10302,
+	0x00f40155, 0x00f40143, 0x00f4015d, 0x00f40302,
+},
+{ /* state 240 */
+	0x00de0156, 0x00de0182, 0x00de0144, 0x00de0152,
+	0x00de0163, 0x00de015e, 0x00de0168, 0x00de0303,
+	0x00df0156, 0x00df0182, 0x00df0144, 0x00df0152,
+	0x00df0163, 0x00df015e, 0x00df0168, 0x00df0303,
+},
+{ /* state 241 */
+	0x00e00156, 0x00e00182, 0x00e00144, 0x00e00152,
+	0x00e00163, 0x00e0015e, 0x00e00168, 0x00e00303,
+	0x00e20156, 0x00e20182, 0x00e20144, 0x00e20152,
+	0x00e20163, 0x00e2015e, 0x00e20168, 0x00e20303,
+},
+{ /* state 242 */
+	0x00e30156, 0x00e30182, 0x00e30144, 0x00e30152,
+	0x00e30163, 0x00e3015e, 0x00e30168, 0x00e30303,
+	0x00e50156, 0x00e50182, 0x00e50144, 0x00e50152,
+	0x00e50163, 0x00e5015e, 0x00e50168, 0x00e50303,
+},
+{ /* state 243 */
+	0x00e80156, 0x00e80182, 0x00e80144, 0x00e80152,
+	0x00e80163, 0x00e8015e, 0x00e80168, 0x00e80303,
+	0x00e90156, 0x00e90182, 0x00e90144, 0x00e90152,
+	0x00e90163, 0x00e9015e, 0x00e90168, 0x00e90303,
+},
+{ /* state 244 */
+	0x00ea0156, 0x00ea0182, 0x00ea0144, 0x00ea0152,
+	0x00ea0163, 0x00ea015e, 0x00ea0168, 0x00ea0303,
+	0x00eb0156, 0x00eb0182, 0x00eb0144, 0x00eb0152,
+	0x00eb0163, 0x00eb015e, 0x00eb0168, 0x00eb0303,
+},
+{ /* state 245 */
+	0x00ec0156, 0x00ec0182, 0x00ec0144, 0x00ec0152,
+	0x00ec0163, 0x00ec015e, 0x00ec0168, 0x00ec0303,
+	0x00ed0156, 0x00ed0182, 0x00ed0144, 0x00ed0152,
+	0x00ed0163, 0x00ed015e, 0x00ed0168, 0x00ed0303,
+},
+{ /* state 246 */
+	0x00ee0156, 0x00ee0182, 0x00ee0144, 0x00ee0152,
+	0x00ee0163, 0x00ee015e, 0x00ee0168, 0x00ee0303,
+	0x00f00156, 0x00f00182, 0x00f00144, 0x00f00152,
+	0x00f00163, 0x00f0015e, 0x00f00168, 0x00f00303,
+},
+{ /* state 247 */
+	0x00f10156, 0x00f10182, 0x00f10144, 0x00f10152,
+	0x00f10163, 0x00f1015e, 0x00f10168, 0x00f10303,
+	0x00f40156, 0x00f40182, 0x00f40144, 0x00f40152,
+	0x00f40163, 0x00f4015e, 0x00f40168, 0x00f40303,
+},
+{ /* state 248 */
+	0x00f20156, 0x00f20182, 0x00f20144, 0x00f20152,
+	0x00f20163, 0x00f2015e, 0x00f20168, 0x00f20303,
+	0x00f30156, 0x00f30182, 0x00f30144, 0x00f30152,
+	0x00f30163, 0x00f3015e, 0x00f30168, 0x00f30303,
+},
+{ /* state 249 */
+	0x00f50142, 0x00f50301, 0x00f60142, 0x00f60301,
+	0x00f70142, 0x00f70301, 0x00f80142, 0x00f80301,
+	0x00fa0142, 0x00fa0301, 0x00fb0142, 0x00fb0301,
+	0x00fc0142, 0x00fc0301, 0x00fd0142, 0x00fd0301,
+},
+{ /* state 250 */
+	0x00f50155, 0x00f50143, 0x00f5015d, 0x00f50302,
+	0x00f60155, 0x00f60143, 0x00f6015d, 0x00f60302,
+	0x00f70155, 0x00f70143, 0x00f7015d, 0x00f70302,
+	0x00f80155, 0x00f80143, 0x00f8015d, 0x00f80302,
+},
+{ /* state 251 */
+	0x00f50156, 0x00f50182, 0x00f50144, 0x00f50152,
+	0x00f50163, 0x00f5015e, 0x00f50168, 0x00f50303,
+	0x00f60156, 0x00f60182, 0x00f60144, 0x00f60152,
+	0x00f60163, 0x00f6015e, 0x00f60168, 0x00f60303,
+},
+{ /* state 252 */
+	0x00f70156, 0x00f70182, 0x00f70144, 0x00f70152,
+	0x00f70163, 0x00f7015e, 0x00f70168, 0x00f70303,
+	0x00f80156, 0x00f80182, 0x00f80144, 0x00f80152,
+	0x00f80163, 0x00f8015e, 0x00f80168, 0x00f80303,
+},
+{ /* state 253 */
+	0x00fa0155, 0x00fa0143, 0x00fa015d, 0x00fa0302,
+	0x00fb0155, 0x00fb0143, 0x00fb015d, 0x00fb0302,
+	0x00fc0155, 0x00fc0143, 0x00fc015d, 0x00fc0302,
+	0x00fd0155, 0x00fd0143, 0x00fd015d, 0x00fd0302,
+},
+{ /* state 254 */
+	0x00fa0156, 0x00fa0182, 0x00fa0144, 0x00fa0152,
+	0x00fa0163, 0x00fa015e, 0x00fa0168, 0x00fa0303,
+	0x00fb0156, 0x00fb0182, 0x00fb0144, 0x00fb0152,
+	0x00fb0163, 0x00fb015e, 0x00fb0168, 0x00fb0303,
+},
+{ /* state 255 */
+	0x00fc0156, 0x00fc0182, 0x00fc0144, 0x00fc0152,
+	0x00fc0163, 0x00fc015e, 0x00fc0168, 0x00fc0303,
+	0x00fd0156, 0x00fd0182, 0x00fd0144, 0x00fd0152,
+	0x00fd0163, 0x00fd015e, 0x00fd0168, 0x00fd0303,
+},
 };
-
-/* state that points to 0x100 for disambiguation with 0x0 */
-#define HUFTABLE_0x100_PREV 118
@@ -1,15 +1,22 @@
 /*
- * minilex.c
+ * minihuf.c
  *
- * High efficiency lexical state parser
+ * Generates the HPACK Huffman decode state machine
  *
- * Copyright (C)2011-2014 Andy Green <andy@warmcat.com>
+ * Copyright (C)2011-2026 Andy Green <andy@warmcat.com>
  *
  * Licensed under MIT
  *
  * Usage: gcc minihuf.c -o minihuf && ./minihuf > huftable.h
  *
- * Run it twice to test parsing on the generated table on stderr
+ * The decoder walks the code tree a nibble at a time.  Each state is an
+ * interior node of the tree, and for each of the 16 possible next nibbles
+ * the table gives the node it ends up at, and the symbol if it completed one
+ * on the way.  The shortest code is 5 bits, so a nibble can complete at most
+ * one symbol.
+ *
+ * It checks every symbol, and a string of all of them, decode correctly using
+ * the generated table on stderr
  */
 
 #include <stdio.h>
@@ -298,219 +305,214 @@ int code_bit(int idx, int bit)
 	return -1;
 }
 
-#include "huftable.h"
+/*
+ * Each entry is packed in a uint32_t so the decoder needs one load per nibble
+ */
 
-#define PARALLEL 2
+#define LWS_HUF_SYM	(1 << 8)
+#define LWS_HUF_ACCEPT	(1 << 9)
+#define LWS_HUF_FAIL	(1 << 10)
 
-struct state {
-	int terminal;
-	int state[PARALLEL];
-	int bytepos;
+#define EOS		0x100
+#define NONE		0xffff
 
-	int real_pos;
+struct node {
+	int child[2];
+	int sym;	/* leaf: symbol, else -1 */
+	int ones;	/* depth if reached by all 1s from the root, else -1 */
+	int fsm;	/* interior: fsm state index */
 };
 
-struct state state[2000];
-unsigned char terms[2000];
-int next = 1;
+struct fsm {
+	unsigned char state;
+	unsigned int flags;
+	unsigned char sym;
+};
+
+static struct node node[600];
+static struct fsm fsm[256][16];
+static int fsm_node[256];
+static int nodes = 1, states;
+
+static int
+decode(const unsigned char *in, int len, unsigned char *out)
+{
+	int s = 0, n, o = 0, accept = 1;
+	const struct fsm *f;
+
+	for (n = 0; n < len * 2; n++) {
+		f = &fsm[s][n & 1 ? in[n >> 1] & 0xf : in[n >> 1] >> 4];
+		if (f->flags & LWS_HUF_FAIL)
+			return -1;
+		if (f->flags & LWS_HUF_SYM)
+			out[o++] = f->sym;
+		s = f->state;
+		accept = !!(f->flags & LWS_HUF_ACCEPT);
+	}
+
+	return accept ? o : -1;
+}
 
-int lextable_decode(int pos, char c)
+static int
+encode(const int *syms, int count, unsigned char *out)
 {
-	int q = pos + !!c;
+	int n, m, bits = 0;
+
+	memset(out, 0xff, 1024);
 
-	if (lextable_terms[q >> 3] & (1 << (q & 7))) /* terminal */
-		return lextable[q] | 0x8000;
+	for (n = 0; n < count; n++)
+		for (m = 0; m < huf_literal[syms[n]].len; m++, bits++)
+			if (!code_bit(syms[n], m))
+				out[bits >> 3] &= ~(0x80 >> (bits & 7));
 
-	return pos + (lextable[q] << 1);
+	return (bits + 7) >> 3;
 }
 
 int main(void)
 {
-	int n = 0;
-	int m = 0;
-	int prev;
-	char c;
-	int walk;
-	int saw;
-	int y;
-	int j;
-	int pos = 0;
-	int biggest = 0;
-	int fails = 0;
-
-	m = 0;
-	while (m < LWS_ARRAY_SIZE(state)) {
-		for (j = 0; j < PARALLEL; j++) {
-			state[m].state[j] = 0xffff;
-			state[m].terminal = 0;
-		}
-		m++;
+	unsigned char enc[1024], dec[1024];
+	int n, m, b, walk, syms[256], len;
+	struct fsm *f;
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(node); n++) {
+		node[n].child[0] = node[n].child[1] = NONE;
+		node[n].sym = -1;
+		node[n].ones = -1;
 	}
+	node[0].ones = 0;
 
-	while (n < LWS_ARRAY_SIZE(huf_literal)) {
+	/* build the code tree */
 
-		m = 0;
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(huf_literal); n++) {
 		walk = 0;
-		prev = 0;
-
-		while (m < huf_literal[n].len) {
-
-			saw = 0;
-			if (state[walk].state[code_bit(n, m)] != 0xffff) {
-				/* exists -- go forward */
-				walk = state[walk].state[code_bit(n, m)];
-				goto again;
+		for (m = 0; m < huf_literal[n].len; m++) {
+			b = code_bit(n, m);
+			if (node[walk].child[b] == NONE) {
+				node[walk].child[b] = nodes;
+				if (b && node[walk].ones >= 0)
+					node[nodes].ones = node[walk].ones + 1;
+				nodes++;
 			}
-
-			/* something we didn't see before */
-
-			state[walk].state[code_bit(n, m)] = next;
-			walk = next++;
-again:
-			m++;
+			walk = node[walk].child[b];
 		}
-
-		state[walk].terminal = n++;
-		state[walk].state[0] = 0; /* terminal marker */
+		node[walk].sym = n;
 	}
 
-	walk = 0;
-	for (n = 0; n < next; n++) {
-		state[n].bytepos = walk;
-		walk += (2 * 2);
-	}
-
-	/* compute everyone's position first */
-
-	pos = 0;
-	walk = 0;
-	for (n = 0; n < next; n++) {
-
-		state[n].real_pos = pos;
+	/* the interior nodes are the fsm states, the root is state 0 */
 
-		if (state[n].state[0]) /* nonterminal */
-			pos += 2;
-
-		walk ++;
+	for (n = 0; n < nodes; n++) {
+		if (node[n].sym >= 0)
+			continue;
+		if (node[n].child[0] == NONE || node[n].child[1] == NONE) {
+			fprintf(stderr, "incomplete code at node %d\n", n);
+			return 1;
+		}
+		if (states == 256) {
+			fprintf(stderr, "too many states\n");
+			return 1;
+		}
+		node[n].fsm = states;
+		fsm_node[states++] = n;
 	}
 
-	fprintf(stdout, "static unsigned char lextable[] = {\n");
+	for (n = 0; n < states; n++)
+		for (m = 0; m < 16; m++) {
+			f = &fsm[n][m];
+			walk = fsm_node[n];
 
-#define TERMINAL_MASK 0x8000
+			for (b = 3; b >= 0; b--) {
+				walk = node[walk].child[(m >> b) & 1];
+				if (node[walk].sym < 0)
+					continue;
 
-	walk = 0;
-	pos = 0;
-
-	for (n = 0; n < next; n++) {
-		for (m = 0; m < 2; m++) {
-			saw = state[n].state[m];
-
-			if (saw == 0) { // c is a terminal then
-				m = 2;
-				continue;
-			}
-			if (!m)
-				fprintf(stdout, "/* pos %04x: %3d */ ",
-							  state[n].real_pos, n);
-			else
-				fprintf(stdout, "                    ");
-
-			if (saw == 0xffff) {
-				fprintf(stdout,
-				  "   0xff, 0xff, /* 0 = fail */\n                    ");
-				pos ++; /* fail */
-				fails++;
-				continue;
+				if (node[walk].sym == EOS) {
+					f->flags = LWS_HUF_FAIL;
+					break;
+				}
+				if (f->flags & LWS_HUF_SYM) {
+					fprintf(stderr, "two symbols in nibble\n");
+					return 1;
+				}
+				f->flags |= LWS_HUF_SYM;
+				f->sym = (unsigned char)node[walk].sym;
+				walk = 0;
 			}
 
-			if (state[saw].state[0] == 0) { /* points to terminal */
-				fprintf(stdout, "    /* terminal %d */ 0x%02X,\n",
-					state[saw].terminal,
-					state[saw].terminal & 0xff);
-				terms[(state[n].real_pos + m) >> 3] |=
-					1 << ((state[n].real_pos + m) & 7);
-				pos++;
-				walk++;
+			if (f->flags & LWS_HUF_FAIL)
 				continue;
-			}
-
-			j = (state[saw].real_pos - q) >> 1;
-
-			if (j > biggest)
-				biggest = j;
 
-			if (j > 0xffff) {
-				fprintf(stderr,
-				  "Jump > 64K bytes ahead (%d to %d)\n",
-					state[n].real_pos, state[saw].real_pos);
-				return 1;
-			}
-
-			fprintf(stdout, "   /* %d */ 0x%02X  "
-				"/* (to 0x%04X state %3d) */,\n",
-				m,
-				j & 0xff,
-				state[saw].real_pos, saw);
-			pos++;
-
-			walk++;
+			f->state = (unsigned char)node[walk].fsm;
+			/* padding must be < 8 bits of the EOS code, ie, 1s */
+			if (node[walk].ones >= 0 && node[walk].ones < 8)
+				f->flags |= LWS_HUF_ACCEPT;
 		}
-	}
-
-	fprintf(stdout, "/* total size %d bytes, biggest jump %d/256, fails=%d */\n};\n"
-			"\n static unsigned char lextable_terms[] = {\n",
-	 		pos, biggest, fails);
 
-	for (n = 0; n < (walk + 7) / 8; n++) {
-		if (!(n & 7))
-			fprintf(stdout, "\n\t");
-		fprintf(stdout, "0x%02x, ", terms[n]);
+	fprintf(stdout, "/*\n * Generated by minihuf.c, do not edit\n"
+			" *\n * huftable[state][nibble]: b0-7 next state, "
+			"b8-10 flags, b16-23 symbol\n */\n\n"
+			"#define LWS_HUF_SYM\t\t(1 << 8)  /* symbol "
+			"completed */\n"
+			"#define LWS_HUF_ACCEPT\t\t(1 << 9)  /* ok to end "
+			"here */\n"
+			"#define LWS_HUF_FAIL\t\t(1 << 10) /* EOS seen */\n"
+			"#define LWS_HUF_STATE(e)\t((e) & 0xff)\n"
+			"#define LWS_HUF_CHAR(e)\t\t((uint8_t)((e) >> 16))\n\n"
+			"static const uint32_t huftable[%d][16] = {\n", states);
+
+	for (n = 0; n < states; n++) {
+		fprintf(stdout, "{ /* state %d */\n", n);
+		for (m = 0; m < 16; m++) {
+			if (!(m & 3))
+				fprintf(stdout, "\t");
+			fprintf(stdout, "0x%08x,", ((unsigned int)
+				fsm[n][m].sym << 16) | fsm[n][m].flags |
+				fsm[n][m].state);
+			fprintf(stdout, (m & 3) == 3 ? "\n" : " ");
+		}
+		fprintf(stdout, "},\n");
 	}
-	fprintf(stdout, "\n};\n");
+	fprintf(stdout, "};\n");
 
 	/*
-	 * Try to parse every legal input string
+	 * Try every symbol on its own, and then all of them in one string
 	 */
 
-	for (n = 0; n < LWS_ARRAY_SIZE(huf_literal); n++) {
-		walk = 0;
-		m = 0;
-		y = -1;
-
-		fprintf(stderr, "  trying %d\n", n);
-
-		while (m < huf_literal[n].len) {
-			prev = walk;
-			walk = lextable_decode(walk, code_bit(n, m));
-
-			if (walk == 0xffff) {
-				fprintf(stderr, "failed\n");
-				return 3;
-			}
-
-			if (walk & 0x8000) {
-				y = walk & 0x7fff;
-				if (y == 0 && m == 29) {
-					y |= 0x100;
-					fprintf(stdout,
-						"\n/* state that points to "
-						"0x100 for disambiguation with "
-						"0x0 */\n"
-						"#define HUFTABLE_0x100_PREV "
-						"%d\n", prev);
-				}
-				break;
-			}
-			m++;
+	for (n = 0; n < 256; n++) {
+		len = encode(&n, 1, enc);
+		if (decode(enc, len, dec) != 1 || dec[0] != n) {
+			fprintf(stderr, "decode failed %d\n", n);
+			return 3;
 		}
+		syms[n] = n;
+	}
 
-		if (y != n) {
-			fprintf(stderr, "decode failed %d got %d (0x%x)\n", n, y, y);
+	len = encode(syms, 256, enc);
+	if (decode(enc, len, dec) != 256) {
+		fprintf(stderr, "decode of all failed\n");
+		return 4;
+	}
+	for (n = 0; n < 256; n++)
+		if (dec[n] != n) {
+			fprintf(stderr, "decode of all wrong at %d\n", n);
 			return 4;
 		}
+
+	/* EOS in the string, and 8 bits of padding, must both fail */
+
+	n = EOS;
+	len = encode(&n, 1, enc);
+	if (decode(enc, len, dec) >= 0) {
+		fprintf(stderr, "EOS accepted\n");
+		return 5;
+	}
+	n = '0'; /* 5 bits */
+	len = encode(&n, 1, enc);
+	if (decode(enc, len + 1, dec) >= 0) {
+		fprintf(stderr, "excess padding accepted\n");
+		return 5;
 	}
 
-	fprintf(stderr, "All decode OK\n");
+	fprintf(stderr, "%d states, all decode OK\n", states);
 
 	return 0;
 }
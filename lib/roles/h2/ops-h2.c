@@ -526,6 +526,12 @@ rops_write_role_protocol_h2(struct lws *wsi, unsigned char *buf, size_t len,
 		wsi->h2.send_END_STREAM = 1;
 	}
 
+	if ((n == LWS_H2_FRAME_TYPE_HEADERS ||
+	     n == LWS_H2_FRAME_TYPE_CONTINUATION) &&
+	    lws_hpack_enc_block(wsi, n == LWS_H2_FRAME_TYPE_HEADERS,
+				!!(flags & LWS_H2_FLAG_END_HEADERS), &buf, &len))
+		return -1;
+
 	n = lws_h2_frame_write(wsi, n, flags, wsi->mux.my_sid, (unsigned int)len, buf);
 	if (n < 0)
 		return n;
@@ -587,6 +593,9 @@ rops_init_vhost_h2(struct lws_vhost *vh,
 			vh->h2.set.s[n] = info->http2_settings[n];
 	}
 
+	vh->h2.hpack_enc_table_size = info->h2_hpack_enc_table_size ?
+					info->h2_hpack_enc_table_size : 4096;
+
 	return 0;
 }
 
@@ -608,7 +617,7 @@ rops_pt_init_destroy_h2(struct lws_context *context,
 
 		pt->sul_ah_lifecheck.cb = lws_sul_http_ah_lifecheck;
 
-		__lws_sul_insert_us(&pt->pt_sul_owner[LWSSULLI_MISS_IF_SUSPENDED],
+		__lws_sul_insert_us(pt, LWSSULLI_MISS_IF_SUSPENDED,
 				 &pt->sul_ah_lifecheck, 30 * LWS_US_PER_SEC);
 	} else
 		lws_dll2_remove(&pt->sul_ah_lifecheck.list);
@@ -683,6 +692,7 @@ rops_destroy_role_h2(struct lws *wsi)
 
 	if (wsi->upgraded_to_http2 || wsi->mux_substream) {
 		lws_hpack_destroy_dynamic_header(wsi);
+		lws_hpack_enc_destroy(wsi);
 
 		if (wsi->h2.h2n)
 			lws_free_set_NULL(wsi->h2.h2n);
@@ -1344,6 +1354,7 @@ rops_alpn_negotiated_h2(struct lws *wsi, const char *alpn)
 			   (int)wsi->h2.h2n->our_set.s[H2SET_HEADER_TABLE_SIZE]))
 		return 1;
 	wsi->txc.tx_cr = 65535;
+	wsi->txc.peer_tx_cr_est = 65535;
 
 	lwsl_info("%s: %s: configured for h2\n", __func__, lws_wsi_tag(wsi));
 
@@ -31,6 +31,7 @@ struct http2_settings {
 
 struct lws_vhost_role_h2 {
 	struct http2_settings set;
+	int hpack_enc_table_size; /* < 0 = LWS_H2_HPACK_ENC_ */
 };
 
 enum lws_h2_wellknown_frame_types {
@@ -194,6 +195,39 @@ struct hpack_dynamic_table {
 	uint16_t num_entries;
 };
 
+/*
+ * Our tx side HPACK state, separate from the peer's table above.  Entries
+ * are kept in a ring, newest at head, each one "name" followed by "value" in
+ * one allocation
+ */
+
+struct lws_hpack_enc_entry {
+	char *nv; /* malloc'd */
+	uint16_t name_len;
+	uint16_t value_len;
+};
+
+struct lws_hpack_enc {
+	struct lws_hpack_enc_entry *ring; /* malloc'd */
+	uint8_t *scratch; /* malloc'd, LWS_PRE + encoded frame payload */
+	size_t scratch_len;
+	uint64_t in;
+	uint64_t out;
+	uint32_t blocks;
+	uint32_t inserts;
+	uint32_t evictions;
+	uint32_t size; /* RFC7541 4.1 accounting */
+	uint32_t max; /* size the peer decoder believes we use */
+	uint32_t update_min; /* lowest peer limit since last size update */
+	uint16_t head;
+	uint16_t count;
+	uint16_t slots;
+
+	uint8_t update_pending:1;
+	uint8_t verbatim:1; /* pass the rest of this block through */
+	uint8_t desync:1; /* stop adding anything to the table */
+};
+
 enum lws_h2_protocol_send_type {
 	LWS_PPS_NONE,
 	LWS_H2_PPS_MY_SETTINGS,
@@ -252,6 +286,7 @@ struct lws_h2_netconn {
 	struct http2_settings our_set;
 	struct http2_settings peer_set;
 	struct hpack_dynamic_table hpack_dyn_table;
+	struct lws_hpack_enc hpack_enc;
 	uint8_t	ping_payload[8];
 	uint8_t one_setting[LWS_H2_SETTINGS_LEN];
 	char goaway_str[32]; /* for rx */
@@ -270,7 +305,7 @@ struct lws_h2_netconn {
 	unsigned int pad_length:1;
 	unsigned int collected_priority:1;
 	unsigned int is_first_header_char:1;
-	unsigned int zero_huff_padding:1;
+	unsigned int huff_pad_bad:1;
 	unsigned int last_action_dyntable_resize:1;
 	unsigned int sent_preface:1;
 
@@ -297,7 +332,6 @@ struct lws_h2_netconn {
 	uint8_t flags;
 	uint8_t padding;
 	uint8_t weight_temp;
-	uint8_t huff_pad;
 	char first_hdr_char;
 	uint8_t hpack_m;
 	uint8_t ext_count;
@@ -340,6 +374,9 @@ lws_wsi_mux_from_id(struct lws *wsi, unsigned int sid);
 int
 lws_hpack_interpret(struct lws *wsi, unsigned char c);
 int
+lws_h2_header_literal(const unsigned char *name, const unsigned char *value,
+		      int length, unsigned char **p, unsigned char *end);
+int
 lws_add_http2_header_by_name(struct lws *wsi,
 			     const unsigned char *name,
 			     const unsigned char *value, int length,
@@ -358,6 +395,16 @@ lws_hpack_destroy_dynamic_header(struct lws *wsi);
 int
 lws_hpack_dynamic_size(struct lws *wsi, int size);
 int
+lws_hpack_enc_block(struct lws *wsi, int first, int last, unsigned char **buf,
+		    size_t *len);
+void
+lws_hpack_enc_peer_table_size(struct lws *nwsi, uint32_t size);
+void
+lws_hpack_enc_destroy(struct lws *wsi);
+int
+lws_hpack_enc_stateless(const uint8_t *in, size_t len, uint8_t *out,
+			size_t *olen);
+int
 lws_h2_goaway(struct lws *wsi, uint32_t err, const char *reason);
 int
 lws_h2_tx_cr_get(struct lws *wsi);
@@ -35,7 +35,8 @@ lcs_init_compression_brotli(lws_comp_ctx_t *ctx, int decomp)
 			BrotliEncoderSetParameter(ctx->u.br_en,
 					BROTLI_PARAM_MODE, BROTLI_MODE_TEXT);
 			BrotliEncoderSetParameter(ctx->u.br_en,
-				BROTLI_PARAM_QUALITY, BROTLI_MIN_QUALITY);
+				BROTLI_PARAM_QUALITY, ctx->whole_file ? 9 :
+							BROTLI_MIN_QUALITY);
 		}
 	}
 	else
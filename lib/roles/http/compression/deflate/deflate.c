@@ -25,7 +25,7 @@
 #include "private-lib-core.h"
 
 static int
-lcs_init_compression_deflate(lws_comp_ctx_t *ctx, int decomp)
+lcs_init_zlib(lws_comp_ctx_t *ctx, int decomp, int window_bits)
 {
 	int n;
 
@@ -38,8 +38,10 @@ lcs_init_compression_deflate(lws_comp_ctx_t *ctx, int decomp)
 	memset(ctx->u.deflate, 0, sizeof(*ctx->u.deflate));
 
 	if (!decomp &&
-	    (n = deflateInit2(ctx->u.deflate, 1, Z_DEFLATED, -15, 8,
-			 Z_DEFAULT_STRATEGY)) != Z_OK) {
+	    (n = deflateInit2(ctx->u.deflate,
+			      ctx->whole_file ? Z_BEST_COMPRESSION : 1,
+			      Z_DEFLATED, window_bits, 8,
+			      Z_DEFAULT_STRATEGY)) != Z_OK) {
 		lwsl_err("deflate init failed: %d\n", n);
 		lws_free_set_NULL(ctx->u.deflate);
 
@@ -55,6 +57,19 @@ lcs_init_compression_deflate(lws_comp_ctx_t *ctx, int decomp)
 	return 0;
 }
 
+static int
+lcs_init_compression_deflate(lws_comp_ctx_t *ctx, int decomp)
+{
+	return lcs_init_zlib(ctx, decomp, -15);
+}
+
+static int
+lcs_init_compression_gzip(lws_comp_ctx_t *ctx, int decomp)
+{
+	/* zlib adds the gzip header and trailer for windowBits 16 + */
+	return lcs_init_zlib(ctx, decomp, 16 + 15);
+}
+
 static int
 lcs_process_deflate(lws_comp_ctx_t *ctx, const void *in, size_t *ilen_iused,
 		    void *out, size_t *olen_oused)
@@ -69,7 +84,14 @@ lcs_process_deflate(lws_comp_ctx_t *ctx, const void *in, size_t *ilen_iused,
 	ctx->u.deflate->avail_out = (unsigned int)*olen_oused;
 
 	if (!ctx->is_decompression)
-		n = deflate(ctx->u.deflate, Z_SYNC_FLUSH);
+		/*
+		 * A whole buffer compressed in one go is ended properly so it
+		 * can be kept and served as-is; per-response streams are only
+		 * sync flushed as before
+		 */
+		n = deflate(ctx->u.deflate, ctx->whole_file &&
+					    ctx->final_on_input_side ?
+						Z_FINISH : Z_SYNC_FLUSH);
 	else
 		n = inflate(ctx->u.deflate, Z_SYNC_FLUSH);
 
@@ -111,3 +133,10 @@ struct lws_compression_support lcs_deflate = {
 	/* .process */			lcs_process_deflate,
 	/* .destroy */			lcs_destroy_deflate,
 };
+
+struct lws_compression_support lcs_gzip = {
+	/* .encoding_name */		"gzip",
+	/* .init_compression */		lcs_init_compression_gzip,
+	/* .process */			lcs_process_deflate,
+	/* .destroy */			lcs_destroy_deflate,
+};
@@ -56,6 +56,7 @@ typedef struct lws_compression_ctx {
 	unsigned int final_on_input_side:1;
 	unsigned int may_have_more:1;
 	unsigned int chunking:1;
+	unsigned int whole_file:1; /* compressed once and kept: favour ratio */
 } lws_comp_ctx_t;
 
 /* generic structure defining the interface to a compression method */
@@ -73,11 +74,15 @@ struct lws_compression_support {
 };
 
 extern struct lws_compression_support lcs_deflate;
+extern struct lws_compression_support lcs_gzip;
 extern struct lws_compression_support lcs_brotli;
 
 int
 lws_http_compression_validate(struct lws *wsi);
 
+struct lws_compression_support *
+lws_http_compression_select(struct lws *wsi, const char *name, char decomp);
+
 int
 lws_http_compression_transform(struct lws *wsi, unsigned char *buf,
 			       size_t len, enum lws_write_protocol *wp,
@@ -85,3 +90,8 @@ lws_http_compression_transform(struct lws *wsi, unsigned char *buf,
 
 void
 lws_http_compression_destroy(struct lws *wsi);
+
+int
+lws_http_compress_buf(const struct lws_compression_support *lcs,
+		      const uint8_t *in, size_t len, uint8_t **out,
+		      size_t *olen);
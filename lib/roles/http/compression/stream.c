@@ -57,9 +57,10 @@ lws_http_compression_validate(struct lws *wsi)
 	return 0;
 }
 
-int
-lws_http_compression_apply(struct lws *wsi, const char *name,
-			   unsigned char **p, unsigned char *end, char decomp)
+/* the compression method _apply() would use, or NULL */
+
+struct lws_compression_support *
+lws_http_compression_select(struct lws *wsi, const char *name, char decomp)
 {
 	size_t n;
 
@@ -75,31 +76,42 @@ lws_http_compression_apply(struct lws *wsi, const char *name,
 			continue;
 
 		/* let's go with this one then... */
-		break;
+		return lcs_available[n];
 	}
 
-	if (n == LWS_ARRAY_SIZE(lcs_available))
+	return NULL;
+}
+
+int
+lws_http_compression_apply(struct lws *wsi, const char *name,
+			   unsigned char **p, unsigned char *end, char decomp)
+{
+	struct lws_compression_support *lcs;
+
+	lcs = lws_http_compression_select(wsi, name, decomp);
+	if (!lcs)
 		return 1;
 
-	lcs_available[n]->init_compression(&wsi->http.comp_ctx, decomp);
+	lcs->init_compression(&wsi->http.comp_ctx, decomp);
 	if (!wsi->http.comp_ctx.u.generic_ctx_ptr) {
-		lwsl_err("%s: init_compression %d failed\n", __func__, (int)n);
+		lwsl_err("%s: init_compression %s failed\n", __func__,
+			 lcs->encoding_name);
 		return 1;
 	}
 
-	wsi->http.lcs = lcs_available[n];
+	wsi->http.lcs = lcs;
 	wsi->http.comp_ctx.may_have_more = 0;
 	wsi->http.comp_ctx.final_on_input_side = 0;
 	wsi->http.comp_ctx.chunking = 0;
 	wsi->http.comp_ctx.is_decompression = !!decomp;
 
 	if (lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_CONTENT_ENCODING,
-			(unsigned char *)lcs_available[n]->encoding_name,
-			(int)strlen(lcs_available[n]->encoding_name), p, end))
+			(unsigned char *)lcs->encoding_name,
+			(int)strlen(lcs->encoding_name), p, end))
 		return -1;
 
 	lwsl_info("%s: %s: applied %s content-encoding\n", __func__,
-		    lws_wsi_tag(wsi), lcs_available[n]->encoding_name);
+		    lws_wsi_tag(wsi), lcs->encoding_name);
 
 	return 0;
 }
@@ -225,3 +237,65 @@ lws_http_compression_transform(struct lws *wsi, unsigned char *buf,
 
 	return 0;
 }
+
+/*
+ * Compress the whole of in[0 .. len) at once with the given method, eg, to
+ * keep a compressed copy of a file.  On success *out is a heap buffer holding
+ * the *olen byte result, which the caller must lws_free().
+ */
+
+int
+lws_http_compress_buf(const struct lws_compression_support *lcs,
+		      const uint8_t *in, size_t len, uint8_t **out,
+		      size_t *olen)
+{
+	size_t size = (len / 2) + 256, used = 0, ilen_iused, olen_oused;
+	uint8_t *buf = NULL, *b1;
+	lws_comp_ctx_t ctx;
+	int n;
+
+	memset(&ctx, 0, sizeof(ctx));
+	ctx.whole_file = 1;
+
+	if (lcs->init_compression(&ctx, 0) || !ctx.u.generic_ctx_ptr)
+		return 1;
+
+	/* there's no more input after this */
+	ctx.final_on_input_side = 1;
+
+	do {
+		if (!buf || size - used < 256) {
+			if (buf)
+				size *= 2;
+			b1 = lws_realloc(buf, size, __func__);
+			if (!b1)
+				goto bail;
+			buf = b1;
+		}
+
+		ilen_iused = len;
+		olen_oused = size - used;
+		n = lcs->process(&ctx, in, &ilen_iused, buf + used,
+				 &olen_oused);
+		if (n < 0 || (!n && !ilen_iused && !olen_oused))
+			/* broken, or stuck not finishing */
+			goto bail;
+
+		in += ilen_iused;
+		len -= ilen_iused;
+		used += olen_oused;
+	} while (n != 1);
+
+	lcs->destroy(&ctx);
+
+	*out = buf;
+	*olen = used;
+
+	return 0;
+
+bail:
+	lcs->destroy(&ctx);
+	lws_free(buf);
+
+	return 1;
+}
@@ -65,18 +65,13 @@ lws_wsi_is_h2(struct lws *wsi)
 }
 #endif
 
-int
-lws_add_http_header_by_name(struct lws *wsi, const unsigned char *name,
-			    const unsigned char *value, int length,
-			    unsigned char **p, unsigned char *end)
+/* formats "name: value\r\n", or the status line if name is NULL */
+
+static int
+lws_add_http1_header_by_name(const unsigned char *name,
+			     const unsigned char *value, int length,
+			     unsigned char **p, unsigned char *end)
 {
-#ifdef LWS_WITH_HTTP2
-	if (lws_wsi_is_h2(wsi))
-		return lws_add_http2_header_by_name(wsi, name,
-						    value, length, p, end);
-#else
-	(void)wsi;
-#endif
 	if (name) {
 		char has_colon = 0;
 		while (*p < end && *name) {
@@ -101,6 +96,22 @@ lws_add_http_header_by_name(struct lws *wsi, const unsigned char *name,
 	return 0;
 }
 
+int
+lws_add_http_header_by_name(struct lws *wsi, const unsigned char *name,
+			    const unsigned char *value, int length,
+			    unsigned char **p, unsigned char *end)
+{
+#ifdef LWS_WITH_HTTP2
+	if (lws_wsi_is_h2(wsi))
+		return lws_add_http2_header_by_name(wsi, name,
+						    value, length, p, end);
+#else
+	(void)wsi;
+#endif
+
+	return lws_add_http1_header_by_name(name, value, length, p, end);
+}
+
 int lws_finalize_http_header(struct lws *wsi, unsigned char **p,
 			     unsigned char *end)
 {
@@ -306,69 +317,71 @@ struct lws_protocol_vhost_options pvo_hsbph[] = {{
 		"form-action 'self';"
 }};
 
-int
-lws_add_http_header_status(struct lws *wsi, unsigned int _code,
-			   unsigned char **p, unsigned char *end)
+static const char *
+lws_http_status_description(unsigned int code)
 {
-	static const char * const hver[] = {
-		"HTTP/1.0", "HTTP/1.1", "HTTP/2"
-	};
-	const struct lws_protocol_vhost_options *headers, *ho;
-	unsigned int code = _code & LWSAHH_CODE_MASK;
-	const char *description = "", *p1;
-	unsigned char code_and_desc[60];
-	int n;
+	const char *description = "";
+
+	if (code >= 400 && code < (400 + LWS_ARRAY_SIZE(err400)))
+		description = err400[code - 400];
+	if (code >= 500 && code < (500 + LWS_ARRAY_SIZE(err500)))
+		description = err500[code - 500];
+
+	if (code == 100)
+		description = "Continue";
+	if (code == 200)
+		description = "OK";
+	if (code == 304)
+		description = "Not Modified";
+	else
+		if (code >= 300 && code < 400)
+			description = "Redirect";
+
+	return description;
+}
 
-	wsi->http.response_code = code;
-#ifdef LWS_WITH_ACCESS_LOG
-	wsi->http.access_log.response = (int)code;
-#endif
+/* adds a response header in the h1 or h2 form, without needing a wsi */
 
-#ifdef LWS_WITH_HTTP2
-	if (lws_wsi_is_h2(wsi)) {
-		n = lws_add_http2_header_status(wsi, code, p, end);
-		if (n)
-			return n;
-	} else
+static int
+lws_http_hdr_add(int h2, const unsigned char *name,
+		 const unsigned char *value, int length,
+		 unsigned char **p, unsigned char *end)
+{
+#if defined(LWS_WITH_HTTP2)
+	if (h2) {
+		/* a response, so on a server substream */
+		if (!strncmp((const char *)name, "transfer-encoding", 17))
+			return 0;
+
+		return lws_h2_header_literal(name, value, length, p, end);
+	}
 #endif
-	{
-		if (code >= 400 && code < (400 + LWS_ARRAY_SIZE(err400)))
-			description = err400[code - 400];
-		if (code >= 500 && code < (500 + LWS_ARRAY_SIZE(err500)))
-			description = err500[code - 500];
-
-		if (code == 100)
-			description = "Continue";
-		if (code == 200)
-			description = "OK";
-		if (code == 304)
-			description = "Not Modified";
-		else
-			if (code >= 300 && code < 400)
-				description = "Redirect";
 
-		if (wsi->http.request_version < LWS_ARRAY_SIZE(hver))
-			p1 = hver[wsi->http.request_version];
-		else
-			p1 = hver[0];
+	return lws_add_http1_header_by_name(name, value, length, p, end);
+}
 
-		n = lws_snprintf((char *)code_and_desc,
-				 sizeof(code_and_desc) - 1, "%s %u %s",
-				 p1, code, description);
+/*
+ * The headers every response on the vhost gets after the status: the vhost
+ * headers, with any mount header of the same name instead, the security best
+ * practices ones, the server name and sts
+ */
 
-		if (lws_add_http_header_by_name(wsi, NULL, code_and_desc, n, p,
-						end))
-			return 1;
-	}
+static int
+lws_add_http_vhost_headers(struct lws_vhost *vh,
+			   const struct lws_protocol_vhost_options *mount,
+			   unsigned int _code, int h2, unsigned char **p,
+			   unsigned char *end)
+{
+	const struct lws_protocol_vhost_options *headers, *ho;
 
-	headers = wsi->a.vhost->headers;
+	headers = vh->headers;
 
 	while (headers) {
 		/*
 		 * Give mount headers the chance to individually override
 		 * each vhost header
 		 */
-		ho = wsi->http.mount_specific_headers;
+		ho = mount;
 		while (ho) {
 			if (!strcmp(ho->name, headers->name))
 				break;
@@ -378,20 +391,19 @@ lws_add_http_header_status(struct lws *wsi, unsigned int _code,
 		if (!ho)
 			ho = headers;
 
-		if (lws_add_http_header_by_name(wsi,
-				(const unsigned char *)ho->name,
-				(unsigned char *)ho->value,
-				(int)strlen(ho->value), p, end))
+		if (lws_http_hdr_add(h2, (const unsigned char *)ho->name,
+				     (unsigned char *)ho->value,
+				     (int)strlen(ho->value), p, end))
 			return 1;
 
 		headers = headers->next;
 	}
 
-	if (wsi->a.vhost->options &
+	if (vh->options &
 	    LWS_SERVER_OPTION_HTTP_HEADERS_SECURITY_BEST_PRACTICES_ENFORCE) {
 		headers = &pvo_hsbph[LWS_ARRAY_SIZE(pvo_hsbph) - 1];
 		while (headers) {
-			if (lws_add_http_header_by_name(wsi,
+			if (lws_http_hdr_add(h2,
 					(const unsigned char *)headers->name,
 					(unsigned char *)headers->value,
 					(int)strlen(headers->value), p, end))
@@ -401,17 +413,18 @@ lws_add_http_header_status(struct lws *wsi, unsigned int _code,
 		}
 	}
 
-	if (wsi->a.context->server_string &&
+	if (vh->context->server_string &&
 	    !(_code & LWSAHH_FLAG_NO_SERVER_NAME)) {
-		assert(wsi->a.context->server_string_len > 0);
-		if (lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_SERVER,
-				(unsigned char *)wsi->a.context->server_string,
-				wsi->a.context->server_string_len, p, end))
+		assert(vh->context->server_string_len > 0);
+		if (lws_http_hdr_add(h2,
+				lws_token_to_string(WSI_TOKEN_HTTP_SERVER),
+				(unsigned char *)vh->context->server_string,
+				vh->context->server_string_len, p, end))
 			return 1;
 	}
 
-	if (wsi->a.vhost->options & LWS_SERVER_OPTION_STS)
-		if (lws_add_http_header_by_name(wsi, (unsigned char *)
+	if (vh->options & LWS_SERVER_OPTION_STS)
+		if (lws_http_hdr_add(h2, (unsigned char *)
 				"Strict-Transport-Security:",
 				(unsigned char *)"max-age=15768000 ; "
 				"includeSubDomains", 36, p, end))
@@ -426,6 +439,234 @@ lws_add_http_header_status(struct lws *wsi, unsigned int _code,
 	return 0;
 }
 
+int
+lws_add_http_header_status(struct lws *wsi, unsigned int _code,
+			   unsigned char **p, unsigned char *end)
+{
+	static const char * const hver[] = {
+		"HTTP/1.0", "HTTP/1.1", "HTTP/2"
+	};
+	unsigned int code = _code & LWSAHH_CODE_MASK;
+	unsigned char code_and_desc[60];
+	const char *p1;
+	int n, h2 = 0;
+
+	wsi->http.response_code = code;
+#ifdef LWS_WITH_ACCESS_LOG
+	wsi->http.access_log.response = (int)code;
+#endif
+
+#ifdef LWS_WITH_HTTP2
+	if (lws_wsi_is_h2(wsi)) {
+		n = lws_add_http2_header_status(wsi, code, p, end);
+		if (n)
+			return n;
+		h2 = 1;
+	} else
+#endif
+	{
+		if (wsi->http.request_version < LWS_ARRAY_SIZE(hver))
+			p1 = hver[wsi->http.request_version];
+		else
+			p1 = hver[0];
+
+		n = lws_snprintf((char *)code_and_desc,
+				 sizeof(code_and_desc) - 1, "%s %u %s",
+				 p1, code, lws_http_status_description(code));
+
+		if (lws_add_http_header_by_name(wsi, NULL, code_and_desc, n, p,
+						end))
+			return 1;
+	}
+
+	return lws_add_http_vhost_headers(wsi->a.vhost,
+					  wsi->http.mount_specific_headers,
+					  _code, h2, p, end);
+}
+
+/*
+ * Precompiled response headers
+ *
+ * The h1 form is made by the h1 formatter and the h2 form out of the same
+ * literals lws_add_http2_header_by_name() makes, with the vhost headers
+ * lws_add_http_header_status() would add, so each is what a connection of
+ * that kind would have made itself.
+ */
+
+struct lws_http_hdr_block {
+	uint8_t			*h1;
+	uint8_t			*h2;
+	size_t			h1_len;
+	size_t			h2_len;
+	unsigned int		code;
+	unsigned int		flags;
+};
+
+static int
+lws_http_hdr_block_build(const lws_http_hdr_block_info_t *i, int h2,
+			 unsigned char **p, unsigned char *end)
+{
+	unsigned int code = i->code & LWSAHH_CODE_MASK;
+	const struct lws_protocol_vhost_options *h;
+	char status[60];
+	int n;
+
+#if defined(LWS_WITH_HTTP2)
+	if (h2) {
+		n = lws_snprintf(status, sizeof(status), "%u", code);
+		if (lws_h2_header_literal(
+				lws_token_to_string(WSI_TOKEN_HTTP_COLON_STATUS),
+				(unsigned char *)status, n, p, end))
+			return 1;
+	} else
+#endif
+	{
+		/* the version is changed at send time for an http/1.0 peer */
+		n = lws_snprintf(status, sizeof(status), "HTTP/1.1 %u %s", code,
+				 lws_http_status_description(code));
+		if (lws_add_http1_header_by_name(NULL, (unsigned char *)status,
+						 n, p, end))
+			return 1;
+	}
+
+	if (lws_add_http_vhost_headers(i->vhost, i->mount_headers, i->code,
+				       h2, p, end))
+		return 1;
+
+	if (i->content_type &&
+	    lws_http_hdr_add(h2,
+			     lws_token_to_string(WSI_TOKEN_HTTP_CONTENT_TYPE),
+			     (unsigned char *)i->content_type,
+			     (int)strlen(i->content_type), p, end))
+		return 1;
+
+	for (h = i->headers; h; h = h->next)
+		if (lws_http_hdr_add(h2, (const unsigned char *)h->name,
+				     (const unsigned char *)h->value,
+				     (int)strlen(h->value), p, end))
+			return 1;
+
+	return 0;
+}
+
+lws_http_hdr_block_t *
+lws_http_hdr_block_create(const lws_http_hdr_block_info_t *i)
+{
+	size_t bl = i->vhost->context->pt_serv_buf_size, h1_len, h2_len = 0;
+	lws_http_hdr_block_t *b = NULL;
+	unsigned char *buf, *p;
+
+	/* room to build the h1 and h2 forms */
+
+	buf = lws_malloc(bl * 2, "hdr block scratch");
+	if (!buf)
+		return NULL;
+
+	p = buf;
+	if (lws_http_hdr_block_build(i, 0, &p, buf + bl))
+		goto bail;
+	h1_len = lws_ptr_diff_size_t(p, buf);
+
+#if defined(LWS_WITH_HTTP2)
+	p = buf + bl;
+	if (lws_http_hdr_block_build(i, 1, &p, buf + (bl * 2) - 16))
+		goto bail;
+	h2_len = lws_ptr_diff_size_t(p, buf + bl);
+#endif
+
+	/* leave room for the h2 form to be encoded in place */
+
+	b = lws_zalloc(sizeof(*b) + h1_len + h2_len + 16, "hdr block");
+	if (!b)
+		goto bail;
+
+	b->h1 = (uint8_t *)&b[1];
+	b->h2 = b->h1 + h1_len;
+	b->h1_len = h1_len;
+	b->h2_len = h2_len;
+	b->code = i->code & LWSAHH_CODE_MASK;
+	b->flags = i->flags;
+	memcpy(b->h1, buf, h1_len);
+
+#if defined(LWS_WITH_HTTP2)
+	if (i->vhost->h2.hpack_enc_table_size == LWS_H2_HPACK_ENC_NO_DYNAMIC) {
+		/*
+		 * Connections on this vhost won't do any better than the
+		 * static table and Huffman, so do it once now and they pass it
+		 * through as it is.  Otherwise each connection must encode it
+		 * against its own dynamic table, and we keep the literal form.
+		 */
+		if (lws_hpack_enc_stateless(buf + bl, h2_len, b->h2,
+					    &b->h2_len))
+			lws_free_set_NULL(b);
+	} else
+		memcpy(b->h2, buf + bl, h2_len);
+#endif
+
+bail:
+	lws_free(buf);
+
+	return b;
+}
+
+void
+lws_http_hdr_block_destroy(lws_http_hdr_block_t **pb)
+{
+	lws_free_set_NULL(*pb);
+}
+
+int
+lws_add_http_header_block(struct lws *wsi, const lws_http_hdr_block_t *b,
+			  lws_filepos_t content_len, const char *etag,
+			  unsigned char **p, unsigned char *end)
+{
+	const uint8_t *img = b->h1;
+	size_t len = b->h1_len;
+	char date[32];
+	time_t t;
+
+#if defined(LWS_WITH_HTTP2)
+	if (lws_wsi_is_h2(wsi)) {
+		img = b->h2;
+		len = b->h2_len;
+		wsi->h2.send_END_STREAM = 0;
+	}
+#endif
+
+	if (lws_ptr_diff_size_t(end, *p) < len + 3)
+		return 1;
+
+	memcpy(*p, img, len);
+	if (img == b->h1 && wsi->http.request_version == HTTP_VERSION_1_0)
+		(*p)[7] = '0'; /* HTTP/1.1 -> HTTP/1.0 */
+	*p += len;
+
+	wsi->http.response_code = b->code;
+#ifdef LWS_WITH_ACCESS_LOG
+	wsi->http.access_log.response = (int)b->code;
+#endif
+
+	if (content_len != LWS_ILLEGAL_HTTP_CONTENT_LEN &&
+	    lws_add_http_header_content_length(wsi, content_len, p, end))
+		return 1;
+
+	if (etag && lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_ETAG,
+						 (const unsigned char *)etag,
+						 (int)strlen(etag), p, end))
+		return 1;
+
+	if (b->flags & LWSHBF_DATE) {
+		t = time(NULL);
+		if (lws_http_date_render_from_unix(date, sizeof(date), &t) ||
+		    lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_DATE,
+						 (const unsigned char *)date,
+						 (int)strlen(date), p, end))
+			return 1;
+	}
+
+	return 0;
+}
+
 int
 lws_return_http_status(struct lws *wsi, unsigned int code,
 		       const char *html_body)
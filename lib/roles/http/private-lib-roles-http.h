@@ -199,12 +199,21 @@ struct lws_peer_role_http {
 	uint32_t total_ah;
 };
 
+struct lws_mount_index;
+
 struct lws_vhost_role_http {
 #if defined(LWS_CLIENT_HTTP_PROXYING)
 	char http_proxy_address[128];
 #endif
 	const struct lws_http_mount *mount_list;
+	struct lws_mount_index *mount_index; /* mount_list hashed, or NULL */
 	const char *error_document_404;
+#if defined(LWS_WITH_SERVER) && defined(LWS_WITH_FILE_OPS)
+	struct lws_http_file_cache *file_cache; /* NULL unless enabled */
+	struct lws_http_precomp *precomp; /* NULL until we make siblings */
+	struct lws_http_cw *cw; /* compression worker, NULL until needed */
+	lws_dll2_owner_t serve_hdrs; /* hdr blocks for uncached files */
+#endif
 #if defined(LWS_CLIENT_HTTP_PROXYING)
 	unsigned int http_proxy_port;
 #endif
@@ -223,6 +232,9 @@ struct lws_access_log {
 #define LWS_HTTP_CHUNK_HDR_MAX_SIZE (6 + 2) /* 6 hex digits and then CRLF */
 #define LWS_HTTP_CHUNK_TRL_MAX_SIZE (2 + 5) /* CRLF, then maybe 0 CRLF CRLF */
 
+/* most we ask sendfile() to move at once for a zero-copy mount */
+#define LWS_SENDFILE_MAX_CHUNK (1024 * 1024)
+
 struct _lws_http_mode_related {
 	struct lws *new_wsi_list;
 
@@ -288,6 +300,10 @@ struct _lws_http_mode_related {
 	unsigned int multipart:1;
 	unsigned int cgi_transaction_complete:1;
 	unsigned int multipart_issue_boundary:1;
+	unsigned int zero_copy:1; /* mount allows sendfile() for file */
+	unsigned int precompressed:1; /* mount may send file.br / file.gz */
+	unsigned int precompress_generate:1; /* ...and may make them */
+	unsigned int etag:1; /* lws_serve_http_file() should add the ETag */
 
 	char auth_username[64];
 	char auth_password[64];
@@ -340,6 +356,80 @@ int
 lws_http_proxy_start(struct lws *wsi, const struct lws_http_mount *hit,
 		     char *uri_ptr, char ws);
 
+#if defined(LWS_WITH_SERVER)
+void
+lws_http_mount_index_create(struct lws_vhost *vh);
+void
+lws_http_mount_index_destroy(struct lws_vhost *vh);
+#else
+#define lws_http_mount_index_create(_vh)
+#define lws_http_mount_index_destroy(_vh)
+#endif
+
+#if defined(LWS_WITH_SERVER) && defined(LWS_WITH_FILE_OPS)
+
+/* files smaller than this aren't worth compressing */
+#define LWS_HTTP_COMPRESS_MIN 128
+
+#if defined(LWS_WITH_THREADPOOL) && defined(LWS_HAVE_PTHREAD_H) && \
+    defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+#define LWS_HTTP_COMPRESS_WORKER
+
+/* embedded in the file cache's and precompressed siblings' jobs */
+
+typedef struct lws_http_cw_job {
+	lws_dll2_t		list;	/* cw->jobs */
+	struct lws_vhost	*vh;
+	void			(*run)(struct lws_http_cw_job *job);
+	/* on a service thread, after run() or if it was stopped first */
+	void			(*reap)(struct lws_vhost *vh,
+					struct lws_http_cw_job *job);
+	char			done;	/* the pool is finished with us */
+} lws_http_cw_job_t;
+
+int
+lws_http_cw_enqueue(struct lws_vhost *vh, int tsi, lws_http_cw_job_t *job,
+		    const char *name);
+void
+lws_http_cw_reap(struct lws_vhost *vh);
+void
+lws_http_cw_destroy(struct lws_vhost *vh);
+#else
+#define lws_http_cw_destroy(_vh)
+#endif
+
+/* fop_fd was opened by the platform fops, so path-based stat() applies */
+#define lws_http_fop_fd_is_platform(_wsi, _fd) \
+		((_fd)->fops == &(_wsi)->a.context->fops_platform)
+int
+lws_http_plat_stat(const char *path, size_t *len, uint32_t *mod_time);
+int
+lws_http_file_cache_create(struct lws_vhost *vh,
+			   const struct lws_context_creation_info *info);
+void
+lws_http_file_cache_destroy(struct lws_vhost *vh);
+int
+lws_http_file_cache_open(struct lws *wsi, const char *path);
+void
+lws_http_file_cache_adopt(struct lws *wsi, const char *path);
+int
+lws_http_file_cache_is_cached(lws_fop_fd_t fop_fd);
+const char *
+lws_http_file_cache_encoding(struct lws *wsi);
+const char *
+lws_http_precomp_select(struct lws *wsi, const char *path, int generate);
+void
+lws_http_precomp_destroy(struct lws_vhost *vh);
+void
+lws_http_serve_hdrs_destroy(struct lws_vhost *vh);
+#else
+#define lws_http_file_cache_create(_vh, _i) (0)
+#define lws_http_file_cache_destroy(_vh)
+#define lws_http_precomp_destroy(_vh)
+#define lws_http_cw_destroy(_vh)
+#define lws_http_serve_hdrs_destroy(_vh)
+#endif
+
 void
 lws_sul_http_ah_lifecheck(lws_sorted_usec_list_t *sul);
 
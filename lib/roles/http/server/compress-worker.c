@@ -0,0 +1,251 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Per-vhost worker thread for compression jobs
+ *
+ * The file cache's compressed forms and precompressed siblings are both made
+ * off the service thread, by one lazily-created, single-thread pool per vhost
+ * that they share.  A user embeds an lws_http_cw_job_t in its own job, its
+ * run() is called on the worker, and its reap() back on a service thread after
+ * the pool is done with it, whether it ran or not.
+ *
+ * While there are jobs, a sul looks for finished ones regularly, so results
+ * and the references jobs hold aren't kept waiting for the next request.
+ * Users may also reap whenever they are about to look for a result, on any pt.
+ *
+ * Whether the sul is armed is tracked under the cw lock, not taken from the
+ * job count, since reaping elsewhere may empty the list while the sul is still
+ * queued on its pt.  Only whoever arms it, on their own pt, or the sul itself
+ * while it runs, may schedule it, so it is never moved between pts while it
+ * may be listed on one.
+ */
+
+#include "private-lib-core.h"
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+
+#include <pthread.h>
+
+#define LWS_HTTP_CW_QUEUE_DEPTH		64
+#define LWS_HTTP_CW_REAP_US		(20 * LWS_US_PER_MS)
+
+struct lws_http_cw {
+	pthread_mutex_t			lock;	/* jobs is shared with worker */
+	struct lws_threadpool		*tp;
+	lws_dll2_owner_t		jobs;
+	lws_sorted_usec_list_t		sul_reap; /* while there are jobs */
+	struct lws_vhost		*vh;
+	int				reap_tsi; /* pt sul_reap is armed on */
+	char				armed;	/* sul_reap is queued or running */
+};
+
+static enum lws_threadpool_task_return
+lws_http_cw_task(void *user, enum lws_threadpool_task_status s)
+{
+	lws_http_cw_job_t *job = (lws_http_cw_job_t *)user;
+
+	if (s == LWS_TP_STATUS_STOPPING)
+		return LWS_TP_RETURN_STOPPED;
+
+	job->run(job);
+
+	return LWS_TP_RETURN_FINISHED;
+}
+
+/* on the worker thread, the pool is done with the job */
+
+static void
+lws_http_cw_task_cleanup(struct lws *wsi, void *user)
+{
+	lws_http_cw_job_t *job = (lws_http_cw_job_t *)user;
+	struct lws_http_cw *cw = job->vh->http.cw;
+
+	pthread_mutex_lock(&cw->lock); /* =================== cw lock */
+	job->done = 1;
+	pthread_mutex_unlock(&cw->lock); /* --------------- cw unlock */
+}
+
+void
+lws_http_cw_reap(struct lws_vhost *vh)
+{
+	struct lws_http_cw *cw = vh->http.cw;
+	lws_dll2_owner_t done;
+
+	if (!cw)
+		return;
+
+	memset(&done, 0, sizeof(done));
+
+	pthread_mutex_lock(&cw->lock); /* =================== cw lock */
+	lws_start_foreach_dll_safe(struct lws_dll2 *, d, d1,
+				   lws_dll2_get_head(&cw->jobs)) {
+		lws_http_cw_job_t *job = lws_container_of(d,
+						lws_http_cw_job_t, list);
+
+		if (job->done) {
+			lws_dll2_remove(d);
+			lws_dll2_add_tail(d, &done);
+		}
+	} lws_end_foreach_dll_safe(d, d1);
+	pthread_mutex_unlock(&cw->lock); /* --------------- cw unlock */
+
+	lws_start_foreach_dll_safe(struct lws_dll2 *, d, d1,
+				   lws_dll2_get_head(&done)) {
+		lws_http_cw_job_t *job = lws_container_of(d,
+						lws_http_cw_job_t, list);
+
+		lws_dll2_remove(d);
+		job->reap(vh, job);
+	} lws_end_foreach_dll_safe(d, d1);
+}
+
+static void
+lws_http_cw_sul_reap_cb(lws_sorted_usec_list_t *sul)
+{
+	struct lws_http_cw *cw = lws_container_of(sul, struct lws_http_cw,
+						  sul_reap);
+	int more;
+
+	lws_http_cw_reap(cw->vh);
+
+	pthread_mutex_lock(&cw->lock); /* =================== cw lock */
+	more = !!cw->jobs.count;
+	if (!more)
+		/* from now, the next enqueue arms it again */
+		cw->armed = 0;
+	pthread_mutex_unlock(&cw->lock); /* --------------- cw unlock */
+
+	if (more)
+		lws_sul_schedule(cw->vh->context, cw->reap_tsi, &cw->sul_reap,
+				 lws_http_cw_sul_reap_cb, LWS_HTTP_CW_REAP_US);
+}
+
+static struct lws_http_cw *
+lws_http_cw_get(struct lws_vhost *vh)
+{
+	struct lws_threadpool_create_args ca;
+	struct lws_http_cw *cw;
+
+	lws_vhost_lock(vh); /* -------------- vh { */
+
+	cw = vh->http.cw;
+	if (cw)
+		goto bail;
+
+	cw = lws_zalloc(sizeof(*cw), __func__);
+	if (!cw)
+		goto bail;
+
+	memset(&ca, 0, sizeof(ca));
+	ca.threads		= 1;
+	ca.max_queue_depth	= LWS_HTTP_CW_QUEUE_DEPTH;
+
+	cw->tp = lws_threadpool_create(vh->context, &ca, "%s-compr", vh->name);
+	if (!cw->tp) {
+		lws_free_set_NULL(cw);
+		goto bail;
+	}
+	pthread_mutex_init(&cw->lock, NULL);
+	cw->vh = vh;
+	vh->http.cw = cw;
+
+bail:
+	lws_vhost_unlock(vh); /* } vh -------------- */
+
+	return cw;
+}
+
+int
+lws_http_cw_enqueue(struct lws_vhost *vh, int tsi, lws_http_cw_job_t *job,
+		    const char *name)
+{
+	struct lws_threadpool_task_args ta;
+	struct lws_http_cw *cw;
+	int arm = 0;
+
+	cw = lws_http_cw_get(vh);
+	if (!cw)
+		return 1;
+
+	job->vh		= vh;
+	job->done	= 0;
+
+	pthread_mutex_lock(&cw->lock); /* =================== cw lock */
+	lws_dll2_add_tail(&job->list, &cw->jobs);
+	pthread_mutex_unlock(&cw->lock); /* --------------- cw unlock */
+
+	memset(&ta, 0, sizeof(ta));
+	ta.user		= job;
+	ta.name		= "compr";
+	ta.async_task	= 1; /* not for any one connection */
+	ta.task		= lws_http_cw_task;
+	ta.cleanup	= lws_http_cw_task_cleanup;
+
+	if (!lws_threadpool_enqueue(cw->tp, &ta, "%s", name)) {
+		pthread_mutex_lock(&cw->lock); /* =========== cw lock */
+		lws_dll2_remove(&job->list);
+		pthread_mutex_unlock(&cw->lock); /* ------- cw unlock */
+
+		return 1;
+	}
+
+	pthread_mutex_lock(&cw->lock); /* =================== cw lock */
+	if (!cw->armed) {
+		/* it's not listed on any pt, so it's ours to put on this one */
+		cw->armed	= 1;
+		cw->reap_tsi	= tsi;
+		arm		= 1;
+	}
+	pthread_mutex_unlock(&cw->lock); /* --------------- cw unlock */
+
+	if (arm)
+		lws_sul_schedule(vh->context, tsi, &cw->sul_reap,
+				 lws_http_cw_sul_reap_cb, LWS_HTTP_CW_REAP_US);
+
+	return 0;
+}
+
+void
+lws_http_cw_destroy(struct lws_vhost *vh)
+{
+	struct lws_http_cw *cw = vh->http.cw;
+
+	if (!cw)
+		return;
+
+	/* under the lock of the pt it may be listed on */
+	lws_sul_schedule(vh->context, cw->reap_tsi, &cw->sul_reap,
+			 lws_http_cw_sul_reap_cb, LWS_SET_TIMER_USEC_CANCEL);
+
+	/* waits for any job that is running now */
+	lws_threadpool_finish(cw->tp);
+	lws_threadpool_destroy(cw->tp);
+
+	/* the pool is done with all of them now, hand them all back */
+	lws_http_cw_reap(vh);
+
+	pthread_mutex_destroy(&cw->lock);
+	lws_free_set_NULL(vh->http.cw);
+}
+
+#endif
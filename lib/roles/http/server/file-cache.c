@@ -0,0 +1,717 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Per-vhost cache of small, recently served files
+ *
+ * Serving a file normally costs an open(), fstat(), read()s and close()
+ * through the vfs each time.  A vhost with a nonzero http_file_cache_size
+ * keeps the content of files up to http_file_cache_max_file in memory instead,
+ * found by path and matched to the file by its size and mtime, and dropping
+ * the least recently used first when it's full.
+ *
+ * Hits are given to lws_serve_http_file() as a fop_fd reading from the cached
+ * bytes, so ranges, HEAD, interpretation etc work just like for real files.
+ * When a hit was last checked against the file longer ago than
+ * http_file_cache_revalidate_ms, the file is stat()ed again and the entry
+ * dropped if it changed or went away.
+ *
+ * With stream compression, the first client that can take br or gzip for a
+ * compressible file has the compressed form built once and kept with it, and
+ * later ones are sent that with a content-length, instead of compressing the
+ * file on the fly for each of them.  With threadpool too, the compressed form
+ * is built on the vhost's compression worker (see compress-worker.c), and
+ * clients are served as if it wasn't cached until it's ready.  Otherwise it's
+ * built on the service thread, and only for files up to
+ * LWS_FC_MAX_INLINE_ENC, so that stays cheap.
+ *
+ * The status and headers for responses from the cache come from the vhost's
+ * header blocks like any other file's, see lws_serve_http_file_headers().
+ */
+
+#include "private-lib-core.h"
+
+#define LWS_FC_HASH			64
+#define LWS_FC_MAX_FILE_DEFAULT		(64 * 1024)
+#define LWS_FC_REVALIDATE_MS_DEFAULT	1000
+#define LWS_FC_MAX_ENC			2
+#define LWS_FC_MAX_INLINE_ENC		(8 * 1024) /* compress inline up to */
+
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+/* compressed forms we may keep, in order of preference */
+static struct lws_compression_support * const fc_enc[] = {
+#if defined(LWS_WITH_HTTP_BROTLI)
+	&lcs_brotli,
+#endif
+	&lcs_gzip,
+};
+#endif
+
+typedef struct lws_fc_rep {
+	uint8_t			*buf;
+	size_t			len;
+} lws_fc_rep_t;
+
+typedef struct lws_fc_entry {
+	lws_dll2_t		lru;	/* cache->lru, head is most recent */
+	lws_dll2_t		bucket;	/* cache->ht[hash % LWS_FC_HASH] */
+	lws_fc_rep_t		enc[LWS_FC_MAX_ENC]; /* compressed, per fc_enc */
+	lws_usec_t		checked; /* last time we saw it match the file */
+	uint8_t			*data;
+	size_t			len;
+	size_t			footprint;
+	uint32_t		mod_time;
+	uint32_t		hash;
+	int			refcount; /* fop_fds reading from us */
+	uint8_t			enc_tried; /* bit per fc_enc[] */
+	uint8_t			enc_busy; /* bit per fc_enc[] being built */
+	char			gone;	/* unlisted, free at last close */
+
+	/* path follows, then data */
+} lws_fc_entry_t;
+
+struct lws_http_file_cache {
+	lws_dll2_owner_t		ht[LWS_FC_HASH];
+	lws_dll2_owner_t		lru;
+	lws_http_file_cache_stats_t	stats;
+	size_t				limit;
+	size_t				max_file;
+	lws_usec_t			revalidate;
+};
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+typedef struct lws_fc_job {
+	lws_http_cw_job_t		cw;
+	lws_fc_entry_t			*e;	/* we hold a reference on it */
+	uint8_t				*buf;	/* the compressed form, or NULL */
+	size_t				len;
+	int				n;	/* fc_enc[] index */
+} lws_fc_job_t;
+#endif
+
+typedef struct lws_fc_fd {
+	struct lws_fop_fd	fop_fd; /* must be first */
+	struct lws_vhost	*vh;
+	lws_fc_entry_t		*e;
+	const uint8_t		*data; /* e->data or one of e->enc[] */
+} lws_fc_fd_t;
+
+static const struct lws_plat_file_ops fops_fc;
+
+static const char *
+lws_fc_path(const lws_fc_entry_t *e)
+{
+	return (const char *)&e[1];
+}
+
+/* call with vhost lock held */
+
+static lws_fc_entry_t *
+lws_fc_lookup(struct lws_http_file_cache *fc, const char *path, uint32_t h)
+{
+	lws_start_foreach_dll(struct lws_dll2 *, d,
+			      lws_dll2_get_head(&fc->ht[h % LWS_FC_HASH])) {
+		lws_fc_entry_t *e = lws_container_of(d, lws_fc_entry_t, bucket);
+
+		if (e->hash == h && !strcmp(lws_fc_path(e), path))
+			return e;
+
+	} lws_end_foreach_dll(d);
+
+	return NULL;
+}
+
+static void
+lws_fc_entry_free(lws_fc_entry_t *e)
+{
+	int n;
+
+	for (n = 0; n < LWS_FC_MAX_ENC; n++)
+		lws_free(e->enc[n].buf);
+
+	lws_free(e);
+}
+
+/* call with vhost lock held... it can't be found after, and goes when unused */
+
+static void
+lws_fc_unlist(struct lws_http_file_cache *fc, lws_fc_entry_t *e)
+{
+	if (e->gone)
+		return;
+
+	lws_dll2_remove(&e->bucket);
+	lws_dll2_remove(&e->lru);
+	fc->stats.entries--;
+	fc->stats.footprint -= e->footprint;
+	e->gone = 1;
+
+	if (!e->refcount)
+		lws_fc_entry_free(e);
+}
+
+/* call with vhost lock held, drop the least recently used until len fits */
+
+static int
+lws_fc_make_room(struct lws_http_file_cache *fc, size_t len,
+		 lws_fc_entry_t *keep)
+{
+	lws_fc_entry_t *e;
+
+	if (len > fc->limit)
+		return 1;
+
+	while (fc->stats.footprint + len > fc->limit) {
+		e = lws_container_of(lws_dll2_get_tail(&fc->lru),
+				     lws_fc_entry_t, lru);
+		if (e == keep)
+			return 1;
+
+		lws_fc_unlist(fc, e);
+		fc->stats.evictions++;
+	}
+
+	return 0;
+}
+
+static void
+lws_fc_unref(struct lws_vhost *vh, lws_fc_entry_t *e)
+{
+	lws_vhost_lock(vh);
+	if (!--e->refcount && e->gone)
+		lws_fc_entry_free(e);
+	lws_vhost_unlock(vh);
+}
+
+/* takes over the caller's reference on e */
+
+static int
+lws_fc_fd_attach(struct lws *wsi, lws_fc_entry_t *e)
+{
+	lws_fc_fd_t *fd = lws_zalloc(sizeof(*fd), __func__);
+
+	if (!fd) {
+		lws_fc_unref(wsi->a.vhost, e);
+
+		return 1;
+	}
+
+	fd->vh			= wsi->a.vhost;
+	fd->e			= e;
+	fd->data		= e->data;
+	fd->fop_fd.fd		= LWS_INVALID_FILE;
+	fd->fop_fd.fops		= &fops_fc;
+	fd->fop_fd.len		= e->len;
+	fd->fop_fd.mod_time	= e->mod_time;
+	fd->fop_fd.flags	= LWS_O_RDONLY | LWS_FOP_FLAG_MOD_TIME_VALID;
+
+	wsi->http.fop_fd	= &fd->fop_fd;
+
+	return 0;
+}
+
+int
+lws_http_file_cache_open(struct lws *wsi, const char *path)
+{
+	struct lws_http_file_cache *fc = wsi->a.vhost->http.file_cache;
+	uint32_t h, mod_time;
+	lws_usec_t now;
+	lws_fc_entry_t *e;
+	size_t len;
+	int check;
+
+	if (!fc)
+		return 1;
+
+	h = lws_fnv1a32(LWS_FNV1A32_INIT, path, strlen(path));
+	now = lws_now_usecs();
+
+	lws_vhost_lock(wsi->a.vhost);
+	e = lws_fc_lookup(fc, path, h);
+	if (!e) {
+		lws_vhost_unlock(wsi->a.vhost);
+
+		return 1;
+	}
+
+	e->refcount++;
+	check = now - e->checked > fc->revalidate;
+	if (check)
+		/* the others on this path can skip it while we look */
+		e->checked = now;
+	lws_vhost_unlock(wsi->a.vhost);
+
+	/* entries are only made from platform fops files, so we can stat */
+	if (check && (lws_http_plat_stat(path, &len, &mod_time) ||
+		      len != e->len || mod_time != e->mod_time)) {
+		lwsl_info("%s: %s changed\n", __func__, path);
+		lws_vhost_lock(wsi->a.vhost);
+		if (!e->gone)
+			fc->stats.invalidations++;
+		lws_fc_unlist(fc, e);
+		lws_vhost_unlock(wsi->a.vhost);
+		lws_fc_unref(wsi->a.vhost, e);
+
+		return 1;
+	}
+
+	lws_vhost_lock(wsi->a.vhost);
+	if (!e->gone) {
+		lws_dll2_remove(&e->lru);
+		lws_dll2_add_head(&e->lru, &fc->lru);
+	}
+	fc->stats.hits++;
+	lws_vhost_unlock(wsi->a.vhost);
+
+	return lws_fc_fd_attach(wsi, e);
+}
+
+/*
+ * wsi->http.fop_fd was just opened on path: if we can, swap it for one on the
+ * cached copy, reading the file into the cache if it's not already there
+ */
+
+void
+lws_http_file_cache_adopt(struct lws *wsi, const char *path)
+{
+	struct lws_http_file_cache *fc = wsi->a.vhost->http.file_cache;
+	lws_fop_fd_t ofd = wsi->http.fop_fd;
+	lws_filepos_t amount, got = 0;
+	lws_fc_entry_t *e, *e1;
+	size_t len, plen;
+	uint32_t h, mod_time;
+
+	/*
+	 * We revalidate entries by stat()ing the path, so we only take files
+	 * the platform fops opened, not ones from zip or other vfs
+	 */
+	if (!fc || !ofd || !lws_http_fop_fd_is_platform(wsi, ofd) ||
+	    (ofd->flags & (LWS_FOP_FLAG_VIRTUAL | LWS_FOP_FLAG_COMPR_IS_GZIP)))
+		return;
+
+	len = (size_t)lws_vfs_get_length(ofd);
+	if (len > fc->max_file || lws_http_plat_stat(path, &len, &mod_time) ||
+	    len != lws_vfs_get_length(ofd))
+		return;
+
+	h = lws_fnv1a32(LWS_FNV1A32_INIT, path, strlen(path));
+
+	lws_vhost_lock(wsi->a.vhost);
+	e = lws_fc_lookup(fc, path, h);
+	if (e && e->len == len && e->mod_time == mod_time) {
+		/* eg, the path was a dir, so it missed before we found it */
+		e->refcount++;
+		e->checked = lws_now_usecs();
+		lws_dll2_remove(&e->lru);
+		lws_dll2_add_head(&e->lru, &fc->lru);
+		fc->stats.hits++;
+		lws_vhost_unlock(wsi->a.vhost);
+
+		goto attach;
+	}
+	lws_vhost_unlock(wsi->a.vhost);
+
+	plen = strlen(path) + 1;
+	e = lws_zalloc(sizeof(*e) + plen + len, __func__);
+	if (!e)
+		return;
+
+	memcpy((char *)&e[1], path, plen);
+	e->data		= (uint8_t *)&e[1] + plen;
+	e->len		= len;
+	e->footprint	= len;
+	e->mod_time	= mod_time;
+	e->hash		= h;
+	e->refcount	= 1;
+	e->checked	= lws_now_usecs();
+
+	while (got < len) {
+		if (lws_vfs_file_read(ofd, &amount, e->data + got,
+				      len - got) < 0 || !amount)
+			break;
+		got += amount;
+	}
+
+	if (got != len) {
+		lws_free(e);
+		/* leave the real one as we found it */
+		if (lws_vfs_file_seek_cur(ofd, -(lws_fileofs_t)got) < 0)
+			lws_vfs_file_close(&wsi->http.fop_fd);
+
+		return;
+	}
+
+	lws_vhost_lock(wsi->a.vhost);
+
+	/* it's fresher than any stale one, or one another pt just added */
+	e1 = lws_fc_lookup(fc, path, h);
+	if (e1)
+		lws_fc_unlist(fc, e1);
+
+	if (lws_fc_make_room(fc, e->footprint, NULL)) {
+		lws_vhost_unlock(wsi->a.vhost);
+		lws_free(e);
+		lws_vfs_file_seek_cur(ofd, -(lws_fileofs_t)got);
+
+		return;
+	}
+
+	lws_dll2_add_head(&e->bucket, &fc->ht[h % LWS_FC_HASH]);
+	lws_dll2_add_head(&e->lru, &fc->lru);
+	fc->stats.entries++;
+	fc->stats.footprint += e->footprint;
+	fc->stats.misses++;
+	lws_vhost_unlock(wsi->a.vhost);
+
+attach:
+	lws_vfs_file_close(&wsi->http.fop_fd);
+	lws_fc_fd_attach(wsi, e);
+}
+
+int
+lws_http_file_cache_is_cached(lws_fop_fd_t fop_fd)
+{
+	return fop_fd && fop_fd->fops == &fops_fc;
+}
+
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+
+/* keep buf as e's compressed form n if it's worth it, or free it */
+
+static void
+lws_fc_install_enc(struct lws_vhost *vh, lws_fc_entry_t *e, int n,
+		   uint8_t *buf, size_t len)
+{
+	struct lws_http_file_cache *fc = vh->http.file_cache;
+
+	lws_vhost_lock(vh);
+	if (len >= e->len || (!e->gone &&
+			      lws_fc_make_room(fc, len, e))) {
+		lws_vhost_unlock(vh);
+		lws_free(buf);
+
+		return;
+	}
+
+	e->enc[n].buf = buf;
+	e->enc[n].len = len;
+	if (!e->gone) {
+		e->footprint += len;
+		fc->stats.footprint += len;
+	}
+	lws_vhost_unlock(vh);
+
+	lwsl_info("%s: %s: %s %u -> %u\n", __func__, lws_fc_path(e),
+		  fc_enc[n]->encoding_name, (unsigned int)e->len,
+		  (unsigned int)len);
+}
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+
+/* on the worker, e->data can't change or go away while we hold a reference */
+
+static void
+lws_fc_job_run(lws_http_cw_job_t *cw)
+{
+	lws_fc_job_t *job = lws_container_of(cw, lws_fc_job_t, cw);
+
+	if (lws_http_compress_buf(fc_enc[job->n], job->e->data, job->e->len,
+				  &job->buf, &job->len))
+		job->buf = NULL;
+}
+
+static void
+lws_fc_job_reap(struct lws_vhost *vh, lws_http_cw_job_t *cw)
+{
+	lws_fc_job_t *job = lws_container_of(cw, lws_fc_job_t, cw);
+
+	lws_vhost_lock(vh);
+	job->e->enc_busy = (uint8_t)(job->e->enc_busy & ~(1 << job->n));
+	lws_vhost_unlock(vh);
+	if (job->buf)
+		lws_fc_install_enc(vh, job->e, job->n, job->buf, job->len);
+	lws_fc_unref(vh, job->e);
+	lws_free(job);
+}
+
+static int
+lws_fc_request_enc(struct lws_vhost *vh, int tsi, lws_fc_entry_t *e, int n)
+{
+	lws_fc_job_t *job;
+
+	job = lws_zalloc(sizeof(*job), __func__);
+	if (!job)
+		return 1;
+
+	job->cw.run	= lws_fc_job_run;
+	job->cw.reap	= lws_fc_job_reap;
+	job->e		= e;
+	job->n		= n;
+
+	lws_vhost_lock(vh);
+	e->refcount++;
+	e->enc_busy = (uint8_t)(e->enc_busy | (1 << n));
+	lws_vhost_unlock(vh);
+
+	if (lws_http_cw_enqueue(vh, tsi, &job->cw, lws_fc_path(e))) {
+		lws_vhost_lock(vh);
+		e->enc_busy = (uint8_t)(e->enc_busy & ~(1 << n));
+		lws_vhost_unlock(vh);
+		lws_fc_unref(vh, e);
+		lws_free(job);
+
+		return 1;
+	}
+
+	return 0;
+}
+
+#endif
+
+/*
+ * Arrange for e's compressed form n to be made, if nobody asked for it yet.
+ * With threadpool it's done on a worker and kept when it's ready, without it
+ * small files are compressed now, and bigger ones are left to stream
+ * compression each time.  Returns 1 if we started on it.
+ */
+
+static int
+lws_fc_build_enc(struct lws_vhost *vh, int tsi, lws_fc_entry_t *e, int n)
+{
+#if !defined(LWS_HTTP_COMPRESS_WORKER)
+	uint8_t *buf;
+	size_t len;
+#endif
+
+	lws_vhost_lock(vh);
+	if (e->enc_tried & (1 << n)) {
+		/* somebody else did it, or is doing it */
+		lws_vhost_unlock(vh);
+		return 0;
+	}
+	e->enc_tried = (uint8_t)(e->enc_tried | (1 << n));
+	lws_vhost_unlock(vh);
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+	if (lws_fc_request_enc(vh, tsi, e, n)) {
+		/* eg, the queue is full... somebody can ask again later */
+		lws_vhost_lock(vh);
+		e->enc_tried = (uint8_t)(e->enc_tried & ~(1 << n));
+		lws_vhost_unlock(vh);
+
+		return 0;
+	}
+#else
+	(void)tsi;
+
+	if (e->len > LWS_FC_MAX_INLINE_ENC)
+		return 0;
+
+	/* e->data can't change or go away while we hold a reference */
+
+	if (!lws_http_compress_buf(fc_enc[n], e->data, e->len, &buf, &len))
+		lws_fc_install_enc(vh, e, n, buf, len);
+#endif
+
+	return 1;
+}
+#endif
+
+/*
+ * A compressible file is being served from the cache: if the client can take
+ * one of our compressed forms, switch the fop_fd over to that and return its
+ * content-encoding name.  If we don't have one yet, ask for it to be built and
+ * return NULL, so this one is sent as if it wasn't cached.
+ */
+
+const char *
+lws_http_file_cache_encoding(struct lws *wsi)
+{
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	lws_fc_fd_t *fd = (lws_fc_fd_t *)wsi->http.fop_fd;
+	const char *ae;
+	int asked = 0;
+	size_t n;
+
+	if (!lws_http_file_cache_is_cached(wsi->http.fop_fd) ||
+	    fd->e->len < LWS_HTTP_COMPRESS_MIN || fd->fop_fd.pos)
+		return NULL;
+
+#if defined(LWS_WITH_RANGES)
+	/* ranges are of the file as it is */
+	if (lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_RANGE))
+		return NULL;
+#endif
+
+	ae = lws_hdr_simple_ptr(wsi, WSI_TOKEN_HTTP_ACCEPT_ENCODING);
+	if (!ae)
+		return NULL;
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+	lws_http_cw_reap(fd->vh);
+#endif
+
+	for (n = 0; n < LWS_ARRAY_SIZE(fc_enc); n++) {
+		if (!strstr(ae, fc_enc[n]->encoding_name))
+			continue;
+
+		lws_vhost_lock(fd->vh);
+		if (fd->e->enc_busy & (1 << n))
+			/* wait for this rather than start on a lesser one */
+			asked = 1;
+		lws_vhost_unlock(fd->vh);
+
+		if (!asked)
+			/* only start on the most preferred one we can */
+			asked = lws_fc_build_enc(fd->vh, wsi->tsi, fd->e,
+						 (int)n);
+
+		lws_vhost_lock(fd->vh);
+		if (fd->e->enc[n].buf) {
+			fd->data = fd->e->enc[n].buf;
+			fd->fop_fd.len = fd->e->enc[n].len;
+			fd->vh->http.file_cache->stats.enc_hits++;
+			lws_vhost_unlock(fd->vh);
+
+			return fc_enc[n]->encoding_name;
+		}
+		lws_vhost_unlock(fd->vh);
+	}
+#endif
+
+	return NULL;
+}
+
+static int
+lws_fc_fop_close(lws_fop_fd_t *fop_fd)
+{
+	lws_fc_fd_t *fd = (lws_fc_fd_t *)*fop_fd;
+
+	lws_fc_unref(fd->vh, fd->e);
+	lws_free(fd);
+	*fop_fd = NULL;
+
+	return 0;
+}
+
+static lws_fileofs_t
+lws_fc_fop_seek_cur(lws_fop_fd_t fop_fd, lws_fileofs_t offset_from_cur_pos)
+{
+	lws_fileofs_t pos = (lws_fileofs_t)fop_fd->pos + offset_from_cur_pos;
+
+	if (pos < 0 || pos > (lws_fileofs_t)fop_fd->len)
+		return -1;
+
+	fop_fd->pos = (lws_filepos_t)pos;
+
+	return pos;
+}
+
+static int
+lws_fc_fop_read(lws_fop_fd_t fop_fd, lws_filepos_t *amount, uint8_t *buf,
+		lws_filepos_t len)
+{
+	lws_fc_fd_t *fd = (lws_fc_fd_t *)fop_fd;
+
+	if (len > fop_fd->len - fop_fd->pos)
+		len = fop_fd->len - fop_fd->pos;
+
+	memcpy(buf, fd->data + fop_fd->pos, (size_t)len);
+	fop_fd->pos += len;
+	*amount = len;
+
+	return 0;
+}
+
+static const struct lws_plat_file_ops fops_fc = {
+	NULL, /* only made by lws_fc_fd_attach() */
+	lws_fc_fop_close,
+	lws_fc_fop_seek_cur,
+	lws_fc_fop_read,
+	NULL,
+	{ { NULL, 0 }, { NULL, 0 }, { NULL, 0 } },
+	NULL,
+	NULL,
+};
+
+int
+lws_http_file_cache_create(struct lws_vhost *vh,
+			   const struct lws_context_creation_info *info)
+{
+	struct lws_http_file_cache *fc;
+
+	if (!info->http_file_cache_size)
+		return 0;
+
+	fc = lws_zalloc(sizeof(*fc), __func__);
+	if (!fc)
+		return 1;
+
+	fc->limit	= info->http_file_cache_size;
+	fc->max_file	= info->http_file_cache_max_file ?
+			  info->http_file_cache_max_file :
+			  LWS_FC_MAX_FILE_DEFAULT;
+	fc->revalidate	= (lws_usec_t)(info->http_file_cache_revalidate_ms ?
+				       info->http_file_cache_revalidate_ms :
+				       LWS_FC_REVALIDATE_MS_DEFAULT) *
+			  LWS_US_PER_MS;
+
+	vh->http.file_cache = fc;
+
+	return 0;
+}
+
+static int
+lws_fc_destroy_entry(struct lws_dll2 *d, void *user)
+{
+	lws_fc_unlist((struct lws_http_file_cache *)user,
+		      lws_container_of(d, lws_fc_entry_t, lru));
+
+	return 0;
+}
+
+void
+lws_http_file_cache_destroy(struct lws_vhost *vh)
+{
+	struct lws_http_file_cache *fc = vh->http.file_cache;
+
+	if (!fc)
+		return;
+
+	/* any still in use are freed when their fop_fd closes */
+	lws_dll2_foreach_safe(&fc->lru, fc, lws_fc_destroy_entry);
+	lws_free_set_NULL(vh->http.file_cache);
+}
+
+int
+lws_http_file_cache_stats(struct lws_vhost *vh,
+			  lws_http_file_cache_stats_t *stats)
+{
+	if (!vh->http.file_cache)
+		return 1;
+
+	lws_vhost_lock(vh);
+	*stats = vh->http.file_cache->stats;
+	lws_vhost_unlock(vh);
+
+	return 0;
+}
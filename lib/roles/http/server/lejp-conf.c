@@ -104,6 +104,9 @@ static const char * const paths_vhosts[] = {
 	"vhosts[].mounts[].headers[].*",
 	"vhosts[].mounts[].headers[]",
 	"vhosts[].mounts[].keepalive-timeout",
+	"vhosts[].mounts[].zero-copy",
+	"vhosts[].mounts[].precompressed",
+	"vhosts[].mounts[].precompress-generate",
 #if defined(LWS_WITH_JOSE)
 	"vhosts[].mounts[].interceptor-path",
 #endif
@@ -149,6 +152,9 @@ static const char * const paths_vhosts[] = {
 
 	"vhosts[].disable-no-protocol-ws-upgrades",
 	"vhosts[].h2-half-closed-long-poll",
+	"vhosts[].file-cache-size",
+	"vhosts[].file-cache-max-file",
+	"vhosts[].file-cache-revalidate-ms",
 };
 
 enum lejp_vhost_paths {
@@ -186,6 +192,9 @@ enum lejp_vhost_paths {
 	LEJPVP_MOUNTPOINT_HEADERS_NAME,
 	LEJPVP_MOUNTPOINT_HEADERS,
 	LEJPVP_MOUNTPOINT_KEEPALIVE_TIMEOUT,
+	LEJPVP_MOUNT_ZERO_COPY,
+	LEJPVP_MOUNT_PRECOMPRESSED,
+	LEJPVP_MOUNT_PRECOMPRESS_GENERATE,
 #if defined(LWS_WITH_JOSE)
 	LEJPVP_MOUNT_INTERCEPTOR_PATH,
 #endif
@@ -233,6 +242,9 @@ enum lejp_vhost_paths {
 
 	LEJPVP_FLAG_DISABLE_NO_PROTOCOL_WS_UPGRADES,
 	LEJPVP_FLAG_H2_HALF_CLOSED_LONG_POLL,
+	LEJPVP_FILE_CACHE_SIZE,
+	LEJPVP_FILE_CACHE_MAX_FILE,
+	LEJPVP_FILE_CACHE_REVALIDATE_MS,
 };
 
 #define MAX_PLUGIN_DIRS 10
@@ -768,6 +780,15 @@ lejp_vhosts_cb(struct lejp_ctx *ctx, char reason)
 	case LEJPVP_MOUNT_CACHE_INTERMEDIARIES:
 		a->m.cache_intermediaries = !!arg_to_bool(ctx->buf);;
 		return 0;
+	case LEJPVP_MOUNT_ZERO_COPY:
+		a->m.zero_copy = !!arg_to_bool(ctx->buf);
+		return 0;
+	case LEJPVP_MOUNT_PRECOMPRESSED:
+		a->m.precompressed = !!arg_to_bool(ctx->buf);
+		return 0;
+	case LEJPVP_MOUNT_PRECOMPRESS_GENERATE:
+		a->m.precompress_generate = !!arg_to_bool(ctx->buf);
+		return 0;
 	case LEJPVP_MOUNT_BASIC_AUTH:
 #if defined(LWS_WITH_HTTP_BASIC_AUTH)
 		a->m.basic_auth_login_file = a->p;
@@ -782,6 +803,16 @@ lejp_vhosts_cb(struct lejp_ctx *ctx, char reason)
 	case LEJPVP_KEEPALIVE_TIMEOUT:
 		a->info->keepalive_timeout = atoi(ctx->buf);
 		return 0;
+	case LEJPVP_FILE_CACHE_SIZE:
+		a->info->http_file_cache_size = (size_t)atol(ctx->buf);
+		return 0;
+	case LEJPVP_FILE_CACHE_MAX_FILE:
+		a->info->http_file_cache_max_file = (size_t)atol(ctx->buf);
+		return 0;
+	case LEJPVP_FILE_CACHE_REVALIDATE_MS:
+		a->info->http_file_cache_revalidate_ms =
+					(unsigned int)atoi(ctx->buf);
+		return 0;
 	case LEJPVP_MOUNTPOINT_KEEPALIVE_TIMEOUT:
 		a->m.keepalive_timeout = (unsigned int)atoi(ctx->buf);
 		return 0;
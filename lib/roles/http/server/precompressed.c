@@ -0,0 +1,481 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Precompressed siblings of static files
+ *
+ * On a file:// mount with precompressed set, a client that accepts br or gzip
+ * is sent file.br or file.gz instead of file, if it is there, is a regular
+ * file no older than file, and is smaller than it.  Range requests always get
+ * the file itself, since the ranges are of that.
+ *
+ * With precompress_generate too, and lws built with threadpool and stream
+ * compression, a compressible file that a client could have had compressed
+ * but has no current sibling gets them made on the vhost's compression worker
+ * (see compress-worker.c), written to a temporary name and renamed into place,
+ * so each version of a file is only compressed once.  The request that noticed
+ * is served as it would have been anyway, later ones find the siblings.
+ *
+ * Siblings we make are given the file's mtime, and on those mounts a sibling
+ * we could make is only current if its mtime is exactly the file's; a file
+ * replaced by an older version, eg, by rsync -t, doesn't get its newer
+ * siblings sent for it.
+ *
+ * We remember the last LWS_PC_MAX_FAILED files we couldn't make siblings for
+ * (eg, the directory isn't writeable), so we don't keep trying for the same
+ * version of them.
+ */
+
+#include "private-lib-core.h"
+
+#if defined(LWS_HTTP_COMPRESS_WORKER) && defined(WIN32)
+#include <sys/utime.h>
+#endif
+
+#define LWS_PC_MAX_FILE		(16 * 1024 * 1024)
+#define LWS_PC_HASH		32
+#define LWS_PC_MAX_FAILED	128 /* files we remember we couldn't do */
+
+/* br is sent if it's there, even if we can't make it ourselves */
+static const struct lws_pc_enc {
+	const char		*name;	/* content-encoding */
+	const char		*suffix;
+} pc_enc[] = {
+	{ "br",		".br" },
+	{ "gzip",	".gz" },
+};
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+
+/*
+ * A file we are making siblings for, or failed to.  The worker only reads the
+ * path and version, the rest belongs to the service threads, under the vhost
+ * lock.
+ */
+
+typedef struct lws_pc_job {
+	lws_http_cw_job_t	cw;
+	lws_dll2_t		bucket;	/* pc->ht[hash % LWS_PC_HASH] */
+	lws_dll2_t		failed_list; /* pc->failed, if failed */
+	size_t			len;	/* the version of the file we tried */
+	uint32_t		mod_time;
+	uint32_t		hash;
+	char			busy;	/* with the worker */
+	char			failed;
+	/* path follows */
+} lws_pc_job_t;
+
+struct lws_http_precomp {
+	lws_dll2_owner_t	ht[LWS_PC_HASH];
+	lws_dll2_owner_t	failed;	/* oldest first */
+};
+
+static struct lws_compression_support *
+lws_pc_lcs(size_t n)
+{
+#if defined(LWS_WITH_HTTP_BROTLI)
+	if (!n)
+		return &lcs_brotli;
+#endif
+
+	return n == 1 ? &lcs_gzip : NULL;
+}
+
+static const char *
+lws_pc_path(const lws_pc_job_t *job)
+{
+	return (const char *)&job[1];
+}
+
+#endif
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+
+static int
+lws_pc_write(const char *path, const uint8_t *buf, size_t len,
+	     uint32_t mod_time)
+{
+	int flags = O_WRONLY | O_CREAT | O_EXCL;
+#if defined(WIN32)
+	struct _utimbuf ut;
+#else
+	struct timespec ts[2];
+#endif
+	ssize_t m;
+	int fd, r;
+
+	/*
+	 * It's in the served dir under a name others can guess... never
+	 * follow or reuse something already there, just give up
+	 */
+#if defined(O_NOFOLLOW)
+	flags |= O_NOFOLLOW;
+#endif
+
+	fd = lws_open(path, flags, 0644);
+	if (fd == -1)
+		return 1;
+
+	while (len) {
+		m = write(fd, buf, len);
+		if (m <= 0) {
+			close(fd);
+			unlink(path);
+
+			return 1;
+		}
+		buf += m;
+		len -= (size_t)m;
+	}
+
+	/* it's of that version of the file, say so */
+
+#if defined(WIN32)
+	ut.actime = ut.modtime = (time_t)mod_time;
+	r = _futime(fd, &ut);
+#else
+	ts[0].tv_sec = 0;
+	ts[0].tv_nsec = UTIME_OMIT;
+	ts[1].tv_sec = (time_t)mod_time;
+	ts[1].tv_nsec = 0;
+	r = futimens(fd, ts);
+#endif
+
+	close(fd);
+	if (r)
+		unlink(path);
+
+	return !!r;
+}
+
+/* on a worker thread... returns nonzero if we couldn't make the siblings */
+
+static int
+lws_pc_generate(lws_pc_job_t *job)
+{
+	const char *path = lws_pc_path(job);
+	char sib[300], tmp[320];
+	uint32_t mod_time;
+	uint8_t *in, *out;
+	size_t n, len, olen;
+	int ret = 0;
+
+	in = lws_malloc(job->len + 1, __func__);
+	if (!in)
+		return 1;
+
+	if (lws_plat_read_file(path, in, job->len + 1) != (int)job->len)
+		/* not what it was when it was asked for, leave it */
+		goto bail;
+
+	for (n = 0; n < LWS_ARRAY_SIZE(pc_enc); n++) {
+		if (!lws_pc_lcs(n))
+			continue;
+
+		if (lws_http_compress_buf(lws_pc_lcs(n), in, job->len,
+					  &out, &olen)) {
+			ret = 1;
+			break;
+		}
+
+		lws_snprintf(sib, sizeof(sib), "%s%s", path, pc_enc[n].suffix);
+		lws_snprintf(tmp, sizeof(tmp), "%s.%p.tmp", sib, job);
+
+		if (lws_pc_write(tmp, out, olen, job->mod_time)) {
+			lwsl_warn("%s: unable to write %s\n", __func__, tmp);
+			lws_free(out);
+			ret = 1;
+			break;
+		}
+		lws_free(out);
+
+		/*
+		 * If the file changed while we were at it, what we made is
+		 * of the old version, don't put it in place
+		 */
+
+		if (lws_http_plat_stat(path, &len, &mod_time) ||
+		    len != job->len || mod_time != job->mod_time) {
+			unlink(tmp);
+			break;
+		}
+
+		if (rename(tmp, sib)) {
+			unlink(tmp);
+			ret = 1;
+			break;
+		}
+
+		lwsl_info("%s: %s: %u -> %u\n", __func__, sib,
+			  (unsigned int)job->len, (unsigned int)olen);
+	}
+
+bail:
+	lws_free(in);
+
+	return ret;
+}
+
+static void
+lws_pc_job_run(lws_http_cw_job_t *cw)
+{
+	lws_pc_job_t *job = lws_container_of(cw, lws_pc_job_t, cw);
+
+	job->failed = (char)lws_pc_generate(job);
+}
+
+static void
+lws_pc_unlist(lws_pc_job_t *job)
+{
+	lws_dll2_remove(&job->bucket);
+	lws_dll2_remove(&job->failed_list);
+	lws_free(job);
+}
+
+/*
+ * Once we made the siblings, they're there to be found and we can forget the
+ * file.  If we couldn't, remember that version of it, but only so many
+ */
+
+static void
+lws_pc_job_reap(struct lws_vhost *vh, lws_http_cw_job_t *cw)
+{
+	lws_pc_job_t *job = lws_container_of(cw, lws_pc_job_t, cw);
+	struct lws_http_precomp *pc = vh->http.precomp;
+
+	lws_vhost_lock(vh); /* -------------- vh { */
+
+	job->busy = 0;
+	if (!job->failed) {
+		lws_pc_unlist(job);
+		goto bail;
+	}
+
+	lws_dll2_add_tail(&job->failed_list, &pc->failed);
+	if (pc->failed.count > LWS_PC_MAX_FAILED)
+		/* forget the oldest */
+		lws_pc_unlist(lws_container_of(lws_dll2_get_head(&pc->failed),
+					       lws_pc_job_t, failed_list));
+
+bail:
+	lws_vhost_unlock(vh); /* } vh -------------- */
+}
+
+/*
+ * Ask for siblings to be made for this version of the file, unless they're
+ * being made already, or we already failed to make them
+ */
+
+static void
+lws_pc_request(struct lws *wsi, const char *path, size_t len,
+	       uint32_t mod_time)
+{
+	struct lws_vhost *vh = wsi->a.vhost;
+	struct lws_http_precomp *pc;
+	lws_pc_job_t *job = NULL;
+	uint32_t h;
+	size_t pl;
+
+	if (len < LWS_HTTP_COMPRESS_MIN || len > LWS_PC_MAX_FILE)
+		return;
+
+	pl = strlen(path) + 1;
+	h = lws_fnv1a32(LWS_FNV1A32_INIT, path, pl - 1);
+
+	lws_vhost_lock(vh); /* -------------- vh { */
+
+	pc = vh->http.precomp;
+	if (!pc) {
+		pc = lws_zalloc(sizeof(*pc), __func__);
+		if (!pc)
+			goto bail;
+		vh->http.precomp = pc;
+	}
+
+	lws_start_foreach_dll(struct lws_dll2 *, d,
+			      lws_dll2_get_head(&pc->ht[h % LWS_PC_HASH])) {
+		lws_pc_job_t *j = lws_container_of(d, lws_pc_job_t, bucket);
+
+		if (j->hash == h && !strcmp(lws_pc_path(j), path)) {
+			job = j;
+			break;
+		}
+	} lws_end_foreach_dll(d);
+
+	if (job && (job->busy || (job->len == len &&
+				  job->mod_time == mod_time)))
+		goto bail;
+
+	if (job) {
+		/* a different version of one we failed on, try it */
+		lws_dll2_remove(&job->failed_list);
+	} else {
+		job = lws_zalloc(sizeof(*job) + pl, __func__);
+		if (!job)
+			goto bail;
+		memcpy(&job[1], path, pl);
+		job->cw.run	= lws_pc_job_run;
+		job->cw.reap	= lws_pc_job_reap;
+		job->hash	= h;
+		lws_dll2_add_tail(&job->bucket, &pc->ht[h % LWS_PC_HASH]);
+	}
+
+	job->len	= len;
+	job->mod_time	= mod_time;
+	job->failed	= 0;
+	job->busy	= 1;
+
+	lws_vhost_unlock(vh); /* } vh -------------- */
+
+	if (!lws_http_cw_enqueue(vh, wsi->tsi, &job->cw, path))
+		return;
+
+	/* we didn't get to try, so don't remember it */
+
+	lws_vhost_lock(vh);
+	lws_pc_unlist(job);
+	lws_vhost_unlock(vh);
+
+	return;
+
+bail:
+	lws_vhost_unlock(vh); /* } vh -------------- */
+}
+
+#endif
+
+/*
+ * wsi->http.fop_fd is open on path, for a mount with precompressed set.  If
+ * the client accepts an encoding we have a usable sibling for, switch the
+ * fop_fd over to that and return its content-encoding name.  Otherwise if
+ * generate, ask for the missing siblings to be made.
+ */
+
+const char *
+lws_http_precomp_select(struct lws *wsi, const char *path, int generate)
+{
+	const struct lws_plat_file_ops *fops;
+	lws_fop_flags_t fflags = LWS_O_RDONLY;
+	size_t n, len, slen;
+	uint32_t mod_time, smod_time;
+	lws_fop_fd_t fop_fd;
+	const char *ae, *vpath;
+	char sib[300];
+	int missing = 0, ours;
+
+	/*
+	 * We look for and check the siblings by stat()ing paths, so only for
+	 * files the platform fops opened, or the file cache's copies of them
+	 */
+	if (!wsi->http.fop_fd ||
+	    (!lws_http_fop_fd_is_platform(wsi, wsi->http.fop_fd) &&
+	     !lws_http_file_cache_is_cached(wsi->http.fop_fd)) ||
+	    (wsi->http.fop_fd->flags & (LWS_FOP_FLAG_VIRTUAL |
+					LWS_FOP_FLAG_COMPR_IS_GZIP)))
+		return NULL;
+
+#if defined(LWS_WITH_RANGES)
+	/* a range is of the file itself, never a sibling */
+	if (lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_RANGE))
+		return NULL;
+#endif
+
+	ae = lws_hdr_simple_ptr(wsi, WSI_TOKEN_HTTP_ACCEPT_ENCODING);
+	if (!ae || lws_http_plat_stat(path, &len, &mod_time))
+		return NULL;
+
+	for (n = 0; n < LWS_ARRAY_SIZE(pc_enc); n++) {
+		if (!strstr(ae, pc_enc[n].name))
+			continue;
+
+		lws_snprintf(sib, sizeof(sib), "%s%s", path, pc_enc[n].suffix);
+
+		/*
+		 * Siblings we would make have the mtime of the version of the
+		 * file they are of, others must just be no older than it
+		 */
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+		ours = generate && lws_pc_lcs(n);
+#else
+		ours = 0;
+#endif
+
+		if (lws_http_plat_stat(sib, &slen, &smod_time) ||
+		    (ours ? smod_time != mod_time : smod_time < mod_time)) {
+			/* not there, or not of this version of the file */
+			if (ours)
+				missing = 1;
+			continue;
+		}
+
+		if (slen >= len)
+			/* it's current but no use */
+			continue;
+
+		fops = lws_vfs_select_fops(wsi->a.context->fops, sib, &vpath);
+		fop_fd = fops->LWS_FOP_OPEN(fops, wsi->a.context->fops, sib,
+					    vpath, &fflags);
+		if (!fop_fd)
+			continue;
+
+		lws_vfs_file_close(&wsi->http.fop_fd);
+		wsi->http.fop_fd = fop_fd;
+
+		lwsl_info("%s: %s: sending %s\n", __func__, path,
+			  pc_enc[n].name);
+
+		return pc_enc[n].name;
+	}
+
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+	if (missing)
+		lws_pc_request(wsi, path, len, mod_time);
+#else
+	(void)missing;
+	(void)generate;
+#endif
+
+	return NULL;
+}
+
+void
+lws_http_precomp_destroy(struct lws_vhost *vh)
+{
+#if defined(LWS_HTTP_COMPRESS_WORKER)
+	struct lws_http_precomp *pc = vh->http.precomp;
+	size_t n;
+
+	if (!pc)
+		return;
+
+	/* the worker was already destroyed, so none are busy */
+
+	for (n = 0; n < LWS_ARRAY_SIZE(pc->ht); n++)
+		lws_start_foreach_dll_safe(struct lws_dll2 *, d, d1,
+					   lws_dll2_get_head(&pc->ht[n])) {
+			lws_pc_unlist(lws_container_of(d, lws_pc_job_t,
+						       bucket));
+		} lws_end_foreach_dll_safe(d, d1);
+
+	lws_free_set_NULL(vh->http.precomp);
+#endif
+}
@@ -329,6 +329,17 @@ done_list:
 			}
 		}
 
+#if defined(__linux__) && defined(SO_REUSEPORT)
+		/*
+		 * The listeners join the reuseport group in bind order, so group
+		 * index m is the listener on pt m
+		 */
+		if (limit > 1 && lws_check_opt(a->vhost->options,
+				LWS_SERVER_OPTION_REUSEPORT_CPU_AFFINITY))
+			lws_plat_listen_steer_cpu(a->vhost, sockfd, m,
+						  limit);
+#endif
+
 		/*
 		 * Create the listen wsi and customize it
 		 */
@@ -551,7 +562,7 @@ single:
 struct lws_vhost *
 lws_select_vhost(struct lws_context *context, int port, const char *servername)
 {
-	struct lws_vhost *vhost = context->vhost_list;
+	struct lws_vhost *vhost, *v;
 	const char *p;
 	int n, colon;
 
@@ -563,13 +574,11 @@ lws_select_vhost(struct lws_context *context, int port, const char *servername)
 
 	/* Priotity 1: first try exact matches */
 
-	while (vhost) {
-		if (port == vhost->listen_port &&
-		    !strncmp(vhost->name, servername, (unsigned int)colon)) {
-			lwsl_info("SNI: Found: %s\n", servername);
-			return vhost;
-		}
-		vhost = vhost->vhost_next;
+	vhost = lws_vhost_name_hash_lookup(context, servername,
+					   (size_t)colon, port);
+	if (vhost) {
+		lwsl_info("SNI: Found: %s\n", servername);
+		return vhost;
 	}
 
 	/*
@@ -578,19 +587,28 @@ lws_select_vhost(struct lws_context *context, int port, const char *servername)
 	 * which is reasonable.  If exact match exists we already chose it and
 	 * never reach here.  SSL will still fail it if the cert doesn't allow
 	 * *.x.com.
+	 *
+	 * We look up each parent domain of servername, and like a walk of the
+	 * vhost list would, take the match that was created first.
 	 */
-	vhost = context->vhost_list;
-	while (vhost) {
-		int m = (int)strlen(vhost->name);
-		if (port && port == vhost->listen_port &&
-		    m <= (colon - 2) &&
-		    servername[colon - m - 1] == '.' &&
-		    !strncmp(vhost->name, servername + colon - m, (unsigned int)m)) {
+	if (port) {
+		for (n = 1; n < colon; n++) {
+			if (servername[n] != '.')
+				continue;
+
+			v = lws_vhost_name_hash_lookup(context,
+						       servername + n + 1,
+						       (size_t)(colon - n - 1),
+						       port);
+			if (v && (!vhost || v->seq < vhost->seq))
+				vhost = v;
+		}
+
+		if (vhost) {
 			lwsl_info("SNI: Found %s on wildcard: %s\n",
 				    servername, vhost->name);
 			return vhost;
 		}
-		vhost = vhost->vhost_next;
 	}
 
 	/* Priority 3: match the first vhost on our port */
@@ -700,6 +718,125 @@ lws_vfs_prepare_flags(struct lws *wsi)
 	return f;
 }
 
+/*
+ * The size and mtime of the regular file at path, or nonzero.
+ *
+ * This stat()s the path directly rather than going through the vfs, so it's
+ * only meaningful for files that were opened by the platform fops (see
+ * lws_http_fop_fd_is_platform()).  The file cache and precompressed siblings
+ * only ever deal with those.
+ */
+
+int
+lws_http_plat_stat(const char *path, size_t *len, uint32_t *mod_time)
+{
+	struct stat st;
+
+	if (stat(path, &st) || (S_IFMT & st.st_mode) != S_IFREG)
+		return 1;
+
+	*len = (size_t)st.st_size;
+	*mod_time = (uint32_t)st.st_mtime;
+
+	return 0;
+}
+
+/*
+ * A file's ETag is made from its length and mtime.  Sent with a content-coding
+ * it's a different representation, so it gets the coding's suffix, eg,
+ * "-br" (RFC 9110 8.8.3).  If-None-Match must name the one this request would
+ * be sent, since a 304 carries that ETag (RFC 9110 15.4.5).
+ */
+
+static const char * const etag_coding[][2] = {
+	{ "br",		"-br" },
+	{ "gzip",	"-gz" },
+	{ "deflate",	"-df" },
+};
+
+static int
+lws_http_etag(lws_fop_fd_t fop_fd, char *buf, size_t len)
+{
+	return lws_snprintf(buf, len, "%08llX%08lX",
+			    (unsigned long long)lws_vfs_get_length(fop_fd),
+			    (unsigned long)lws_vfs_get_mod_time(fop_fd));
+}
+
+static const char *
+lws_http_etag_suffix(const char *ce)
+{
+	size_t n;
+
+	for (n = 0; ce && n < LWS_ARRAY_SIZE(etag_coding); n++)
+		if (!strcmp(ce, etag_coding[n][0]))
+			return etag_coding[n][1];
+
+	return "";
+}
+
+/* the cache-control the mount asked for */
+
+static int
+lws_http_cache_control(struct lws *wsi, char *buf, size_t len)
+{
+	if (wsi->cache_no)
+		return lws_snprintf(buf, len, "no-cache");
+
+	if (!wsi->cache_secs || !wsi->cache_reuse)
+		return lws_snprintf(buf, len, "no-store");
+
+	return lws_snprintf(buf, len, "%s%s, max-age=%u",
+			    wsi->cache_revalidate ? "must-revalidate, " : "",
+			    intermediates[wsi->cache_intermediaries],
+			    wsi->cache_secs);
+}
+
+/*
+ * He has the representation with this ETag already, send him a 304 with it
+ * instead of the file
+ */
+
+static int
+lws_http_not_modified(struct lws *wsi, const char *etag, int etag_len,
+		      char vary, unsigned char *p, unsigned char *end)
+{
+	unsigned char *start = p;
+	char cache_control[50];
+	int n;
+
+	if (lws_add_http_header_status(wsi, HTTP_STATUS_NOT_MODIFIED,
+				       &p, end) ||
+	    lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_ETAG,
+				(unsigned char *)etag, etag_len, &p, end))
+		return -1;
+
+	if (vary && lws_add_http_header_by_name(wsi,
+				(unsigned char *)"vary:",
+				(unsigned char *)"accept-encoding", 15,
+				&p, end))
+		return -1;
+
+	/* but we still need to send cache control... */
+
+	n = lws_http_cache_control(wsi, cache_control, sizeof(cache_control));
+	if (lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_CACHE_CONTROL,
+					 (unsigned char *)cache_control, n,
+					 &p, end) ||
+	    lws_finalize_http_header(wsi, &p, end))
+		return -1;
+
+	n = lws_write(wsi, start, lws_ptr_diff_size_t(p, start),
+		      LWS_WRITE_HTTP_HEADERS | LWS_WRITE_H2_STREAM_END);
+	if (n != lws_ptr_diff(p, start)) {
+		lwsl_err("_write returned %d from %ld\n", n, (long)(p - start));
+		return -1;
+	}
+
+	lws_vfs_file_close(&wsi->http.fop_fd);
+
+	return lws_http_transaction_completed(wsi);
+}
+
 static int
 lws_http_serve(struct lws *wsi, char *uri, const char *origin,
 	       const struct lws_http_mount *m)
@@ -742,6 +879,13 @@ lws_http_serve(struct lws *wsi, char *uri, const char *origin,
 
 	fflags |= lws_vfs_prepare_flags(wsi);
 
+	if (wsi->http.fop_fd)
+		lws_vfs_file_close(&wsi->http.fop_fd);
+
+	if (!lws_http_file_cache_open(wsi, path))
+		/* we have it in memory and it didn't change */
+		goto cached;
+
 	do {
 		spin++;
 		fops = lws_vfs_select_fops(wsi->a.context->fops, path, &vpath);
@@ -813,9 +957,10 @@ lws_http_serve(struct lws *wsi, char *uri, const char *origin,
 	if (spin == 5)
 		lwsl_err("symlink loop %s \n", path);
 
-	n = sprintf(sym, "%08llX%08lX",
-		    (unsigned long long)lws_vfs_get_length(wsi->http.fop_fd),
-		    (unsigned long)lws_vfs_get_mod_time(wsi->http.fop_fd));
+	lws_http_file_cache_adopt(wsi, path);
+
+cached:
+	lws_http_etag(wsi->http.fop_fd, sym, sizeof(sym));
 
 	/* disable ranges if IF_RANGE token invalid */
 
@@ -823,81 +968,6 @@ lws_http_serve(struct lws *wsi, char *uri, const char *origin,
 		if (strcmp(sym, lws_hdr_simple_ptr(wsi, WSI_TOKEN_HTTP_IF_RANGE)))
 			/* differs - defeat Range: */
 			wsi->http.ah->frag_index[WSI_TOKEN_HTTP_RANGE] = 0;
-
-	if (lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_IF_NONE_MATCH)) {
-		/*
-		 * he thinks he has some version of it already,
-		 * check if the tag matches
-		 */
-		if (!strcmp(sym, lws_hdr_simple_ptr(wsi,
-					WSI_TOKEN_HTTP_IF_NONE_MATCH))) {
-
-			char cache_control[50], *cc = "no-store";
-			int cclen = 8;
-
-			lwsl_debug("%s: ETAG match %s %s\n", __func__,
-				   uri, origin);
-
-			/* we don't need to send the payload */
-			if (lws_add_http_header_status(wsi,
-					HTTP_STATUS_NOT_MODIFIED, &p, end)) {
-				lwsl_err("%s: failed adding not modified\n",
-						__func__);
-				return -1;
-			}
-
-			if (lws_add_http_header_by_token(wsi,
-					WSI_TOKEN_HTTP_ETAG,
-					(unsigned char *)sym, n, &p, end))
-				return -1;
-
-			/* but we still need to send cache control... */
-
-			if (m->cache_max_age && m->cache_reusable) {
-				if (!m->cache_revalidate) {
-					cc = cache_control;
-					cclen = sprintf(cache_control,
-						"%s, max-age=%u",
-						intermediates[wsi->cache_intermediaries],
-						m->cache_max_age);
-				} else {
-					cc = cache_control;
-                                        cclen = sprintf(cache_control,
-                                        	"must-revalidate, %s, max-age=%u",
-                                                intermediates[wsi->cache_intermediaries],
-                                                m->cache_max_age);
-				}
-			}
-
-			if (lws_add_http_header_by_token(wsi,
-					WSI_TOKEN_HTTP_CACHE_CONTROL,
-					(unsigned char *)cc, cclen, &p, end))
-				return -1;
-
-			if (lws_finalize_http_header(wsi, &p, end))
-				return -1;
-
-			n = lws_write(wsi, start, lws_ptr_diff_size_t(p, start),
-				      LWS_WRITE_HTTP_HEADERS |
-				      LWS_WRITE_H2_STREAM_END);
-			if (n != lws_ptr_diff(p, start)) {
-				lwsl_err("_write returned %d from %ld\n", n,
-					 (long)(p - start));
-				return -1;
-			}
-
-			lws_vfs_file_close(&wsi->http.fop_fd);
-
-			if (lws_http_transaction_completed(wsi))
-				return -1;
-
-			return 0;
-		}
-	}
-
-	if (lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_ETAG,
-			(unsigned char *)sym, n, &p, end))
-		return -1;
 #endif
 
 	mimetype = lws_get_mimetype(path, m);
@@ -971,6 +1041,13 @@ lws_http_serve(struct lws *wsi, char *uri, const char *origin,
 	}
 
 	*p = '\0';
+#if !defined(_WIN32_WCE)
+	/* it adds the ETag, or 304s, once it knows the content-coding */
+	wsi->http.etag = 1;
+#endif
+	wsi->http.zero_copy = m->zero_copy;
+	wsi->http.precompressed = m->precompressed;
+	wsi->http.precompress_generate = m->precompress_generate;
 	n = lws_serve_http_file(wsi, path, mimetype, (char *)start,
 				lws_ptr_diff(p, start));
 
@@ -986,48 +1063,187 @@ notfound:
 #endif
 
 #if defined(LWS_ROLE_H1) || defined(LWS_ROLE_H2)
+
+/*
+ * A mountpoint can only match the uri up to a '/', up to the end of the uri,
+ * or if it's a single char.  So rather than compare every mount, the vhost
+ * keeps its mounts hashed by mountpoint, and we look up the uri prefix at
+ * each of those places.  The cost depends on the uri length, not the number
+ * of mounts.
+ *
+ * Which of the matching mounts is chosen depends on their order in the mount
+ * list, so we consider the matches in list order like walking the list did.
+ */
+
+typedef struct lws_mount_index_entry {
+	const struct lws_http_mount	*m;
+	uint32_t			hash;
+	int				next; /* in bucket, or -1 */
+} lws_mount_index_entry_t;
+
+struct lws_mount_index {
+	int				*bucket; /* first entry, or -1 */
+	lws_mount_index_entry_t		*e; /* in mount list order */
+	uint32_t			mask;
+
+	/* bucket and entry arrays are overallocated */
+};
+
+/* the most matching mounts one uri can have before we walk the list */
+#define LWS_MOUNT_INDEX_MAX_HITS 16
+
+void
+lws_http_mount_index_destroy(struct lws_vhost *vh)
+{
+	lws_free_set_NULL(vh->http.mount_index);
+}
+
+void
+lws_http_mount_index_create(struct lws_vhost *vh)
+{
+	const struct lws_http_mount *m;
+	struct lws_mount_index *mi;
+	int n = 0, b = 1, i;
+
+	lws_http_mount_index_destroy(vh);
+
+	for (m = vh->http.mount_list; m; m = m->mount_next)
+		n++;
+	if (!n)
+		return;
+
+	while (b < n * 2)
+		b <<= 1;
+
+	mi = lws_malloc(sizeof(*mi) + sizeof(int) * (unsigned int)b +
+			sizeof(*mi->e) * (unsigned int)n, "mount index");
+	if (!mi) {
+		/* lws_find_mount() will just walk the list */
+		lwsl_vhost_warn(vh, "OOM indexing mounts");
+		return;
+	}
+
+	mi->bucket = (int *)&mi[1];
+	mi->e = (lws_mount_index_entry_t *)&mi->bucket[b];
+	mi->mask = (uint32_t)b - 1;
+
+	for (i = 0; i < b; i++)
+		mi->bucket[i] = -1;
+
+	for (m = vh->http.mount_list, i = 0; m; m = m->mount_next, i++) {
+		mi->e[i].m = m;
+		mi->e[i].hash = lws_fnv1a32(LWS_FNV1A32_INIT, m->mountpoint,
+					    (size_t)m->mountpoint_len);
+	}
+
+	/* link from the end, so each bucket is also in mount list order */
+
+	for (i = n - 1; i >= 0; i--) {
+		b = (int)(mi->e[i].hash & mi->mask);
+		mi->e[i].next = mi->bucket[b];
+		mi->bucket[b] = i;
+	}
+
+	vh->http.mount_index = mi;
+}
+
+/*
+ * hm matched the uri, see if it's a better choice than *hit.  Returns nonzero
+ * if the uri is explicitly not mounted.
+ */
+
+static int
+lws_find_mount_consider(struct lws *wsi, const struct lws_http_mount *hm,
+			int *best, const struct lws_http_mount **hit)
+{
+#if defined(LWS_WITH_SYS_METRICS)
+	lws_metrics_tag_wsi_add(wsi, "mnt", hm->mountpoint);
+#endif
+
+	if (hm->origin_protocol == LWSMPRO_NO_MOUNT)
+		return 1;
+
+	if (hm->origin_protocol == LWSMPRO_CALLBACK ||
+	    ((hm->origin_protocol == LWSMPRO_CGI ||
+	     lws_hdr_total_length(wsi, WSI_TOKEN_GET_URI) ||
+	     lws_hdr_total_length(wsi, WSI_TOKEN_POST_URI) ||
+#if defined(LWS_WITH_HTTP_UNCOMMON_HEADERS)
+	     lws_hdr_total_length(wsi, WSI_TOKEN_PUT_URI) ||
+	     lws_hdr_total_length(wsi, WSI_TOKEN_PATCH_URI) ||
+	     lws_hdr_total_length(wsi, WSI_TOKEN_DELETE_URI) ||
+#endif
+	     lws_hdr_total_length(wsi, WSI_TOKEN_HEAD_URI) ||
+#if defined(LWS_ROLE_H2)
+	     (wsi->mux_substream &&
+		lws_hdr_total_length(wsi,
+				WSI_TOKEN_HTTP_COLON_PATH)) ||
+#endif
+	     hm->protocol) &&
+	    hm->mountpoint_len > *best)) {
+		*best = hm->mountpoint_len;
+		*hit = hm;
+	}
+
+	return 0;
+}
+
 LWS_VISIBLE const struct lws_http_mount *
 lws_find_mount(struct lws *wsi, const char *uri_ptr, int uri_len)
 {
+	struct lws_mount_index *mi = wsi->a.vhost->http.mount_index;
 	const struct lws_http_mount *hm, *hit = NULL;
-	int best = 0;
+	int hits[LWS_MOUNT_INDEX_MAX_HITS], nh = 0, best = 0, hashed = 0, n, e, i;
+	uint32_t h = LWS_FNV1A32_INIT;
+
+	if (!mi)
+		goto walk;
+
+	for (n = 0; n <= uri_len; n++) {
+		if (n == 1 || uri_ptr[n] == '\0' || uri_ptr[n] == '/') {
+			/* the hash of uri_ptr[0..n) */
+			h = lws_fnv1a32(h, uri_ptr + hashed, (size_t)(n - hashed));
+			hashed = n;
+
+			for (e = mi->bucket[h & mi->mask]; e >= 0;
+			     e = mi->e[e].next) {
+				hm = mi->e[e].m;
+				if (mi->e[e].hash != h ||
+				    hm->mountpoint_len != n ||
+				    strncmp(uri_ptr, hm->mountpoint,
+					    (unsigned int)n))
+					continue;
+
+				if (nh == LWS_MOUNT_INDEX_MAX_HITS)
+					goto walk;
+
+				/* keep the hits in mount list order */
+				for (i = nh++; i && hits[i - 1] > e; i--)
+					hits[i] = hits[i - 1];
+				hits[i] = e;
+			}
+		}
+
+		if (n == uri_len || !uri_ptr[n])
+			break;
+	}
+
+	for (i = 0; i < nh; i++)
+		if (lws_find_mount_consider(wsi, mi->e[hits[i]].m, &best, &hit))
+			return NULL;
 
+	return hit;
+
+walk:
 	hm = wsi->a.vhost->http.mount_list;
 	while (hm) {
 		if (uri_len >= hm->mountpoint_len &&
 		    !strncmp(uri_ptr, hm->mountpoint, hm->mountpoint_len) &&
 		    (uri_ptr[hm->mountpoint_len] == '\0' ||
 		     uri_ptr[hm->mountpoint_len] == '/' ||
-		     hm->mountpoint_len == 1)
-		    ) {
-#if defined(LWS_WITH_SYS_METRICS)
-			lws_metrics_tag_wsi_add(wsi, "mnt", hm->mountpoint);
-#endif
-
-			if (hm->origin_protocol == LWSMPRO_NO_MOUNT)
-				return NULL;
+		     hm->mountpoint_len == 1) &&
+		    lws_find_mount_consider(wsi, hm, &best, &hit))
+			return NULL;
 
-			if (hm->origin_protocol == LWSMPRO_CALLBACK ||
-			    ((hm->origin_protocol == LWSMPRO_CGI ||
-			     lws_hdr_total_length(wsi, WSI_TOKEN_GET_URI) ||
-			     lws_hdr_total_length(wsi, WSI_TOKEN_POST_URI) ||
-#if defined(LWS_WITH_HTTP_UNCOMMON_HEADERS)
-			     lws_hdr_total_length(wsi, WSI_TOKEN_PUT_URI) ||
-			     lws_hdr_total_length(wsi, WSI_TOKEN_PATCH_URI) ||
-			     lws_hdr_total_length(wsi, WSI_TOKEN_DELETE_URI) ||
-#endif
-			     lws_hdr_total_length(wsi, WSI_TOKEN_HEAD_URI) ||
-#if defined(LWS_ROLE_H2)
-			     (wsi->mux_substream &&
-				lws_hdr_total_length(wsi,
-						WSI_TOKEN_HTTP_COLON_PATH)) ||
-#endif
-			     hm->protocol) &&
-			    hm->mountpoint_len > best)) {
-				best = hm->mountpoint_len;
-				hit = hm;
-			}
-		}
 		hm = hm->mount_next;
 	}
 
@@ -2767,6 +2983,9 @@ lws_http_transaction_completed(struct lws *wsi)
 	wsi->http.tx_content_remain = 0;
 	wsi->hdr_parsing_completed = 0;
 	wsi->sending_chunked = 0;
+	wsi->http.zero_copy = 0;
+	wsi->http.precompressed = 0;
+	wsi->http.precompress_generate = 0;
 #ifdef LWS_WITH_ACCESS_LOG
 	wsi->http.access_log.sent = 0;
 #endif
@@ -2853,6 +3072,138 @@ lws_http_transaction_completed(struct lws *wsi)
 }
 
 #if defined(LWS_WITH_FILE_OPS)
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+/* types we know compress well, so may be sent compressed */
+
+static int
+lws_http_compressible(const char *content_type)
+{
+	return content_type && (!strncmp(content_type, "text/", 5) ||
+				!strcmp(content_type, "application/javascript") ||
+				!strcmp(content_type, "image/svg+xml"));
+}
+#endif
+
+/*
+ * Served files, including ones from the file cache, get their status, vhost
+ * and mount headers and content-type from one of the blocks the vhost keeps for
+ * the combinations of those it sent most recently.
+ */
+
+#define LWS_SERVE_HDR_BLOCKS 16
+
+typedef struct lws_serve_hdrs {
+	lws_dll2_t		list;	/* vh->http.serve_hdrs, most recent first */
+	lws_http_hdr_block_t	*b;
+	const struct lws_protocol_vhost_options *mount; /* made for these... */
+	unsigned int		code;		/* ...this code... */
+	uint32_t		hash;		/* ...and this content-type */
+
+	/* content-type follows */
+} lws_serve_hdrs_t;
+
+static void
+lws_serve_hdrs_free(lws_serve_hdrs_t *h)
+{
+	lws_dll2_remove(&h->list);
+	lws_http_hdr_block_destroy(&h->b);
+	lws_free(h);
+}
+
+static int
+lws_serve_hdrs_destroy_cb(struct lws_dll2 *d, void *user)
+{
+	lws_serve_hdrs_free(lws_container_of(d, lws_serve_hdrs_t, list));
+
+	return 0;
+}
+
+void
+lws_http_serve_hdrs_destroy(struct lws_vhost *vh)
+{
+	lws_vhost_lock(vh);
+	lws_dll2_foreach_safe(&vh->http.serve_hdrs, NULL,
+			      lws_serve_hdrs_destroy_cb);
+	lws_vhost_unlock(vh);
+}
+
+/* returns nonzero if the caller must add them itself */
+
+static int
+lws_serve_http_file_headers(struct lws *wsi, unsigned int code,
+			    const char *content_type, unsigned char **p,
+			    unsigned char *end)
+{
+	const struct lws_protocol_vhost_options *mount =
+					wsi->http.mount_specific_headers;
+	struct lws_vhost *vh = wsi->a.vhost;
+	lws_http_hdr_block_info_t i;
+	lws_serve_hdrs_t *h = NULL;
+	size_t ctl;
+	uint32_t hash;
+	int r = 1;
+
+	if (!content_type)
+		content_type = "";
+	ctl = strlen(content_type);
+	hash = lws_fnv1a32(LWS_FNV1A32_INIT, content_type, ctl);
+
+	lws_vhost_lock(vh);
+
+	lws_start_foreach_dll(struct lws_dll2 *, d,
+			      lws_dll2_get_head(&vh->http.serve_hdrs)) {
+		lws_serve_hdrs_t *h1 = lws_container_of(d, lws_serve_hdrs_t,
+							list);
+
+		if (h1->hash == hash && h1->code == code &&
+		    h1->mount == mount &&
+		    !strcmp((const char *)&h1[1], content_type)) {
+			h = h1;
+			break;
+		}
+	} lws_end_foreach_dll(d);
+
+	if (h) {
+		lws_dll2_remove(&h->list);
+	} else {
+		h = lws_malloc(sizeof(*h) + ctl + 1, __func__);
+		if (!h)
+			goto bail;
+
+		memset(&i, 0, sizeof(i));
+		i.vhost		= vh;
+		i.mount_headers	= mount;
+		i.content_type	= ctl ? content_type : NULL;
+		i.code		= code;
+
+		memset(&h->list, 0, sizeof(h->list));
+		h->b = lws_http_hdr_block_create(&i);
+		if (!h->b) {
+			lws_free(h);
+			goto bail;
+		}
+		h->mount	= mount;
+		h->code		= code;
+		h->hash		= hash;
+		memcpy(&h[1], content_type, ctl + 1);
+
+		if (vh->http.serve_hdrs.count == LWS_SERVE_HDR_BLOCKS)
+			lws_serve_hdrs_free(lws_container_of(
+				lws_dll2_get_tail(&vh->http.serve_hdrs),
+				lws_serve_hdrs_t, list));
+	}
+
+	lws_dll2_add_head(&h->list, &vh->http.serve_hdrs);
+
+	r = lws_add_http_header_block(wsi, h->b, LWS_ILLEGAL_HTTP_CONTENT_LEN,
+				      NULL, p, end);
+
+bail:
+	lws_vhost_unlock(vh);
+
+	return r;
+}
+
 int
 lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 		    const char *other_headers, int other_headers_len)
@@ -2863,8 +3214,8 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 #if defined(LWS_WITH_RANGES)
 	struct lws_range_parsing *rp = &wsi->http.range;
 #endif
-	int ret = 0, cclen = 8, n = HTTP_STATUS_OK;
-	char cache_control[50], *cc = "no-store";
+	int ret = 0, cclen, n = HTTP_STATUS_OK;
+	char cache_control[50];
 	lws_fop_flags_t fflags = LWS_O_RDONLY;
 	const struct lws_plat_file_ops *fops;
 	lws_filepos_t total_content_length;
@@ -2874,6 +3225,12 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 #if defined(LWS_WITH_RANGES)
 	int ranges;
 #endif
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	struct lws_compression_support *lcs = NULL;
+#endif
+	const char *ce = NULL, *ct = NULL, *etag_ce = NULL;
+	char vary = 0, hb, etag[32];
+	int etag_len = 0;
 
 	if (wsi->handling_404)
 		n = HTTP_STATUS_NOT_FOUND;
@@ -2885,7 +3242,7 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 	 *
 	 * If wsi->http.fop_fd is already set, the caller already opened it
 	 */
-	if (!wsi->http.fop_fd) {
+	if (!wsi->http.fop_fd && lws_http_file_cache_open(wsi, file)) {
 		fops = lws_vfs_select_fops(wsi->a.context->fops, file, &vpath);
 		fflags |= lws_vfs_prepare_flags(wsi);
 		wsi->http.fop_fd = fops->LWS_FOP_OPEN(fops, wsi->a.context->fops,
@@ -2898,12 +3255,84 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 						return -1;
 			return !wsi->mux_substream;
 		}
+		lws_http_file_cache_adopt(wsi, file);
 	}
 
 	/*
 	 * Caution... wsi->http.fop_fd is live from here
 	 */
 
+	if (wsi->http.etag) {
+		/* lws_http_serve() wants one, of the file itself */
+		wsi->http.etag = 0;
+		etag_len = lws_http_etag(wsi->http.fop_fd, etag, sizeof(etag));
+	}
+
+	if (wsi->http.precompressed && !wsi->interpreting) {
+		/* what we send depends on accept-encoding, and may be... */
+		vary = 1;
+		/* ...a file.br or file.gz next to the file */
+		ce = lws_http_precomp_select(wsi, file,
+					     wsi->http.precompress_generate
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+					     && lws_http_compressible(content_type)
+#endif
+					     );
+	}
+
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	if (!ce && lws_http_file_cache_is_cached(wsi->http.fop_fd) &&
+	    !wsi->interpreting && lws_http_compressible(content_type)) {
+		/* what we send depends on accept-encoding, and may be... */
+		vary = 1;
+		/* ...a compressed form the cache keeps, if he can take it */
+		ce = lws_http_file_cache_encoding(wsi);
+	}
+#endif
+
+	/* the content-coding we send decides the ETag, so settle it first */
+	if ((wsi->http.fop_fd->flags & (LWS_FOP_FLAG_COMPR_ACCEPTABLE_GZIP |
+		       LWS_FOP_FLAG_COMPR_IS_GZIP)) ==
+	    (LWS_FOP_FLAG_COMPR_ACCEPTABLE_GZIP | LWS_FOP_FLAG_COMPR_IS_GZIP))
+		etag_ce = "gzip";
+	else if (ce)
+		etag_ce = ce;
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	else if (!wsi->interpreting &&
+#if defined(LWS_WITH_RANGES)
+		 /* Content-Range talks about the identity bytes */
+		 !lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_RANGE) &&
+#endif
+		 lws_http_compressible(content_type)) {
+		/*
+		 * if we know its very compressible, and we can use
+		 * compression, then use the most preferred compression
+		 * method that the client said he will accept
+		 */
+		lcs = lws_http_compression_select(wsi, NULL, 0);
+		if (lcs)
+			etag_ce = lcs->encoding_name;
+	}
+#endif
+
+	if (etag_len && n == HTTP_STATUS_OK &&
+	    lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_IF_NONE_MATCH)) {
+		lws_snprintf(etag + etag_len, sizeof(etag) - (size_t)etag_len,
+			     "%s", lws_http_etag_suffix(etag_ce));
+
+		/* does he have this representation already? */
+		if (!strcmp(etag, lws_hdr_simple_ptr(wsi,
+					WSI_TOKEN_HTTP_IF_NONE_MATCH))) {
+			lwsl_debug("%s: ETag match %s\n", __func__, file);
+
+			if (lws_http_not_modified(wsi, etag, (int)strlen(etag),
+						  vary, p, end))
+				goto bail;
+
+			return 0;
+		}
+	}
+
 	wsi->http.filelen = lws_vfs_get_length(wsi->http.fop_fd);
 	total_content_length = wsi->http.filelen;
 
@@ -2933,45 +3362,47 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 		n = HTTP_STATUS_PARTIAL_CONTENT;
 #endif
 
-	if (lws_add_http_header_status(wsi, (unsigned int)n, &p, end))
-		goto bail;
-
-	if ((wsi->http.fop_fd->flags & (LWS_FOP_FLAG_COMPR_ACCEPTABLE_GZIP |
-		       LWS_FOP_FLAG_COMPR_IS_GZIP)) ==
-	    (LWS_FOP_FLAG_COMPR_ACCEPTABLE_GZIP | LWS_FOP_FLAG_COMPR_IS_GZIP)) {
-		if (lws_add_http_header_by_token(wsi,
-			WSI_TOKEN_HTTP_CONTENT_ENCODING,
-			(unsigned char *)"gzip", 4, &p, end))
-			goto bail;
-		lwsl_info("file is being provided in gzip\n");
-	}
-#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
-	else {
-		/*
-		 * if we know its very compressible, and we can use
-		 * compression, then use the most preferred compression
-		 * method that the client said he will accept
-		 */
-
-		if (!wsi->interpreting && (
-		     !strncmp(content_type, "text/", 5) ||
-		     !strcmp(content_type, "application/javascript") ||
-		     !strcmp(content_type, "image/svg+xml")))
-			lws_http_compression_apply(wsi, NULL, &p, end, 0);
-	}
-#endif
-
 	if (
 #if defined(LWS_WITH_RANGES)
 	    ranges < 2 &&
 #endif
 	    content_type && content_type[0])
+		ct = content_type;
+
+	/* from one of the vhost's header blocks */
+	hb = !lws_serve_http_file_headers(wsi, (unsigned int)n, ct, &p, end);
+	if (!hb && lws_add_http_header_status(wsi, (unsigned int)n, &p, end))
+		goto bail;
+
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	if (lcs) {
+		if (lws_http_compression_apply(wsi, lcs->encoding_name,
+					       &p, end, 0) || !wsi->http.lcs) {
+			/* it goes as it is after all */
+			etag_ce = NULL;
+		}
+	} else
+#endif
+	if (etag_ce) {
 		if (lws_add_http_header_by_token(wsi,
-						 WSI_TOKEN_HTTP_CONTENT_TYPE,
-						 (unsigned char *)content_type,
-						 (int)strlen(content_type),
-						 &p, end))
+				WSI_TOKEN_HTTP_CONTENT_ENCODING,
+				(unsigned char *)etag_ce, (int)strlen(etag_ce),
+				&p, end))
 			goto bail;
+		lwsl_info("file is being provided in %s\n", etag_ce);
+	}
+
+	if (vary && lws_add_http_header_by_name(wsi,
+				(unsigned char *)"vary:",
+				(unsigned char *)"accept-encoding", 15,
+				&p, end))
+		goto bail;
+
+	if (!hb && ct &&
+	    lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_CONTENT_TYPE,
+					 (unsigned char *)ct, (int)strlen(ct),
+					 &p, end))
+		goto bail;
 
 #if defined(LWS_WITH_RANGES)
 	if (ranges >= 2) { /* multipart byteranges */
@@ -3089,24 +3520,8 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 		}
 	}
 
-	if (wsi->cache_no) {
-		cc = cache_control;
-		cclen = sprintf(cache_control, "no-cache");
-	}
-	else if (wsi->cache_secs && wsi->cache_reuse) {
-		if (!wsi->cache_revalidate) {
-			cc = cache_control;
-			cclen = sprintf(cache_control, "%s, max-age=%u",
-                         intermediates[wsi->cache_intermediaries],
-                         wsi->cache_secs);
-		} else {
-			cc = cache_control;
-			cclen = sprintf(cache_control,
-                         "must-revalidate, %s, max-age=%u",
-                         intermediates[wsi->cache_intermediaries],
-                         wsi->cache_secs);
-		}
-	}
+	cclen = lws_http_cache_control(wsi, cache_control,
+				       sizeof(cache_control));
 
 	/* Only add cache control if its not specified by any other_headers. */
 	if (!other_headers ||
@@ -3114,7 +3529,17 @@ lws_serve_http_file(struct lws *wsi, const char *file, const char *content_type,
 	     !strstr(other_headers, "Cache-Control"))) {
 		if (lws_add_http_header_by_token(wsi,
 				WSI_TOKEN_HTTP_CACHE_CONTROL,
-				(unsigned char *)cc, cclen, &p, end))
+				(unsigned char *)cache_control, cclen,
+				&p, end))
+			goto bail;
+	}
+
+	if (etag_len) {
+		etag_len += lws_snprintf(etag + etag_len,
+					 sizeof(etag) - (size_t)etag_len, "%s",
+					 lws_http_etag_suffix(etag_ce));
+		if (lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_ETAG,
+				(unsigned char *)etag, etag_len, &p, end))
 			goto bail;
 	}
 
@@ -3160,11 +3585,51 @@ bail:
 
 #if defined(LWS_WITH_FILE_OPS)
 
+#if defined(LWS_HAVE_SENDFILE)
+/*
+ * The mount asked for zero-copy, but we can only sendfile() when the bytes go
+ * out on the socket exactly as they are in a real file: no userland tls, no h2
+ * framing, no chunking, interpretation, stream compression or multipart range
+ * boundaries, and nothing buffered ahead of them.
+ */
+
+static int
+lws_http_file_can_sendfile(struct lws *wsi)
+{
+	if (!wsi->http.zero_copy || wsi->mux_substream ||
+	    wsi->sending_chunked || wsi->interpreting ||
+	    lws_has_buffered_out(wsi) ||
+	    wsi->http.fop_fd->fops->LWS_FOP_READ != _lws_plat_file_read)
+		return 0;
+
+	/* on tls, only if the kernel is doing the record encryption */
+	if (lws_is_ssl(wsi)
+#if defined(LWS_WITH_TLS) && defined(LWS_HAVE_SSL_sendfile) && \
+    !defined(LWS_WITH_MBEDTLS)
+	    && !wsi->tls.ktls_tx
+#endif
+	)
+		return 0;
+
+#if defined(LWS_WITH_HTTP_STREAM_COMPRESSION)
+	if (wsi->http.lcs)
+		return 0;
+#endif
+#if defined(LWS_WITH_RANGES)
+	if (wsi->http.range.count_ranges > 1)
+		return 0;
+#endif
+
+	return 1;
+}
+#endif
+
 int lws_serve_http_file_fragment(struct lws *wsi)
 {
 	struct lws_context *context = wsi->a.context;
 	struct lws_context_per_thread *pt = &context->pt[(int)wsi->tsi];
 	struct lws_process_html_args args;
+	enum lws_write_protocol wp;
 	lws_filepos_t amount, poss;
 	unsigned char *p, *pstart;
 #if defined(LWS_WITH_RANGES)
@@ -3312,6 +3777,59 @@ int lws_serve_http_file_fragment(struct lws *wsi)
 				poss = wsi->http.range.budget;
 		}
 #endif
+#if defined(LWS_HAVE_SENDFILE)
+		if (lws_http_file_can_sendfile(wsi)) {
+			/*
+			 * serv_buf size doesn't limit us, just the file or
+			 * range remaining and any protocol tx size hint
+			 */
+			poss = wsi->http.filelen - wsi->http.filepos;
+#if defined(LWS_WITH_RANGES)
+			if (wsi->http.range.count_ranges &&
+			    poss > wsi->http.range.budget)
+				poss = wsi->http.range.budget;
+#endif
+			if (wsi->a.protocol->tx_packet_size &&
+			    poss > wsi->a.protocol->tx_packet_size)
+				poss = wsi->a.protocol->tx_packet_size;
+			if (poss > LWS_SENDFILE_MAX_CHUNK)
+				poss = LWS_SENDFILE_MAX_CHUNK;
+
+#if defined(LWS_WITH_TLS) && defined(LWS_HAVE_SSL_sendfile) && \
+    !defined(LWS_WITH_MBEDTLS)
+			if (lws_is_ssl(wsi))
+				n = lws_tls_file_sendfile(wsi, wsi->http.fop_fd,
+							  &amount, poss);
+			else
+#endif
+				n = lws_plat_file_sendfile(wsi->http.fop_fd,
+							   wsi->desc.sockfd,
+							   &amount, poss);
+			if (n < 0) {
+				wsi->socket_is_permanently_unusable = 1;
+				goto file_had_it;
+			}
+			if (!amount)
+				/* socket is full, come back when writeable */
+				break;
+
+			wsi->could_have_pending = 1;
+			lws_set_timeout(wsi, PENDING_TIMEOUT_HTTP_CONTENT,
+					(int)context->timeout_secs);
+#ifdef LWS_WITH_ACCESS_LOG
+			wsi->http.access_log.sent += amount;
+#endif
+#if defined(LWS_WITH_SYS_METRICS)
+			if (wsi->a.vhost)
+				lws_metric_event(wsi->a.vhost->mt_traffic_tx,
+						 METRES_GO, (u_mt_t)amount);
+#endif
+			n = m = (int)amount;
+
+			goto account;
+		}
+#endif
+
 		if (wsi->sending_chunked) {
 			/* we need to drop the chunk size in here */
 			p += 10;
@@ -3362,12 +3880,23 @@ int lws_serve_http_file_fragment(struct lws *wsi)
 				lwsl_debug("added trailing boundary\n");
 			}
 #endif
-			m = lws_write(wsi, p, (unsigned int)n, wsi->http.filepos + amount ==
-					wsi->http.filelen ?
-					 LWS_WRITE_HTTP_FINAL : LWS_WRITE_HTTP);
+			wp = wsi->http.filepos + amount == wsi->http.filelen ?
+					LWS_WRITE_HTTP_FINAL : LWS_WRITE_HTTP;
+#if defined(LWS_WITH_RANGES)
+			/* the end of the last range is the end of the response */
+			if (wsi->http.range.count_ranges >= 1)
+				wp = wsi->http.range.send_ctr + 1 ==
+					wsi->http.range.count_ranges &&
+				     wsi->http.range.budget - amount == 0 ?
+					LWS_WRITE_HTTP_FINAL : LWS_WRITE_HTTP;
+#endif
+			m = lws_write(wsi, p, (unsigned int)n, wp);
 			if (m < 0)
 				goto file_had_it;
 
+#if defined(LWS_HAVE_SENDFILE)
+account:
+#endif
 			wsi->http.filepos += amount;
 
 #if defined(LWS_WITH_RANGES)
@@ -3411,6 +3940,7 @@ all_sent:
 			lwsi_set_state(wsi, LRS_ESTABLISHED);
 			/* we might be in keepalive, so close it off here */
 			lws_vfs_file_close(&wsi->http.fop_fd);
+			wsi->http.zero_copy = 0;
 
 			lwsl_debug("file completed\n");
 
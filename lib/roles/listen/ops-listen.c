@@ -22,15 +22,219 @@
  * IN THE SOFTWARE.
  */
 
+#if !defined(_GNU_SOURCE)
+#define _GNU_SOURCE /* for accept4() */
+#endif
 #include <private-lib-core.h>
 
+#if defined(LWS_PLAT_UNIX) && defined(LWS_HAVE_ACCEPT4)
+#define lws_accept(_fd, _sa, _len) \
+	accept4(_fd, _sa, _len, SOCK_NONBLOCK | SOCK_CLOEXEC)
+#define LWS_ACCEPT_SOPT	LWS_SKT_OPT_ACCEPTED_NB_CLOEXEC
+#else
+#define lws_accept(_fd, _sa, _len) accept(_fd, _sa, _len)
+#define LWS_ACCEPT_SOPT	0
+#endif
+
+#if defined(LWS_WITH_SYS_METRICS)
+/*
+ * Histogram of how many connections we accepted per wake of the listen
+ * socket, in power of two buckets, eg, "0", "1", "2-3", "4-7"
+ */
+
+static void
+lws_listen_batch_report(struct lws_context *cx, unsigned int n)
+{
+	unsigned int lo = 1;
+	char name[24];
+
+	if (!cx->mth_accept_batch)
+		return;
+
+	if (n < 2)
+		lws_snprintf(name, sizeof(name), "%u", n);
+	else {
+		while (lo * 2 <= n)
+			lo *= 2;
+		lws_snprintf(name, sizeof(name), "%u-%u", lo, (lo * 2) - 1);
+	}
+
+	/* the service threads all bump the same histogram */
+	lws_context_lock(cx, __func__);
+	lws_metrics_hist_bump_priv(cx->mth_accept_batch, name);
+	lws_context_unlock(cx);
+}
+#endif
+
+#if defined(LWS_WITH_TLS)
+/*
+ * can we really accept it, with regards to SSL limit?  another vhost may also
+ * have had POLLIN on his listener this round and used it up already
+ */
+
+static int
+lws_listen_tls_full(struct lws *wsi)
+{
+	struct lws_context *context = wsi->a.context;
+
+	return wsi->a.vhost->tls.use_ssl &&
+	       context->simultaneous_ssl_restriction &&
+	       context->simultaneous_ssl ==
+			context->simultaneous_ssl_restriction;
+}
+#endif
+
+/*
+ * Filter and adopt one connection that was accepted on listen wsi, either
+ * by us below, or by an event lib that does the accept itself.  Returns
+ * LWS_HPI_RET_HANDLED if the listen wsi can go on accepting.
+ */
+
+static lws_handling_result_t
+lws_listen_adopt(struct lws_context_per_thread *pt, struct lws *wsi,
+		 struct lws_filter_network_conn_args *filt)
+{
+	struct lws_context *context = wsi->a.context;
+	int opts = LWS_ADOPT_SOCKET | LWS_ADOPT_ALLOW_SSL, tsi = -1;
+	lws_sock_file_fd_type fd;
+	struct lws *cwsi;
+
+	if (context->being_destroyed) {
+		compatible_close(filt->accept_fd);
+
+		return LWS_HPI_RET_PLEASE_CLOSE_ME;
+	}
+
+	lws_plat_set_socket_options(wsi->a.vhost, filt->accept_fd,
+				    LWS_ACCEPT_SOPT);
+
+#if defined(LWS_WITH_IPV6)
+	lwsl_debug("accepted new conn port %u on fd=%d\n",
+		((filt->cli_addr.ss_family == AF_INET6) ?
+		ntohs(((struct sockaddr_in6 *) &filt->cli_addr)->sin6_port) :
+		ntohs(((struct sockaddr_in *) &filt->cli_addr)->sin_port)),
+		filt->accept_fd);
+#else
+	{
+	struct sockaddr_in sain;
+
+	memcpy(&sain, &filt->cli_addr, sizeof(sain));
+	lwsl_debug("accepted new conn port %u on fd=%d\n",
+		   ntohs(sain.sin_port),
+		   filt->accept_fd);
+	}
+#endif
+
+	/*
+	 * look at who we connected to and give user code a
+	 * chance to reject based on client IP.  There's no
+	 * protocol selected yet so we issue this to
+	 * protocols[0]
+	 */
+	if ((wsi->a.vhost->protocols[0].callback)(wsi,
+			LWS_CALLBACK_FILTER_NETWORK_CONNECTION,
+			(void *)filt,
+			(void *)(lws_intptr_t)filt->accept_fd, 0)) {
+		lwsl_debug("Callback denied net connection\n");
+		compatible_close(filt->accept_fd);
+
+		return LWS_HPI_RET_HANDLED;
+	}
+
+	if (!(wsi->a.vhost->options &
+		LWS_SERVER_OPTION_ADOPT_APPLY_LISTEN_ACCEPT_CONFIG))
+		opts |= LWS_ADOPT_HTTP;
+
+#if defined(LWS_WITH_TLS)
+	if (!wsi->a.vhost->tls.use_ssl)
+#endif
+		opts &= ~LWS_ADOPT_ALLOW_SSL;
+
+	fd.sockfd = filt->accept_fd;
+#if LWS_MAX_SMP > 1
+	/*
+	 * With per-pt reuseport listeners and steering, the kernel
+	 * already chose this pt for the connection, keep it here if
+	 * we have room for it
+	 */
+	if (lws_check_opt(wsi->a.vhost->options,
+			LWS_SERVER_OPTION_REUSEPORT_CPU_AFFINITY) &&
+	    pt->fds_count < context->fd_limit_per_thread - 1)
+		tsi = wsi->tsi;
+#endif
+	/* we already know the peer, adoption needn't ask for it again */
+	cwsi = lws_adopt_descriptor_vhost_tsi(wsi->a.vhost,
+				(lws_adoption_type)opts, fd,
+				wsi->a.vhost->listen_accept_protocol, tsi,
+				&filt->cli_addr, filt->clilen);
+	if (!cwsi) {
+		lwsl_info("%s: vh %s: adopt failed\n", __func__,
+				wsi->a.vhost->name);
+
+		/* already closed cleanly as necessary */
+		return LWS_HPI_RET_WSI_ALREADY_DIED;
+	}
+/*
+	if (lws_server_socket_service_ssl(cwsi, accept_fd, 1)) {
+		lws_close_free_wsi(cwsi, LWS_CLOSE_STATUS_NOSTATUS,
+				   "listen svc fail");
+		return LWS_HPI_RET_WSI_ALREADY_DIED;
+	}
+
+	lwsl_info("%s: new %s: wsistate 0x%lx, role_ops %s\n",
+		    __func__, lws_wsi_tag(cwsi), (unsigned long)cwsi->wsistate,
+		    cwsi->role_ops->name);
+*/
+
+	return LWS_HPI_RET_HANDLED;
+}
+
+/*
+ * An event lib that accepts for us, eg, io_uring multishot accept, hands us
+ * the new fd here.  The kernel accepted it already, so if we can't take it
+ * now, all we can do is hang up on it.
+ */
+
+lws_handling_result_t
+lws_listen_accepted(struct lws *wsi, lws_sockfd_type accept_fd)
+{
+	struct lws_context_per_thread *pt = &wsi->a.context->pt[(int)wsi->tsi];
+	struct lws_filter_network_conn_args filt;
+
+	if (wsi->a.vhost->being_destroyed ||
+#if defined(LWS_WITH_TLS)
+	    lws_listen_tls_full(wsi) ||
+#endif
+	    pt->fds_count >= wsi->a.context->fd_limit_per_thread - 1) {
+		compatible_close(accept_fd);
+
+		return LWS_HPI_RET_HANDLED;
+	}
+
+	memset(&filt, 0, sizeof(filt));
+	filt.accept_fd = accept_fd;
+	filt.clilen = sizeof(filt.cli_addr);
+
+	/* the filter callback gets the peer address */
+	if (getpeername(accept_fd, (struct sockaddr *)&filt.cli_addr,
+			&filt.clilen)) {
+		lwsl_info("%s: getpeername: errno %d\n", __func__, LWS_ERRNO);
+		compatible_close(accept_fd);
+
+		return LWS_HPI_RET_HANDLED;
+	}
+
+	return lws_listen_adopt(pt, wsi, &filt);
+}
+
 static lws_handling_result_t
 rops_handle_POLLIN_listen(struct lws_context_per_thread *pt, struct lws *wsi,
 			  struct lws_pollfd *pollfd)
 {
 	struct lws_context *context = wsi->a.context;
+	lws_handling_result_t ret = LWS_HPI_RET_HANDLED;
 	struct lws_filter_network_conn_args filt;
-	lws_sock_file_fd_type fd;
+	unsigned int batch = 0;
 
 	memset(&filt, 0, sizeof(filt));
 
@@ -46,23 +250,12 @@ rops_handle_POLLIN_listen(struct lws_context_per_thread *pt, struct lws *wsi,
 	 */
 
 	do {
-		struct lws *cwsi;
-		int opts = LWS_ADOPT_SOCKET | LWS_ADOPT_ALLOW_SSL;
-
 		if (!(pollfd->revents & (LWS_POLLIN | LWS_POLLOUT)) ||
 		    !(pollfd->events & LWS_POLLIN))
 			break;
 
 #if defined(LWS_WITH_TLS)
-		/*
-		 * can we really accept it, with regards to SSL limit?
-		 * another vhost may also have had POLLIN on his
-		 * listener this round and used it up already
-		 */
-		if (wsi->a.vhost->tls.use_ssl &&
-		    context->simultaneous_ssl_restriction &&
-		    context->simultaneous_ssl ==
-				  context->simultaneous_ssl_restriction)
+		if (lws_listen_tls_full(wsi))
 			/*
 			 * no... ignore it, he won't come again until
 			 * we are below the simultaneous_ssl_restriction
@@ -81,9 +274,9 @@ rops_handle_POLLIN_listen(struct lws_context_per_thread *pt, struct lws *wsi,
 		 * block the connect queue for other legit peers.
 		 */
 
-		filt.accept_fd = accept((int)pollfd->fd,
-					(struct sockaddr *)&filt.cli_addr,
-					&filt.clilen);
+		filt.accept_fd = lws_accept((int)pollfd->fd,
+					    (struct sockaddr *)&filt.cli_addr,
+					    &filt.clilen);
 		if (filt.accept_fd == LWS_SOCK_INVALID) {
 			if (LWS_ERRNO == LWS_EAGAIN ||
 			    LWS_ERRNO == LWS_EWOULDBLOCK) {
@@ -91,85 +284,33 @@ rops_handle_POLLIN_listen(struct lws_context_per_thread *pt, struct lws *wsi,
 			}
 			lwsl_err("accept: errno %d\n", LWS_ERRNO);
 
-			return LWS_HPI_RET_HANDLED;
+			break;
 		}
 
-		if (context->being_destroyed) {
-			compatible_close(filt.accept_fd);
+		batch++;
 
-			return LWS_HPI_RET_PLEASE_CLOSE_ME;
-		}
-
-		lws_plat_set_socket_options(wsi->a.vhost, filt.accept_fd, 0);
+		ret = lws_listen_adopt(pt, wsi, &filt);
 
-#if defined(LWS_WITH_IPV6)
-		lwsl_debug("accepted new conn port %u on fd=%d\n",
-			((filt.cli_addr.ss_family == AF_INET6) ?
-			ntohs(((struct sockaddr_in6 *) &filt.cli_addr)->sin6_port) :
-			ntohs(((struct sockaddr_in *) &filt.cli_addr)->sin_port)),
-			filt.accept_fd);
-#else
-		{
-		struct sockaddr_in sain;
-
-		memcpy(&sain, &filt.cli_addr, sizeof(sain));
-		lwsl_debug("accepted new conn port %u on fd=%d\n",
-			   ntohs(sain.sin_port),
-			   filt.accept_fd);
-		}
+	/*
+	 * Keep draining the accept queue, but only up to the budget so we
+	 * don't starve everything else on this pt during a connect storm.
+	 * The listen socket is nonblocking, so on unix accept() telling us
+	 * EAGAIN is cheaper than polling it first every time.
+	 */
+	} while (ret == LWS_HPI_RET_HANDLED &&
+		 batch < context->accept_budget &&
+		 pt->fds_count < context->fd_limit_per_thread - 1 &&
+		 wsi->position_in_fds_table != LWS_NO_FDS_POS
+#if !defined(LWS_PLAT_UNIX)
+		 && lws_poll_listen_fd(&pt->fds[wsi->position_in_fds_table]) > 0
 #endif
+		);
 
-		/*
-		 * look at who we connected to and give user code a
-		 * chance to reject based on client IP.  There's no
-		 * protocol selected yet so we issue this to
-		 * protocols[0]
-		 */
-		if ((wsi->a.vhost->protocols[0].callback)(wsi,
-				LWS_CALLBACK_FILTER_NETWORK_CONNECTION,
-				(void *)&filt,
-				(void *)(lws_intptr_t)filt.accept_fd, 0)) {
-			lwsl_debug("Callback denied net connection\n");
-			compatible_close(filt.accept_fd);
-			return LWS_HPI_RET_HANDLED;
-		}
-
-		if (!(wsi->a.vhost->options &
-			LWS_SERVER_OPTION_ADOPT_APPLY_LISTEN_ACCEPT_CONFIG))
-			opts |= LWS_ADOPT_HTTP;
-
-#if defined(LWS_WITH_TLS)
-		if (!wsi->a.vhost->tls.use_ssl)
+#if defined(LWS_WITH_SYS_METRICS)
+	lws_listen_batch_report(context, batch);
 #endif
-			opts &= ~LWS_ADOPT_ALLOW_SSL;
 
-		fd.sockfd = filt.accept_fd;
-		cwsi = lws_adopt_descriptor_vhost(wsi->a.vhost, (lws_adoption_type)opts, fd,
-				wsi->a.vhost->listen_accept_protocol, NULL);
-		if (!cwsi) {
-			lwsl_info("%s: vh %s: adopt failed\n", __func__,
-					wsi->a.vhost->name);
-
-			/* already closed cleanly as necessary */
-			return LWS_HPI_RET_WSI_ALREADY_DIED;
-		}
-/*
-		if (lws_server_socket_service_ssl(cwsi, accept_fd, 1)) {
-			lws_close_free_wsi(cwsi, LWS_CLOSE_STATUS_NOSTATUS,
-					   "listen svc fail");
-			return LWS_HPI_RET_WSI_ALREADY_DIED;
-		}
-
-		lwsl_info("%s: new %s: wsistate 0x%lx, role_ops %s\n",
-			    __func__, lws_wsi_tag(cwsi), (unsigned long)cwsi->wsistate,
-			    cwsi->role_ops->name);
-*/
-
-	} while (pt->fds_count < context->fd_limit_per_thread - 1 &&
-		 wsi->position_in_fds_table != LWS_NO_FDS_POS &&
-		 lws_poll_listen_fd(&pt->fds[wsi->position_in_fds_table]) > 0);
-
-	return LWS_HPI_RET_HANDLED;
+	return ret;
 }
 
 lws_handling_result_t
@@ -1330,6 +1330,7 @@ cmd_completion:
 				    !w->user_space_externally_allocated)
 					lws_free_set_NULL(w->user_space);
 				w->user_space = wsi->user_space;
+				w->user_space_slab = wsi->user_space_slab;
 				wsi->user_space = NULL;
 				w->user_space_externally_allocated =
 					wsi->user_space_externally_allocated;
@@ -2113,14 +2114,14 @@ do_write:
 		 * we must RETRY the publish
 		 */
 		wsi->mqtt->sul_qos_puback_pubrec_wait.cb = lws_mqtt_publish_resend;
-		__lws_sul_insert_us(&pt->pt_sul_owner[wsi->conn_validity_wakesuspend],
+		__lws_sul_insert_us(pt, wsi->conn_validity_wakesuspend,
 				    &wsi->mqtt->sul_qos_puback_pubrec_wait,
 				    3 * LWS_USEC_PER_SEC);
 	}
 
 	if (wsi->mqtt->inside_shadow) {
 		wsi->mqtt->sul_shadow_wait.cb = lws_mqtt_shadow_timeout;
-		__lws_sul_insert_us(&pt->pt_sul_owner[wsi->conn_validity_wakesuspend],
+		__lws_sul_insert_us(pt, wsi->conn_validity_wakesuspend,
 				    &wsi->mqtt->sul_shadow_wait,
 				    60 * LWS_USEC_PER_SEC);
 	}
@@ -2464,7 +2465,7 @@ lws_mqtt_client_send_unsubcribe(struct lws *wsi,
 	wsi->mqtt->inside_unsubscribe = 1;
 
 	wsi->mqtt->sul_unsuback_wait.cb = lws_mqtt_unsuback_timeout;
-	__lws_sul_insert_us(&pt->pt_sul_owner[wsi->conn_validity_wakesuspend],
+	__lws_sul_insert_us(pt, wsi->conn_validity_wakesuspend,
 			    &wsi->mqtt->sul_unsuback_wait,
 			    3 * LWS_USEC_PER_SEC);
 
@@ -32,6 +32,12 @@ rops_handle_POLLIN_pipe(struct lws_context_per_thread *pt, struct lws *wsi,
 	eventfd_t value;
 	int n;
 
+	/*
+	 * Clear this before consuming the signal, so anything signalled from
+	 * here on either is handled below or gets its own wake
+	 */
+	__atomic_store_n(&pt->wake_pending, 0, __ATOMIC_SEQ_CST);
+
 	n = eventfd_read(wsi->desc.sockfd, &value);
 	if (n < 0) {
 		lwsl_notice("%s: eventfd read %d bailed errno %d\n", __func__,
@@ -42,6 +48,8 @@ rops_handle_POLLIN_pipe(struct lws_context_per_thread *pt, struct lws *wsi,
 	char s[100];
 	int n;
 
+	__atomic_store_n(&pt->wake_pending, 0, __ATOMIC_SEQ_CST);
+
 	/*
 	 * discard the byte(s) that signaled us
 	 * We really don't care about the number of bytes, but coverity
@@ -60,6 +68,11 @@ rops_handle_POLLIN_pipe(struct lws_context_per_thread *pt, struct lws *wsi,
 		return LWS_HPI_RET_PLEASE_CLOSE_ME;
 #endif
 
+	pt->wake_delivered++;
+
+	/* messages other threads posted to us with lws_pt_msg_post() */
+	lws_pt_msg_drain(pt, 0);
+
 #if defined(LWS_WITH_THREADPOOL) && defined(LWS_HAVE_PTHREAD_H)
 	/*
 	 * threadpools that need to call for on_writable callbacks do it by
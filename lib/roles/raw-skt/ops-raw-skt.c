@@ -173,6 +173,29 @@ rops_handle_POLLIN_raw_skt(struct lws_context_per_thread *pt, struct lws *wsi,
 			goto post_rx;
 #endif
 		default:
+#if defined(LWS_WITH_UDP)
+			if (wsi->udp_batch_rx && wsi->udp) {
+				n = lws_udp_read_batch(wsi);
+				if (n == LWS_SSL_CAPABLE_ERROR)
+					goto fail;
+				/* the whole batch is lost together */
+				if (!n || lws_fi(&wsi->fic, "udp_rx_loss"))
+					goto try_pollout;
+
+				n = user_callback_handle_rxflow(
+						wsi->a.protocol->callback, wsi,
+						LWS_CALLBACK_RAW_RX_BATCH,
+						wsi->user_space,
+						wsi->udp_rx_batch->d,
+						(unsigned int)n);
+				if (n < 0) {
+					lwsl_wsi_info(wsi, "RAW_RX_BATCH fail");
+					goto fail;
+				}
+
+				goto try_pollout;
+			}
+#endif
 			ebuf.token = NULL;
 			ebuf.len = (int) wsi->a.protocol->rx_buffer_size;
 
@@ -0,0 +1,318 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Encode-once broadcast messages
+ *
+ * Server -> client frames are never masked, so a frame built once is good
+ * for every server-side connection.  We build it once at creation time, in
+ * front of the payload copy, and send the same bytes to everyone.
+ *
+ * permessage-deflate output normally depends on the per-connection
+ * compression context.  But if the connection's tx context is fresh, ie,
+ * it never compressed anything yet or it was reset at the end of the last
+ * message because no context takeover was negotiated, the output for a
+ * message is the same for everybody.  So we can also keep a precompressed
+ * frame and send that to those connections, as long as they accept our
+ * window size.
+ *
+ * Uncompressed messages are always legal on a pmd connection and don't
+ * touch its compression context, so a pmd connection that can't take the
+ * compressed frame just gets the plain one, unless the message was created
+ * asking for compression, in which case we let lws_write() compress it for
+ * that connection as usual.
+ */
+
+#include <private-lib-core.h>
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+#include "ext/extension-permessage-deflate.h"
+
+/* the window size we compress with, peers must allow at least this */
+#define LWS_WS_BCAST_WBITS 15
+#endif
+
+struct lws_ws_bcast {
+	uint8_t			*frame;		/* plain frame, in this alloc */
+	uint8_t			*payload;	/* inside frame */
+	uint8_t			*dframe;	/* deflated frame or NULL */
+	uint8_t			*dalloc;	/* allocation holding dframe */
+	size_t			len;		/* payload len */
+	size_t			flen;		/* plain frame len */
+	size_t			dflen;		/* deflated frame len */
+	int			refcount;
+	uint8_t			wp;
+	uint8_t			flags;
+};
+
+/* write the server header that ends at p, returns its length */
+
+static size_t
+lws_ws_bcast_hdr(uint8_t *p, uint8_t b0, size_t len)
+{
+	if (len < 126) {
+		p[-2] = b0;
+		p[-1] = (uint8_t)len;
+
+		return 2;
+	}
+
+	if (len < 65536) {
+		p[-4] = b0;
+		p[-3] = 126;
+		p[-2] = (uint8_t)(len >> 8);
+		p[-1] = (uint8_t)len;
+
+		return 4;
+	}
+
+	p[-10] = b0;
+	p[-9] = 127;
+	lws_ser_wu64be(p - 8, (uint64_t)len);
+
+	return 10;
+}
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+static int
+lws_ws_bcast_deflate(struct lws_ws_bcast *b, uint8_t b0)
+{
+	size_t bound, dlen;
+	z_stream z;
+	uint8_t *d;
+
+	memset(&z, 0, sizeof(z));
+	if (deflateInit2(&z, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+			 -LWS_WS_BCAST_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+		return 1;
+
+	/* room for the sync flush trailer we will remove */
+	bound = (size_t)deflateBound(&z, (uLong)b->len) + 16;
+	d = lws_malloc(LWS_PRE + bound, __func__);
+	if (!d) {
+		deflateEnd(&z);
+		return 1;
+	}
+
+	z.next_in = b->payload;
+	z.avail_in = (uInt)b->len;
+	z.next_out = d + LWS_PRE;
+	z.avail_out = (uInt)bound;
+
+	if (deflate(&z, Z_SYNC_FLUSH) != Z_OK || z.avail_in) {
+		deflateEnd(&z);
+		lws_free(d);
+		return 1;
+	}
+	deflateEnd(&z);
+
+	/* RFC7692 7.2.1: the 00 00 ff ff from the sync flush is implied */
+
+	dlen = bound - z.avail_out;
+	if (dlen >= 4)
+		dlen -= 4;
+
+	if (dlen >= b->len) {
+		/* no win, plain frame for everyone */
+		lws_free(d);
+		return 0;
+	}
+
+	b->dalloc = d;
+	b->dflen = dlen + lws_ws_bcast_hdr(d + LWS_PRE, b0 | 0x40, dlen);
+	b->dframe = d + LWS_PRE + dlen - b->dflen;
+
+	return 0;
+}
+
+/*
+ * Returns the pmd priv if pmd is the only active extension on the wsi,
+ * NULL if there are no extensions, or (void *)-1 if there are others
+ */
+
+static struct lws_ext_pm_deflate_priv *
+lws_ws_bcast_pmd(struct lws *wsi)
+{
+	if (!wsi->ws->count_act_ext)
+		return NULL;
+
+	if (wsi->ws->count_act_ext != 1 ||
+	    strcmp(wsi->ws->active_extensions[0]->name, "permessage-deflate"))
+		return (struct lws_ext_pm_deflate_priv *)(intptr_t)-1;
+
+	return (struct lws_ext_pm_deflate_priv *)wsi->ws->act_ext_user[0];
+}
+#endif
+
+struct lws_ws_bcast *
+lws_ws_bcast_create(const void *payload, size_t len,
+		    enum lws_write_protocol wp, int flags)
+{
+	struct lws_ws_bcast *b;
+	uint8_t b0;
+
+	switch ((int)wp) {
+	case LWS_WRITE_TEXT:
+		b0 = 0x80 | LWSWSOPC_TEXT_FRAME;
+		break;
+	case LWS_WRITE_BINARY:
+		b0 = 0x80 | LWSWSOPC_BINARY_FRAME;
+		break;
+	default:
+		lwsl_err("%s: wp must be TEXT or BINARY\n", __func__);
+		return NULL;
+	}
+
+	b = lws_malloc(sizeof(*b) + LWS_PRE + len, __func__);
+	if (!b)
+		return NULL;
+
+	memset(b, 0, sizeof(*b));
+	b->payload = (uint8_t *)&b[1] + LWS_PRE;
+	if (len)
+		memcpy(b->payload, payload, len);
+	b->len = len;
+	b->wp = (uint8_t)wp;
+	b->flags = (uint8_t)flags;
+	b->refcount = 1;
+
+	b->flen = len + lws_ws_bcast_hdr(b->payload, b0, len);
+	b->frame = b->payload + len - b->flen;
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	if ((flags & LWSWSBC_F_DEFLATE) && len &&
+	    lws_ws_bcast_deflate(b, b0)) {
+		lws_free(b);
+		return NULL;
+	}
+#endif
+
+	return b;
+}
+
+struct lws_ws_bcast *
+lws_ws_bcast_ref(struct lws_ws_bcast *b)
+{
+	b->refcount++;
+
+	return b;
+}
+
+void
+lws_ws_bcast_unref(struct lws_ws_bcast *b)
+{
+	if (!b || --b->refcount)
+		return;
+
+	if (b->dalloc)
+		lws_free(b->dalloc);
+	lws_free(b);
+}
+
+const uint8_t *
+lws_ws_bcast_payload(const struct lws_ws_bcast *b, size_t *len)
+{
+	*len = b->len;
+
+	return b->payload;
+}
+
+/*
+ * lws_write_iov() takes care of keeping the copy alive if pmd is still
+ * compressing from it after we return
+ */
+
+static int
+lws_ws_bcast_write_copy(struct lws *wsi, struct lws_ws_bcast *b)
+{
+	lws_iov_t v = { b->payload, b->len };
+
+	return lws_write_iov(wsi, &v, 1, (enum lws_write_protocol)b->wp) <
+							(int)b->len ? -1 : 0;
+}
+
+int
+lws_ws_bcast_write(struct lws *wsi, struct lws_ws_bcast *b)
+{
+	uint8_t *frame = b->frame;
+	size_t flen = b->flen;
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	struct lws_ext_pm_deflate_priv *pmd;
+#endif
+
+	if (!wsi->ws || (wsi->ws->last_valid && !wsi->ws->last_fin)) {
+		lwsl_wsi_err(wsi, "not ws, or inside a fragmented message");
+		return -1;
+	}
+
+	/* peers who need masking or h2 framing can't share our bytes */
+
+	if (lwsi_role_client(wsi) || lwsi_role_h2_ENCAPSULATION(wsi) ||
+	    wsi->ws->inside_frame || wsi->ws->stashed_write_pending)
+		return lws_ws_bcast_write_copy(wsi, b);
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	if (wsi->ws->tx_draining_ext)
+		return lws_ws_bcast_write_copy(wsi, b);
+
+	pmd = lws_ws_bcast_pmd(wsi);
+	if (pmd == (struct lws_ext_pm_deflate_priv *)(intptr_t)-1)
+		/* some other extension may want to see the payload */
+		return lws_ws_bcast_write_copy(wsi, b);
+
+	if (pmd && (b->flags & LWSWSBC_F_DEFLATE)) {
+		if (!b->dframe)
+			/*
+			 * we found compression didn't help, don't let
+			 * lws_write() try it per-connection either
+			 */
+			goto send;
+
+		if (pmd->tx_init || pmd->args[PMD_SERVER_MAX_WINDOW_BITS] <
+						LWS_WS_BCAST_WBITS)
+			/*
+			 * his compression context is in use, or he needs a
+			 * smaller window... compress it just for him
+			 */
+			return lws_ws_bcast_write_copy(wsi, b);
+
+		frame = b->dframe;
+		flen = b->dflen;
+	}
+send:
+#endif
+
+	/*
+	 * lws_write() considers LWS_WRITE_RAW as already-framed, it just sends
+	 * it or buffers it behind anything pending.  We must do the outgoing
+	 * frame state bookkeeping it would have done for TEXT / BINARY.
+	 */
+
+	if (lws_write(wsi, frame, flen, LWS_WRITE_RAW) < (int)flen)
+		return -1;
+
+	wsi->ws->last_valid = 1;
+	wsi->ws->last_opcode = (uint8_t)(frame[0] & 0xf);
+	wsi->ws->last_fin = 1;
+
+	return 0;
+}
@@ -107,6 +107,19 @@ lws_ws_client_rx_parser_block(struct lws *wsi, const uint8_t **buf, size_t *len)
 	size_t chunk_len;
 
 	while (*len) {
+		/*
+		 * If the rest of a frame header after the first byte is all
+		 * here, decode it in one step
+		 */
+		if (wsi->lws_rx_parse_state == LWS_RXPS_04_FRAME_HDR_LEN) {
+			chunk_len = lws_ws_frame_hdr_rest(wsi, *buf, *len, 0);
+			if (chunk_len) {
+				*buf += chunk_len;
+				*len -= chunk_len;
+				continue;
+			}
+		}
+
 		/*
 		 * We can process headers and control frames byte-by-byte
 		 * using the original state machine.
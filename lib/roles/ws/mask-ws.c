@@ -0,0 +1,114 @@
+/*
+ * libwebsockets - small server side websockets and web server implementation
+ *
+ * Copyright (C) 2010 - 2026 Andy Green <andy@warmcat.com>
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ *
+ * Applying the ws masking key is a per-byte XOR with a 4-byte period, so
+ * any span that starts in phase can be done a vector or word at a time with
+ * the key repeated across the register.  We rotate the key once so it's in
+ * phase with buf[0], and every chunk we take is a multiple of 4 bytes, so it
+ * stays in phase all the way down to the bytewise tail.
+ *
+ * The vector kernels are chosen at build time from what the compiler was
+ * told the target supports, there's no runtime cpu dispatch.  The 64-bit
+ * word loop is the portable fallback and mops up after the vector loops.
+ */
+
+#include <private-lib-core.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+void
+lws_ws_mask_xor(uint8_t *buf, size_t len, const uint8_t *mask,
+		uint8_t *mask_idx)
+{
+	unsigned int idx = mask_idx ? *mask_idx & 3u : 0u;
+	uint8_t key[8];
+	uint64_t k64;
+	size_t n;
+
+	for (n = 0; n < sizeof(key); n++)
+		key[n] = mask[(idx + n) & 3];
+
+	if (mask_idx)
+		*mask_idx = (uint8_t)((idx + len) & 3);
+
+	/* the key bytes in memory order, so no endian concerns */
+	memcpy(&k64, key, sizeof(k64));
+
+#if defined(__AVX2__)
+	if (len >= 32) {
+		__m256i k = _mm256_set1_epi64x((long long)k64);
+
+		do {
+			_mm256_storeu_si256((__m256i *)buf, _mm256_xor_si256(
+				_mm256_loadu_si256((const __m256i *)buf), k));
+			buf += 32;
+			len -= 32;
+		} while (len >= 32);
+	}
+#endif
+#if defined(__SSE2__)
+	if (len >= 16) {
+		__m128i k = _mm_set1_epi64x((long long)k64);
+
+		do {
+			_mm_storeu_si128((__m128i *)buf, _mm_xor_si128(
+				_mm_loadu_si128((const __m128i *)buf), k));
+			buf += 16;
+			len -= 16;
+		} while (len >= 16);
+	}
+#endif
+#if defined(__ARM_NEON)
+	if (len >= 16) {
+		uint8x16_t k = vreinterpretq_u8_u64(vdupq_n_u64(k64));
+
+		do {
+			vst1q_u8(buf, veorq_u8(vld1q_u8(buf), k));
+			buf += 16;
+			len -= 16;
+		} while (len >= 16);
+	}
+#endif
+
+	/* memcpy() lets the compiler do unaligned access safely */
+
+	while (len >= 8) {
+		uint64_t w;
+
+		memcpy(&w, buf, sizeof(w));
+		w ^= k64;
+		memcpy(buf, &w, sizeof(w));
+		buf += 8;
+		len -= 8;
+	}
+
+	for (n = 0; n < len; n++)
+		buf[n] ^= key[n];
+}
@@ -47,6 +47,88 @@ lws_ws_proxy_est_cb(lws_sorted_usec_list_t *sul)
 
 #define LWS_CPYAPP(ptr, str) { strcpy(ptr, str); ptr += strlen(str); }
 
+/*
+ * Once the rx state machine has taken the first header byte, the rest of the
+ * header is just the length and maybe the key.  If all of that is already in
+ * the buffer, decode it in one step instead of 1 - 12 more trips through the
+ * state machine, leaving us in LWS_RXPS_WS_FRAME_PAYLOAD.
+ *
+ * Only the common case is handled here: anything that's illegal, or a zero
+ * length payload which must spill immediately, returns 0 and is left for the
+ * state machine to deal with bytewise as before.
+ *
+ * Returns the number of header bytes consumed, or 0.
+ */
+
+size_t
+lws_ws_frame_hdr_rest(struct lws *wsi, const uint8_t *p, size_t len,
+		      int allow_mask)
+{
+	size_t need = 1, n = 1;
+	uint64_t plen;
+	uint8_t c;
+
+	if (!len || wsi->lws_rx_parse_state != LWS_RXPS_04_FRAME_HDR_LEN)
+		return 0;
+
+	c = p[0];
+	if ((c & 0x80) && !allow_mask)
+		return 0;
+
+	switch (c & 0x7f) {
+	case 126:
+		need += 2;
+		break;
+	case 127:
+		need += 8;
+		break;
+	}
+	if (c & 0x80)
+		need += 4;
+
+	if (len < need ||
+	    /* control frames are not allowed to have big lengths */
+	    ((c & 0x7f) >= 126 && (wsi->ws->opcode & 8)))
+		return 0;
+
+	switch (c & 0x7f) {
+	case 126:
+		plen = ((uint64_t)p[1] << 8) | p[2];
+		n = 3;
+		break;
+	case 127:
+		if (p[1] & 0x80)
+			/* b63 must be zero */
+			return 0;
+		plen = 0;
+		for (n = 1; n < 9; n++)
+			plen = (plen << 8) | p[n];
+		break;
+	default:
+		plen = c & 0x7f;
+		break;
+	}
+
+	if (!plen)
+		return 0;
+
+	/* as bytewise, 32-bit builds only see the low 32 bits */
+	wsi->ws->rx_packet_length = (size_t)plen;
+	wsi->ws->this_frame_masked = !!(c & 0x80);
+
+	if (wsi->ws->this_frame_masked) {
+		memcpy(wsi->ws->mask, p + n, 4);
+		if (p[n] | p[n + 1] | p[n + 2] | p[n + 3])
+			wsi->ws->all_zero_nonce = 0;
+		wsi->ws->mask_idx = 0;
+		n += 4;
+	}
+
+	wsi->lws_rx_parse_state = LWS_RXPS_WS_FRAME_PAYLOAD;
+
+	return n;
+}
+
 /*
  * client-parser.c: lws_ws_client_rx_sm() needs to be roughly kept in
  *   sync with changes here, esp related to ext draining
@@ -1433,6 +1515,7 @@ rops_handle_POLLOUT_ws(struct lws *wsi)
 		lwsl_ext("SERVICING TX EXT DRAINING\n");
 		if (lws_write(wsi, NULL, 0, LWS_WRITE_CONTINUATION) < 0)
 			return LWS_HP_RET_BAIL_DIE;
+		lws_ws_tx_lin_release(wsi);
 		/* leave POLLOUT active */
 		return LWS_HP_RET_BAIL_OK;
 	}
@@ -1648,6 +1731,107 @@ rops_close_role_ws(struct lws_context_per_thread *pt, struct lws *wsi)
 	return 0;
 }
 
+/*
+ * Write the header for a frame of len payload bytes so that it ends at p, and
+ * track the outgoing message state.  Returns the header length, or -1 if wp
+ * is not something we can frame.
+ */
+
+static int
+lws_ws_tx_frame_hdr(struct lws *wsi, enum lws_write_protocol wp, size_t len,
+		    unsigned char is_masked_bit, unsigned char *p)
+{
+	int pre = 0, n;
+
+	switch (wp & 0xf) {
+	case LWS_WRITE_TEXT:
+		n = LWSWSOPC_TEXT_FRAME;
+		if (wsi->ws->last_valid && !wsi->ws->last_fin) {
+			lwsl_wsi_err(wsi, "Sending TEXT after previous frame that lacked FIN");
+			assert(0);
+		}
+		wsi->ws->last_valid = 1;
+		wsi->ws->last_opcode = (uint8_t)n;
+		wsi->ws->last_fin = !(wp & LWS_WRITE_NO_FIN);
+		break;
+	case LWS_WRITE_BINARY:
+		n = LWSWSOPC_BINARY_FRAME;
+		if (wsi->ws->last_valid && !wsi->ws->last_fin) {
+			lwsl_wsi_err(wsi, "Sending BINARY after previous frame that lacked FIN");
+			assert(0);
+		}
+		wsi->ws->last_valid = 1;
+		wsi->ws->last_opcode = (uint8_t)n;
+		wsi->ws->last_fin = !(wp & LWS_WRITE_NO_FIN);
+		break;
+	case LWS_WRITE_CONTINUATION:
+		n = LWSWSOPC_CONTINUATION;
+		if (wsi->ws->last_valid && wsi->ws->last_fin) {
+			lwsl_wsi_err(wsi, "Sending CONTINUATION after previous frame that had FIN");
+			assert(0);
+		}
+		if (!wsi->ws->last_valid) {
+			lwsl_wsi_err(wsi, "Sending CONTINUATION as first frame");
+			assert(0);
+		}
+		wsi->ws->last_valid = 1;
+		wsi->ws->last_opcode = (uint8_t)n;
+		wsi->ws->last_fin = !(wp & LWS_WRITE_NO_FIN);
+		break;
+
+	case LWS_WRITE_CLOSE:
+		n = LWSWSOPC_CLOSE;
+		break;
+	case LWS_WRITE_PING:
+		n = LWSWSOPC_PING;
+		break;
+	case LWS_WRITE_PONG:
+		n = LWSWSOPC_PONG;
+		break;
+	default:
+		lwsl_warn("lws_write: unknown write opc / wp\n");
+		return -1;
+	}
+
+	if (!(wp & LWS_WRITE_NO_FIN))
+		n |= 1 << 7;
+
+	if (len < 126) {
+		pre += 2;
+		p[-pre] = (uint8_t)n;
+		p[-pre + 1] = (unsigned char)(len | is_masked_bit);
+	} else {
+		if (len < 65536) {
+			pre += 4;
+			p[-pre] = (uint8_t)n;
+			p[-pre + 1] = (uint8_t)(126 | is_masked_bit);
+			p[-pre + 2] = (unsigned char)(len >> 8);
+			p[-pre + 3] = (unsigned char)len;
+		} else {
+			pre += 10;
+			p[-pre] = (uint8_t)n;
+			p[-pre + 1] = (uint8_t)(127 | is_masked_bit);
+#if defined __LP64__
+			p[-pre + 2] = (len >> 56) & 0x7f;
+			p[-pre + 3] = (uint8_t)(len >> 48);
+			p[-pre + 4] = (uint8_t)(len >> 40);
+			p[-pre + 5] = (uint8_t)(len >> 32);
+#else
+			p[-pre + 2] = 0;
+			p[-pre + 3] = 0;
+			p[-pre + 4] = 0;
+			p[-pre + 5] = 0;
+#endif
+			p[-pre + 6] = (unsigned char)(len >> 24);
+			p[-pre + 7] = (unsigned char)(len >> 16);
+			p[-pre + 8] = (unsigned char)(len >> 8);
+			p[-pre + 9] = (unsigned char)len;
+		}
+	}
+
+	return pre;
+}
+
 static int
 rops_write_role_protocol_ws(struct lws *wsi, unsigned char *buf, size_t len,
 			    enum lws_write_protocol *wp)
@@ -1832,91 +2016,10 @@ rops_write_role_protocol_ws(struct lws *wsi, unsigned char *buf, size_t len,
 			is_masked_bit = 0x80;
 		}
 
-		switch ((*wp) & 0xf) {
-		case LWS_WRITE_TEXT:
-			n = LWSWSOPC_TEXT_FRAME;
-			if (wsi->ws->last_valid && !wsi->ws->last_fin) {
-				lwsl_wsi_err(wsi, "Sending TEXT after previous frame that lacked FIN");
-				assert(0);
-			}
-			wsi->ws->last_valid = 1;
-			wsi->ws->last_opcode = (uint8_t)n;
-			wsi->ws->last_fin = !((*wp) & LWS_WRITE_NO_FIN);
-			break;
-		case LWS_WRITE_BINARY:
-			n = LWSWSOPC_BINARY_FRAME;
-			if (wsi->ws->last_valid && !wsi->ws->last_fin) {
-				lwsl_wsi_err(wsi, "Sending BINARY after previous frame that lacked FIN");
-				assert(0);
-			}
-			wsi->ws->last_valid = 1;
-			wsi->ws->last_opcode = (uint8_t)n;
-			wsi->ws->last_fin = !((*wp) & LWS_WRITE_NO_FIN);
-			break;
-		case LWS_WRITE_CONTINUATION:
-			n = LWSWSOPC_CONTINUATION;
-			if (wsi->ws->last_valid && wsi->ws->last_fin) {
-				lwsl_wsi_err(wsi, "Sending CONTINUATION after previous frame that had FIN");
-				assert(0);
-			}
-			if (!wsi->ws->last_valid) {
-				lwsl_wsi_err(wsi, "Sending CONTINUATION as first frame");
-				assert(0);
-			}
-			wsi->ws->last_valid = 1;
-			wsi->ws->last_opcode = (uint8_t)n;
-			wsi->ws->last_fin = !((*wp) & LWS_WRITE_NO_FIN);
-			break;
-
-		case LWS_WRITE_CLOSE:
-			n = LWSWSOPC_CLOSE;
-			break;
-		case LWS_WRITE_PING:
-			n = LWSWSOPC_PING;
-			break;
-		case LWS_WRITE_PONG:
-			n = LWSWSOPC_PONG;
-			break;
-		default:
-			lwsl_warn("lws_write: unknown write opc / wp\n");
+		n = lws_ws_tx_frame_hdr(wsi, *wp, len, is_masked_bit, buf - pre);
+		if (n < 0)
 			return -1;
-		}
-
-		if (!((*wp) & LWS_WRITE_NO_FIN))
-			n |= 1 << 7;
-
-		if (len < 126) {
-			pre += 2;
-			buf[-pre] = (uint8_t)n;
-			buf[-pre + 1] = (unsigned char)(len | is_masked_bit);
-		} else {
-			if (len < 65536) {
-				pre += 4;
-				buf[-pre] = (uint8_t)n;
-				buf[-pre + 1] = (uint8_t)(126 | is_masked_bit);
-				buf[-pre + 2] = (unsigned char)(len >> 8);
-				buf[-pre + 3] = (unsigned char)len;
-			} else {
-				pre += 10;
-				buf[-pre] = (uint8_t)n;
-				buf[-pre + 1] = (uint8_t)(127 | is_masked_bit);
-#if defined __LP64__
-					buf[-pre + 2] = (len >> 56) & 0x7f;
-					buf[-pre + 3] = (uint8_t)(len >> 48);
-					buf[-pre + 4] = (uint8_t)(len >> 40);
-					buf[-pre + 5] = (uint8_t)(len >> 32);
-#else
-					buf[-pre + 2] = 0;
-					buf[-pre + 3] = 0;
-					buf[-pre + 4] = 0;
-					buf[-pre + 5] = 0;
-#endif
-				buf[-pre + 6] = (unsigned char)(len >> 24);
-				buf[-pre + 7] = (unsigned char)(len >> 16);
-				buf[-pre + 8] = (unsigned char)(len >> 8);
-				buf[-pre + 9] = (unsigned char)len;
-			}
-		}
+		pre += n;
 		break;
 	}
 
@@ -1938,9 +2041,8 @@ do_more_inside_frame:
 		 * in v7, just mask the payload
 		 */
 		if (dropmask) { /* never set if already inside frame */
-			for (n = 4; n < (int)len + 4; n++)
-				dropmask[n] = dropmask[n] ^ wsi->ws->mask[
-					(wsi->ws->mask_idx++) & 3];
+			lws_ws_mask_xor(dropmask + 4, len, wsi->ws->mask,
+					&wsi->ws->mask_idx);
 
 			/* copy the frame nonce into place */
 			memcpy(dropmask, wsi->ws->mask, 4);
@@ -2017,6 +2119,62 @@ send_raw:
 	return lws_issue_raw(wsi, (unsigned char *)buf - pre, len + (unsigned int)pre);
 }
 
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+/*
+ * lws_write_iov() can hand the frame header and the payload fragments to the
+ * socket in one sendmsg() when rops_write_role_protocol_ws() would not have
+ * had to touch the payload: no masking, no extension and no h2 framing.
+ */
+
+int
+lws_ws_can_write_iov(struct lws *wsi, enum lws_write_protocol wp)
+{
+	switch ((int)(wp & 0x3f)) {
+	case LWS_WRITE_TEXT:
+	case LWS_WRITE_BINARY:
+	case LWS_WRITE_CONTINUATION:
+		break;
+	default:
+		return 0;
+	}
+
+	return wsi->ws && wsi->ws->ietf_spec_revision == 13 &&
+	       !lwsi_role_client(wsi) && !lwsi_role_h2_ENCAPSULATION(wsi) &&
+	       !wsi->h2_stream_carries_ws && !wsi->ws->inside_frame &&
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	       !wsi->ws->count_act_ext && !wsi->ws->tx_draining_ext &&
+#endif
+	       !wsi->ws->stashed_write_pending;
+}
+
+int
+lws_ws_write_iov(struct lws *wsi, const lws_iov_t *iov, int count,
+		 size_t len, enum lws_write_protocol wp)
+{
+	lws_iov_t v[LWS_ISSUE_RAW_MAX_IOV];
+	unsigned char hdr[10];
+	int n;
+
+	if (count >= LWS_ISSUE_RAW_MAX_IOV)
+		return -1;
+
+	n = lws_ws_tx_frame_hdr(wsi, wp, len, 0, hdr + sizeof(hdr));
+	if (n < 0)
+		return -1;
+
+	v[0].buf = hdr + sizeof(hdr) - n;
+	v[0].len = (size_t)n;
+	memcpy(&v[1], iov, sizeof(*iov) * (unsigned int)count);
+
+	/* it's all either sent or buffered on buflist_out now */
+
+	if (lws_issue_raw_iov(wsi, v, count + 1) < 0)
+		return -1;
+
+	return (int)len;
+}
+#endif
+
 static int
 rops_close_kill_connection_ws(struct lws *wsi, enum lws_close_status reason)
 {
@@ -2123,12 +2281,26 @@ ws_destroy_proxy_buf(struct lws_dll2 *d, void *user)
 }
 #endif
 
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+void
+lws_ws_tx_lin_release(struct lws *wsi)
+{
+	/* once the extensions drained it, nothing points into it any more */
+	if (!wsi->ws->tx_draining_ext)
+		lws_free_set_NULL(wsi->ws->tx_lin);
+}
+#endif
+
 static int
 rops_destroy_role_ws(struct lws *wsi)
 {
 #if defined(LWS_WITH_HTTP_PROXY)
 	lws_dll2_foreach_safe(&wsi->ws->proxy_owner, NULL, ws_destroy_proxy_buf);
 #endif
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	if (wsi->ws->tx_lin)
+		lws_free(wsi->ws->tx_lin);
+#endif
 
 	lws_free_set_NULL(wsi->ws);
 
@@ -96,6 +96,8 @@ struct _lws_websocket_related {
 	void *act_ext_user[LWS_MAX_EXTENSIONS_ACTIVE];
 	struct lws *rx_draining_ext_list;
 	struct lws *tx_draining_ext_list;
+	/* lws_write_iov() linearizes here while extensions may hold on to it */
+	uint8_t *tx_lin;
 #endif
 
 #if defined(LWS_WITH_HTTP_PROXY)
@@ -175,7 +177,22 @@ lws_ws_handshake_client(struct lws *wsi, unsigned char **buf, size_t len);
 lws_handling_result_t
 lws_ws_client_rx_parser_block(struct lws *wsi, const uint8_t **buf, size_t *len);
 
+size_t
+lws_ws_frame_hdr_rest(struct lws *wsi, const uint8_t *p, size_t len,
+		      int allow_mask);
+
+#if defined(LWS_HAVE_SENDMSG) && defined(LWS_PLAT_UNIX)
+int
+lws_ws_can_write_iov(struct lws *wsi, enum lws_write_protocol wp);
+int
+lws_ws_write_iov(struct lws *wsi, const lws_iov_t *iov, int count,
+		 size_t len, enum lws_write_protocol wp);
+#endif
+
 #if !defined(LWS_WITHOUT_EXTENSIONS)
+void
+lws_ws_tx_lin_release(struct lws *wsi);
+
 LWS_VISIBLE void
 lws_context_init_extensions(const struct lws_context_creation_info *info,
 			    struct lws_context *context);
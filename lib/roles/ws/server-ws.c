@@ -818,7 +818,7 @@ lws_ws_frame_rest_is_payload(struct lws *wsi, uint8_t **buf, size_t len)
 {
 	struct lws_ext_pm_deflate_rx_ebufs pmdrx;
 	unsigned int avail = (unsigned int)len;
-	uint8_t *buffer = *buf, mask[4];
+	uint8_t *buffer = *buf;
 #if !defined(LWS_WITHOUT_EXTENSIONS)
 	unsigned int old_packet_length = (unsigned int)wsi->ws->rx_packet_length;
 #endif
@@ -858,31 +858,10 @@ lws_ws_frame_rest_is_payload(struct lws *wsi, uint8_t **buf, size_t len)
 	pmdrx.eb_out.token = buffer;
 	pmdrx.eb_out.len = (int)avail;
 
-	if (!wsi->ws->all_zero_nonce) {
-
-		for (n = 0; n < 4; n++)
-			mask[n] = wsi->ws->mask[(wsi->ws->mask_idx + n) & 3];
-
-		/* deal with 4-byte chunks using unwrapped loop */
-		n = (int)(avail >> 2);
-		while (n--) {
-			*(buffer) = *(buffer) ^ mask[0];
-			buffer++;
-			*(buffer) = *(buffer) ^ mask[1];
-			buffer++;
-			*(buffer) = *(buffer) ^ mask[2];
-			buffer++;
-			*(buffer) = *(buffer) ^ mask[3];
-			buffer++;
-		}
-		/* and the remaining bytes bytewise */
-		for (n = 0; n < (int)(avail & 3); n++) {
-			*(buffer) = *(buffer) ^ mask[n];
-			buffer++;
-		}
-
-		wsi->ws->mask_idx = (wsi->ws->mask_idx + avail) & 3;
-	}
+	if (!wsi->ws->all_zero_nonce)
+		/* unmask the whole span in place, it's passed up as one */
+		lws_ws_mask_xor(buffer, avail, wsi->ws->mask,
+				&wsi->ws->mask_idx);
 
 	lwsl_info("%s: using %d of raw input (total %d on offer)\n", __func__,
 		    avail, (int)len);
@@ -1053,6 +1032,16 @@ lws_parse_ws(struct lws *wsi, unsigned char **buf, size_t len)
 		}
 #endif
 
+		/* if the rest of a frame header is here, take it in one go */
+		if (wsi->lws_rx_parse_state == LWS_RXPS_04_FRAME_HDR_LEN) {
+			size_t used = lws_ws_frame_hdr_rest(wsi, *buf, len, 1);
+
+			*buf += used;
+			len -= used;
+			if (!len)
+				break;
+		}
+
 		/* consume payload bytes efficiently */
 		while (wsi->lws_rx_parse_state == LWS_RXPS_WS_FRAME_PAYLOAD &&
 				(wsi->ws->opcode == LWSWSOPC_TEXT_FRAME ||
@@ -100,8 +100,9 @@ static int
 lws_ssl_server_name_cb(SSL *ssl, int *ad, void *arg)
 {
 	struct lws_context *context = (struct lws_context *)arg;
-	struct lws_vhost *vhost, *vh;
+	struct lws_vhost *vhost, *vh = NULL;
 	const char *servername;
+	struct lws *wsi;
 
 	if (!ssl)
 		return SSL_TLSEXT_ERR_NOACK;
@@ -109,14 +110,20 @@ lws_ssl_server_name_cb(SSL *ssl, int *ad, void *arg)
 	/*
 	 * We can only get ssl accepted connections by using a vhost's ssl_ctx
 	 * find out which listening one took us and only match vhosts on the
-	 * same port.
+	 * same port.  Normally that's the vhost the wsi was accepted on.
 	 */
-	vh = context->vhost_list;
-	while (vh) {
-		if (!vh->being_destroyed &&
-		    vh->tls.ssl_ctx == SSL_get_SSL_CTX(ssl))
-			break;
-		vh = vh->vhost_next;
+	wsi = SSL_get_ex_data(ssl, openssl_websocket_private_data_index);
+	if (wsi && wsi->a.vhost && !wsi->a.vhost->being_destroyed &&
+	    wsi->a.vhost->tls.ssl_ctx == SSL_get_SSL_CTX(ssl))
+		vh = wsi->a.vhost;
+	else {
+		vh = context->vhost_list;
+		while (vh) {
+			if (!vh->being_destroyed &&
+			    vh->tls.ssl_ctx == SSL_get_SSL_CTX(ssl))
+				break;
+			vh = vh->vhost_next;
+		}
 	}
 
 	if (!vh) {
@@ -530,6 +537,10 @@ lws_tls_server_vhost_backend_init(const struct lws_context_creation_info *info,
 
 	SSL_CTX_set_options(vhost->tls.ssl_ctx, SSL_OP_SINGLE_DH_USE);
 	SSL_CTX_set_options(vhost->tls.ssl_ctx, SSL_OP_CIPHER_SERVER_PREFERENCE);
+#if defined(SSL_OP_ENABLE_KTLS)
+	if (lws_check_opt(info->options, LWS_SERVER_OPTION_KTLS))
+		SSL_CTX_set_options(vhost->tls.ssl_ctx, SSL_OP_ENABLE_KTLS);
+#endif
 
 	if (info->ssl_cipher_list)
 		SSL_CTX_set_cipher_list(vhost->tls.ssl_ctx, info->ssl_cipher_list);
@@ -674,6 +685,7 @@ lws_tls_server_accept(struct lws *wsi)
 			lwsl_info("%s: no client cert CN\n", __func__);
 
 		lws_openssl_describe_cipher(wsi);
+		lws_openssl_ktls_check(wsi);
 
 		if (SSL_pending(wsi->tls.ssl) &&
 		    lws_dll2_is_detached(&wsi->tls.dll_pending_tls))
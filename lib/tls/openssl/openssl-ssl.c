@@ -48,6 +48,31 @@ int lws_openssl_describe_cipher(struct lws *wsi)
 	return 0;
 }
 
+/*
+ * Called when the handshake completed.  If the vhost asked for kTLS,
+ * OpenSSL tried to push the keys into the kernel at the key change, it
+ * may have failed quietly if the kernel tls module or the cipher wasn't
+ * available.  Find out what we actually got.
+ */
+
+void
+lws_openssl_ktls_check(struct lws *wsi)
+{
+#if defined(BIO_get_ktls_send) && !defined(OPENSSL_NO_KTLS)
+	if (!wsi->a.vhost ||
+	    !lws_check_opt(wsi->a.vhost->options, LWS_SERVER_OPTION_KTLS))
+		return;
+
+	wsi->tls.ktls_tx = !!BIO_get_ktls_send(SSL_get_wbio(wsi->tls.ssl));
+	wsi->tls.ktls_rx = !!BIO_get_ktls_recv(SSL_get_rbio(wsi->tls.ssl));
+
+	lwsl_wsi_info(wsi, "kTLS tx %d, rx %d", wsi->tls.ktls_tx,
+		      wsi->tls.ktls_rx);
+#else
+	(void)wsi;
+#endif
+}
+
 int lws_ssl_get_error(struct lws *wsi, int n)
 {
 	int m;
@@ -421,6 +446,50 @@ lws_ssl_capable_write(struct lws *wsi, unsigned char *buf, size_t len)
 	return LWS_SSL_CAPABLE_ERROR;
 }
 
+#if defined(LWS_HAVE_SSL_sendfile)
+/*
+ * Only usable when wsi->tls.ktls_tx: the kernel encrypts the file pages on
+ * their way to the socket.  Same contract as lws_plat_file_sendfile(), ie,
+ * we send from and advance the file's current position, and *amount is 0
+ * if the socket couldn't take anything right now.
+ */
+
+int
+lws_tls_file_sendfile(struct lws *wsi, lws_fop_fd_t fop_fd,
+		      lws_filepos_t *amount, lws_filepos_t len)
+{
+	ossl_ssize_t n;
+	int m;
+
+	*amount = 0;
+
+	errno = 0;
+	ERR_clear_error();
+	n = SSL_sendfile(wsi->tls.ssl, (int)fop_fd->fd, (off_t)fop_fd->pos,
+			 (size_t)len, 0);
+	if (n < 0) {
+		m = lws_ssl_get_error(wsi, (int)n);
+		if (m == SSL_ERROR_WANT_WRITE || SSL_want_write(wsi->tls.ssl))
+			return 0;
+
+		lws_tls_err_describe_clear();
+
+		return -1;
+	}
+	if (!n && len)
+		/* the file got shorter than we thought */
+		return -1;
+
+	/* SSL_sendfile() takes an explicit offset, catch the fd up */
+	if (lws_vfs_file_seek_cur(fop_fd, (lws_fileofs_t)n) < 0)
+		return -1;
+
+	*amount = (lws_filepos_t)n;
+
+	return 0;
+}
+#endif
+
 void
 lws_ssl_info_callback(const SSL *ssl, int where, int ret)
 {
@@ -95,5 +95,8 @@ lws_gencrypto_openssl_hash_to_EVP_MD(enum lws_genhash_types hash_type);
 int BN_bn2binpad(const BIGNUM *a, unsigned char *to, int tolen);
 #endif
 
+void
+lws_openssl_ktls_check(struct lws *wsi);
+
 #endif
 
@@ -88,6 +88,8 @@ struct lws_lws_tls {
 	char			err_helper[64];
 	unsigned int		use_ssl;
 	unsigned int		redirect_to_https:1;
+	unsigned int		ktls_tx:1; /* kernel does our record tx */
+	unsigned int		ktls_rx:1; /* kernel does our record rx */
 };
 
 
@@ -97,6 +99,11 @@ int LWS_WARN_UNUSED_RESULT
 lws_ssl_capable_read(struct lws *wsi, unsigned char *buf, size_t len);
 int LWS_WARN_UNUSED_RESULT
 lws_ssl_capable_write(struct lws *wsi, unsigned char *buf, size_t len);
+#if defined(LWS_HAVE_SSL_sendfile) && !defined(LWS_WITH_MBEDTLS)
+int
+lws_tls_file_sendfile(struct lws *wsi, lws_fop_fd_t fop_fd,
+		      lws_filepos_t *amount, lws_filepos_t len);
+#endif
 int LWS_WARN_UNUSED_RESULT
 lws_ssl_pending(struct lws *wsi);
 int LWS_WARN_UNUSED_RESULT
@@ -0,0 +1,319 @@
+/*
+ * lws-api-test-lws_buflist
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ */
+
+#include <libwebsockets.h>
+
+/*
+ * Every byte appended is the next one in a running sequence, so whatever is
+ * still on the buflist must always read back as a contiguous run of it,
+ * starting from the next byte we have not consumed yet.
+ */
+
+static unsigned int wseq, rseq;
+
+#define SEQ(_n) ((uint8_t)(((_n) * 7u) + ((_n) >> 8)))
+
+static int
+append(struct lws_buflist **head, size_t len)
+{
+	uint8_t buf[256];
+	size_t n;
+
+	for (n = 0; n < len; n++)
+		buf[n] = SEQ(wseq + n);
+	wseq += (unsigned int)len;
+
+	return lws_buflist_append_segment(head, buf, len);
+}
+
+/* peek everything and confirm it's the expected run, returns bytes or -1 */
+
+static int
+check(struct lws_buflist **head, int expected_segs)
+{
+	lws_buflist_frag_t frags[16];
+	unsigned int s = rseq;
+	int n, m, total = 0;
+	size_t i;
+
+	n = lws_buflist_peek_segments(head, frags, LWS_ARRAY_SIZE(frags));
+	if (n != expected_segs) {
+		lwsl_err("%s: peek %d segs, expected %d\n", __func__, n,
+			 expected_segs);
+		return -1;
+	}
+
+	for (m = 0; m < n; m++) {
+		if (!frags[m].len) {
+			lwsl_err("%s: frag %d empty\n", __func__, m);
+			return -1;
+		}
+		for (i = 0; i < frags[m].len; i++, s++)
+			if (frags[m].buf[i] != SEQ(s)) {
+				lwsl_err("%s: frag %d ofs %d mismatch\n",
+					 __func__, m, (int)i);
+				return -1;
+			}
+		total += (int)frags[m].len;
+	}
+
+	if (s != wseq) {
+		lwsl_err("%s: buflist ends at %u, expected %u\n", __func__, s,
+			 wseq);
+		return -1;
+	}
+
+	return total;
+}
+
+static size_t
+use(struct lws_buflist **head, size_t len)
+{
+	rseq += (unsigned int)len;
+
+	return lws_buflist_use(head, len);
+}
+
+/*
+ * test 1: partial consumes crossing segment boundaries
+ */
+
+static int
+test1(void)
+{
+	struct lws_buflist *head = NULL;
+	lws_buflist_frag_t frags[2];
+	size_t r;
+
+	wseq = rseq = 0;
+
+	if (append(&head, 10) != 1 || append(&head, 20) ||
+	    append(&head, 30) || append(&head, 40))
+		goto bail;
+
+	if (check(&head, 4) != 100)
+		goto bail;
+
+	/* peeking must not consume anything */
+	if (lws_buflist_peek_segments(&head, frags, 2) != 2 ||
+	    check(&head, 4) != 100)
+		goto bail;
+
+	/* all of seg 1 and the first 5 of seg 2 */
+	r = use(&head, 15);
+	if (r != 15) {
+		lwsl_err("%s: use 15 left %d\n", __func__, (int)r);
+		goto bail;
+	}
+	if (check(&head, 3) != 85)
+		goto bail;
+
+	/* the rest of seg 2, all of seg 3 and 1 byte of seg 4 */
+	r = use(&head, 46);
+	if (r != 39) {
+		lwsl_err("%s: use 46 left %d\n", __func__, (int)r);
+		goto bail;
+	}
+	if (check(&head, 1) != 39)
+		goto bail;
+
+	/* ending exactly on a boundary reports the next segment's length */
+	if (append(&head, 25) || append(&head, 5))
+		goto bail;
+	r = use(&head, 39);
+	if (r != 25) {
+		lwsl_err("%s: use 39 left %d\n", __func__, (int)r);
+		goto bail;
+	}
+	if (check(&head, 2) != 30)
+		goto bail;
+
+	/* consuming everything across two segments empties it */
+	r = use(&head, 30);
+	if (r || head) {
+		lwsl_err("%s: drain left %d %p\n", __func__, (int)r, head);
+		goto bail;
+	}
+	if (check(&head, 0))
+		goto bail;
+
+	return 0;
+
+bail:
+	lws_buflist_destroy_all_segments(&head);
+
+	return 1;
+}
+
+/*
+ * test 2: frags arrays smaller than the number of segments, draining in a
+ *	   loop of peek N, use what was peeked, like a vectored send
+ */
+
+static int
+test2(void)
+{
+	struct lws_buflist *head = NULL;
+	lws_buflist_frag_t frags[3];
+	size_t sum, r;
+	int n, m, loops = 0;
+
+	wseq = rseq = 0;
+
+	for (n = 0; n < 11; n++)
+		if (append(&head, (size_t)(n * 13 + 1)) < 0)
+			goto bail;
+
+	/* zero-length frags array */
+	if (lws_buflist_peek_segments(&head, frags, 0))
+		goto bail;
+
+	/* only use the first 2 of what we peeked, to leave a partial head */
+	n = lws_buflist_peek_segments(&head, frags, 3);
+	if (n != 3 || frags[0].len != 1 || frags[1].len != 14 ||
+	    frags[2].len != 27)
+		goto bail;
+	use(&head, frags[0].len + frags[1].len + 3);
+	if (check(&head, 9) < 0)
+		goto bail;
+
+	while (head) {
+		n = lws_buflist_peek_segments(&head, frags,
+					      LWS_ARRAY_SIZE(frags));
+		if (n < 1 || n > (int)LWS_ARRAY_SIZE(frags))
+			goto bail;
+
+		/* the peeked frags must follow on from what we consumed */
+		if (frags[0].buf[0] != SEQ(rseq))
+			goto bail;
+
+		sum = 0;
+		for (m = 0; m < n; m++)
+			sum += frags[m].len;
+
+		r = use(&head, sum);
+		if ((r && !head) || (!r && head))
+			goto bail;
+		loops++;
+		if (check(&head, 9 - (loops * 3)) < 0)
+			goto bail;
+	}
+
+	/* 9 segments left after the partial use, in 3s */
+	if (loops != 3 || rseq != wseq) {
+		lwsl_err("%s: loops %d, rseq %u, wseq %u\n", __func__, loops,
+			 rseq, wseq);
+		goto bail;
+	}
+
+	return 0;
+
+bail:
+	lwsl_err("%s: failed\n", __func__);
+	lws_buflist_destroy_all_segments(&head);
+
+	return 1;
+}
+
+/*
+ * test 3: the tail must stay consistent as the head changes, so appends
+ *	   after partial and complete drains still land at the end
+ */
+
+static int
+test3(void)
+{
+	struct lws_buflist *head = NULL;
+	int n;
+
+	wseq = rseq = 0;
+
+	if (append(&head, 50) != 1 || append(&head, 50))
+		goto bail;
+
+	/* head segment destroyed, the new head must know the tail */
+	use(&head, 60);
+	if (append(&head, 7) || check(&head, 2) != 47)
+		goto bail;
+
+	/* down to a single, partially used segment which is also the tail */
+	use(&head, 45);
+	if (check(&head, 1) != 2)
+		goto bail;
+	if (append(&head, 3) || check(&head, 2) != 5)
+		goto bail;
+
+	/* drain completely, then it must start a fresh list */
+	if (use(&head, 5) || head)
+		goto bail;
+	if (lws_buflist_total_len(&head))
+		goto bail;
+
+	if (append(&head, 9) != 1 || append(&head, 11) || append(&head, 13))
+		goto bail;
+	if (check(&head, 3) != 33 || lws_buflist_total_len(&head) != 33)
+		goto bail;
+
+	/* lots of appends, with the head being consumed underneath */
+	for (n = 0; n < 2000; n++) {
+		if (append(&head, (size_t)(n % 200) + 1) < 0)
+			goto bail;
+		if (!(n % 3))
+			use(&head, lws_buflist_next_segment_len(&head, NULL));
+	}
+
+	while (head) {
+		uint8_t *b;
+		size_t l = lws_buflist_next_segment_len(&head, &b);
+
+		if (!l || b[0] != SEQ(rseq) || b[l - 1] != SEQ(rseq + l - 1))
+			goto bail;
+		use(&head, l);
+	}
+
+	if (rseq != wseq)
+		goto bail;
+
+	return 0;
+
+bail:
+	lwsl_err("%s: failed\n", __func__);
+	lws_buflist_destroy_all_segments(&head);
+
+	return 1;
+}
+
+int main(int argc, const char **argv)
+{
+	int logs = LLL_USER | LLL_ERR | LLL_WARN | LLL_NOTICE;
+	int ret = 0, n;
+	const char *p;
+
+	if ((p = lws_cmdline_option(argc, argv, "-d")))
+		logs = atoi(p);
+
+	lws_set_log_level(logs, NULL);
+	lwsl_user("LWS API selftest: lws_buflist\n");
+
+	n = test1();
+	lwsl_user("%s: test1: %d\n", __func__, n);
+	ret |= n;
+
+	n = test2();
+	lwsl_user("%s: test2: %d\n", __func__, n);
+	ret |= n;
+
+	n = test3();
+	lwsl_user("%s: test3: %d\n", __func__, n);
+	ret |= n;
+
+	lwsl_user("Completed: %s\n", ret ? "FAIL" : "PASS");
+
+	return ret;
+}
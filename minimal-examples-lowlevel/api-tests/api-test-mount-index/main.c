@@ -0,0 +1,289 @@
+/*
+ * lws-api-test-mount-index
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * This api test confirms lws_find_mount() using the vhost's mount index finds
+ * the same mount the walk of the mount list it replaced did, for random mount
+ * sets and uris.
+ *
+ * The mountpoints include "/", single-char ones, ones with a trailing '/' and
+ * duplicates, and the mounts are of every kind, including callback, cgi and
+ * no-mount.  lws_find_mount() needs a wsi that is serving a request, so we make
+ * one GET to ourselves and do it all from its LWS_CALLBACK_HTTP.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+
+#define MAX_MOUNTS	24
+
+static const char * const mountpoints[] = {
+	"/", "/a", "/a/", "/ab", "/a/b", "/a/b/", "/a/b/c", "/b", "/b/a",
+	"/ab/a", "a", "b", "ab", "a/b",
+};
+
+static const char * const pieces[] = {
+	"/", "/", "a", "b", "ab", "c",
+};
+
+static const char * const fixed_uris[] = {
+	"", "/", "a", "b", "/a", "/a/", "/a//", "/ab", "/ab/", "/abc", "/a/b",
+	"/a/b/", "/a/bc", "/a/b/c/d", "/b/a/", "a/b", "ab/",
+};
+
+static const uint8_t origins[] = {
+	LWSMPRO_FILE, LWSMPRO_FILE, LWSMPRO_CALLBACK, LWSMPRO_CALLBACK,
+	LWSMPRO_CGI, LWSMPRO_REDIR_HTTP, LWSMPRO_HTTP, LWSMPRO_NO_MOUNT,
+};
+
+static struct lws_http_mount mounts[MAX_MOUNTS];
+static int interrupted, port = 7792, rounds = 2000, fail, compared, tested;
+static uint32_t seed = 0x5eed1234;
+
+static uint32_t
+rnd(uint32_t range)
+{
+	/* xorshift32, so a failure can be reproduced with -s */
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	return seed % range;
+}
+
+/*
+ * How lws_find_mount() walked the mount list for a GET before the index.
+ * A callback mount that matches is taken even if it's shorter than the best
+ * so far, anything else has to be longer.
+ */
+
+static const struct lws_http_mount *
+legacy_find_mount(const struct lws_http_mount *hm, const char *uri_ptr,
+		  int uri_len)
+{
+	const struct lws_http_mount *hit = NULL;
+	int best = 0;
+
+	while (hm) {
+		if (uri_len >= hm->mountpoint_len &&
+		    !strncmp(uri_ptr, hm->mountpoint, hm->mountpoint_len) &&
+		    (uri_ptr[hm->mountpoint_len] == '\0' ||
+		     uri_ptr[hm->mountpoint_len] == '/' ||
+		     hm->mountpoint_len == 1)) {
+			if (hm->origin_protocol == LWSMPRO_NO_MOUNT)
+				return NULL;
+
+			if (hm->origin_protocol == LWSMPRO_CALLBACK ||
+			    hm->mountpoint_len > best) {
+				best = hm->mountpoint_len;
+				hit = hm;
+			}
+		}
+
+		hm = hm->mount_next;
+	}
+
+	return hit;
+}
+
+static int
+compare(struct lws *wsi, const char *uri)
+{
+	const struct lws_http_mount *i, *l;
+	int len = (int)strlen(uri);
+
+	i = lws_find_mount(wsi, uri, len);
+	l = legacy_find_mount(mounts, uri, len);
+	compared++;
+
+	if (i == l)
+		return 0;
+
+	lwsl_err("%s: seed 0x%x: '%s': index %d '%s', walk %d '%s'\n",
+		 __func__, (unsigned int)seed, uri,
+		 i ? (int)(i - mounts) : -1, i ? i->mountpoint : "-",
+		 l ? (int)(l - mounts) : -1, l ? l->mountpoint : "-");
+
+	return 1;
+}
+
+static void
+test_mounts(struct lws *wsi)
+{
+	struct lws_vhost *vh = lws_get_vhost(wsi);
+	char uri[64];
+	int r, n, m, c, k;
+
+	for (r = 0; r < rounds && fail < 10; r++) {
+		memset(mounts, 0, sizeof(mounts));
+		c = (int)rnd(MAX_MOUNTS + 1);
+
+		/*
+		 * Sometimes only use "/" and "/a", so a uri can match more
+		 * mounts than the index collects, and it has to walk
+		 */
+		k = r % 16 ? (int)LWS_ARRAY_SIZE(mountpoints) : 2;
+
+		for (n = 0; n < c; n++) {
+			mounts[n].mountpoint = mountpoints[rnd((uint32_t)k)];
+			mounts[n].mountpoint_len = (unsigned char)
+					strlen(mounts[n].mountpoint);
+			mounts[n].origin_protocol = origins[
+					rnd(LWS_ARRAY_SIZE(origins))];
+			mounts[n].origin = "x";
+			if (n)
+				mounts[n - 1].mount_next = &mounts[n];
+		}
+
+		lws_vhost_set_mounts(vh, c ? mounts : NULL);
+
+		for (n = 0; n < (int)LWS_ARRAY_SIZE(fixed_uris); n++)
+			fail += compare(wsi, fixed_uris[n]);
+
+		for (n = 0; n < 32; n++) {
+			uri[0] = '\0';
+			c = (int)rnd(7);
+			for (m = 0; m < c; m++)
+				strcat(uri, pieces[rnd(LWS_ARRAY_SIZE(pieces))]);
+
+			fail += compare(wsi, uri);
+		}
+
+		tested++;
+	}
+
+	/* the mounts are ours, don't leave the vhost pointing at them */
+	lws_vhost_set_mounts(vh, NULL);
+}
+
+static int
+callback_http(struct lws *wsi, enum lws_callback_reasons reason,
+	      void *user, void *in, size_t len)
+{
+	switch (reason) {
+
+	/* server side */
+
+	case LWS_CALLBACK_HTTP:
+		test_mounts(wsi);
+
+		if (lws_return_http_status(wsi, HTTP_STATUS_OK, NULL) ||
+		    lws_http_transaction_completed(wsi))
+			return -1;
+
+		return 0;
+
+	/* client side */
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: CLIENT_CONNECTION_ERROR: %s\n", __func__,
+			 in ? (char *)in : "(null)");
+		fail++;
+		interrupted = 1;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		{
+			char buffer[1024 + LWS_PRE];
+			char *px = buffer + LWS_PRE;
+			int lenx = sizeof(buffer) - LWS_PRE;
+
+			if (lws_http_client_read(wsi, &px, &lenx) < 0)
+				return -1;
+		}
+		return 0;
+
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		interrupted = 1;
+		lws_cancel_service(lws_get_context(wsi));
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "http", callback_http, 0, 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int
+main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	struct lws_client_connect_info i;
+	struct lws_context *context;
+	const char *p;
+	int n = 0;
+
+	signal(SIGINT, sigint_handler);
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-r")))
+		rounds = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-s")))
+		seed = (uint32_t)strtoul(p, NULL, 0);
+
+	lwsl_user("LWS API selftest: mount index, seed 0x%x\n",
+		  (unsigned int)seed);
+
+	info.port = port;
+	info.protocols = protocols;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	memset(&i, 0, sizeof i); /* otherwise uninitialized garbage */
+	i.context = context;
+	i.address = "127.0.0.1";
+	i.port = port;
+	i.path = "/";
+	i.host = i.address;
+	i.origin = i.address;
+	i.method = "GET";
+	i.protocol = protocols[0].name;
+
+	if (!lws_client_connect_via_info(&i)) {
+		lwsl_err("%s: client connection failed\n", __func__);
+		fail++;
+		interrupted = 1;
+	}
+
+	while (n >= 0 && !interrupted)
+		n = lws_service(context, 0);
+
+	lws_context_destroy(context);
+
+	lwsl_user("%s: %d mount sets, %d lookups compared\n", __func__,
+		  tested, compared);
+
+	if (fail || tested != rounds) {
+		lwsl_user("Completed: FAILED\n");
+
+		return 1;
+	}
+
+	lwsl_user("Completed: PASS\n");
+
+	return 0;
+}
@@ -0,0 +1,300 @@
+/*
+ * lws-api-test-pt-msg
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * This api test confirms lws_pt_msg_post() delivers every message from
+ * several foreign threads exactly once, in each poster's order, on the
+ * service thread, and hands back messages still queued at context destroy.
+ *
+ * Then it destroys the context while the threads are still posting, every
+ * post that was accepted must be delivered exactly once, either by service
+ * or at destroy, and the rest must be refused.
+ *
+ * It also confirms a burst of lws_cancel_service() is coalesced into one wake.
+ */
+
+#include <libwebsockets.h>
+#define HAVE_STRUCT_TIMESPEC
+#include <pthread.h>
+#include <string.h>
+
+#define POSTERS		4
+#define LEFTOVERS	3
+
+struct my_msg {
+	lws_pt_msg_t		msg;
+	int			poster;
+	unsigned int		seq;
+};
+
+static struct lws_context *context;
+static pthread_t service_thread, racers[POSTERS];
+static unsigned int per_poster = 20000, next_seq[POSTERS + 1], received,
+		    at_destroy, fail, accepted[POSTERS], delivered[POSTERS];
+static int racing, racer_count, racers_joined;
+
+static void
+msg_cb(struct lws_context *cx, int tsi, lws_pt_msg_t *m)
+{
+	struct my_msg *mm = lws_container_of(m, struct my_msg, msg);
+
+	if (pthread_self() != service_thread) {
+		lwsl_err("%s: called on wrong thread\n", __func__);
+		fail++;
+	}
+
+	if (racing && mm->poster < POSTERS)
+		/* posted by a racer, either now in service or at destroy */
+		delivered[mm->poster]++;
+
+	if (lws_context_is_being_destroyed(cx)) {
+		if (racing && !racers_joined) {
+			int n;
+
+			/*
+			 * The inbox is closed now, so the racers will all see
+			 * their next post refused and stop.  Until they have,
+			 * the context must stay around for them.
+			 */
+			for (n = 0; n < racer_count; n++)
+				pthread_join(racers[n], NULL);
+			racers_joined = 1;
+		}
+		if (mm->poster == POSTERS)
+			at_destroy++;
+		free(mm);
+		return;
+	}
+
+	if (racing) {
+		free(mm);
+		return;
+	}
+
+	if (mm->seq != next_seq[mm->poster]) {
+		lwsl_err("%s: poster %d: got seq %u, expected %u\n", __func__,
+			 mm->poster, mm->seq, next_seq[mm->poster]);
+		fail++;
+	}
+	next_seq[mm->poster] = mm->seq + 1;
+	received++;
+
+	free(mm);
+}
+
+static int
+post(int poster, unsigned int seq)
+{
+	struct my_msg *mm = malloc(sizeof(*mm));
+
+	if (!mm)
+		return 1;
+
+	memset(mm, 0, sizeof(*mm));
+	mm->msg.cb = msg_cb;
+	mm->poster = poster;
+	mm->seq = seq;
+
+	if (lws_pt_msg_post(context, 0, &mm->msg)) {
+		free(mm);
+		return 1;
+	}
+
+	return 0;
+}
+
+static void *
+thread_poster(void *d)
+{
+	int poster = (int)(intptr_t)d;
+	unsigned int n;
+
+	for (n = 0; n < per_poster; n++)
+		if (post(poster, n)) {
+			lwsl_err("%s: post failed\n", __func__);
+			break;
+		}
+
+	return NULL;
+}
+
+/* post until we're refused, because the context is going down */
+
+static void *
+thread_racer(void *d)
+{
+	int poster = (int)(intptr_t)d;
+	unsigned int n = 0;
+
+	while (!post(poster, n++))
+		accepted[poster]++;
+
+	return NULL;
+}
+
+int
+main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	pthread_t pts[POSTERS];
+	int n, m, threads = 0;
+	lws_usec_t us_start;
+	const char *p;
+	void *retval;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	if ((p = lws_cmdline_option(argc, argv, "-c")))
+		per_poster = (unsigned int)atoi(p);
+
+	lwsl_user("LWS API selftest: lws_pt_msg\n");
+
+	info.port = CONTEXT_PORT_NO_LISTEN;
+	info.count_threads = 1;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	service_thread = pthread_self();
+
+	/* an out of range tsi must be refused */
+
+	{
+		struct my_msg mm;
+
+		memset(&mm, 0, sizeof(mm));
+		mm.msg.cb = msg_cb;
+		if (!lws_pt_msg_post(context, 1, &mm.msg)) {
+			lwsl_err("%s: bad tsi accepted\n", __func__);
+			fail++;
+		}
+	}
+
+	/* a burst of cancels before the service thread runs needs one wake */
+
+	{
+		lws_pt_wake_stats_t s0, s1;
+
+		/* take any wakes left from creation first */
+		lws_pt_wake_stats(context, 0, &s0);
+		while (s0.signalled != s0.delivered &&
+		       lws_service(context, 0) >= 0)
+			lws_pt_wake_stats(context, 0, &s0);
+
+		for (n = 0; n < 1000; n++)
+			lws_cancel_service(context);
+		lws_service(context, 0);
+		lws_pt_wake_stats(context, 0, &s1);
+
+		lwsl_user("%s: 1000 cancels: %u requested, %u signalled, "
+			  "%u delivered\n", __func__,
+			  s1.requested - s0.requested,
+			  s1.signalled - s0.signalled,
+			  s1.delivered - s0.delivered);
+#if !defined(WIN32)
+		if (s1.requested - s0.requested != 1000 ||
+		    s1.signalled - s0.signalled != 1 ||
+		    s1.delivered - s0.delivered != 1) {
+			lwsl_err("%s: cancel burst not coalesced\n", __func__);
+			fail++;
+		}
+#endif
+	}
+
+	us_start = lws_now_usecs();
+
+	for (n = 0; n < POSTERS; n++) {
+		if (pthread_create(&pts[n], NULL, thread_poster,
+				   (void *)(intptr_t)n)) {
+			lwsl_err("%s: thread creation failed\n", __func__);
+			fail++;
+			break;
+		}
+		threads++;
+	}
+
+	m = 0;
+	while (m >= 0 && received < POSTERS * per_poster && !fail &&
+	       lws_now_usecs() - us_start < 30 * LWS_US_PER_SEC)
+		m = lws_service(context, 0);
+
+	for (n = 0; n < threads; n++)
+		pthread_join(pts[n], &retval);
+
+	lwsl_user("%s: %u messages from %d threads in %dms\n", __func__,
+		  received, POSTERS,
+		  (int)((lws_now_usecs() - us_start) / LWS_US_PER_MS));
+
+	if (received != POSTERS * per_poster) {
+		lwsl_err("%s: received %u, expected %u\n", __func__, received,
+			 POSTERS * per_poster);
+		fail++;
+	}
+
+	/* these threads are still posting when the context goes down */
+
+	racing = 1;
+	for (n = 0; n < POSTERS; n++) {
+		if (pthread_create(&racers[n], NULL, thread_racer,
+				   (void *)(intptr_t)n)) {
+			lwsl_err("%s: thread creation failed\n", __func__);
+			fail++;
+			break;
+		}
+		racer_count++;
+	}
+
+	us_start = lws_now_usecs();
+	while (lws_now_usecs() - us_start < 20 * LWS_US_PER_MS)
+		if (lws_service(context, 0) < 0)
+			break;
+
+	/* and these are still queued */
+
+	for (n = 0; n < LEFTOVERS; n++)
+		if (post(POSTERS, (unsigned int)n))
+			fail++;
+
+	lws_context_destroy(context);
+
+	if (at_destroy != LEFTOVERS) {
+		lwsl_err("%s: %u leftovers returned at destroy, expected %d\n",
+			 __func__, at_destroy, LEFTOVERS);
+		fail++;
+	}
+
+	if (!racers_joined) {
+		lwsl_err("%s: racers not joined at destroy\n", __func__);
+		fail++;
+	}
+
+	m = 0;
+	for (n = 0; n < racer_count; n++) {
+		if (accepted[n] != delivered[n]) {
+			lwsl_err("%s: racer %d: %u accepted, %u delivered\n",
+				 __func__, n, accepted[n], delivered[n]);
+			fail++;
+		}
+		m += (int)accepted[n];
+	}
+
+	lwsl_user("%s: %d posts accepted while racing destroy\n", __func__, m);
+
+	if (fail) {
+		lwsl_user("Completed: FAILED\n");
+
+		return 1;
+	}
+
+	lwsl_user("Completed: PASS\n");
+
+	return 0;
+}
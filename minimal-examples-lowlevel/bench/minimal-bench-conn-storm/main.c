@@ -0,0 +1,586 @@
+/*
+ * lws-minimal-bench-conn-storm
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures how fast a server context can accept connections, upgrade them
+ * to ws and close them again, like a wave of clients reconnecting after a
+ * deploy, and how much memory idle ws connections cost it.
+ *
+ * For each service thread count in the sweep, we fork a load generator that
+ * uses plain sockets, so none of its cost lands on the server process.  It
+ * keeps -C connections in flight, each doing connect, ws upgrade and close,
+ * until -c have completed, and times each from connect() to having the 101
+ * response.  Then it opens -i connections, upgrades them and holds them
+ * open, so the server can compare its RSS with and without them.
+ *
+ * The load generator reports back over a pipe, which the server side reads
+ * by adopting it as a raw file wsi.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <netinet/in.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+static const char upgrade[] =
+	"GET / HTTP/1.1\r\n"
+	"Host: localhost\r\n"
+	"Upgrade: websocket\r\n"
+	"Connection: Upgrade\r\n"
+	"Sec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+	"Sec-WebSocket-Version: 13\r\n"
+	"Sec-WebSocket-Protocol: bench-storm\r\n\r\n";
+
+struct slot {
+	lws_usec_t	t0;
+	int		fd;
+	int		sent;
+	int		got;
+	char		rx[256];
+};
+
+struct run {
+	struct lws_context	*context;
+	pthread_mutex_t		lock;
+	char			line[128];
+	int			linelen;
+	int			open;
+	int			ctl_w;
+	int			loadgen_done;
+	int			fail;
+
+	/* results */
+	double			cps;
+	long			p50, p99;
+	long			rss_before, rss_idle;
+	int			idle;
+};
+
+static struct run *r;
+static int port = 7990, total = 10000, conc = 64, idle_target = 10000;
+static const char *evlib = "poll";
+static volatile int interrupted;
+
+static long
+rss_kib(void)
+{
+	long pages = 0, rss = 0;
+	FILE *f = fopen("/proc/self/statm", "r");
+
+	if (!f)
+		return 0;
+	if (fscanf(f, "%ld %ld", &pages, &rss) != 2)
+		rss = 0;
+	fclose(f);
+
+	return rss * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+/*
+ * load generator side, in the forked child
+ */
+
+static int
+lg_connect(struct slot *s)
+{
+	struct sockaddr_in sin;
+	int fd = socket(AF_INET, SOCK_STREAM, 0);
+
+	if (fd < 0)
+		return -1;
+
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	memset(&sin, 0, sizeof(sin));
+	sin.sin_family = AF_INET;
+	sin.sin_port = htons((uint16_t)port);
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	s->t0 = lws_now_usecs();
+	s->sent = 0;
+	s->got = 0;
+
+	if (connect(fd, (struct sockaddr *)&sin, sizeof(sin)) < 0 &&
+	    errno != EINPROGRESS) {
+		close(fd);
+		return -1;
+	}
+
+	s->fd = fd;
+
+	return 0;
+}
+
+/* returns 1 when the upgrade completed, 0 if still going, -1 if failed */
+
+static int
+lg_service(struct slot *s, short revents)
+{
+	ssize_t n;
+
+	if (revents & (POLLERR | POLLHUP) && !(revents & POLLIN))
+		return -1;
+
+	if (!s->sent) {
+		if (!(revents & POLLOUT))
+			return 0;
+		if (write(s->fd, upgrade, sizeof(upgrade) - 1) !=
+						(ssize_t)sizeof(upgrade) - 1)
+			return -1;
+		s->sent = 1;
+
+		return 0;
+	}
+
+	if (!(revents & POLLIN))
+		return 0;
+
+	n = read(s->fd, s->rx + s->got, sizeof(s->rx) - 1 - (size_t)s->got);
+	if (n <= 0)
+		return -1;
+	s->got += (int)n;
+	s->rx[s->got] = '\0';
+
+	if (!strstr(s->rx, "\r\n\r\n"))
+		return s->got == (int)sizeof(s->rx) - 1 ? -1 : 0;
+
+	return strncmp(s->rx, "HTTP/1.1 101", 12) ? -1 : 1;
+}
+
+static int
+cmp_long(const void *a, const void *b)
+{
+	long la = *(const long *)a, lb = *(const long *)b;
+
+	return la < lb ? -1 : la > lb;
+}
+
+/*
+ * Keep up to conc connections in flight until count have upgraded.  If keep,
+ * the upgraded fds are left open in keep[], else they are closed and their
+ * connect -> 101 latency is recorded in lat[].
+ */
+
+static int
+lg_phase(int count, long *lat, int *keep)
+{
+	struct pollfd *pfd = calloc((size_t)conc, sizeof(*pfd));
+	struct slot *sl = calloc((size_t)conc, sizeof(*sl));
+	int started = 0, done = 0, n, m, ret = -1;
+	lws_usec_t t0 = lws_now_usecs();
+
+	if (!pfd || !sl)
+		goto bail;
+
+	for (n = 0; n < conc; n++)
+		sl[n].fd = -1;
+
+	while (done < count) {
+		for (n = 0; n < conc; n++) {
+			if (sl[n].fd < 0 && started < count) {
+				if (lg_connect(&sl[n])) {
+					if (done || lws_now_usecs() - t0 >
+							5 * LWS_US_PER_SEC)
+						goto bail;
+					/* server still coming up */
+					usleep(1000);
+					continue;
+				}
+				started++;
+			}
+			pfd[n].fd = sl[n].fd;
+			pfd[n].events = (short)(sl[n].sent ? POLLIN : POLLOUT);
+			pfd[n].revents = 0;
+		}
+
+		if (poll(pfd, (nfds_t)conc, 5000) <= 0)
+			goto bail;
+
+		for (n = 0; n < conc; n++) {
+			if (sl[n].fd < 0 || !pfd[n].revents)
+				continue;
+
+			m = lg_service(&sl[n], pfd[n].revents);
+			if (!m)
+				continue;
+			if (m < 0) {
+				/*
+				 * Only expected while the server is still
+				 * coming up, before anything succeeded
+				 */
+				if (done || lws_now_usecs() - t0 > 5 * LWS_US_PER_SEC)
+					goto bail;
+				usleep(1000);
+				close(sl[n].fd);
+				sl[n].fd = -1;
+				started--;
+				continue;
+			}
+
+			if (keep)
+				keep[done] = sl[n].fd;
+			else {
+				lat[done] = (long)(lws_now_usecs() - sl[n].t0);
+				close(sl[n].fd);
+			}
+			sl[n].fd = -1;
+			done++;
+		}
+	}
+
+	ret = 0;
+
+bail:
+	if (sl)
+		for (n = 0; n < conc; n++)
+			if (sl[n].fd >= 0)
+				close(sl[n].fd);
+	free(pfd);
+	free(sl);
+
+	return ret;
+}
+
+static int
+loadgen(int ctl_w, int go_r)
+{
+	long *lat = calloc((size_t)total, sizeof(long));
+	int *idle = calloc((size_t)idle_target + 1, sizeof(int));
+	lws_usec_t t;
+	char buf[128];
+	int n, ret = 1;
+
+	if (!lat || !idle)
+		goto bail;
+
+	t = lws_now_usecs();
+	if (lg_phase(total, lat, NULL))
+		goto bail;
+	t = lws_now_usecs() - t;
+
+	qsort(lat, (size_t)total, sizeof(long), cmp_long);
+
+	n = lws_snprintf(buf, sizeof(buf), "S %f %ld %ld\n",
+			 (double)total * 1000000.0 / (double)t,
+			 lat[total / 2], lat[(total * 99) / 100]);
+	if (write(ctl_w, buf, (size_t)n) != n)
+		goto bail;
+
+	/* wait for the server to take its baseline RSS */
+	if (read(go_r, buf, 1) != 1)
+		goto bail;
+
+	if (idle_target && lg_phase(idle_target, NULL, idle))
+		goto bail;
+
+	n = lws_snprintf(buf, sizeof(buf), "I %d\n", idle_target);
+	if (write(ctl_w, buf, (size_t)n) != n)
+		goto bail;
+
+	/* hold them open until the server measured it */
+	if (read(go_r, buf, 1) != 1)
+		goto bail;
+
+	ret = 0;
+
+bail:
+	if (idle)
+		for (n = 0; n < idle_target; n++)
+			if (idle[n] > 0)
+				close(idle[n]);
+	free(idle);
+	free(lat);
+
+	return ret;
+}
+
+/*
+ * server side
+ */
+
+static void
+ctl_line(struct run *run, const char *line)
+{
+	switch (line[0]) {
+	case 'S':
+		if (sscanf(line + 2, "%lf %ld %ld", &run->cps, &run->p50,
+			   &run->p99) != 3)
+			run->fail = 1;
+		run->rss_before = rss_kib();
+		break;
+	case 'I':
+		run->idle = atoi(line + 2);
+		/* give the pts a moment to finish with the last of them */
+		usleep(100000);
+		run->rss_idle = rss_kib();
+		break;
+	default:
+		run->fail = 1;
+		return;
+	}
+
+	if (write(run->ctl_w, "x", 1) != 1)
+		run->fail = 1;
+}
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	ssize_t n;
+	char *p;
+
+	switch (reason) {
+	case LWS_CALLBACK_ESTABLISHED:
+		pthread_mutex_lock(&r->lock);
+		r->open++;
+		pthread_mutex_unlock(&r->lock);
+		break;
+
+	case LWS_CALLBACK_CLOSED:
+		pthread_mutex_lock(&r->lock);
+		n = !--r->open && r->loadgen_done;
+		pthread_mutex_unlock(&r->lock);
+		if (n)
+			/* the main thread may be waiting on another pt */
+			lws_cancel_service(lws_get_context(wsi));
+		break;
+
+	case LWS_CALLBACK_RAW_RX_FILE:
+		n = read(lws_get_socket_fd(wsi), r->line + r->linelen,
+			 sizeof(r->line) - 1 - (size_t)r->linelen);
+		if (n <= 0)
+			return -1;
+		r->linelen += (int)n;
+		r->line[r->linelen] = '\0';
+
+		while ((p = strchr(r->line, '\n'))) {
+			*p = '\0';
+			ctl_line(r, r->line);
+			r->linelen -= lws_ptr_diff(p + 1, r->line);
+			memmove(r->line, p + 1, (size_t)r->linelen + 1);
+		}
+		break;
+
+	case LWS_CALLBACK_RAW_CLOSE_FILE:
+		pthread_mutex_lock(&r->lock);
+		r->loadgen_done = 1;
+		pthread_mutex_unlock(&r->lock);
+		lws_cancel_service(lws_get_context(wsi));
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-storm", callback_bench, 0, 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static void *
+thread_service(void *tsi)
+{
+	while (!interrupted &&
+	       lws_service_tsi(r->context, 0, (int)(lws_intptr_t)tsi) >= 0)
+		;
+
+	return NULL;
+}
+
+static int
+run_one(struct lws_context_creation_info *info, int threads, int *got_threads)
+{
+	pthread_t pts[LWS_MAX_SMP];
+	struct lws_vhost *vh;
+	struct run run;
+	int ctl[2], go[2], n, ret = 1;
+	lws_sock_file_fd_type u;
+	pid_t pid;
+
+	*got_threads = threads;
+	memset(&run, 0, sizeof(run));
+	pthread_mutex_init(&run.lock, NULL);
+	r = &run;
+	interrupted = 0;
+
+	if (pipe(ctl) || pipe(go))
+		return 1;
+
+	pid = fork();
+	if (pid < 0)
+		return 1;
+	if (!pid) {
+		close(ctl[0]);
+		close(go[1]);
+		exit(loadgen(ctl[1], go[0]));
+	}
+	close(ctl[1]);
+	close(go[0]);
+	run.ctl_w = go[1];
+
+	info->count_threads = (unsigned int)threads;
+	run.context = lws_create_context(info);
+	if (!run.context) {
+		lwsl_err("lws init failed\n");
+		kill(pid, SIGTERM);
+		goto bail;
+	}
+	*got_threads = lws_get_count_threads(run.context);
+
+	vh = lws_get_vhost_by_name(run.context, "default");
+	u.filefd = (lws_filefd_type)(long long)ctl[0];
+	if (!lws_adopt_descriptor_vhost(vh, LWS_ADOPT_RAW_FILE_DESC, u,
+					"bench-storm", NULL)) {
+		kill(pid, SIGTERM);
+		goto bail1;
+	}
+
+	for (n = 1; n < *got_threads; n++)
+		pthread_create(&pts[n], NULL, thread_service,
+			       (void *)(lws_intptr_t)n);
+
+	/* until the load generator is gone and everything it opened closed */
+
+	while (!run.fail && lws_service_tsi(run.context, 0, 0) >= 0) {
+		pthread_mutex_lock(&run.lock);
+		n = run.loadgen_done && !run.open;
+		pthread_mutex_unlock(&run.lock);
+		if (n)
+			break;
+	}
+
+	interrupted = 1;
+	lws_cancel_service(run.context);
+	for (n = 1; n < *got_threads; n++)
+		pthread_join(pts[n], NULL);
+
+	ret = run.fail;
+
+bail1:
+	lws_context_destroy(run.context);
+bail:
+	close(go[1]);
+	if (waitpid(pid, &n, 0) != pid || !WIFEXITED(n) || WEXITSTATUS(n))
+		ret = 1;
+	pthread_mutex_destroy(&run.lock);
+
+	if (!ret)
+		lwsl_user("%8s %7d %10.0f %8ld %8ld %12ld\n", evlib, *got_threads,
+			  run.cps, run.p50, run.p99, run.idle ?
+			  ((run.rss_idle - run.rss_before) * 10000) / run.idle :
+			  0);
+
+	return ret;
+}
+
+int main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	int threads = 1, t, got, ret = 0;
+	struct rlimit rl;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench conn storm [-c conns] [-C concurrent] "
+		  "[-i idle] [-t max threads] [-p port] [-b accept budget] "
+		  "[--epoll] [--uring] [--uv] [--ev] [--event] [--glib] "
+		  "[--slab] [--steer]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-c")))
+		total = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-C")))
+		conc = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-i")))
+		idle_target = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-t")))
+		threads = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-b")))
+		info.accept_budget = (unsigned int)atoi(p);
+
+	if (total < 1 || conc < 1 || idle_target < 0 || threads < 1)
+		return 1;
+	if (conc > total)
+		conc = total;
+
+	/* the server and the load generator both need an fd per connection */
+
+	if (!getrlimit(RLIMIT_NOFILE, &rl)) {
+		rl.rlim_cur = rl.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &rl);
+		if (rl.rlim_cur != RLIM_INFINITY &&
+		    (int)rl.rlim_cur - 128 < idle_target) {
+			idle_target = (int)rl.rlim_cur - 128;
+			lwsl_warn("fd limit: only %d idle\n", idle_target);
+		}
+	}
+
+	signal(SIGPIPE, SIG_IGN);
+
+	info.port = port;
+	info.protocols = protocols;
+
+	if (lws_cmdline_option(argc, argv, "--epoll")) {
+		info.options |= LWS_SERVER_OPTION_EPOLL;
+		evlib = "epoll";
+	}
+	if (lws_cmdline_option(argc, argv, "--uring")) {
+		info.options |= LWS_SERVER_OPTION_IO_URING;
+		evlib = "uring";
+	}
+	if (lws_cmdline_option(argc, argv, "--uv")) {
+		info.options |= LWS_SERVER_OPTION_LIBUV;
+		evlib = "libuv";
+	}
+	if (lws_cmdline_option(argc, argv, "--ev")) {
+		info.options |= LWS_SERVER_OPTION_LIBEV;
+		evlib = "libev";
+	}
+	if (lws_cmdline_option(argc, argv, "--event")) {
+		info.options |= LWS_SERVER_OPTION_LIBEVENT;
+		evlib = "libevent";
+	}
+	if (lws_cmdline_option(argc, argv, "--glib")) {
+		info.options |= LWS_SERVER_OPTION_GLIB;
+		evlib = "glib";
+	}
+	if (lws_cmdline_option(argc, argv, "--slab"))
+		info.options |= LWS_SERVER_OPTION_WSI_SLAB;
+	if (lws_cmdline_option(argc, argv, "--steer"))
+		info.options |= LWS_SERVER_OPTION_REUSEPORT_CPU_AFFINITY;
+
+	lwsl_user("%8s %7s %10s %8s %8s %12s\n", "evlib", "threads",
+		  "conn/s", "p50 us", "p99 us", "KiB/10k idle");
+
+	for (t = 1; t <= threads && !ret; t++) {
+		ret = run_one(&info, t, &got);
+		if (got < t) {
+			lwsl_warn("lws built for at most %d threads\n", got);
+			break;
+		}
+	}
+
+	lwsl_user("Completed: %s\n", ret ? "FAIL" : "OK");
+
+	return ret;
+}
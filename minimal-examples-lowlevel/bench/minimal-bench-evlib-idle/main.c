@@ -0,0 +1,180 @@
+/*
+ * lws-minimal-bench-evlib-idle
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures the cost of one event loop wakeup as the number of idle fds
+ * in the pt grows.
+ *
+ * We adopt one end of a socketpair() per idle "connection" into lws as a
+ * raw file wsi, and never write to them.  One more socketpair is used to
+ * wake the loop: we write one byte to it, and time how long it takes lws to
+ * wake up and deliver it to us in LWS_CALLBACK_RAW_RX_FILE.
+ *
+ * With the default poll() loop the cost grows linearly with the idle count,
+ * with --epoll or --uring it should stay flat.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+static int *peers, idle_count, got, fail;
+static const char *bench_name = "bench-idle";
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	uint8_t buf[16];
+
+	switch (reason) {
+	case LWS_CALLBACK_RAW_RX_FILE:
+		if (read(lws_get_socket_fd(wsi), buf, sizeof(buf)) <= 0) {
+			fail = 1;
+			return -1;
+		}
+		got = 1;
+		break;
+
+	case LWS_CALLBACK_RAW_CLOSE_FILE:
+		/* the peer ends are ours, we close them at the end */
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-idle", callback_bench, 0, 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static int
+adopt_pair(struct lws_vhost *vh, int *peer)
+{
+	lws_sock_file_fd_type u;
+	int sv[2];
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) < 0)
+		return 1;
+
+	u.filefd = (lws_filefd_type)(long long)sv[0];
+	if (!lws_adopt_descriptor_vhost(vh, LWS_ADOPT_RAW_FILE_DESC, u,
+					bench_name, NULL)) {
+		close(sv[0]);
+		close(sv[1]);
+
+		return 1;
+	}
+
+	*peer = sv[1];
+
+	return 0;
+}
+
+int main(int argc, const char **argv)
+{
+	static const int steps[] = { 0, 100, 1000, 2000, 4000, 8000,
+				     16000, 32000, 64000 };
+	struct lws_context_creation_info info;
+	int wakeups = 2000, ping = -1, n, m = 0, s;
+	struct lws_context *context;
+	struct lws_vhost *vh;
+	struct rlimit rl;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench evlib idle [--epoll] [--et] [--uring] [-w wakeups] [-m max idle]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-w")))
+		wakeups = atoi(p);
+
+	/* take all the fds we are allowed, two per idle connection */
+
+	if (!getrlimit(RLIMIT_NOFILE, &rl)) {
+		rl.rlim_cur = rl.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &rl);
+	}
+	idle_count = (int)(rl.rlim_cur / 2) - 64;
+	if ((p = lws_cmdline_option(argc, argv, "-m")) && atoi(p) < idle_count)
+		idle_count = atoi(p);
+
+	info.port = CONTEXT_PORT_NO_LISTEN_SERVER;
+	info.protocols = protocols;
+	if (lws_cmdline_option(argc, argv, "--epoll"))
+		info.options |= LWS_SERVER_OPTION_EPOLL;
+	if (lws_cmdline_option(argc, argv, "--et"))
+		info.options |= LWS_SERVER_OPTION_EPOLL |
+				LWS_SERVER_OPTION_EPOLL_EDGE_TRIGGERED;
+	if (lws_cmdline_option(argc, argv, "--uring"))
+		info.options |= LWS_SERVER_OPTION_IO_URING;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+	vh = lws_get_vhost_by_name(context, "default");
+
+	peers = calloc((size_t)idle_count + 1, sizeof(int));
+	if (!peers || adopt_pair(vh, &ping))
+		goto bail;
+
+	lwsl_user("%10s %14s\n", "idle fds", "us / wakeup");
+
+	for (s = 0; s < (int)LWS_ARRAY_SIZE(steps) &&
+			   steps[s] <= idle_count && !fail; s++) {
+		lws_usec_t t;
+
+		while (m < steps[s]) {
+			if (adopt_pair(vh, &peers[m])) {
+				lwsl_err("adopt failed at %d\n", m);
+				goto bail;
+			}
+			m++;
+		}
+
+		/* let the adoptions settle */
+		lws_service(context, -1);
+
+		t = lws_now_usecs();
+		for (n = 0; n < wakeups && !fail; n++) {
+			got = 0;
+			if (write(ping, "x", 1) != 1)
+				goto bail;
+			while (!got && !fail)
+				if (lws_service(context, 0) < 0)
+					goto bail;
+		}
+		t = lws_now_usecs() - t;
+
+		lwsl_user("%10d %14.2f\n", m, (double)t / (double)wakeups);
+	}
+
+bail:
+	lws_context_destroy(context);
+
+	if (peers) {
+		while (m--)
+			close(peers[m]);
+		free(peers);
+	}
+	if (ping >= 0)
+		close(ping);
+
+	lwsl_user("Completed: %s\n", fail ? "FAIL" : "OK");
+
+	return fail;
+}
@@ -0,0 +1,580 @@
+/*
+ * lws-minimal-bench-file-cache
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures serving a set of small static files from a file:// mount, with
+ * and without the vhost keeping them in memory using http_file_cache_size.
+ *
+ * One context holds two tls h2 server vhosts mounting the same directory of
+ * generated css files, one with the file cache and one without, and an lws
+ * client, all serviced by the one thread.  For each run the client makes -n
+ * requests one after another on one h2 connection, going round the files, and
+ * checks each body is the file it asked for.
+ *
+ * A last run asks the cached vhost for the files again saying it can take
+ * gzip and br, where lws has stream compression these should come from the
+ * compressed forms the cache keeps.  Each encoded response must have an ETag
+ * with the coding's suffix, and asking again with If-None-Match of one of those
+ * must get a 304 with the same tag, but asking for it without saying we take
+ * the coding must get the file itself.  Finally one file is changed, and the cached vhost must
+ * serve the new content once it has revalidated.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define FILES		64
+#define REVALIDATE_MS	100
+
+static const struct run {
+	const char	*name;
+	int		vh;
+	char		enc;	/* say we accept gzip, br */
+} runs[] = {
+	{ "nocache",	0, 0 },
+	{ "cache",	1, 0 },
+	{ "cache-enc",	1, 1 },
+};
+
+static struct file {
+	size_t		len;
+	uint32_t	hash;
+} files[FILES];
+
+static struct state {
+	lws_sorted_usec_list_t	sul;
+	struct lws_context	*context;
+	struct lws_vhost	*vh[2];
+	struct lws_vhost	*vh_cli;
+	const struct run	*run;
+	uint64_t		body;
+	int			issued;
+	int			completed;
+	int			want; /* requests to make */
+	int			encoded;
+	char			etag[32]; /* the last one we were sent */
+	char			inm; /* send it as If-None-Match, 2: not ours */
+	char			done, fail;
+} st;
+
+struct pss {
+	uint32_t		hash;
+	size_t			len;
+	char			completed;
+};
+
+static int port = 7740, count = 10000;
+static char dir[128];
+static volatile int interrupted;
+
+/* the ETag of an encoded response has the coding's suffix */
+
+static int
+etag_ok(const char *etag, const char *ce)
+{
+	size_t el = strlen(etag);
+	const char *sfx = !ce ? NULL : (!strcmp(ce, "gzip") ? "-gz" : "-br");
+
+	if (el != 16 + (sfx ? 3 : 0))
+		return 0;
+
+	return !sfx || !strcmp(etag + 16, sfx);
+}
+
+static uint32_t
+fnv1a(uint32_t h, const uint8_t *p, size_t len)
+{
+	while (len--)
+		h = (h ^ *p++) * 0x01000193;
+
+	return h;
+}
+
+/* some plausible, compressible css */
+
+static int
+write_file(int n, int gen)
+{
+	char path[256], line[128];
+	size_t want = 512 + (((size_t)n * 7919) % 24000) + (size_t)gen * 100;
+	uint32_t h = 0x811c9dc5;
+	size_t len = 0;
+	int m = 0, l;
+	FILE *f;
+
+	lws_snprintf(path, sizeof(path), "%s/f%02d.css", dir, n);
+	f = fopen(path, "w");
+	if (!f)
+		return 1;
+
+	while (len < want) {
+		l = lws_snprintf(line, sizeof(line), ".c%d-%d-%d { margin: "
+				 "%dpx %dpx; color: #%06x; }\n", gen, n, m,
+				 m % 17, m % 5, ((unsigned int)m * 2654435761u)
+							& 0xffffff);
+		if (fwrite(line, 1, (size_t)l, f) != (size_t)l) {
+			fclose(f);
+			return 1;
+		}
+		h = fnv1a(h, (uint8_t *)line, (size_t)l);
+		len += (size_t)l;
+		m++;
+	}
+
+	files[n].len = len;
+	files[n].hash = h;
+
+	return fclose(f);
+}
+
+static void
+remove_files(void)
+{
+	char path[256];
+	int n;
+
+	for (n = 0; n < FILES; n++) {
+		lws_snprintf(path, sizeof(path), "%s/f%02d.css", dir, n);
+		unlink(path);
+	}
+	rmdir(dir);
+}
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul);
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	int f = (int)(intptr_t)lws_get_opaque_user_data(wsi) % FILES;
+	uint8_t buf[LWS_PRE + 4096];
+	struct pss *pss = (struct pss *)user;
+	unsigned char **p = (unsigned char **)in;
+	char ce[16], ct[16], tag[32], *px;
+	int lenx, status;
+
+	switch (reason) {
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: connection error: %s\n", __func__,
+			 in ? (const char *)in : "");
+		st.fail = 1;
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_CLIENT_APPEND_HANDSHAKE_HEADER:
+		if (st.run && st.run->enc &&
+		    lws_add_http_header_by_token(wsi,
+				WSI_TOKEN_HTTP_ACCEPT_ENCODING,
+				(unsigned char *)"gzip, br", 8, p,
+				(*p) + len))
+			return -1;
+		if (st.inm &&
+		    lws_add_http_header_by_token(wsi,
+				WSI_TOKEN_HTTP_IF_NONE_MATCH,
+				(unsigned char *)st.etag, (int)strlen(st.etag),
+				p, (*p) + len))
+			return -1;
+		break;
+
+	case LWS_CALLBACK_ESTABLISHED_CLIENT_HTTP:
+		pss->hash = 0x811c9dc5;
+		pss->len = 0;
+
+		/*
+		 * A new h2 connection's window starts at 65535, and opening the
+		 * first client stream on it adds 4 x 64KiB, so before any DATA
+		 * our estimate of the connection window must be at least that
+		 */
+		if (st.run != &runs[0] || st.completed)
+			break;
+		lenx = lws_wsi_tx_credit(lws_get_network_wsi(wsi),
+					 LWSTXCR_PEER_TO_US, 0);
+		if (lenx < 65535 + 4 * 65536) {
+			lwsl_err("%s: f%02d: peer connection window est %d\n",
+				 __func__, f, lenx);
+			st.fail = 1;
+		}
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP_READ:
+		pss->hash = fnv1a(pss->hash, in, len);
+		pss->len += len;
+		st.body += len;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		px = (char *)buf + LWS_PRE;
+		lenx = (int)sizeof(buf) - LWS_PRE;
+		if (lws_http_client_read(wsi, &px, &lenx) < 0)
+			return -1;
+		return 0;
+
+	case LWS_CALLBACK_COMPLETED_CLIENT_HTTP:
+		pss->completed = 1;
+		status = (int)lws_http_client_http_response(wsi);
+
+		if (st.inm == 1) {
+			/* he has it already, as the tag says */
+			if (status != 304 ||
+			    lws_hdr_copy(wsi, tag, sizeof(tag),
+					 WSI_TOKEN_HTTP_ETAG) <= 0 ||
+			    strcmp(tag, st.etag)) {
+				lwsl_err("%s: f%02d: If-None-Match %s: %d\n",
+					 __func__, f, st.etag, status);
+				st.fail = 1;
+			}
+		} else if (status != 200) {
+			lwsl_err("%s: f%02d: response %d\n", __func__, f,
+				 status);
+			st.fail = 1;
+		} else if (lws_hdr_copy(wsi, st.etag, sizeof(st.etag),
+				WSI_TOKEN_HTTP_ETAG) <= 0) {
+			lwsl_err("%s: f%02d: no etag\n", __func__, f);
+			st.fail = 1;
+		} else if (lws_hdr_copy(wsi, ct, sizeof(ct),
+				WSI_TOKEN_HTTP_CONTENT_TYPE) <= 0 ||
+			   strcmp(ct, "text/css")) {
+			/* from one of the vhost's header blocks */
+			lwsl_err("%s: f%02d: bad content-type\n", __func__, f);
+			st.fail = 1;
+		} else if (lws_hdr_copy(wsi, ce, sizeof(ce),
+				WSI_TOKEN_HTTP_CONTENT_ENCODING) > 0) {
+			/* we can't check it, but it should be smaller */
+			if (!st.run->enc || (strcmp(ce, "gzip") &&
+					     strcmp(ce, "br")) ||
+			    pss->len >= files[f].len || !etag_ok(st.etag, ce)) {
+				lwsl_err("%s: f%02d: %s, %u bytes, etag %s\n",
+					 __func__, f, ce, (unsigned int)pss->len,
+					 st.etag);
+				st.fail = 1;
+			}
+			st.encoded++;
+		} else if (pss->len != files[f].len ||
+			   pss->hash != files[f].hash ||
+			   !etag_ok(st.etag, NULL)) {
+			lwsl_err("%s: f%02d: wrong content, %u bytes, etag %s\n",
+				 __func__, f, (unsigned int)pss->len, st.etag);
+			st.fail = 1;
+		}
+
+		if (++st.completed == st.want || st.fail)
+			st.done = 1;
+		else
+			/* the next one goes on the same h2 connection */
+			lws_sul_schedule(st.context, 0, &st.sul, sul_next_cb, 1);
+		break;
+
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		if (pss && !pss->completed && !st.done) {
+			lwsl_err("%s: closed early\n", __func__);
+			st.fail = 1;
+			st.done = 1;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-file-cache", callback_bench, sizeof(struct pss), 0, 0, NULL,
+	  0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul)
+{
+	struct lws_client_connect_info i;
+	char path[16];
+
+	lws_snprintf(path, sizeof(path), "/f%02d.css", st.issued % FILES);
+
+	memset(&i, 0, sizeof(i));
+	i.context		= st.context;
+	i.vhost			= st.vh_cli;
+	i.address		= "localhost";
+	i.host			= i.address;
+	i.origin		= i.address;
+	i.port			= port + st.run->vh;
+	i.path			= path;
+	i.method		= "GET";
+	i.alpn			= "h2";
+	i.local_protocol_name	= protocols[0].name;
+	i.opaque_user_data	= (void *)(intptr_t)st.issued;
+	i.ssl_connection	= LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED |
+				  LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK |
+				  LCCSCF_PIPELINE;
+
+	st.issued++;
+	if (!lws_client_connect_via_info(&i)) {
+		lwsl_err("%s: connect failed\n", __func__);
+		st.fail = 1;
+		st.done = 1;
+	}
+}
+
+static int
+run_requests(const struct run *r, int first, int want, lws_usec_t *us)
+{
+	lws_usec_t t0;
+	int n = 0;
+
+	memset(&st.sul, 0, sizeof(st.sul));
+	st.run = r;
+	st.issued = first;
+	st.completed = 0;
+	st.want = want;
+	st.encoded = 0;
+	st.body = 0;
+	st.done = st.fail = 0;
+
+	t0 = lws_now_usecs();
+	sul_next_cb(&st.sul);
+
+	while (n >= 0 && !st.done && !interrupted &&
+	       lws_now_usecs() - t0 < 30 * LWS_US_PER_SEC)
+		n = lws_service(st.context, 0);
+
+	*us = lws_now_usecs() - t0;
+	lws_sul_cancel(&st.sul);
+
+	if (!st.done || st.fail) {
+		lwsl_err("%s: %s: failed\n", __func__, r->name);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+run_one(const struct run *r)
+{
+	lws_http_file_cache_stats_t s;
+	lws_usec_t us;
+
+	if (run_requests(r, 0, count, &us))
+		return 1;
+
+	memset(&s, 0, sizeof(s));
+	lws_http_file_cache_stats(st.vh[r->vh], &s);
+
+	lwsl_user("%10s %8d %10.0f %8.1f %10.0f %8llu %8llu %8llu %8u\n",
+		  r->name, count, (double)count * LWS_US_PER_SEC / (double)us,
+		  (double)us / count, (double)st.body / count,
+		  (unsigned long long)s.hits, (unsigned long long)s.misses,
+		  (unsigned long long)s.enc_hits,
+		  (unsigned int)s.footprint);
+
+	if (r->vh && !s.hits) {
+		lwsl_err("%s: %s: no cache hits\n", __func__, r->name);
+		return 1;
+	}
+
+	if (st.encoded && !s.enc_hits) {
+		lwsl_err("%s: %s: encoded responses not from the cache\n",
+			 __func__, r->name);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Ask for f01 again with the ETag we were last sent for it, encoded if lws
+ * has stream compression.  It hasn't changed, so we must get a 304.  If it was
+ * encoded, the tag isn't the one the identity form would have, so asking with
+ * it but without accept-encoding must get the identity form.
+ */
+
+static int
+run_inm(void)
+{
+	lws_usec_t us;
+	int ret;
+
+	if (run_requests(&runs[2], 1, 1, &us))
+		return 1;
+
+	st.inm = 1;
+	ret = run_requests(&runs[2], 1, 1, &us);
+	st.inm = 0;
+
+	if (ret)
+		return ret;
+
+	lwsl_user("%10s: 304 for etag %s\n", "inm", st.etag);
+
+	if (strlen(st.etag) == 16)
+		return 0;
+
+	st.inm = 2;
+	ret = run_requests(&runs[1], 1, 1, &us);
+	st.inm = 0;
+
+	if (!ret)
+		lwsl_user("%10s: 200 without coding, etag %s\n", "inm",
+			  st.etag);
+
+	return ret;
+}
+
+/*
+ * Change f00, the cached vhost must serve the new content once it revalidates.
+ * Its size changes too, since the mtime may not have ticked over.
+ */
+
+static int
+run_changed(void)
+{
+	lws_http_file_cache_stats_t s;
+	lws_usec_t us, t0;
+
+	if (write_file(0, 1))
+		return 1;
+
+	t0 = lws_now_usecs();
+	while (lws_now_usecs() - t0 < 2 * REVALIDATE_MS * LWS_US_PER_MS)
+		lws_service(st.context, 0);
+
+	if (run_requests(&runs[1], 0, 1, &us))
+		return 1;
+
+	lws_http_file_cache_stats(st.vh[1], &s);
+	if (!s.invalidations) {
+		lwsl_err("%s: change not noticed\n", __func__);
+		return 1;
+	}
+
+	lwsl_user("%10s: served new content after change\n", "changed");
+
+	return 0;
+}
+
+static int
+create_vhosts(struct lws_context_creation_info *info)
+{
+	static struct lws_http_mount mount;
+	struct lws_context_creation_info vi;
+	int n;
+
+	memset(&mount, 0, sizeof(mount));
+	mount.mountpoint	= "/";
+	mount.mountpoint_len	= 1;
+	mount.origin		= dir;
+	mount.origin_protocol	= LWSMPRO_FILE;
+
+	for (n = 0; n < 2; n++) {
+		vi = *info;
+		vi.vhost_name = runs[n].name;
+		vi.port = port + n;
+		vi.ssl_cert_filepath = "localhost-100y.cert";
+		vi.ssl_private_key_filepath = "localhost-100y.key";
+		vi.mounts = &mount;
+		if (n) {
+			vi.http_file_cache_size = 4 * 1024 * 1024;
+			vi.http_file_cache_revalidate_ms = REVALIDATE_MS;
+		}
+		st.vh[n] = lws_create_vhost(st.context, &vi);
+		if (!st.vh[n])
+			return 1;
+	}
+
+	vi = *info;
+	vi.vhost_name = "cli";
+	vi.port = CONTEXT_PORT_NO_LISTEN;
+	st.vh_cli = lws_create_vhost(st.context, &vi);
+
+	return !st.vh_cli;
+}
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	int n, ret = 0;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench file cache [-n requests] [-p port]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-n")))
+		count = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if (count < FILES)
+		count = FILES;
+
+	lws_snprintf(dir, sizeof(dir), "/tmp/lws-bench-file-cache-%d",
+		     (int)getpid());
+	if (mkdir(dir, 0700)) {
+		lwsl_err("unable to create %s\n", dir);
+		return 1;
+	}
+	for (n = 0; n < FILES; n++)
+		if (write_file(n, 0)) {
+			lwsl_err("unable to write files in %s\n", dir);
+			remove_files();
+			return 1;
+		}
+
+	signal(SIGINT, sigint_handler);
+
+	info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+		       LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	info.protocols = protocols;
+
+	st.context = lws_create_context(&info);
+	if (!st.context) {
+		lwsl_err("lws init failed\n");
+		remove_files();
+		return 1;
+	}
+
+	if (create_vhosts(&info)) {
+		lwsl_err("vhost creation failed\n");
+		ret = 1;
+		goto bail;
+	}
+
+	lwsl_user("%10s %8s %10s %8s %10s %8s %8s %8s %8s\n", "run", "reqs",
+		  "req/s", "us/req", "body B", "hits", "misses", "enc",
+		  "cache B");
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(runs) && !ret && !interrupted; n++)
+		ret = run_one(&runs[n]);
+
+	if (!ret && !interrupted)
+		ret = run_inm();
+
+	if (!ret && !interrupted)
+		ret = run_changed();
+
+bail:
+	lws_context_destroy(st.context);
+	remove_files();
+
+	lwsl_user("Completed: %s\n", ret || interrupted ? "FAIL" : "OK");
+
+	return ret || interrupted;
+}
@@ -0,0 +1,426 @@
+/*
+ * lws-minimal-bench-hdr-block
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures the cost of adding a typical set of response headers one by one
+ * with the lws_add_http_header_*() apis, against adding the same set from an
+ * lws_http_hdr_block_t precompiled with lws_http_hdr_block_create(), for h1
+ * and h2.
+ *
+ * One context holds two tls server vhosts, one with the default HPACK
+ * encoder and one with it limited to the static table and Huffman coding,
+ * and an lws client, all serviced by the one thread.  For each run the client
+ * makes one request, and the server times building the response headers -n
+ * times each way in the HTTP callback before answering with the block.
+ *
+ * Where the two ways should give the same bytes, they are checked to be the
+ * same.  The client checks the headers it got are what the server meant.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+
+static const struct lws_protocol_vhost_options
+vh_hdrs = { NULL, NULL, "x-served-by:", "lws" },
+
+hdrs[] = {{
+	NULL, NULL, "cache-control:", "public, max-age=31536000, immutable"
+}, {
+	&hdrs[0], NULL, "last-modified:", "Thu, 15 Oct 2026 09:21:07 GMT"
+}, {
+	&hdrs[1], NULL, "accept-ranges:", "bytes"
+}, {
+	&hdrs[2], NULL, "vary:", "accept-encoding"
+}, {
+	&hdrs[3], NULL, "strict-transport-security:",
+			"max-age=63072000; includeSubDomains"
+}, {
+	&hdrs[4], NULL, "x-frame-options:", "deny"
+}, {
+	&hdrs[5], NULL, "x-content-type-options:", "nosniff"
+}};
+
+static const struct run {
+	const char	*name;
+	const char	*alpn;
+	int		vh;
+	char		same;	/* both ways give the same bytes */
+} runs[] = {
+	{ "h1",		"http/1.1",	0, 1 },
+	{ "h2",		"h2",		0, 1 },
+	{ "h2-static",	"h2",		1, 0 },
+};
+
+static const struct vhd {
+	const char	*name;
+	int		table_size;
+} vhds[] = {
+	{ "dynamic",	0 },
+	{ "static",	LWS_H2_HPACK_ENC_NO_DYNAMIC },
+};
+
+static struct state {
+	struct lws_context	*context;
+	struct lws_vhost	*vh_cli;
+	lws_http_hdr_block_t	*block[LWS_ARRAY_SIZE(vhds)];
+	const struct run	*run;
+	lws_usec_t		us_api;
+	lws_usec_t		us_block;
+	size_t			len_api;
+	size_t			len_block;
+	char			done, fail;
+} st;
+
+static int port = 7730, count = 20000;
+static volatile int interrupted;
+
+#define CONTENT_TYPE	"text/css"
+#define ETAG		"\"5f1e-17a2c3d4\""
+
+/* what the block holds, added one by one */
+
+static int
+headers_api(struct lws *wsi, unsigned char **p, unsigned char *end)
+{
+	const struct lws_protocol_vhost_options *h;
+	char date[32];
+	time_t t;
+
+	if (lws_add_http_header_status(wsi, HTTP_STATUS_OK, p, end) ||
+	    lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_CONTENT_TYPE,
+				(const unsigned char *)CONTENT_TYPE,
+				(int)strlen(CONTENT_TYPE), p, end))
+		return 1;
+
+	for (h = &hdrs[LWS_ARRAY_SIZE(hdrs) - 1]; h; h = h->next)
+		if (lws_add_http_header_by_name(wsi,
+					(const unsigned char *)h->name,
+					(const unsigned char *)h->value,
+					(int)strlen(h->value), p, end))
+			return 1;
+
+	t = time(NULL);
+
+	return lws_add_http_header_content_length(wsi, 3, p, end) ||
+	       lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_ETAG,
+				(const unsigned char *)ETAG,
+				(int)strlen(ETAG), p, end) ||
+	       lws_http_date_render_from_unix(date, sizeof(date), &t) ||
+	       lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_DATE,
+				(const unsigned char *)date,
+				(int)strlen(date), p, end);
+}
+
+static int
+headers_block(struct lws *wsi, unsigned char **p, unsigned char *end)
+{
+	return lws_add_http_header_block(wsi, st.block[st.run->vh], 3, ETAG,
+					 p, end);
+}
+
+static int
+time_it(struct lws *wsi, unsigned char *start, unsigned char *end,
+	int (*build)(struct lws *wsi, unsigned char **p, unsigned char *end),
+	lws_usec_t *us, size_t *len)
+{
+	unsigned char *p = start;
+	lws_usec_t t0 = lws_now_usecs();
+	int n;
+
+	for (n = 0; n < count; n++) {
+		p = start;
+		if (build(wsi, &p, end))
+			return 1;
+	}
+
+	*us = lws_now_usecs() - t0;
+	*len = lws_ptr_diff_size_t(p, start);
+
+	return 0;
+}
+
+static int
+check_hdr(struct lws *wsi, enum lws_token_indexes t, const char *want)
+{
+	char buf[128];
+
+	if (lws_hdr_copy(wsi, buf, sizeof(buf), t) < 0 ||
+	    (want ? strcmp(buf, want) : !buf[0])) {
+		lwsl_err("%s: %s: got '%s', expected '%s'\n", __func__,
+			 lws_token_to_string(t), buf, want ? want : "any");
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	uint8_t buf[LWS_PRE + 2048], cmp[LWS_PRE + 2048],
+		*start = &buf[LWS_PRE], *p = start, *q,
+		*end = &buf[sizeof(buf) - 1];
+	char *px;
+	int lenx;
+
+	switch (reason) {
+
+	/* server side */
+
+	case LWS_CALLBACK_HTTP:
+		if (time_it(wsi, start, end, headers_api, &st.us_api,
+			    &st.len_api) ||
+		    time_it(wsi, start, end, headers_block, &st.us_block,
+			    &st.len_block))
+			return 1;
+
+		if (st.run->same) {
+			/* the date may have ticked over, so give it two goes */
+			for (lenx = 0; lenx < 2; lenx++) {
+				q = &cmp[LWS_PRE];
+				if (headers_api(wsi, &q, &cmp[sizeof(cmp) - 1]))
+					return 1;
+				p = start;
+				if (headers_block(wsi, &p, end))
+					return 1;
+				if (lws_ptr_diff(p, start) ==
+					lws_ptr_diff(q, &cmp[LWS_PRE]) &&
+				    !memcmp(start, &cmp[LWS_PRE],
+					    lws_ptr_diff_size_t(p, start)))
+					break;
+			}
+			if (lenx == 2) {
+				lwsl_err("%s: %s: block differs\n", __func__,
+					 st.run->name);
+				lwsl_hexdump_err(start,
+						 lws_ptr_diff_size_t(p, start));
+				st.fail = 1;
+			}
+		} else
+			if (st.len_block >= st.len_api) {
+				lwsl_err("%s: %s: block not smaller\n",
+					 __func__, st.run->name);
+				st.fail = 1;
+			}
+
+		p = start;
+		if (headers_block(wsi, &p, end) ||
+		    lws_finalize_write_http_header(wsi, start, &p, end))
+			return 1;
+		lws_callback_on_writable(wsi);
+		return 0;
+
+	case LWS_CALLBACK_HTTP_WRITEABLE:
+		memcpy(start, "ok\n", 3);
+		if (lws_write(wsi, start, 3, LWS_WRITE_HTTP_FINAL) != 3)
+			return 1;
+		if (lws_http_transaction_completed(wsi))
+			return -1;
+		return 0;
+
+	/* client side */
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: connection error: %s\n", __func__,
+			 in ? (const char *)in : "");
+		st.fail = 1;
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		px = (char *)buf + LWS_PRE;
+		lenx = (int)sizeof(buf) - LWS_PRE;
+		if (lws_http_client_read(wsi, &px, &lenx) < 0)
+			return -1;
+		return 0;
+
+	case LWS_CALLBACK_COMPLETED_CLIENT_HTTP:
+		if (lws_http_client_http_response(wsi) != 200 ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_CONTENT_TYPE, CONTENT_TYPE) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_CACHE_CONTROL,
+			      hdrs[0].value) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_LAST_MODIFIED,
+			      hdrs[1].value) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_ETAG, ETAG) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_CONTENT_LENGTH, "3") ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_DATE, NULL)) {
+			lwsl_err("%s: %s: bad response\n", __func__,
+				 st.run->name);
+			st.fail = 1;
+		}
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		/* the last run's connection may only close now */
+		if (lws_get_opaque_user_data(wsi) == st.run && !st.done) {
+			lwsl_err("%s: closed early\n", __func__);
+			st.fail = 1;
+			st.done = 1;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-hdr-block", callback_bench, 0, 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static int
+run_one(const struct run *r)
+{
+	struct lws_client_connect_info i;
+	lws_usec_t t0;
+	int n = 0;
+
+	st.run = r;
+	st.done = st.fail = 0;
+
+	memset(&i, 0, sizeof(i));
+	i.context		= st.context;
+	i.vhost			= st.vh_cli;
+	i.address		= "localhost";
+	i.host			= i.address;
+	i.origin		= i.address;
+	i.port			= port + r->vh;
+	i.path			= "/";
+	i.method		= "GET";
+	i.alpn			= r->alpn;
+	i.local_protocol_name	= protocols[0].name;
+	i.opaque_user_data	= (void *)r;
+	i.ssl_connection	= LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED |
+				  LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
+
+	if (!lws_client_connect_via_info(&i)) {
+		lwsl_err("%s: connect failed\n", __func__);
+		return 1;
+	}
+
+	t0 = lws_now_usecs();
+	while (n >= 0 && !st.done && !interrupted &&
+	       lws_now_usecs() - t0 < 20 * LWS_US_PER_SEC)
+		n = lws_service(st.context, 0);
+
+	if (!st.done || st.fail) {
+		lwsl_err("%s: %s: failed\n", __func__, r->name);
+		return 1;
+	}
+
+	lwsl_user("%10s %8d %10.1f %10.1f %7.1fx %8u %8u\n", r->name, count,
+		  (double)st.us_api * 1000.0 / count,
+		  (double)st.us_block * 1000.0 / count,
+		  st.us_block ? (double)st.us_api / (double)st.us_block : 0.0,
+		  (unsigned int)st.len_api, (unsigned int)st.len_block);
+
+	return 0;
+}
+
+static int
+create_vhosts(struct lws_context_creation_info *info)
+{
+	struct lws_context_creation_info vi;
+	lws_http_hdr_block_info_t bi;
+	struct lws_vhost *vh;
+	int n;
+
+	memset(&bi, 0, sizeof(bi));
+	bi.headers	= &hdrs[LWS_ARRAY_SIZE(hdrs) - 1];
+	bi.content_type	= CONTENT_TYPE;
+	bi.code		= HTTP_STATUS_OK;
+	bi.flags	= LWSHBF_DATE;
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(vhds); n++) {
+		vi = *info;
+		vi.vhost_name = vhds[n].name;
+		vi.port = port + n;
+		vi.ssl_cert_filepath = "localhost-100y.cert";
+		vi.ssl_private_key_filepath = "localhost-100y.key";
+		vi.headers = &vh_hdrs;
+		vi.h2_hpack_enc_table_size = vhds[n].table_size;
+		vh = lws_create_vhost(st.context, &vi);
+		if (!vh)
+			return 1;
+
+		bi.vhost = vh;
+		st.block[n] = lws_http_hdr_block_create(&bi);
+		if (!st.block[n])
+			return 1;
+	}
+
+	vi = *info;
+	vi.vhost_name = "cli";
+	vi.port = CONTEXT_PORT_NO_LISTEN;
+	st.vh_cli = lws_create_vhost(st.context, &vi);
+
+	return !st.vh_cli;
+}
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	int n, ret = 0;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench hdr block [-n count] [-p port]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-n")))
+		count = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if (count < 1)
+		return 1;
+
+	signal(SIGINT, sigint_handler);
+
+	info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+		       LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	info.protocols = protocols;
+
+	st.context = lws_create_context(&info);
+	if (!st.context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	if (create_vhosts(&info)) {
+		lwsl_err("vhost creation failed\n");
+		ret = 1;
+		goto bail;
+	}
+
+	lwsl_user("%10s %8s %10s %10s %8s %8s %8s\n", "proto", "count",
+		  "api ns", "block ns", "speedup", "api B", "block B");
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(runs) && !ret && !interrupted; n++)
+		ret = run_one(&runs[n]);
+
+bail:
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(vhds); n++)
+		lws_http_hdr_block_destroy(&st.block[n]);
+	lws_context_destroy(st.context);
+
+	lwsl_user("Completed: %s\n", ret || interrupted ? "FAIL" : "OK");
+
+	return ret || interrupted;
+}
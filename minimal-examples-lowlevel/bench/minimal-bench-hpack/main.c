@@ -0,0 +1,436 @@
+/*
+ * lws-minimal-bench-hpack
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures how many bytes of h2 response headers go on the wire for some
+ * typical sets of response headers, with the lws HPACK encoder disabled,
+ * using only the static table and Huffman coding, and also using the dynamic
+ * table.
+ *
+ * One context holds a tls h2 server vhost for each mode and header set, and
+ * lws client connections to them, all serviced by the one thread.  For each
+ * combination the client makes -n requests one after another on one h2
+ * connection, the server answers each with the headers from the set, and the
+ * header block totals come from lws_h2_hpack_enc_stats() on the server
+ * connection.  The client checks the headers it decoded are what the server
+ * meant to send.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+
+enum {
+	SET_API,
+	SET_STATIC,
+	SET_REDIRECT,
+
+	SET_COUNT
+};
+
+static const char * const set_names[] = { "api", "static", "redirect" };
+
+static const struct mode {
+	const char	*name;
+	int		table_size;
+} modes[] = {
+	{ "literal",	LWS_H2_HPACK_ENC_DISABLE },
+	{ "static",	LWS_H2_HPACK_ENC_NO_DYNAMIC },
+	{ "dynamic",	0 },
+};
+
+static const char * const content_type[] = {
+	"application/json", "text/css", "text/html"
+};
+static const char * const cache_control[] = {
+	"no-store", "public, max-age=31536000, immutable", "no-cache"
+};
+
+static struct state {
+	lws_sorted_usec_list_t		sul;
+	struct lws_context		*context;
+	struct lws_vhost		*vh_cli;
+	lws_h2_hpack_enc_stats_t	stats;
+	int				set;
+	int				port;
+	int				issued;
+	int				completed;
+	char				done, fail;
+} st;
+
+struct pss {
+	char		completed;
+};
+
+static int port = 7720, count = 64;
+static volatile int interrupted;
+
+/* the per-request part of the headers, so both ends can work it out */
+
+static void
+etag(char *buf, size_t len, int req)
+{
+	lws_snprintf(buf, len, "\"%x-%08x\"", req,
+		     (unsigned int)req * 2654435761u);
+}
+
+static int
+add_hdr(struct lws *wsi, const char *name, const char *value,
+	unsigned char **p, unsigned char *end)
+{
+	return lws_add_http_header_by_name(wsi, (const unsigned char *)name,
+					   (const unsigned char *)value,
+					   (int)strlen(value), p, end);
+}
+
+static int
+server_headers(struct lws *wsi, int req, unsigned char **p, unsigned char *end)
+{
+	char tag[32], v[96];
+
+	etag(tag, sizeof(tag), req);
+
+	switch (st.set) {
+	case SET_API:
+		lws_snprintf(v, sizeof(v), "%08x-5b1c-4e0f-9a3d-%012x",
+			     (unsigned int)req * 40503u, (unsigned int)req);
+		return lws_add_http_common_headers(wsi, HTTP_STATUS_OK,
+					content_type[SET_API], 3, p, end) ||
+		       add_hdr(wsi, "cache-control:",
+					cache_control[SET_API], p, end) ||
+		       add_hdr(wsi, "etag:", tag, p, end) ||
+		       add_hdr(wsi, "vary:", "accept-encoding, origin",
+					p, end) ||
+		       add_hdr(wsi, "access-control-allow-origin:",
+					"https://app.example.com", p, end) ||
+		       add_hdr(wsi, "strict-transport-security:",
+					"max-age=63072000; includeSubDomains",
+					p, end) ||
+		       add_hdr(wsi, "x-content-type-options:", "nosniff",
+					p, end) ||
+		       add_hdr(wsi, "x-request-id:", v, p, end);
+
+	case SET_STATIC:
+		return lws_add_http_common_headers(wsi, HTTP_STATUS_OK,
+					content_type[SET_STATIC], 3, p, end) ||
+		       add_hdr(wsi, "cache-control:",
+					cache_control[SET_STATIC], p, end) ||
+		       add_hdr(wsi, "etag:", tag, p, end) ||
+		       add_hdr(wsi, "last-modified:",
+					"Thu, 15 Oct 2026 09:21:07 GMT",
+					p, end) ||
+		       add_hdr(wsi, "accept-ranges:", "bytes", p, end) ||
+		       add_hdr(wsi, "strict-transport-security:",
+					"max-age=63072000; includeSubDomains",
+					p, end) ||
+		       add_hdr(wsi, "x-frame-options:", "deny", p, end) ||
+		       add_hdr(wsi, "x-content-type-options:", "nosniff",
+					p, end);
+
+	default:
+		lws_snprintf(v, sizeof(v),
+			     "https://localhost/login?next=%%2Fr%%2F%d", req);
+		return lws_add_http_common_headers(wsi, HTTP_STATUS_FOUND,
+					content_type[SET_REDIRECT], 3, p, end) ||
+		       add_hdr(wsi, "cache-control:",
+					cache_control[SET_REDIRECT], p, end) ||
+		       add_hdr(wsi, "etag:", tag, p, end) ||
+		       add_hdr(wsi, "location:", v, p, end) ||
+		       add_hdr(wsi, "set-cookie:", "__Host-sid=0f3a9c; Path=/; "
+					"Secure; HttpOnly; SameSite=Lax",
+					p, end);
+	}
+}
+
+static int
+check_hdr(struct lws *wsi, enum lws_token_indexes t, const char *want)
+{
+	char buf[128];
+
+	if (lws_hdr_copy(wsi, buf, sizeof(buf), t) < 0 || strcmp(buf, want)) {
+		lwsl_err("%s: %s: got '%s', expected '%s'\n", __func__,
+			 lws_token_to_string(t), buf, want);
+		return 1;
+	}
+
+	return 0;
+}
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul);
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	uint8_t buf[LWS_PRE + 1024], *start = &buf[LWS_PRE], *p = start,
+		*end = &buf[sizeof(buf) - 1];
+	int req = (int)(intptr_t)lws_get_opaque_user_data(wsi);
+	struct pss *pss = (struct pss *)user;
+	char tag[32], *px;
+	int lenx;
+
+	switch (reason) {
+
+	/* server side */
+
+	case LWS_CALLBACK_HTTP:
+		req = atoi((const char *)in + 1);
+		if (server_headers(wsi, req, &p, end) ||
+		    lws_finalize_write_http_header(wsi, start, &p, end))
+			return 1;
+		/* the totals so far, for all the responses on the connection */
+		lws_h2_hpack_enc_stats(wsi, &st.stats);
+		lws_callback_on_writable(wsi);
+		return 0;
+
+	case LWS_CALLBACK_HTTP_WRITEABLE:
+		memcpy(start, "ok\n", 3);
+		if (lws_write(wsi, start, 3, LWS_WRITE_HTTP_FINAL) != 3)
+			return 1;
+		if (lws_http_transaction_completed(wsi))
+			return -1;
+		return 0;
+
+	/* client side */
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: connection error: %s\n", __func__,
+			 in ? (const char *)in : "");
+		st.fail = 1;
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		px = (char *)buf + LWS_PRE;
+		lenx = (int)sizeof(buf) - LWS_PRE;
+		if (lws_http_client_read(wsi, &px, &lenx) < 0)
+			return -1;
+		return 0;
+
+	case LWS_CALLBACK_COMPLETED_CLIENT_HTTP:
+		etag(tag, sizeof(tag), req);
+		if (lws_http_client_http_response(wsi) !=
+			(st.set == SET_REDIRECT ? 302u : 200u) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_CONTENT_TYPE,
+			      content_type[st.set]) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_CACHE_CONTROL,
+			      cache_control[st.set]) ||
+		    check_hdr(wsi, WSI_TOKEN_HTTP_ETAG, tag)) {
+			lwsl_err("%s: %s req %d: bad response\n", __func__,
+				 set_names[st.set], req);
+			st.fail = 1;
+		}
+
+		pss->completed = 1;
+		if (++st.completed == count || st.fail)
+			st.done = 1;
+		else
+			/* the next one goes on the same h2 connection */
+			lws_sul_schedule(st.context, 0, &st.sul, sul_next_cb, 1);
+		break;
+
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		if (pss && !pss->completed && !st.done) {
+			lwsl_err("%s: closed early\n", __func__);
+			st.fail = 1;
+			st.done = 1;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-hpack", callback_bench, sizeof(struct pss), 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul)
+{
+	struct lws_client_connect_info i;
+	char path[16];
+
+	lws_snprintf(path, sizeof(path), "/%d", st.issued);
+
+	memset(&i, 0, sizeof(i));
+	i.context		= st.context;
+	i.vhost			= st.vh_cli;
+	i.address		= "localhost";
+	i.host			= i.address;
+	i.origin		= i.address;
+	i.port			= st.port;
+	i.path			= path;
+	i.method		= "GET";
+	i.alpn			= "h2";
+	i.local_protocol_name	= protocols[0].name;
+	i.opaque_user_data	= (void *)(intptr_t)st.issued;
+	i.ssl_connection	= LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED |
+				  LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK |
+				  LCCSCF_HTTP_NO_FOLLOW_REDIRECT |
+				  LCCSCF_PIPELINE;
+
+	st.issued++;
+	if (!lws_client_connect_via_info(&i)) {
+		lwsl_err("%s: connect failed\n", __func__);
+		st.fail = 1;
+		st.done = 1;
+	}
+}
+
+static int
+run_one(int m, int set, const lws_h2_hpack_enc_stats_t *ref)
+{
+	lws_usec_t t0;
+	int n = 0;
+
+	memset(&st.sul, 0, sizeof(st.sul));
+	memset(&st.stats, 0, sizeof(st.stats));
+	st.set = set;
+	st.port = port + (m * SET_COUNT) + set;
+	st.issued = st.completed = 0;
+	st.done = st.fail = 0;
+
+	sul_next_cb(&st.sul);
+
+	t0 = lws_now_usecs();
+	while (n >= 0 && !st.done && !interrupted &&
+	       lws_now_usecs() - t0 < 20 * LWS_US_PER_SEC)
+		n = lws_service(st.context, 0);
+
+	lws_sul_cancel(&st.sul);
+
+	if (!st.done || st.fail || (int)st.stats.blocks != count) {
+		lwsl_err("%s: %s %s: failed, %u blocks on the connection\n",
+			 __func__, modes[m].name, set_names[set],
+			 (unsigned int)st.stats.blocks);
+		return 1;
+	}
+
+	lwsl_user("%8s %9s %8d %10.1f %10.1f %7.1f%% %8u %9u %6u\n",
+		  modes[m].name, set_names[set], count,
+		  (double)st.stats.in / count, (double)st.stats.out / count,
+		  100.0 * (double)st.stats.out / (double)st.stats.in,
+		  (unsigned int)st.stats.inserts,
+		  (unsigned int)st.stats.evictions,
+		  (unsigned int)st.stats.table_size);
+
+	/* each mode must do better than the one before it */
+
+	if (ref && st.stats.out >= ref->out) {
+		lwsl_err("%s: %s %s: %llu bytes, no better than %llu\n",
+			 __func__, modes[m].name, set_names[set],
+			 (unsigned long long)st.stats.out,
+			 (unsigned long long)ref->out);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * A server vhost per mode and header set, so each run gets its own h2
+ * connection with a fresh dynamic table
+ */
+
+static int
+create_vhosts(struct lws_context_creation_info *info)
+{
+	static char names[LWS_ARRAY_SIZE(modes) * SET_COUNT][24];
+	struct lws_context_creation_info vi;
+	int m, set, n;
+
+	for (m = 0; m < (int)LWS_ARRAY_SIZE(modes); m++)
+		for (set = 0; set < SET_COUNT; set++) {
+			n = (m * SET_COUNT) + set;
+			/* lws keeps the pointer to the name */
+			lws_snprintf(names[n], sizeof(names[n]), "%s-%s",
+				     modes[m].name, set_names[set]);
+			vi = *info;
+			vi.vhost_name = names[n];
+			vi.port = port + n;
+			vi.ssl_cert_filepath = "localhost-100y.cert";
+			vi.ssl_private_key_filepath = "localhost-100y.key";
+			vi.h2_hpack_enc_table_size = modes[m].table_size;
+			if (!lws_create_vhost(st.context, &vi))
+				return 1;
+		}
+
+	vi = *info;
+	vi.vhost_name = "cli";
+	vi.port = CONTEXT_PORT_NO_LISTEN;
+	st.vh_cli = lws_create_vhost(st.context, &vi);
+
+	return !st.vh_cli;
+}
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int main(int argc, const char **argv)
+{
+	lws_h2_hpack_enc_stats_t last[SET_COUNT];
+	struct lws_context_creation_info info;
+	int m, set, ret = 0;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench hpack [-n requests] [-p port]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-n")))
+		count = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if (count < 1)
+		return 1;
+
+	signal(SIGINT, sigint_handler);
+
+	info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+		       LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	info.protocols = protocols;
+
+	st.context = lws_create_context(&info);
+	if (!st.context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	if (create_vhosts(&info)) {
+		lwsl_err("vhost creation failed\n");
+		ret = 1;
+		goto bail;
+	}
+
+	lwsl_user("%8s %9s %8s %10s %10s %8s %8s %9s %6s\n", "mode", "headers",
+		  "requests", "in B/resp", "out B/resp", "ratio", "inserts",
+		  "evictions", "table");
+
+	for (m = 0; m < (int)LWS_ARRAY_SIZE(modes) && !ret && !interrupted;
+	     m++)
+		for (set = 0; set < SET_COUNT && !ret && !interrupted; set++) {
+			ret = run_one(m, set, m ? &last[set] : NULL);
+			last[set] = st.stats;
+		}
+
+bail:
+	lws_context_destroy(st.context);
+
+	lwsl_user("Completed: %s\n", ret || interrupted ? "FAIL" : "OK");
+
+	return ret || interrupted;
+}
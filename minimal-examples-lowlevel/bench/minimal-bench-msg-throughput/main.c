@@ -0,0 +1,649 @@
+/*
+ * lws-minimal-bench-msg-throughput
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures message throughput through lws_write() on one side and the
+ * receive callback on the other, for ws, ws + permessage-deflate, h1, h2 and
+ * raw-skt, with and without tls, sweeping the message size.
+ *
+ * One context holds the server vhosts and a client connection to them, all
+ * serviced by the one thread.  For each role / tls / size, the client connects
+ * and the server writes messages of that size to it as fast as it's allowed
+ * to, using lws_write() from the WRITEABLE callback like an application would.
+ * The client times a window of -T ms from the first data it receives, then
+ * closes and the next combination starts.
+ *
+ * Results go on stdout as JSON, msgs/s and MB/s are as seen by the receiver,
+ * cpu and lws heap allocations are for the whole process, ie, both ends.
+ *
+ * With --iov, the server writes each chunk with lws_write_iov() in three
+ * pieces instead, and the client checks every byte it receives.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+#include <sys/resource.h>
+
+/* largest single lws_write(), bigger messages are sent as fragments */
+#define FRAG		65536
+/* every h2 peer must accept frames this big */
+#define H2_FRAME	16384
+
+enum {
+	ROLE_WS,
+	ROLE_WS_PMD,
+	ROLE_H1,
+	ROLE_H2,
+	ROLE_RAW,
+
+	ROLE_COUNT
+};
+
+static const char * const role_names[] = { "ws", "ws-pmd", "h1", "h2", "raw" };
+
+struct pss {
+	size_t		left;	/* server: remaining in current message */
+	char		client;
+};
+
+static struct state {
+	lws_sorted_usec_list_t	sul;
+	struct lws_vhost	*vh_cli, *vh_cli_pmd;
+	struct rusage		ru0;
+	lws_usec_t		t0, t1;
+	uint64_t		bytes;
+	uint64_t		allocs0, allocs1;
+	uint64_t		rxpos;
+	size_t			size;
+	int			role;
+	char			started, measured, done, fail;
+} st;
+
+static uint8_t txbuf[LWS_PRE + FRAG], rxbuf[LWS_PRE + 4096];
+static uint64_t allocs;
+static int port = 7990, dur_ms = 500, use_iov;
+static const char *evlib = "poll";
+static volatile int interrupted;
+
+/* counts what lws allocates, so we can report allocations per message */
+
+static void *
+counting_realloc(void *ptr, size_t size, const char *reason)
+{
+	if (!size) {
+		free(ptr);
+		return NULL;
+	}
+	if (!ptr)
+		allocs++;
+
+	return realloc(ptr, size);
+}
+
+static void
+window_start(void)
+{
+	st.started = 1;
+	st.t0 = lws_now_usecs();
+	st.allocs0 = allocs;
+	getrusage(RUSAGE_SELF, &st.ru0);
+}
+
+/*
+ * Byte o of every message is txbuf[o % FRAG], since bigger messages go as
+ * FRAG-sized pieces each sent from the start of txbuf.  h2 pieces can be cut
+ * short by the tx credit, so it can't be checked like this.
+ */
+
+static int
+rx_check(const uint8_t *in, size_t len)
+{
+	size_t n;
+
+	if (st.role == ROLE_H2)
+		return 0;
+
+	for (n = 0; n < len; n++, st.rxpos++)
+		if (in[n] != txbuf[LWS_PRE +
+				   (size_t)((st.rxpos % st.size) % FRAG)]) {
+			lwsl_err("%s: %s size %u: bad byte at %llu\n",
+				 __func__, role_names[st.role],
+				 (unsigned int)st.size,
+				 (unsigned long long)st.rxpos);
+			st.fail = 1;
+
+			return 1;
+		}
+
+	return 0;
+}
+
+/* returns nonzero when the window is over and the client should close */
+
+static int
+rx(const void *in, size_t len)
+{
+	if (!st.started)
+		window_start();
+
+	if (use_iov && rx_check((const uint8_t *)in, len))
+		return 1;
+
+	st.bytes += len;
+
+	if (lws_now_usecs() - st.t0 < (lws_usec_t)dur_ms * LWS_US_PER_MS)
+		return 0;
+
+	st.t1 = lws_now_usecs();
+	st.allocs1 = allocs;
+	st.measured = 1;
+
+	return 1;
+}
+
+static void
+sul_timeout_cb(lws_sorted_usec_list_t *sul)
+{
+	lwsl_err("%s: %s size %u timed out\n", __func__, role_names[st.role],
+		 (unsigned int)st.size);
+	st.fail = 1;
+	st.done = 1;
+}
+
+/* server side: one lws_write() of up to a fragment of the current message */
+
+static int
+send_some(struct lws *wsi, struct pss *pss)
+{
+	enum lws_write_protocol wp;
+	lws_fileofs_t allow;
+	lws_iov_t v[3];
+	size_t chunk;
+	int start, n;
+
+	start = !pss->left;
+	if (start)
+		pss->left = st.size;
+
+	chunk = pss->left > FRAG ? FRAG : pss->left;
+
+	switch (st.role) {
+	case ROLE_WS:
+	case ROLE_WS_PMD:
+		wp = (enum lws_write_protocol)lws_write_ws_flags(
+				LWS_WRITE_BINARY, start, chunk == pss->left);
+		break;
+	case ROLE_H2:
+		if (chunk > H2_FRAME)
+			chunk = H2_FRAME;
+		allow = lws_get_peer_write_allowance(wsi);
+		if (!allow) {
+			/* lws makes us WRITEABLE again when there's credit */
+			if (start)
+				pss->left = 0;
+			return 0;
+		}
+		if (allow > 0 && (size_t)allow < chunk)
+			chunk = (size_t)allow;
+		/* fallthru */
+	case ROLE_H1:
+		wp = LWS_WRITE_HTTP;
+		break;
+	default:
+		wp = LWS_WRITE_RAW;
+		break;
+	}
+
+	if (use_iov) {
+		/* the same bytes as three fragments, without LWS_PRE */
+		v[0].buf = txbuf + LWS_PRE;
+		v[0].len = chunk / 4;
+		v[1].buf = txbuf + LWS_PRE + v[0].len;
+		v[1].len = chunk / 2;
+		v[2].buf = txbuf + LWS_PRE + v[0].len + v[1].len;
+		v[2].len = chunk - v[0].len - v[1].len;
+
+		n = lws_write_iov(wsi, v, 3, wp);
+	} else
+		n = lws_write(wsi, txbuf + LWS_PRE, chunk, wp);
+	if (n < (int)chunk)
+		return -1;
+
+	pss->left -= chunk;
+	if (st.role != ROLE_H2 || lws_get_peer_write_allowance(wsi))
+		lws_callback_on_writable(wsi);
+
+	return 0;
+}
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	struct pss *pss = (struct pss *)user;
+	uint8_t hdr[LWS_PRE + 256], *start = &hdr[LWS_PRE], *p = start,
+		*end = &hdr[sizeof(hdr) - 1];
+	char *px;
+	int lenx;
+
+	switch (reason) {
+
+	/* server side */
+
+	case LWS_CALLBACK_HTTP:
+		/* a response long enough that the client always closes first */
+		if (lws_add_http_common_headers(wsi, HTTP_STATUS_OK,
+				"application/octet-stream",
+				(lws_filepos_t)1 << 40, &p, end) ||
+		    lws_finalize_write_http_header(wsi, start, &p, end))
+			return 1;
+		/* fallthru */
+	case LWS_CALLBACK_ESTABLISHED:
+		lws_callback_on_writable(wsi);
+		return 0;
+
+	case LWS_CALLBACK_HTTP_WRITEABLE:
+	case LWS_CALLBACK_SERVER_WRITEABLE:
+		return send_some(wsi, pss);
+
+	case LWS_CALLBACK_RAW_WRITEABLE:
+		if (!pss->client)
+			return send_some(wsi, pss);
+		/* raw client sends one byte to start the server sending */
+		if (lws_write(wsi, txbuf + LWS_PRE, 1, LWS_WRITE_RAW) != 1)
+			return -1;
+		return 0;
+
+	/* client side */
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: %s connection error: %s\n", __func__,
+			 role_names[st.role], in ? (const char *)in : "");
+		st.fail = 1;
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_RAW_CONNECTED:
+		/*
+		 * Raw has no request, and with tls the server can't write
+		 * until the handshake completed, so the client speaks first
+		 */
+		pss->client = 1;
+		lws_callback_on_writable(wsi);
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		px = (char *)rxbuf + LWS_PRE;
+		lenx = (int)sizeof(rxbuf) - LWS_PRE;
+		if (lws_http_client_read(wsi, &px, &lenx) < 0)
+			return -1;
+		return 0;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP_READ:
+	case LWS_CALLBACK_CLIENT_RECEIVE:
+		return rx(in, len) ? -1 : 0;
+
+	case LWS_CALLBACK_RAW_RX:
+		if (!pss->client) {
+			lws_callback_on_writable(wsi);
+			return 0;
+		}
+		return rx(in, len) ? -1 : 0;
+
+	case LWS_CALLBACK_RAW_CLOSE:
+		if (!pss->client)
+			break;
+		/* fallthru */
+	case LWS_CALLBACK_CLIENT_CLOSED:
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		if (!st.measured) {
+			lwsl_err("%s: %s closed early\n", __func__,
+				 role_names[st.role]);
+			st.fail = 1;
+		}
+		st.done = 1;
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-tp", callback_bench, sizeof(struct pss), 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+static const struct lws_extension extensions[] = {
+	{
+		"permessage-deflate",
+		lws_extension_callback_pm_deflate,
+		"permessage-deflate"
+		 "; client_no_context_takeover"
+		 "; client_max_window_bits"
+	},
+	{ NULL, NULL, NULL /* terminator */ }
+};
+#endif
+
+static int
+role_available(int role, int tls)
+{
+	switch (role) {
+	case ROLE_WS:
+#if defined(LWS_ROLE_WS)
+		return 1;
+#else
+		return 0;
+#endif
+	case ROLE_WS_PMD:
+#if defined(LWS_ROLE_WS) && !defined(LWS_WITHOUT_EXTENSIONS)
+		return 1;
+#else
+		return 0;
+#endif
+	case ROLE_H1:
+		return 1;
+	case ROLE_H2:
+		/* the lws client only does h2 negotiated by tls alpn */
+#if defined(LWS_ROLE_H2)
+		return tls;
+#else
+		return 0;
+#endif
+	default:
+		return 1;
+	}
+}
+
+static int
+run_one(struct lws_context *context, int role, int tls, size_t size,
+	FILE *json, int *first)
+{
+	struct lws_client_connect_info i;
+	double secs, msgs, cpu_us;
+	struct rusage ru1;
+	int n = 0;
+
+	memset(&st.sul, 0, sizeof(st.sul));
+	st.bytes = 0;
+	st.rxpos = 0;
+	st.size = size;
+	st.role = role;
+	st.started = st.measured = st.done = st.fail = 0;
+
+	memset(&i, 0, sizeof(i));
+	i.context		= context;
+	i.vhost			= role == ROLE_WS_PMD ? st.vh_cli_pmd : st.vh_cli;
+	i.address		= "localhost";
+	i.host			= i.address;
+	i.origin		= i.address;
+	i.path			= "/";
+	i.local_protocol_name	= "bench-tp";
+	i.port			= port + (role == ROLE_RAW ? 2 : 0) + tls;
+
+	if (tls)
+		i.ssl_connection = LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED |
+				   LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK;
+
+	switch (role) {
+	case ROLE_WS:
+	case ROLE_WS_PMD:
+		i.protocol = "bench-tp";
+		i.alpn = "http/1.1";
+		break;
+	case ROLE_H1:
+		i.method = "GET";
+		i.alpn = "http/1.1";
+		break;
+	case ROLE_H2:
+		i.method = "GET";
+		i.alpn = "h2";
+		break;
+	default:
+		i.method = "RAW";
+		break;
+	}
+
+	lws_sul_schedule(context, 0, &st.sul, sul_timeout_cb,
+			 ((lws_usec_t)dur_ms * LWS_US_PER_MS) +
+						(10 * LWS_US_PER_SEC));
+
+	if (!lws_client_connect_via_info(&i)) {
+		lws_sul_cancel(&st.sul);
+		return 1;
+	}
+
+	while (n >= 0 && !st.done && !interrupted)
+		n = lws_service(context, 0);
+
+	lws_sul_cancel(&st.sul);
+
+	if (st.fail || !st.measured)
+		return 1;
+
+	getrusage(RUSAGE_SELF, &ru1);
+
+	secs = (double)(st.t1 - st.t0) / 1000000.0;
+	msgs = (double)st.bytes / (double)size;
+	cpu_us = (double)((ru1.ru_utime.tv_sec - st.ru0.ru_utime.tv_sec) +
+			  (ru1.ru_stime.tv_sec - st.ru0.ru_stime.tv_sec)) *
+								1000000.0 +
+		 (double)((ru1.ru_utime.tv_usec - st.ru0.ru_utime.tv_usec) +
+			  (ru1.ru_stime.tv_usec - st.ru0.ru_stime.tv_usec));
+
+	lwsl_user("%6s %4s %9u %12.0f %10.2f %10.3f %10.3f\n",
+		  role_names[role], tls ? "tls" : "-", (unsigned int)size,
+		  msgs / secs, (double)st.bytes / secs / 1000000.0,
+		  cpu_us / msgs, (double)(st.allocs1 - st.allocs0) / msgs);
+
+	fprintf(json, "%s\n\t\t{ \"role\": \"%s\", \"tls\": %s, "
+		"\"size\": %u, \"msgs_per_s\": %.1f, \"mb_per_s\": %.3f, "
+		"\"cpu_us_per_msg\": %.4f, \"allocs_per_msg\": %.4f }",
+		*first ? "" : ",", role_names[role], tls ? "true" : "false",
+		(unsigned int)size, msgs / secs,
+		(double)st.bytes / secs / 1000000.0, cpu_us / msgs,
+		(double)(st.allocs1 - st.allocs0) / msgs);
+	*first = 0;
+
+	return 0;
+}
+
+static int
+create_vhosts(struct lws_context *context,
+	      struct lws_context_creation_info *info)
+{
+	struct lws_context_creation_info vi;
+	int tls;
+
+	for (tls = 0; tls < 2; tls++) {
+#if !defined(LWS_WITH_TLS)
+		if (tls)
+			break;
+#endif
+		vi = *info;
+		vi.vhost_name = tls ? "srv-tls" : "srv";
+		vi.port = port + tls;
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+		vi.extensions = extensions;
+#endif
+		if (tls) {
+			vi.ssl_cert_filepath = "localhost-100y.cert";
+			vi.ssl_private_key_filepath = "localhost-100y.key";
+		}
+		if (!lws_create_vhost(context, &vi))
+			return 1;
+
+		vi.vhost_name = tls ? "raw-tls" : "raw";
+		vi.port = port + 2 + tls;
+		vi.options |= LWS_SERVER_OPTION_ADOPT_APPLY_LISTEN_ACCEPT_CONFIG;
+		vi.listen_accept_role = "raw-skt";
+		vi.listen_accept_protocol = "bench-tp";
+		if (!lws_create_vhost(context, &vi))
+			return 1;
+	}
+
+	vi = *info;
+	vi.vhost_name = "cli";
+	vi.port = CONTEXT_PORT_NO_LISTEN;
+	st.vh_cli = lws_create_vhost(context, &vi);
+	if (!st.vh_cli)
+		return 1;
+
+#if !defined(LWS_WITHOUT_EXTENSIONS)
+	vi.vhost_name = "cli-pmd";
+	vi.extensions = extensions;
+	st.vh_cli_pmd = lws_create_vhost(context, &vi);
+	if (!st.vh_cli_pmd)
+		return 1;
+#endif
+
+	return 0;
+}
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int main(int argc, const char **argv)
+{
+	size_t size, size_min = 16, size_max = 16 * 1024 * 1024, step = 4;
+	int role, tls, tls_from = 0, tls_to = 1, first = 1, ret = 0;
+	struct lws_context_creation_info info;
+	unsigned int roles = (1u << ROLE_COUNT) - 1;
+	struct lws_context *context;
+	FILE *json = stdout;
+	const char *p;
+	uint32_t r = 0x12345678;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench msg throughput [-r ws,ws-pmd,h1,h2,raw] "
+		  "[--plain] [--tls] [--min size] [--max size] [--step n] "
+		  "[-T ms] [-p port] [-o file.json] [--epoll] [--uring] "
+		  "[--iov]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-r"))) {
+		roles = 0;
+		for (role = 0; role < ROLE_COUNT; role++) {
+			const char *q = p;
+			size_t l = strlen(role_names[role]);
+
+			while ((q = strstr(q, role_names[role]))) {
+				if ((q == p || q[-1] == ',') &&
+				    (q[l] == ',' || !q[l]))
+					roles |= 1u << role;
+				q += l;
+			}
+		}
+	}
+	if (lws_cmdline_option(argc, argv, "--plain"))
+		tls_to = 0;
+	if (lws_cmdline_option(argc, argv, "--tls"))
+		tls_from = 1;
+#if !defined(LWS_WITH_TLS)
+	tls_to = 0;
+#endif
+	if ((p = lws_cmdline_option(argc, argv, "--min")))
+		size_min = (size_t)atol(p);
+	if ((p = lws_cmdline_option(argc, argv, "--max")))
+		size_max = (size_t)atol(p);
+	if ((p = lws_cmdline_option(argc, argv, "--step")))
+		step = (size_t)atol(p);
+	if ((p = lws_cmdline_option(argc, argv, "-T")))
+		dur_ms = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	use_iov = !!lws_cmdline_option(argc, argv, "--iov");
+
+	if (!roles || tls_from > tls_to || !size_min || size_min > size_max ||
+	    step < 2 || dur_ms < 1)
+		return 1;
+
+	if ((p = lws_cmdline_option(argc, argv, "-o"))) {
+		json = fopen(p, "w");
+		if (!json) {
+			lwsl_err("can't open %s\n", p);
+			return 1;
+		}
+	}
+
+	/* somewhat compressible, so pmd has some work to do */
+	for (size = 0; size < FRAG; size++) {
+		r = r * 1103515245 + 12345;
+		txbuf[LWS_PRE + size] = (uint8_t)('a' + ((r >> 16) & 31));
+	}
+
+	signal(SIGINT, sigint_handler);
+	signal(SIGPIPE, SIG_IGN);
+
+	lws_set_allocator(counting_realloc);
+
+	info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+		       LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	if (lws_cmdline_option(argc, argv, "--epoll")) {
+		info.options |= LWS_SERVER_OPTION_EPOLL;
+		evlib = "epoll";
+	}
+	if (lws_cmdline_option(argc, argv, "--uring")) {
+		info.options |= LWS_SERVER_OPTION_IO_URING;
+		evlib = "uring";
+	}
+	info.protocols = protocols;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	if (create_vhosts(context, &info)) {
+		lwsl_err("vhost creation failed\n");
+		ret = 1;
+		goto bail;
+	}
+
+	lwsl_user("%6s %4s %9s %12s %10s %10s %10s\n", "role", "tls", "size",
+		  "msgs/s", "MB/s", "cpu us/msg", "allocs/msg");
+
+	fprintf(json, "{\n\t\"lws\": \"%s\",\n\t\"evlib\": \"%s\",\n"
+		"\t\"iov\": %s,\n\t\"window_ms\": %d,\n\t\"results\": [",
+		lws_get_library_version(), evlib, use_iov ? "true" : "false",
+		dur_ms);
+
+	for (role = 0; role < ROLE_COUNT && !ret && !interrupted; role++) {
+		if (!(roles & (1u << role)))
+			continue;
+		for (tls = tls_from; tls <= tls_to && !ret && !interrupted;
+		     tls++) {
+			if (!role_available(role, tls))
+				continue;
+			for (size = size_min; size <= size_max && !ret &&
+					      !interrupted; size *= step)
+				ret = run_one(context, role, tls, size, json,
+					      &first);
+		}
+	}
+
+	fprintf(json, "\n\t]\n}\n");
+
+bail:
+	lws_context_destroy(context);
+	if (json != stdout)
+		fclose(json);
+
+	lwsl_user("Completed: %s\n", ret || interrupted ? "FAIL" : "OK");
+
+	return ret || interrupted;
+}
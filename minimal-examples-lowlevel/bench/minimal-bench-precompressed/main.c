@@ -0,0 +1,664 @@
+/*
+ * lws-minimal-bench-precompressed
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures serving a set of small static files from a file:// mount to a
+ * client that accepts compression, compressed on the fly for each response,
+ * against sent from file.br / file.gz siblings that the mount made in the
+ * background with precompress_generate.
+ *
+ * One context holds two tls h2 server vhosts mounting the same directory of
+ * generated css files, one normal and one with precompressed and
+ * precompress_generate set on the mount, and an lws client, all serviced by
+ * the one thread.  For each run the client makes -n requests one after
+ * another on one h2 connection, going round the files.
+ *
+ * Before the precompressed run, the client asks once for each file, then we
+ * wait for the siblings to appear.  Then a file is replaced by an older
+ * version, which must be sent as it is until its siblings are remade.
+ * Finally a Range request to the precompressed vhost must get the
+ * uncompressed bytes.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <signal.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <utime.h>
+
+#define FILES		64
+#define RANGE_LEN	100
+
+static const struct run {
+	const char	*name;
+	int		vh;
+	char		enc;	/* say we accept gzip, deflate, br */
+} runs[] = {
+	{ "identity",	0, 0 },
+	{ "on-the-fly",	0, 1 },
+	{ "precomp",	1, 1 },
+};
+
+static struct file {
+	size_t		len;
+	uint32_t	hash;
+	uint32_t	head_hash; /* of the first RANGE_LEN bytes */
+} files[FILES];
+
+static struct state {
+	lws_sorted_usec_list_t	sul;
+	struct lws_context	*context;
+	struct lws_vhost	*vh_cli;
+	const struct run	*run;
+	uint64_t		body;
+	int			issued;
+	int			completed;
+	int			want; /* requests to make */
+	int			encoded;
+	char			range;
+	char			done, fail;
+} st;
+
+struct pss {
+	uint32_t		hash;
+	size_t			len;
+	char			completed;
+};
+
+static const char * const sfx[] = { "", ".gz", ".br" };
+static int port = 7750, count = 10000;
+static char dir[128];
+static volatile int interrupted;
+
+static uint32_t
+fnv1a(uint32_t h, const uint8_t *p, size_t len)
+{
+	while (len--)
+		h = (h ^ *p++) * 0x01000193;
+
+	return h;
+}
+
+/* some plausible, compressible css */
+
+static int
+write_file(int n)
+{
+	size_t want = 512 + (((size_t)n * 7919) % 24000), len = 0, l;
+	uint32_t h = 0x811c9dc5;
+	char path[256], line[128];
+	uint8_t head[RANGE_LEN];
+	int m = 0;
+	FILE *f;
+
+	lws_snprintf(path, sizeof(path), "%s/f%02d.css", dir, n);
+	f = fopen(path, "w");
+	if (!f)
+		return 1;
+
+	while (len < want) {
+		l = (size_t)lws_snprintf(line, sizeof(line), ".c%d-%d { margin: "
+				 "%dpx %dpx; color: #%06x; }\n", n, m,
+				 m % 17, m % 5, ((unsigned int)m * 2654435761u)
+							& 0xffffff);
+		if (fwrite(line, 1, l, f) != l) {
+			fclose(f);
+			return 1;
+		}
+		if (len < RANGE_LEN)
+			memcpy(head + len, line, len + l > RANGE_LEN ?
+						 RANGE_LEN - len : l);
+		h = fnv1a(h, (uint8_t *)line, l);
+		len += l;
+		m++;
+	}
+
+	files[n].len = len;
+	files[n].hash = h;
+	files[n].head_hash = fnv1a(0x811c9dc5, head, RANGE_LEN);
+
+	return fclose(f);
+}
+
+static void
+remove_files(void)
+{
+	char path[256];
+	size_t s;
+	int n;
+
+	for (n = 0; n < FILES; n++)
+		for (s = 0; s < LWS_ARRAY_SIZE(sfx); s++) {
+			lws_snprintf(path, sizeof(path), "%s/f%02d.css%s", dir,
+				     n, sfx[s]);
+			unlink(path);
+		}
+	rmdir(dir);
+}
+
+/* how many files have a .gz sibling yet */
+
+static int
+count_siblings(void)
+{
+	char path[256];
+	struct stat s;
+	int n, c = 0;
+
+	for (n = 0; n < FILES; n++) {
+		lws_snprintf(path, sizeof(path), "%s/f%02d.css.gz", dir, n);
+		if (!stat(path, &s))
+			c++;
+	}
+
+	return c;
+}
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul);
+
+static int
+check_response(struct lws *wsi, struct pss *pss, int f)
+{
+	int status = (int)lws_http_client_http_response(wsi);
+	char ce[16];
+
+	if (st.run->vh && lws_hdr_total_length(wsi, WSI_TOKEN_HTTP_VARY) <= 0) {
+		lwsl_err("%s: f%02d: no vary\n", __func__, f);
+		return 1;
+	}
+
+	if (st.range) {
+		/* ranges are of the file itself, never compressed */
+		if (status != 206 ||
+		    lws_hdr_total_length(wsi,
+				WSI_TOKEN_HTTP_CONTENT_ENCODING) > 0 ||
+		    pss->len != RANGE_LEN || pss->hash != files[f].head_hash) {
+			lwsl_err("%s: f%02d: bad range response %d, %u bytes\n",
+				 __func__, f, status, (unsigned int)pss->len);
+			return 1;
+		}
+
+		return 0;
+	}
+
+	if (status != 200) {
+		lwsl_err("%s: f%02d: response %d\n", __func__, f, status);
+		return 1;
+	}
+
+	if (lws_hdr_copy(wsi, ce, sizeof(ce),
+			 WSI_TOKEN_HTTP_CONTENT_ENCODING) > 0) {
+		/* we can't check it, but it should be smaller */
+		if (!st.run->enc || pss->len >= files[f].len) {
+			lwsl_err("%s: f%02d: %s, %u bytes\n", __func__,
+				 f, ce, (unsigned int)pss->len);
+			return 1;
+		}
+		st.encoded++;
+
+		return 0;
+	}
+
+	if (pss->len != files[f].len || pss->hash != files[f].hash) {
+		lwsl_err("%s: f%02d: wrong content, %u bytes\n",
+			 __func__, f, (unsigned int)pss->len);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int
+callback_bench(struct lws *wsi, enum lws_callback_reasons reason,
+	       void *user, void *in, size_t len)
+{
+	int f = (int)(intptr_t)lws_get_opaque_user_data(wsi) % FILES;
+	uint8_t buf[LWS_PRE + 4096];
+	struct pss *pss = (struct pss *)user;
+	unsigned char **p = (unsigned char **)in;
+	char *px;
+	int lenx;
+
+	switch (reason) {
+
+	case LWS_CALLBACK_CLIENT_CONNECTION_ERROR:
+		lwsl_err("%s: connection error: %s\n", __func__,
+			 in ? (const char *)in : "");
+		st.fail = 1;
+		st.done = 1;
+		break;
+
+	case LWS_CALLBACK_CLIENT_APPEND_HANDSHAKE_HEADER:
+		if (st.run && st.run->enc &&
+		    lws_add_http_header_by_token(wsi,
+				WSI_TOKEN_HTTP_ACCEPT_ENCODING,
+				(unsigned char *)"gzip, deflate, br", 17, p,
+				(*p) + len))
+			return -1;
+		if (st.range &&
+		    lws_add_http_header_by_token(wsi, WSI_TOKEN_HTTP_RANGE,
+				(unsigned char *)"bytes=0-99", 10, p,
+				(*p) + len))
+			return -1;
+		break;
+
+	case LWS_CALLBACK_ESTABLISHED_CLIENT_HTTP:
+		pss->hash = 0x811c9dc5;
+		pss->len = 0;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP_READ:
+		pss->hash = fnv1a(pss->hash, in, len);
+		pss->len += len;
+		st.body += len;
+		break;
+
+	case LWS_CALLBACK_RECEIVE_CLIENT_HTTP:
+		px = (char *)buf + LWS_PRE;
+		lenx = (int)sizeof(buf) - LWS_PRE;
+		if (lws_http_client_read(wsi, &px, &lenx) < 0)
+			return -1;
+		return 0;
+
+	case LWS_CALLBACK_COMPLETED_CLIENT_HTTP:
+		pss->completed = 1;
+
+		if (check_response(wsi, pss, f))
+			st.fail = 1;
+
+		if (++st.completed == st.want || st.fail)
+			st.done = 1;
+		else
+			/* the next one goes on the same h2 connection */
+			lws_sul_schedule(st.context, 0, &st.sul, sul_next_cb, 1);
+		break;
+
+	case LWS_CALLBACK_CLOSED_CLIENT_HTTP:
+		if (pss && !pss->completed && !st.done) {
+			lwsl_err("%s: closed early\n", __func__);
+			st.fail = 1;
+			st.done = 1;
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return lws_callback_http_dummy(wsi, reason, user, in, len);
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "bench-precompressed", callback_bench, sizeof(struct pss), 0, 0,
+	  NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+static void
+sul_next_cb(lws_sorted_usec_list_t *sul)
+{
+	struct lws_client_connect_info i;
+	char path[16];
+
+	lws_snprintf(path, sizeof(path), "/f%02d.css", st.issued % FILES);
+
+	memset(&i, 0, sizeof(i));
+	i.context		= st.context;
+	i.vhost			= st.vh_cli;
+	i.address		= "localhost";
+	i.host			= i.address;
+	i.origin		= i.address;
+	i.port			= port + st.run->vh;
+	i.path			= path;
+	i.method		= "GET";
+	i.alpn			= "h2";
+	i.local_protocol_name	= protocols[0].name;
+	i.opaque_user_data	= (void *)(intptr_t)st.issued;
+	i.ssl_connection	= LCCSCF_USE_SSL | LCCSCF_ALLOW_SELFSIGNED |
+				  LCCSCF_SKIP_SERVER_CERT_HOSTNAME_CHECK |
+				  LCCSCF_PIPELINE;
+
+	st.issued++;
+	if (!lws_client_connect_via_info(&i)) {
+		lwsl_err("%s: connect failed\n", __func__);
+		st.fail = 1;
+		st.done = 1;
+	}
+}
+
+static int
+run_requests(const struct run *r, int first, int want, lws_usec_t *us)
+{
+	lws_usec_t t0;
+	int n = 0;
+
+	memset(&st.sul, 0, sizeof(st.sul));
+	st.run = r;
+	st.issued = first;
+	st.completed = 0;
+	st.want = want;
+	st.encoded = 0;
+	st.body = 0;
+	st.done = st.fail = 0;
+
+	t0 = lws_now_usecs();
+	sul_next_cb(&st.sul);
+
+	while (n >= 0 && !st.done && !interrupted &&
+	       lws_now_usecs() - t0 < 30 * LWS_US_PER_SEC)
+		n = lws_service(st.context, 0);
+
+	*us = lws_now_usecs() - t0;
+	lws_sul_cancel(&st.sul);
+
+	if (!st.done || st.fail) {
+		lwsl_err("%s: %s: failed\n", __func__, r->name);
+		return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * Ask the precompressed vhost for each file once, they get served however
+ * they can be while the siblings are made in the background
+ */
+
+static int
+make_siblings(void)
+{
+	lws_usec_t us, t0;
+	int n = 0;
+
+	if (run_requests(&runs[2], 0, FILES, &us))
+		return 1;
+
+	t0 = lws_now_usecs();
+	while (n >= 0 && !interrupted && count_siblings() != FILES &&
+	       lws_now_usecs() - t0 < 10 * LWS_US_PER_SEC)
+		n = lws_service(st.context, 10);
+
+	if (count_siblings() != FILES) {
+		lwsl_err("%s: only %d of %d siblings made\n", __func__,
+			 count_siblings(), FILES);
+		return 1;
+	}
+
+	lwsl_user("%10s: %d made in %.1fms\n", "siblings", FILES,
+		  (double)(lws_now_usecs() - t0) / LWS_US_PER_MS);
+
+	return 0;
+}
+
+static int
+run_one(const struct run *r)
+{
+	lws_usec_t us;
+
+	if (run_requests(r, 0, count, &us))
+		return 1;
+
+	lwsl_user("%10s %8d %10.0f %8.1f %10.0f %8d\n", r->name, count,
+		  (double)count * LWS_US_PER_SEC / (double)us,
+		  (double)us / count, (double)st.body / count, st.encoded);
+
+	if (r->enc && st.encoded != count) {
+		lwsl_err("%s: %s: only %d of %d compressed\n", __func__,
+			 r->name, st.encoded, count);
+		return 1;
+	}
+
+	return 0;
+}
+
+/* wait for f00's .gz sibling to have f00's mtime */
+
+static int
+wait_remade(void)
+{
+	char path[256], sib[256];
+	struct stat s, ss;
+	lws_usec_t t0;
+	int n = 0;
+
+	lws_snprintf(path, sizeof(path), "%s/f00.css", dir);
+	lws_snprintf(sib, sizeof(sib), "%s.gz", path);
+	if (stat(path, &s))
+		return 1;
+
+	t0 = lws_now_usecs();
+	while (n >= 0 && !interrupted &&
+	       lws_now_usecs() - t0 < 10 * LWS_US_PER_SEC) {
+		if (!stat(sib, &ss) && ss.st_mtime == s.st_mtime)
+			return 0;
+		n = lws_service(st.context, 10);
+	}
+
+	return 1;
+}
+
+/* the size of the sibling of f00 lws would send, or -1 */
+
+static long
+sibling_len(void)
+{
+	char path[256];
+	struct stat s;
+	int n;
+
+	for (n = LWS_ARRAY_SIZE(sfx) - 1; n; n--) {
+		lws_snprintf(path, sizeof(path), "%s/f00.css%s", dir, sfx[n]);
+		if (!stat(path, &s))
+			return (long)s.st_size;
+	}
+
+	return -1;
+}
+
+/*
+ * Put f01's content in f00 with an mtime older than f00's siblings, like
+ * rsync -t of an older version would.  The siblings aren't of it, so they
+ * mustn't be sent for it (it's still compressed on the fly), then it must get
+ * new ones.  We can't decompress here, so we tell by the size
+ */
+
+static int
+run_stale(void)
+{
+	char from[256], to[256], buf[4096];
+	struct utimbuf ut;
+	FILE *fi, *fo;
+	lws_usec_t us;
+	long old = sibling_len();
+	size_t l;
+
+	lws_snprintf(from, sizeof(from), "%s/f01.css", dir);
+	lws_snprintf(to, sizeof(to), "%s/f00.css", dir);
+	fi = fopen(from, "r");
+	if (!fi)
+		return 1;
+	fo = fopen(to, "w");
+	if (!fo) {
+		fclose(fi);
+		return 1;
+	}
+	while ((l = fread(buf, 1, sizeof(buf), fi)) > 0)
+		if (fwrite(buf, 1, l, fo) != l)
+			break;
+	fclose(fi);
+	if (fclose(fo))
+		return 1;
+
+	ut.actime = ut.modtime = time(NULL) - 3600;
+	if (utime(to, &ut))
+		return 1;
+	files[0] = files[1];
+
+	if (run_requests(&runs[2], 0, 1, &us))
+		return 1;
+	if ((long)st.body == old) {
+		lwsl_err("%s: older file sent with its newer siblings\n",
+			 __func__);
+		return 1;
+	}
+
+	if (wait_remade()) {
+		lwsl_err("%s: siblings not remade\n", __func__);
+		return 1;
+	}
+
+	if (run_requests(&runs[2], 0, 1, &us) ||
+	    (long)st.body != sibling_len()) {
+		lwsl_err("%s: remade siblings not used\n", __func__);
+		return 1;
+	}
+
+	lwsl_user("%10s: older file not sent its siblings, they were remade\n",
+		  "stale");
+
+	return 0;
+}
+
+#if defined(LWS_WITH_RANGES)
+/* without ranges support, lws serves the whole file with a 200 */
+
+static int
+run_range(void)
+{
+	lws_usec_t us;
+	int ret;
+
+	st.range = 1;
+	ret = run_requests(&runs[2], 1, 1, &us);
+	st.range = 0;
+
+	if (!ret)
+		lwsl_user("%10s: uncompressed bytes for a range\n", "range");
+
+	return ret;
+}
+#endif
+
+static int
+create_vhosts(struct lws_context_creation_info *info)
+{
+	static struct lws_http_mount mount[2];
+	struct lws_context_creation_info vi;
+	int n;
+
+	for (n = 0; n < 2; n++) {
+		memset(&mount[n], 0, sizeof(mount[n]));
+		mount[n].mountpoint		= "/";
+		mount[n].mountpoint_len		= 1;
+		mount[n].origin			= dir;
+		mount[n].origin_protocol	= LWSMPRO_FILE;
+		mount[n].precompressed		= !!n;
+		mount[n].precompress_generate	= !!n;
+
+		vi = *info;
+		vi.vhost_name = n ? "precomp" : "plain";
+		vi.port = port + n;
+		vi.ssl_cert_filepath = "localhost-100y.cert";
+		vi.ssl_private_key_filepath = "localhost-100y.key";
+		vi.mounts = &mount[n];
+		if (!lws_create_vhost(st.context, &vi))
+			return 1;
+	}
+
+	vi = *info;
+	vi.vhost_name = "cli";
+	vi.port = CONTEXT_PORT_NO_LISTEN;
+	st.vh_cli = lws_create_vhost(st.context, &vi);
+
+	return !st.vh_cli;
+}
+
+static void
+sigint_handler(int sig)
+{
+	interrupted = 1;
+}
+
+int main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	int n, ret = 0;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench precompressed [-n requests] [-p port]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-n")))
+		count = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+	if (count < FILES)
+		count = FILES;
+
+	lws_snprintf(dir, sizeof(dir), "/tmp/lws-bench-precompressed-%d",
+		     (int)getpid());
+	if (mkdir(dir, 0700)) {
+		lwsl_err("unable to create %s\n", dir);
+		return 1;
+	}
+	for (n = 0; n < FILES; n++)
+		if (write_file(n)) {
+			lwsl_err("unable to write files in %s\n", dir);
+			remove_files();
+			return 1;
+		}
+
+	signal(SIGINT, sigint_handler);
+
+	info.options = LWS_SERVER_OPTION_EXPLICIT_VHOSTS |
+		       LWS_SERVER_OPTION_DO_SSL_GLOBAL_INIT;
+	info.protocols = protocols;
+
+	st.context = lws_create_context(&info);
+	if (!st.context) {
+		lwsl_err("lws init failed\n");
+		remove_files();
+		return 1;
+	}
+
+	if (create_vhosts(&info)) {
+		lwsl_err("vhost creation failed\n");
+		ret = 1;
+		goto bail;
+	}
+
+	lwsl_user("%10s %8s %10s %8s %10s %8s\n", "run", "reqs", "req/s",
+		  "us/req", "body B", "enc");
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(runs) && !ret && !interrupted; n++) {
+		if (runs[n].vh)
+			ret = make_siblings();
+		if (!ret)
+			ret = run_one(&runs[n]);
+	}
+
+	if (!ret && !interrupted)
+		ret = run_stale();
+
+#if defined(LWS_WITH_RANGES)
+	if (!ret && !interrupted)
+		ret = run_range();
+#endif
+
+bail:
+	lws_context_destroy(st.context);
+	remove_files();
+
+	lwsl_user("Completed: %s\n", ret || interrupted ? "FAIL" : "OK");
+
+	return ret || interrupted;
+}
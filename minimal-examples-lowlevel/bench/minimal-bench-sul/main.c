@@ -0,0 +1,204 @@
+/*
+ * lws-minimal-bench-sul
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures the cost of scheduling and rescheduling lws_sul timers as the
+ * number of pending timers on the pt grows.
+ *
+ * First a shorter run checks the ordering guarantee: a few thousand sul on
+ * both the normal and wake-suspend owners, some rescheduled and some
+ * cancelled, must all fire no earlier than their due time and strictly in
+ * order of due time across both owners.
+ *
+ * Then for each step we add sul with delays spread over 1s .. 300s, like
+ * the timeout and validity timers of a large number of connections, and
+ * time how long it takes to reschedule random ones of them to new random
+ * delays, as happens whenever connection traffic resets its timeout.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+
+struct bsul {
+	lws_sorted_usec_list_t	sul;
+	lws_usec_t		due;
+};
+
+static struct lws_context *context;
+static struct bsul *bs;
+static lws_usec_t last_due;
+static uint64_t rng = 0x2545F4914F6CDD1Dull;
+static int fired, expected, fail;
+
+static uint32_t
+rnd(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 7;
+	rng ^= rng << 17;
+
+	return (uint32_t)(rng >> 16);
+}
+
+static void
+sul_check_cb(lws_sorted_usec_list_t *sul)
+{
+	struct bsul *b = lws_container_of(sul, struct bsul, sul);
+
+	if (lws_now_usecs() < b->due) {
+		lwsl_err("%s: fired %lldus early\n", __func__,
+			 (long long)(b->due - lws_now_usecs()));
+		fail = 1;
+	}
+	if (b->due < last_due) {
+		lwsl_err("%s: fired out of order\n", __func__);
+		fail = 1;
+	}
+
+	last_due = b->due;
+	if (++fired == expected)
+		/* don't sit in poll() until some unrelated sul is due */
+		lws_cancel_service(context);
+}
+
+static void
+sul_bench_cb(lws_sorted_usec_list_t *sul)
+{
+	/* the bench timers are far in the future, they never fire */
+	fail = 1;
+}
+
+static void
+sched(struct lws_context *cx, struct bsul *b, sul_cb_t cb, lws_usec_t us,
+      int wake)
+{
+	if (wake)
+		lws_sul_schedule_wakesuspend(cx, 0, &b->sul, cb, us);
+	else
+		lws_sul_schedule(cx, 0, &b->sul, cb, us);
+
+	/*
+	 * Take the due time lws computed, a separate lws_now_usecs() here can
+	 * differ by 1us and make close timers look out of order
+	 */
+	b->due = b->sul.us;
+}
+
+static int
+check_order(struct lws_context *cx, int count)
+{
+	lws_usec_t deadline;
+	int n;
+
+	expected = count;
+
+	for (n = 0; n < count; n++)
+		sched(cx, &bs[n], sul_check_cb,
+		      (lws_usec_t)(rnd() % 1500) * LWS_US_PER_MS +
+						(lws_usec_t)(rnd() % 1000),
+		      !(n & 7));
+
+	/* move some, cancel some */
+
+	for (n = 0; n < count; n += 5)
+		sched(cx, &bs[n], sul_check_cb,
+		      (lws_usec_t)(rnd() % 1500) * LWS_US_PER_MS, !(n & 3));
+
+	for (n = 3; n < count; n += 17) {
+		lws_sul_cancel(&bs[n].sul);
+		expected--;
+	}
+
+	deadline = lws_now_usecs() + 5 * LWS_US_PER_SEC;
+	while (fired < expected && !fail && lws_now_usecs() < deadline)
+		if (lws_service(cx, 0) < 0)
+			return 1;
+
+	if (fired != expected) {
+		lwsl_err("%s: %d of %d fired\n", __func__, fired, expected);
+		return 1;
+	}
+
+	return fail;
+}
+
+int main(int argc, const char **argv)
+{
+	static const int steps[] = { 1000, 10000, 100000, 1000000 };
+	int count = 100000, resched = 100000, check = 5000, n, m = 0, s;
+	struct lws_context_creation_info info;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench sul [-n max timers] [-r reschedules] [-c check timers]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-n")))
+		count = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-r")))
+		resched = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-c")))
+		check = atoi(p);
+
+	info.port = CONTEXT_PORT_NO_LISTEN_SERVER;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+
+	bs = calloc((size_t)(count > check ? count : check), sizeof(*bs));
+	if (!bs)
+		goto bail;
+
+	if (check_order(context, check)) {
+		fail = 1;
+		goto bail;
+	}
+	lwsl_user("ordering check of %d timers OK\n", check);
+
+	lwsl_user("%10s %14s %14s\n", "timers", "ns / sched", "ns / resched");
+
+	for (s = 0; s < (int)LWS_ARRAY_SIZE(steps) && steps[s] <= count &&
+								!fail; s++) {
+		lws_usec_t t, t1;
+		int added = steps[s] - m;
+
+		t = lws_now_usecs();
+		while (m < steps[s])
+			sched(context, &bs[m++], sul_bench_cb,
+			      (lws_usec_t)(1000 + rnd() % 299000) *
+							LWS_US_PER_MS, 0);
+		t = lws_now_usecs() - t;
+
+		t1 = lws_now_usecs();
+		for (n = 0; n < resched; n++)
+			sched(context, &bs[rnd() % (uint32_t)m], sul_bench_cb,
+			      (lws_usec_t)(1000 + rnd() % 299000) *
+							LWS_US_PER_MS, 0);
+		t1 = lws_now_usecs() - t1;
+
+		lwsl_user("%10d %14.1f %14.1f\n", m,
+			  (double)t * 1000.0 / (double)added,
+			  (double)t1 * 1000.0 / (double)resched);
+	}
+
+bail:
+	if (bs) {
+		for (n = 0; n < (m > check ? m : check); n++)
+			lws_sul_cancel(&bs[n].sul);
+		free(bs);
+	}
+
+	lws_context_destroy(context);
+
+	lwsl_user("Completed: %s\n", fail ? "FAIL" : "OK");
+
+	return fail;
+}
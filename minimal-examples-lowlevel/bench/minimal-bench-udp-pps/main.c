@@ -0,0 +1,242 @@
+/*
+ * lws-minimal-bench-udp-pps
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Measures small datagram throughput over loopback between two lws UDP wsi
+ * on the same service thread, first one datagram per syscall and callback
+ * using lws_write() and LWS_CALLBACK_RAW_RX, then batched using
+ * lws_udp_write_batch() and LWS_CAUDP_BATCH_RX / LWS_CALLBACK_RAW_RX_BATCH.
+ *
+ * The sender keeps up to WINDOW datagrams in flight so the loopback socket
+ * buffer never overflows; if any do get lost, the stall is noticed and they
+ * are counted as lost.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+
+#define WINDOW		64
+#define MAX_PAYLOAD	1400
+
+struct run {
+	const char		*name;
+	struct lws		*rx;
+	struct lws		*tx;
+	uint64_t		sent;
+	uint64_t		rcvd;
+	uint64_t		rx_cbs;
+	uint64_t		lost;
+	uint64_t		bad;
+	uint64_t		last_rcvd;
+	int			flags;
+	char			stop;
+};
+
+static struct run runs[] = {
+	{ .name = "single" },
+	{ .name = "batched", .flags = LWS_CAUDP_BATCH_RX },
+};
+
+static uint8_t payload[LWS_PRE + MAX_PAYLOAD];
+static lws_sorted_usec_list_t sul_stall;
+static struct lws_context *context;
+static struct run *cur;
+static size_t plen = 64;
+
+static void
+refill(struct run *r)
+{
+	if (!r->stop && r->sent - r->rcvd <= WINDOW / 2)
+		lws_callback_on_writable(r->tx);
+}
+
+/*
+ * Loopback doesn't drop unless the socket buffer is full, but if anything
+ * went missing the window would never drain; write it off and carry on
+ */
+
+static void
+stall_cb(lws_sorted_usec_list_t *sul)
+{
+	if (cur) {
+		if (cur->rcvd == cur->last_rcvd && cur->sent != cur->rcvd) {
+			cur->lost += cur->sent - cur->rcvd;
+			cur->rcvd = cur->sent;
+			refill(cur);
+		}
+		cur->last_rcvd = cur->rcvd;
+	}
+
+	lws_sul_schedule(context, 0, &sul_stall, stall_cb, 100 * LWS_US_PER_MS);
+}
+
+static int
+callback_udp(struct lws *wsi, enum lws_callback_reasons reason, void *user,
+	     void *in, size_t len)
+{
+	struct run *r = wsi ? (struct run *)lws_get_opaque_user_data(wsi) :
+			      NULL;
+	lws_udp_dgram_t dg[WINDOW];
+	const lws_udp_dgram_t *d;
+	unsigned int n, want;
+	int m;
+
+	switch (reason) {
+
+	case LWS_CALLBACK_RAW_RX:
+		if (!r)
+			break;
+		r->rx_cbs++;
+		r->rcvd++;
+		if (len != plen)
+			r->bad++;
+		refill(r);
+		break;
+
+	case LWS_CALLBACK_RAW_RX_BATCH:
+		if (!r)
+			break;
+		d = (const lws_udp_dgram_t *)in;
+		r->rx_cbs++;
+		r->rcvd += len;
+		for (n = 0; n < (unsigned int)len; n++)
+			if (d[n].len != plen || d[n].truncated)
+				r->bad++;
+		refill(r);
+		break;
+
+	case LWS_CALLBACK_RAW_WRITEABLE:
+		if (!r || wsi != r->tx || r->stop)
+			break;
+
+		want = WINDOW - (unsigned int)(r->sent - r->rcvd);
+
+		if (!(r->flags & LWS_CAUDP_BATCH_RX)) {
+			while (want--) {
+				if (lws_write(wsi, payload + LWS_PRE, plen,
+					      LWS_WRITE_RAW) < (int)plen)
+					return -1;
+				r->sent++;
+			}
+			break;
+		}
+
+		memset(dg, 0, sizeof(dg[0]) * want);
+		for (n = 0; n < want; n++) {
+			dg[n].buf = payload + LWS_PRE;
+			dg[n].len = plen;
+		}
+
+		m = lws_udp_write_batch(wsi, dg, want);
+		if (m < 0)
+			return -1;
+		r->sent += (unsigned int)m;
+		break;
+
+	default:
+		break;
+	}
+
+	return 0;
+}
+
+static const struct lws_protocols protocols[] = {
+	{ "udp-pps", callback_udp, 0, 0, 0, NULL, 0 },
+	LWS_PROTOCOL_LIST_TERM
+};
+
+int main(int argc, const char **argv)
+{
+	struct lws_context_creation_info info;
+	int secs = 3, port = 7682, n, fail = 0;
+	struct lws_vhost *vh;
+	lws_usec_t t, el;
+	const char *p;
+
+	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
+	lws_cmdline_option_handle_builtin(argc, argv, &info);
+
+	lwsl_user("LWS minimal bench udp pps [-s secs] [-l payload] [-p port]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-s")))
+		secs = atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-l")))
+		plen = (size_t)atoi(p);
+	if ((p = lws_cmdline_option(argc, argv, "-p")))
+		port = atoi(p);
+
+	if (!plen || plen > MAX_PAYLOAD) {
+		lwsl_err("payload must be 1 .. %d\n", MAX_PAYLOAD);
+		return 1;
+	}
+	memset(payload, 0xa5, sizeof(payload));
+
+	info.port = CONTEXT_PORT_NO_LISTEN_SERVER;
+	info.protocols = protocols;
+
+	context = lws_create_context(&info);
+	if (!context) {
+		lwsl_err("lws init failed\n");
+		return 1;
+	}
+	vh = lws_get_vhost_by_name(context, "default");
+
+	stall_cb(&sul_stall);
+
+	lwsl_user("%8s %12s %12s %10s %8s\n", "mode", "datagrams", "pps",
+		  "dgram/cb", "lost");
+
+	for (n = 0; n < (int)LWS_ARRAY_SIZE(runs) && !fail; n++) {
+		struct run *r = &runs[n];
+
+		r->rx = lws_create_adopt_udp(vh, "127.0.0.1", port + n,
+					     LWS_CAUDP_BIND | r->flags,
+					     protocols[0].name, NULL, NULL, r,
+					     NULL, NULL);
+		r->tx = lws_create_adopt_udp(vh, "127.0.0.1", port + n, 0,
+					     protocols[0].name, NULL, NULL, r,
+					     NULL, NULL);
+		if (!r->rx || !r->tx) {
+			lwsl_err("%s: udp wsi creation failed\n", __func__);
+			fail = 1;
+			break;
+		}
+
+		cur = r;
+		lws_callback_on_writable(r->tx);
+
+		t = lws_now_usecs();
+		while (lws_now_usecs() - t < secs * LWS_US_PER_SEC)
+			if (lws_service(context, 0) < 0) {
+				fail = 1;
+				break;
+			}
+		el = lws_now_usecs() - t;
+		r->stop = 1;
+		cur = NULL;
+
+		lwsl_user("%8s %12llu %12.0f %10.2f %8llu\n", r->name,
+			  (unsigned long long)r->rcvd,
+			  (double)r->rcvd * LWS_US_PER_SEC / (double)el,
+			  r->rx_cbs ? (double)r->rcvd / (double)r->rx_cbs : 0.0,
+			  (unsigned long long)r->lost);
+
+		if (!r->rcvd || r->bad) {
+			lwsl_err("%s: %s: %llu received, %llu bad\n", __func__,
+				 r->name, (unsigned long long)r->rcvd,
+				 (unsigned long long)r->bad);
+			fail = 1;
+		}
+	}
+
+	lws_sul_cancel(&sul_stall);
+	lws_context_destroy(context);
+
+	lwsl_user("Completed: %s\n", fail ? "FAILED" : "OK");
+
+	return fail;
+}
@@ -0,0 +1,204 @@
+/*
+ * lws-minimal-bench-ws-unmask
+ *
+ * Written in 2010-2026 by Andy Green <andy@warmcat.com>
+ *
+ * This file is made available under the Creative Commons CC0 1.0
+ * Universal Public Domain Dedication.
+ *
+ * Compares ways to apply the ws masking key to a payload buffer in place.
+ *
+ *  - bytewise: the classic c ^ mask[idx++ & 3] per byte
+ *  - unroll4:  the 4-byte unrolled loop lws used before
+ *  - word64:   a plain 64-bit word loop
+ *  - lws:      lws_ws_mask_xor(), using whatever vector kernel lws was built
+ *		with
+ *
+ * Each is first checked against bytewise for a range of lengths, alignments
+ * and starting key phases, then timed at several buffer sizes.  On x86 we
+ * also report bytes per TSC tick.
+ */
+
+#include <libwebsockets.h>
+#include <string.h>
+#include <stdlib.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC
+#endif
+
+typedef void (*mask_fn_t)(uint8_t *buf, size_t len, const uint8_t *mask,
+			  uint8_t *mask_idx);
+
+static void
+mask_bytewise(uint8_t *buf, size_t len, const uint8_t *mask, uint8_t *mask_idx)
+{
+	uint8_t idx = *mask_idx;
+
+	while (len--)
+		*buf++ ^= mask[(idx++) & 3];
+
+	*mask_idx = idx & 3;
+}
+
+static void
+mask_unroll4(uint8_t *buf, size_t len, const uint8_t *mask, uint8_t *mask_idx)
+{
+	uint8_t m[4];
+	size_t n;
+
+	for (n = 0; n < 4; n++)
+		m[n] = mask[(*mask_idx + n) & 3];
+
+	n = len >> 2;
+	while (n--) {
+		*buf++ ^= m[0];
+		*buf++ ^= m[1];
+		*buf++ ^= m[2];
+		*buf++ ^= m[3];
+	}
+	for (n = 0; n < (len & 3); n++)
+		*buf++ ^= m[n];
+
+	*mask_idx = (uint8_t)((*mask_idx + len) & 3);
+}
+
+static void
+mask_word64(uint8_t *buf, size_t len, const uint8_t *mask, uint8_t *mask_idx)
+{
+	uint8_t key[8];
+	uint64_t k, w;
+	size_t n;
+
+	for (n = 0; n < 8; n++)
+		key[n] = mask[(*mask_idx + n) & 3];
+	memcpy(&k, key, 8);
+	*mask_idx = (uint8_t)((*mask_idx + len) & 3);
+
+	for (; len >= 8; len -= 8, buf += 8) {
+		memcpy(&w, buf, 8);
+		w ^= k;
+		memcpy(buf, &w, 8);
+	}
+	for (n = 0; n < len; n++)
+		buf[n] ^= key[n];
+}
+
+static const struct {
+	const char	*name;
+	mask_fn_t	fn;
+} kernels[] = {
+	{ "bytewise",	mask_bytewise },
+	{ "unroll4",	mask_unroll4 },
+	{ "word64",	mask_word64 },
+	{ "lws",	lws_ws_mask_xor },
+};
+
+static const uint8_t key[4] = { 0x37, 0xfa, 0x21, 0x3d };
+
+static int
+check(mask_fn_t fn)
+{
+	uint8_t a[256 + 32], b[sizeof(a)], ia, ib;
+	size_t len, ofs, n;
+
+	for (n = 0; n < sizeof(a); n++)
+		a[n] = (uint8_t)(n * 7);
+
+	for (ofs = 0; ofs < 32; ofs++)
+		for (len = 0; len <= 256; len++)
+			for (n = 0; n < 4; n++) {
+				memcpy(b, a, sizeof(a));
+				ia = ib = (uint8_t)n;
+				mask_bytewise(a + ofs, len, key, &ia);
+				fn(b + ofs, len, key, &ib);
+				if (memcmp(a, b, sizeof(a)) || ia != ib)
+					return 1;
+				/* masking is its own inverse, restore a */
+				ia = (uint8_t)n;
+				mask_bytewise(a + ofs, len, key, &ia);
+			}
+
+	return 0;
+}
+
+int main(int argc, const char **argv)
+{
+	static const size_t sizes[] = { 64, 1024, 16384, 262144, 4194304 };
+	size_t total = 256 * 1024 * 1024, s, k, rounds, r;
+	int logs = LLL_USER | LLL_ERR | LLL_WARN | LLL_NOTICE, fail = 0;
+	const char *p;
+	uint8_t *buf;
+
+	if ((p = lws_cmdline_option(argc, argv, "-d")))
+		logs = atoi(p);
+	lws_set_log_level(logs, NULL);
+
+	lwsl_user("LWS minimal bench ws unmask [-m MB per measurement]\n");
+
+	if ((p = lws_cmdline_option(argc, argv, "-m")))
+		total = (size_t)atoi(p) * 1024 * 1024;
+
+	for (k = 0; k < LWS_ARRAY_SIZE(kernels); k++)
+		if (check(kernels[k].fn)) {
+			lwsl_err("%s: output mismatch\n", kernels[k].name);
+			fail = 1;
+		}
+	if (fail)
+		goto bail;
+
+	/* +1 so the buffer is misaligned like a payload after a ws header */
+	buf = malloc(sizes[LWS_ARRAY_SIZE(sizes) - 1] + 1);
+	if (!buf)
+		return 1;
+	memset(buf, 0x55, sizes[LWS_ARRAY_SIZE(sizes) - 1] + 1);
+
+#if defined(HAVE_TSC)
+	lwsl_user("%10s %10s %12s %12s\n", "kernel", "size", "MB/s", "B/tick");
+#else
+	lwsl_user("%10s %10s %12s\n", "kernel", "size", "MB/s");
+#endif
+
+	for (s = 0; s < LWS_ARRAY_SIZE(sizes); s++) {
+		rounds = total / sizes[s];
+		if (!rounds)
+			rounds = 1;
+
+		for (k = 0; k < LWS_ARRAY_SIZE(kernels); k++) {
+			uint8_t idx = 0;
+			lws_usec_t t;
+#if defined(HAVE_TSC)
+			uint64_t c;
+
+			c = __rdtsc();
+#endif
+			t = lws_now_usecs();
+			for (r = 0; r < rounds; r++)
+				kernels[k].fn(buf + 1, sizes[s], key, &idx);
+			t = lws_now_usecs() - t;
+#if defined(HAVE_TSC)
+			c = __rdtsc() - c;
+#endif
+			if (!t)
+				t = 1;
+
+#if defined(HAVE_TSC)
+			lwsl_user("%10s %10u %12.1f %12.2f\n", kernels[k].name,
+				  (unsigned int)sizes[s],
+				  (double)(rounds * sizes[s]) / (double)t,
+				  (double)(rounds * sizes[s]) / (double)c);
+#else
+			lwsl_user("%10s %10u %12.1f\n", kernels[k].name,
+				  (unsigned int)sizes[s],
+				  (double)(rounds * sizes[s]) / (double)t);
+#endif
+		}
+	}
+
+	free(buf);
+
+bail:
+	lwsl_user("Completed: %s\n", fail ? "FAIL" : "OK");
+
+	return fail;
+}
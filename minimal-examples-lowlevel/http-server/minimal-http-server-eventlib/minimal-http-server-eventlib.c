@@ -63,7 +63,7 @@ int main(int argc, const char **argv)
 
 	lws_set_log_level(logs, NULL);
 	lwsl_user("LWS minimal http server eventlib | visit http://localhost:7681\n");
-	lwsl_user(" [-s (ssl)] [--uv (libuv)] [--ev (libev)] [--event (libevent)]\n");
+	lwsl_user(" [-s (ssl)] [--uv (libuv)] [--ev (libev)] [--event (libevent)] [--epoll] [--uring]\n");
 
 	memset(&info, 0, sizeof info); /* otherwise uninitialized garbage */
 	info.port = 7681;
@@ -96,6 +96,12 @@ int main(int argc, const char **argv)
 				else
 					signal(SIGINT, sigint_handler);
 
+	/* epoll and io_uring are driven by the default service loop like poll() */
+	if (lws_cmdline_option(argc, argv, "--epoll"))
+		info.options |= LWS_SERVER_OPTION_EPOLL;
+	if (lws_cmdline_option(argc, argv, "--uring"))
+		info.options |= LWS_SERVER_OPTION_IO_URING;
+
 	context = lws_create_context(&info);
 	if (!context) {
 		lwsl_err("lws init failed\n");
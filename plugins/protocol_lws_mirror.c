@@ -55,8 +55,7 @@ struct per_session_data__lws_mirror {
 
 /* this is the element in the ring */
 struct a_message {
-	void *payload;
-	size_t len;
+	struct lws_ws_bcast *bcast;
 };
 
 struct mirror_instance {
@@ -185,9 +184,8 @@ __mirror_destroy_message(void *_msg)
 {
 	struct a_message *msg = _msg;
 
-	free(msg->payload);
-	msg->payload = NULL;
-	msg->len = 0;
+	lws_ws_bcast_unref(msg->bcast);
+	msg->bcast = NULL;
 }
 
 static int
@@ -373,7 +371,7 @@ bail1:
 			if (!msg)
 				break;
 
-			if (!msg->payload) {
+			if (!msg->bcast) {
 				lwsl_err("%s: NULL payload: worst = %d,"
 					 " pss->tail = %d\n", __func__,
 					 oldest_tail, pss->tail);
@@ -383,8 +381,11 @@ bail1:
 				break;
 			}
 
-			n = lws_write(wsi, (unsigned char *)msg->payload +
-				      LWS_PRE, msg->len, LWS_WRITE_TEXT);
+			/*
+			 * the message was framed once when it arrived, every
+			 * pss sends the same bytes
+			 */
+			n = lws_ws_bcast_write(wsi, msg->bcast);
 			if (n < 0) {
 				lwsl_info("%s: WRITEABLE: %d\n", __func__, n);
 
@@ -435,14 +436,18 @@ bail2:
 			goto req_writable;
 		}
 
-		amsg.payload = malloc(LWS_PRE + len);
-		amsg.len = len;
-		if (!amsg.payload) {
+		/* pmd peers should keep getting it compressed... */
+		amsg.bcast = lws_ws_bcast_create(in, len, LWS_WRITE_TEXT,
+						 LWSWSBC_F_DEFLATE);
+		if (!amsg.bcast)
+			/* ...but if we can't, plain is still legal for them */
+			amsg.bcast = lws_ws_bcast_create(in, len,
+							 LWS_WRITE_TEXT, 0);
+		if (!amsg.bcast) {
 			lwsl_notice("OOM: dropping\n");
 			goto done2;
 		}
 
-		memcpy((char *)amsg.payload + LWS_PRE, in, len);
 		if (!lws_ring_insert(pss->mi->ring, &amsg, 1)) {
 			__mirror_destroy_message(&amsg);
 			lwsl_notice("dropping!\n");